@@ -32,6 +32,8 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/zip_io.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
 
 #include "thirdparty/misc/fastlz.h"
 
@@ -355,3 +357,116 @@ int Compression::zstd_level = 3;
 bool Compression::zstd_long_distance_matching = false;
 int Compression::zstd_window_log_size = 27; // ZSTD_WINDOWLOG_LIMIT_DEFAULT
 int Compression::gzip_chunk = 16384;
+
+Vector<uint8_t> ZstdDictionary::build(const Vector<Vector<uint8_t>> &p_samples, int p_max_size) {
+	// Simplified version of the cover algorithm: segments are scored by how many samples share their 8 byte sequences,
+	// and the best ones are concatenated. zstd favors the content at the end of the dictionary, so the best go last.
+	const int kmer_size = 8;
+	const int segment_size = 64;
+
+	HashMap<uint64_t, uint32_t> kmer_samples;
+	for (const Vector<uint8_t> &sample : p_samples) {
+		HashSet<uint64_t> seen;
+		for (int i = 0; i + kmer_size <= sample.size(); i++) {
+			uint64_t kmer;
+			memcpy(&kmer, sample.ptr() + i, kmer_size);
+			if (!seen.has(kmer)) {
+				seen.insert(kmer);
+				uint32_t *count = kmer_samples.getptr(kmer);
+				if (count) {
+					(*count)++;
+				} else {
+					kmer_samples.insert(kmer, 1);
+				}
+			}
+		}
+	}
+
+	struct Segment {
+		const uint8_t *ptr = nullptr;
+		int size = 0;
+		uint64_t score = 0;
+
+		bool operator<(const Segment &p_other) const {
+			return score > p_other.score;
+		}
+	};
+
+	Vector<Segment> segments;
+	for (const Vector<uint8_t> &sample : p_samples) {
+		for (int ofs = 0; ofs < sample.size(); ofs += segment_size) {
+			Segment segment;
+			segment.ptr = sample.ptr() + ofs;
+			segment.size = MIN(segment_size, sample.size() - ofs);
+			for (int i = 0; i + kmer_size <= segment.size; i++) {
+				uint64_t kmer;
+				memcpy(&kmer, segment.ptr + i, kmer_size);
+				// Content found in a single sample doesn't help other files.
+				segment.score += kmer_samples[kmer] - 1;
+			}
+			if (segment.score > 0) {
+				segments.push_back(segment);
+			}
+		}
+	}
+	segments.sort();
+
+	Vector<const Segment *> selected;
+	HashSet<uint32_t> used;
+	int total = 0;
+	for (const Segment &segment : segments) {
+		if (total + segment.size > p_max_size) {
+			break;
+		}
+		uint32_t hash = hash_murmur3_buffer(segment.ptr, segment.size);
+		if (used.has(hash)) {
+			continue;
+		}
+		used.insert(hash);
+		selected.push_back(&segment);
+		total += segment.size;
+	}
+
+	Vector<uint8_t> dictionary;
+	dictionary.resize(total);
+	uint8_t *w = dictionary.ptrw();
+	for (int i = selected.size() - 1; i >= 0; i--) {
+		memcpy(w, selected[i]->ptr, selected[i]->size);
+		w += selected[i]->size;
+	}
+	return dictionary;
+}
+
+int ZstdDictionary::compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size) const {
+	ERR_FAIL_NULL_V_MSG(cdict, -1, "Dictionary was not created for compression.");
+
+	ZSTD_CCtx *cctx = ZSTD_createCCtx();
+	size_t max_dst_size = ZSTD_compressBound(p_src_size);
+	size_t ret = ZSTD_compress_usingCDict(cctx, p_dst, max_dst_size, p_src, p_src_size, (const ZSTD_CDict *)cdict);
+	ZSTD_freeCCtx(cctx);
+	return ZSTD_isError(ret) ? -1 : (int)ret;
+}
+
+int ZstdDictionary::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size) const {
+	ZSTD_DCtx *dctx = ZSTD_createDCtx();
+	size_t ret = ZSTD_decompress_usingDDict(dctx, p_dst, p_dst_max_size, p_src, p_src_size, (const ZSTD_DDict *)ddict);
+	ZSTD_freeDCtx(dctx);
+	return ZSTD_isError(ret) ? -1 : (int)ret;
+}
+
+ZstdDictionary::ZstdDictionary(const Vector<uint8_t> &p_data, bool p_for_compression) {
+	data = p_data;
+	ddict = ZSTD_createDDict(data.ptr(), data.size());
+	if (p_for_compression) {
+		cdict = ZSTD_createCDict(data.ptr(), data.size(), Compression::zstd_level);
+	}
+}
+
+ZstdDictionary::~ZstdDictionary() {
+	if (cdict) {
+		ZSTD_freeCDict((ZSTD_CDict *)cdict);
+	}
+	if (ddict) {
+		ZSTD_freeDDict((ZSTD_DDict *)ddict);
+	}
+}
@@ -57,4 +57,22 @@ public:
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_size, const uint8_t *p_src, int p_src_size, Mode p_mode);
 };
 
+// Raw content dictionary for zstd, improves compression of many small inputs sharing content (e.g. resource files).
+class ZstdDictionary {
+	Vector<uint8_t> data;
+	void *cdict = nullptr;
+	void *ddict = nullptr;
+
+public:
+	static Vector<uint8_t> build(const Vector<Vector<uint8_t>> &p_samples, int p_max_size);
+
+	const Vector<uint8_t> &get_data() const { return data; }
+
+	int compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size) const;
+	int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size) const;
+
+	ZstdDictionary(const Vector<uint8_t> &p_data, bool p_for_compression = false);
+	~ZstdDictionary();
+};
+
 #endif // COMPRESSION_H
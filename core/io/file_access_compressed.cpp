@@ -30,8 +30,12 @@
 
 #include "file_access_compressed.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 
+// Amount of data decompressed ahead when reading sequentially.
+#define READ_AHEAD_SIZE (256 * 1024)
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
@@ -76,17 +80,143 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	comp_buffer.resize(max_bs);
 	buffer.resize(block_size);
 	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
-
-	int ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
-	read_block = 0;
+	read_ahead_first = 0;
+	read_ahead_count = 0;
 	read_pos = 0;
 
-	return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	return _load_block(0, false) ? OK : ERR_FILE_CORRUPT;
+}
+
+void FileAccessCompressed::_compress_block(void *p_userdata, uint32_t p_index) {
+	BlockTaskData *data = (BlockTaskData *)p_userdata;
+	uint64_t from = (uint64_t)p_index * data->block_size;
+	int bl = MIN(data->total - from, (uint64_t)data->block_size);
+
+	Vector<uint8_t> &cblock = data->compressed[p_index];
+	cblock.resize(Compression::get_max_compressed_buffer_size(bl, data->mode));
+	int s;
+	if (data->dictionary) {
+		s = data->dictionary->compress(cblock.ptrw(), data->src + from, bl);
+	} else {
+		s = Compression::compress(cblock.ptrw(), data->src + from, bl, data->mode);
+	}
+	if (s < 0) {
+		data->failed.set();
+		s = 0;
+	}
+	cblock.resize(s);
+}
+
+void FileAccessCompressed::_decompress_block(void *p_userdata, uint32_t p_index) {
+	BlockTaskData *data = (BlockTaskData *)p_userdata;
+	uint8_t *dst = data->dst + (uint64_t)p_index * data->block_size;
+	int dst_max_size = MIN(data->total, (uint64_t)data->block_size);
+
+	int ret;
+	if (data->dictionary) {
+		ret = data->dictionary->decompress(dst, dst_max_size, data->src + data->src_offsets[p_index], data->src_sizes[p_index]);
+	} else {
+		ret = Compression::decompress(dst, dst_max_size, data->src + data->src_offsets[p_index], data->src_sizes[p_index], data->mode);
+	}
+	if (ret == -1) {
+		data->failed.set();
+	}
+}
+
+void FileAccessCompressed::_run_block_tasks(void (*p_func)(void *, uint32_t), BlockTaskData *p_data, uint32_t p_count) {
+	// Only spread the work when called from outside of the pool, see GodotStep3D::set_parallel_islands().
+	if (p_count > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(p_func, p_data, p_count, -1, true, "FileAccessCompressed");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_func(p_data, i);
+		}
+	}
+}
+
+bool FileAccessCompressed::_load_block(uint32_t p_block, bool p_sequential) const {
+	uint32_t ahead_count = MIN(MAX(READ_AHEAD_SIZE / block_size, 1u), read_block_count - p_block);
+
+	if (p_block >= read_ahead_first && p_block < read_ahead_first + read_ahead_count) {
+		read_ptr = read_ahead_buffer.ptrw() + (uint64_t)(p_block - read_ahead_first) * block_size;
+	} else if (p_sequential && ahead_count > 1) {
+		// Compressed blocks are stored back to back, so the upcoming ones can be read at once and decompressed in parallel.
+		const ReadBlock &last = read_blocks[p_block + ahead_count - 1];
+		uint64_t comp_from = read_blocks[p_block].offset;
+
+		Vector<uint8_t> comp_data;
+		comp_data.resize(last.offset + last.csize - comp_from);
+		Vector<uint64_t> src_offsets;
+		src_offsets.resize(ahead_count);
+		Vector<uint32_t> src_sizes;
+		src_sizes.resize(ahead_count);
+		for (uint32_t i = 0; i < ahead_count; i++) {
+			src_offsets.write[i] = read_blocks[p_block + i].offset - comp_from;
+			src_sizes.write[i] = read_blocks[p_block + i].csize;
+		}
+
+		f->seek(comp_from);
+		if (f->get_buffer(comp_data.ptrw(), comp_data.size()) != (uint64_t)comp_data.size()) {
+			return false;
+		}
+
+		read_ahead_count = 0;
+		read_ahead_buffer.resize((uint64_t)ahead_count * block_size);
+
+		BlockTaskData data;
+		data.mode = cmode;
+		data.dictionary = cmode == Compression::MODE_ZSTD ? dictionary : nullptr;
+		data.block_size = block_size;
+		data.total = read_total;
+		data.src = comp_data.ptr();
+		data.dst = read_ahead_buffer.ptrw();
+		data.src_offsets = src_offsets.ptr();
+		data.src_sizes = src_sizes.ptr();
+		_run_block_tasks(&FileAccessCompressed::_decompress_block, &data, ahead_count);
+		if (data.failed.is_set()) {
+			return false;
+		}
+
+		read_ahead_first = p_block;
+		read_ahead_count = ahead_count;
+		read_ptr = read_ahead_buffer.ptrw();
+	} else {
+		f->seek(read_blocks[p_block].offset);
+		f->get_buffer(comp_buffer.ptrw(), read_blocks[p_block].csize);
+		int ret;
+		if (dictionary && cmode == Compression::MODE_ZSTD) {
+			ret = dictionary->decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[p_block].csize);
+		} else {
+			ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[p_block].csize, cmode);
+		}
+		if (ret == -1) {
+			return false;
+		}
+		read_ptr = buffer.ptrw();
+	}
+
+	read_block = p_block;
+	read_block_size = p_block == read_block_count - 1 ? read_total % block_size : block_size;
+	return true;
+}
+
+Error FileAccessCompressed::open_for_write(Ref<FileAccess> p_base) {
+	_close();
+
+	f = p_base;
+	buffer.clear();
+	writing = true;
+	write_pos = 0;
+	write_buffer_size = 256;
+	buffer.resize(256);
+	write_max = 0;
+	write_ptr = buffer.ptrw();
+
+	return OK;
 }
 
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
@@ -133,6 +263,7 @@ void FileAccessCompressed::_close() {
 	if (writing) {
 		//save block table and all compressed blocks
 
+		uint64_t start = f->get_position();
 		CharString mgc = magic.utf8();
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
 		f->store_32(cmode); //write compression mode 4
@@ -144,24 +275,34 @@ void FileAccessCompressed::_close() {
 			f->store_32(0); //compressed sizes, will update later
 		}
 
+		// Blocks are compressed independently, so they can be processed in parallel and written in order afterwards.
+		Vector<Vector<uint8_t>> blocks;
+		blocks.resize(bc);
+
+		BlockTaskData data;
+		data.mode = cmode;
+		data.dictionary = cmode == Compression::MODE_ZSTD ? dictionary : nullptr;
+		data.block_size = block_size;
+		data.total = write_max;
+		data.src = write_ptr;
+		data.compressed = blocks.ptrw();
+		_run_block_tasks(&FileAccessCompressed::_compress_block, &data, bc);
+		if (data.failed.is_set()) {
+			ERR_PRINT("Failed to compress block in file '" + f->get_path() + "'.");
+		}
+
 		Vector<int> block_sizes;
 		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
+			f->store_buffer(blocks[i].ptr(), blocks[i].size());
+			block_sizes.push_back(blocks[i].size());
 		}
 
-		f->seek(16); //ok write block sizes
+		uint64_t end = f->get_position();
+		f->seek(start + 16); //ok write block sizes
 		for (uint32_t i = 0; i < bc; i++) {
 			f->store_32(block_sizes[i]);
 		}
-		f->seek_end();
+		f->seek(end);
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
 
 		buffer.clear();
@@ -170,6 +311,8 @@ void FileAccessCompressed::_close() {
 		comp_buffer.clear();
 		buffer.clear();
 		read_blocks.clear();
+		read_ahead_buffer.clear();
+		read_ahead_count = 0;
 	}
 	f.unref();
 }
@@ -211,12 +354,7 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			read_eof = false;
 			uint32_t block_idx = p_position / block_size;
 			if (block_idx != read_block) {
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				ERR_FAIL_COND_MSG(!_load_block(block_idx, false), "Compressed file is corrupt.");
 			}
 
 			read_pos = p_position % block_size;
@@ -273,18 +411,12 @@ uint8_t FileAccessCompressed::get_8() const {
 
 	read_pos++;
 	if (read_pos >= read_block_size) {
-		read_block++;
-
-		if (read_block < read_block_count) {
+		if (read_block + 1 < read_block_count) {
 			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			int total = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-			ERR_FAIL_COND_V_MSG(total == -1, 0, "Compressed file is corrupt.");
-			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+			ERR_FAIL_COND_V_MSG(!_load_block(read_block + 1, true), 0, "Compressed file is corrupt.");
 			read_pos = 0;
 
 		} else {
-			read_block--;
 			at_end = true;
 		}
 	}
@@ -302,27 +434,25 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
-		if (read_pos >= read_block_size) {
-			read_block++;
+	uint64_t dst_idx = 0;
+	while (dst_idx < p_length) {
+		uint64_t to_copy = MIN(p_length - dst_idx, (uint64_t)(read_block_size - read_pos));
+		memcpy(p_dst + dst_idx, read_ptr + read_pos, to_copy);
+		dst_idx += to_copy;
+		read_pos += to_copy;
 
-			if (read_block < read_block_count) {
+		if (read_pos >= read_block_size) {
+			if (read_block + 1 < read_block_count) {
 				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				ERR_FAIL_COND_V_MSG(!_load_block(read_block + 1, true), -1, "Compressed file is corrupt.");
 				read_pos = 0;
 
 			} else {
-				read_block--;
 				at_end = true;
-				if (i + 1 < p_length) {
+				if (dst_idx < p_length) {
 					read_eof = true;
 				}
-				return i + 1;
+				return dst_idx;
 			}
 		}
 	}
@@ -349,6 +479,16 @@ void FileAccessCompressed::store_8(uint8_t p_dest) {
 	write_ptr[write_pos++] = p_dest;
 }
 
+void FileAccessCompressed::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!writing, "File has not been opened in write mode.");
+	ERR_FAIL_COND(!p_src && p_length > 0);
+
+	WRITE_FIT(p_length);
+	memcpy(write_ptr + write_pos, p_src, p_length);
+	write_pos += p_length;
+}
+
 bool FileAccessCompressed::file_exists(const String &p_name) {
 	Ref<FileAccess> fa = FileAccess::open(p_name, FileAccess::READ);
 	if (fa.is_null()) {
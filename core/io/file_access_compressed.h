@@ -33,9 +33,11 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/templates/safe_refcount.h"
 
 class FileAccessCompressed : public FileAccess {
 	Compression::Mode cmode = Compression::MODE_ZSTD;
+	const ZstdDictionary *dictionary = nullptr;
 	bool writing = false;
 	uint64_t write_pos = 0;
 	uint8_t *write_ptr = nullptr;
@@ -51,7 +53,7 @@ class FileAccessCompressed : public FileAccess {
 	};
 
 	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	mutable uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
 	mutable uint32_t read_block_size = 0;
@@ -59,16 +61,42 @@ class FileAccessCompressed : public FileAccess {
 	Vector<ReadBlock> read_blocks;
 	uint64_t read_total = 0;
 
+	// Blocks decompressed ahead of time while reading sequentially.
+	mutable Vector<uint8_t> read_ahead_buffer;
+	mutable uint32_t read_ahead_first = 0;
+	mutable uint32_t read_ahead_count = 0;
+
 	String magic = "GCMP";
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	struct BlockTaskData {
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		const ZstdDictionary *dictionary = nullptr;
+		uint32_t block_size = 0;
+		uint64_t total = 0;
+		const uint8_t *src = nullptr;
+		uint8_t *dst = nullptr;
+		const uint32_t *src_sizes = nullptr;
+		const uint64_t *src_offsets = nullptr;
+		Vector<uint8_t> *compressed = nullptr;
+		SafeFlag failed;
+	};
+
+	static void _compress_block(void *p_userdata, uint32_t p_index);
+	static void _decompress_block(void *p_userdata, uint32_t p_index);
+	static void _run_block_tasks(void (*p_func)(void *, uint32_t), BlockTaskData *p_data, uint32_t p_count);
+
+	bool _load_block(uint32_t p_block, bool p_sequential) const;
 	void _close();
 
 public:
 	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+	// Only used in MODE_ZSTD, must be set before opening and outlive the file.
+	void set_dictionary(const ZstdDictionary *p_dictionary) { dictionary = p_dictionary; }
 
 	Error open_after_magic(Ref<FileAccess> p_base);
+	Error open_for_write(Ref<FileAccess> p_base); ///< write the compressed stream at the current position of p_base when closed
 
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
 	virtual bool is_open() const override; ///< true when file is open
@@ -91,6 +119,7 @@ public:
 	virtual Error resize(int64_t p_length) override { return ERR_UNAVAILABLE; }
 	virtual void flush() override;
 	virtual void store_8(uint8_t p_dest) override; ///< store a byte
+	virtual void store_buffer(const uint8_t *p_src, uint64_t p_length) override;
 
 	virtual bool file_exists(const String &p_name) override; ///< return true if a file exists
 
@@ -30,6 +30,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
@@ -47,7 +48,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, const ZstdDictionary *p_dictionary) {
 	String simplified_path = p_path.simplify_path();
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -55,6 +56,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.dictionary = p_dictionary;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -212,7 +214,9 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
 	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE);
 
-	for (int i = 0; i < 16; i++) {
+	uint64_t dictionary_ofs = f->get_64();
+	uint32_t dictionary_size = f->get_32();
+	for (int i = 0; i < 13; i++) {
 		//reserved
 		f->get_32();
 	}
@@ -223,6 +227,19 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		file_base += pck_start_pos;
 	}
 
+	ZstdDictionary *dictionary = nullptr;
+	if (pack_flags & PACK_ZSTD_DICTIONARY) {
+		uint64_t dir_pos = f->get_position();
+		Vector<uint8_t> dictionary_data;
+		dictionary_data.resize(dictionary_size);
+		f->seek(file_base + dictionary_ofs + p_offset);
+		ERR_FAIL_COND_V_MSG(f->get_buffer(dictionary_data.ptrw(), dictionary_size) != dictionary_size, false, "Can't read pack compression dictionary.");
+		f->seek(dir_pos);
+
+		dictionary = memnew(ZstdDictionary(dictionary_data));
+		dictionaries.push_back(dictionary);
+	}
+
 	if (enc_directory) {
 		Ref<FileAccessEncrypted> fae;
 		fae.instantiate();
@@ -255,7 +272,8 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		ERR_CONTINUE_MSG((flags & PACK_FILE_COMPRESSED) && !dictionary, "File '" + path + "' is compressed, but the pack has no compression dictionary.");
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED) ? dictionary : nullptr);
 	}
 
 	return true;
@@ -265,6 +283,12 @@ Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::Pack
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
+PackedSourcePCK::~PackedSourcePCK() {
+	for (ZstdDictionary *dictionary : dictionaries) {
+		memdelete(dictionary);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
 Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
@@ -402,6 +426,21 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
+
+	if (pf.dictionary) {
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure(PACK_COMPRESSED_FILE_MAGIC);
+		fac->set_dictionary(pf.dictionary);
+
+		char magic[5] = {};
+		f->get_buffer((uint8_t *)magic, 4);
+		ERR_FAIL_COND_MSG(String(magic) != PACK_COMPRESSED_FILE_MAGIC, "Compressed pack-referenced file '" + String(pf.pack) + "' is corrupt.");
+		Error err = fac->open_after_magic(f);
+		ERR_FAIL_COND_MSG(err, "Can't open compressed pack-referenced file '" + String(pf.pack) + "'.");
+		f = fac;
+		off = 0;
+	}
 	pos = 0;
 	eof = false;
 }
@@ -31,6 +31,7 @@
 #ifndef FILE_ACCESS_PACK_H
 #define FILE_ACCESS_PACK_H
 
+#include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/string/print_string.h"
@@ -43,13 +44,18 @@
 // The current packed file format version number.
 #define PACK_FORMAT_VERSION 2
 
+// Magic of the compressed stream used for files with PACK_FILE_COMPRESSED ("GCPD" in ASCII).
+#define PACK_COMPRESSED_FILE_MAGIC "GCPD"
+
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
 	PACK_REL_FILEBASE = 1 << 1,
+	PACK_ZSTD_DICTIONARY = 1 << 2, // Offset (64 bits, relative to file base) and size (32 bits) of the dictionary are stored in the first reserved fields.
 };
 
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_COMPRESSED = 1 << 1, // Compressed with the pack's zstd dictionary.
 };
 
 class PackSource;
@@ -67,6 +73,7 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		const ZstdDictionary *dictionary = nullptr; // Set if the file is compressed.
 	};
 
 private:
@@ -110,7 +117,7 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, const ZstdDictionary *p_dictionary = nullptr); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -136,9 +143,13 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	Vector<ZstdDictionary *> dictionaries;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+
+	virtual ~PackedSourcePCK();
 };
 
 class FileAccessPack : public FileAccess {
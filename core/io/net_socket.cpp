@@ -30,6 +30,8 @@
 
 #include "net_socket.h"
 
+#include "core/os/os.h"
+
 NetSocket *(*NetSocket::_create)() = nullptr;
 
 NetSocket *NetSocket::create() {
@@ -40,3 +42,96 @@ NetSocket *NetSocket::create() {
 	ERR_PRINT("Unable to create network socket, platform not supported");
 	return nullptr;
 }
+
+Error NetSocket::recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received) {
+	r_received = 0;
+	while (r_received < p_count) {
+		if (r_received > 0 && poll(POLL_TYPE_IN, 0) != OK) {
+			break; // Nothing else pending, don't block on a blocking socket.
+		}
+		Datagram &dg = p_datagrams[r_received];
+		Error err = recvfrom(dg.buffer, dg.size, dg.transferred, dg.ip, dg.port);
+		if (err != OK) {
+			return r_received > 0 ? OK : err;
+		}
+		r_received++;
+	}
+	return OK;
+}
+
+Error NetSocket::sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent) {
+	r_sent = 0;
+	while (r_sent < p_count) {
+		const Datagram &dg = p_datagrams[r_sent];
+		int sent = 0;
+		Error err = sendto(dg.buffer, dg.size, sent, dg.ip, dg.port);
+		if (err != OK) {
+			return r_sent > 0 ? OK : err;
+		}
+		r_sent++;
+	}
+	return OK;
+}
+
+NetSocketPoller *(*NetSocketPoller::_create)() = nullptr;
+
+NetSocketPoller *NetSocketPoller::create() {
+	if (_create) {
+		return _create();
+	}
+	return memnew(NetSocketPoller);
+}
+
+Error NetSocketPoller::add(const Ref<NetSocket> &p_socket, uint64_t p_id, NetSocket::PollType p_type) {
+	ERR_FAIL_COND_V(p_socket.is_null() || !p_socket->is_open(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(sockets.has(p_id), ERR_ALREADY_EXISTS);
+	Entry entry;
+	entry.socket = p_socket;
+	entry.type = p_type;
+	sockets.insert(p_id, entry);
+	return OK;
+}
+
+Error NetSocketPoller::modify(uint64_t p_id, NetSocket::PollType p_type) {
+	Entry *entry = sockets.getptr(p_id);
+	ERR_FAIL_NULL_V(entry, ERR_DOES_NOT_EXIST);
+	entry->type = p_type;
+	return OK;
+}
+
+void NetSocketPoller::remove(uint64_t p_id) {
+	sockets.erase(p_id);
+}
+
+void NetSocketPoller::clear() {
+	sockets.clear();
+}
+
+Error NetSocketPoller::wait(LocalVector<Event> &r_events, int p_timeout) {
+	r_events.clear();
+	const uint64_t until = OS::get_singleton()->get_ticks_msec() + MAX(p_timeout, 0);
+	while (true) {
+		for (const KeyValue<uint64_t, Entry> &E : sockets) {
+			const Entry &entry = E.value;
+			Event ev;
+			ev.id = E.key;
+			if (entry.type != NetSocket::POLL_TYPE_OUT) {
+				Error err = entry.socket->poll(NetSocket::POLL_TYPE_IN, 0);
+				ev.readable = err == OK;
+				ev.error = err != OK && err != ERR_BUSY;
+			}
+			if (entry.type != NetSocket::POLL_TYPE_IN && !ev.error) {
+				Error err = entry.socket->poll(NetSocket::POLL_TYPE_OUT, 0);
+				ev.writable = err == OK;
+				ev.error = err != OK && err != ERR_BUSY;
+			}
+			if (ev.readable || ev.writable || ev.error) {
+				r_events.push_back(ev);
+			}
+		}
+		if (!r_events.is_empty() || (p_timeout >= 0 && OS::get_singleton()->get_ticks_msec() >= until)) {
+			return OK;
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+}
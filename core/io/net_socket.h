@@ -33,6 +33,8 @@
 
 #include "core/io/ip.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 
 class NetSocket : public RefCounted {
 protected:
@@ -53,6 +55,17 @@ public:
 		TYPE_UDP,
 	};
 
+	// A single datagram for the batched UDP calls. When receiving, `size` is the buffer capacity
+	// and `ip`/`port` are filled with the sender. When sending, `size` is the payload length.
+	// `transferred` holds the number of bytes actually received or sent.
+	struct Datagram {
+		uint8_t *buffer = nullptr;
+		int size = 0;
+		int transferred = 0;
+		IPAddress ip;
+		uint16_t port = 0;
+	};
+
 	virtual Error open(Type p_type, IP::Type &ip_type) = 0;
 	virtual void close() = 0;
 	virtual Error bind(IPAddress p_addr, uint16_t p_port) = 0;
@@ -65,6 +78,11 @@ public:
 	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IPAddress p_ip, uint16_t p_port) = 0;
 	virtual Ref<NetSocket> accept(IPAddress &r_ip, uint16_t &r_port) = 0;
 
+	// Batched UDP I/O. Implementations may move several datagrams per system call, the default
+	// falls back to one recvfrom/sendto per datagram. Return ERR_BUSY only if nothing was transferred.
+	virtual Error recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received);
+	virtual Error sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent);
+
 	virtual bool is_open() const = 0;
 	virtual int get_available_bytes() const = 0;
 	virtual Error get_socket_address(IPAddress *r_ip, uint16_t *r_port) const = 0;
@@ -78,4 +96,42 @@ public:
 	virtual Error leave_multicast_group(const IPAddress &p_multi_address, const String &p_if_name) = 0;
 };
 
+// Watches many sockets at once and reports only those that are ready, so servers with many
+// mostly idle connections don't have to poll each one every frame. The base class checks the
+// sockets one by one; platforms can provide a kernel-backed implementation (e.g. epoll).
+class NetSocketPoller : public RefCounted {
+protected:
+	static NetSocketPoller *(*_create)();
+
+	struct Entry {
+		Ref<NetSocket> socket;
+		NetSocket::PollType type = NetSocket::POLL_TYPE_IN;
+	};
+
+	HashMap<uint64_t, Entry> sockets;
+
+public:
+	struct Event {
+		uint64_t id = 0;
+		bool readable = false;
+		bool writable = false;
+		bool error = false; // Hang-up or socket error, the next read will report it.
+	};
+
+	static NetSocketPoller *create();
+
+	virtual Error add(const Ref<NetSocket> &p_socket, uint64_t p_id, NetSocket::PollType p_type = NetSocket::POLL_TYPE_IN);
+	virtual Error modify(uint64_t p_id, NetSocket::PollType p_type);
+	virtual void remove(uint64_t p_id);
+	virtual void clear();
+	// Fills r_events with the sockets that are ready, waiting up to p_timeout msecs if none is.
+	// A negative timeout waits until one is.
+	virtual Error wait(LocalVector<Event> &r_events, int p_timeout = 0);
+
+	bool has(uint64_t p_id) const { return sockets.has(p_id); }
+	int get_socket_count() const { return sockets.size(); }
+
+	virtual ~NetSocketPoller() {}
+};
+
 #endif // NET_SOCKET_H
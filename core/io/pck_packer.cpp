@@ -34,6 +34,8 @@
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -121,17 +123,8 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	pf.src_path = p_src;
 	pf.ofs = ofs;
 	pf.size = f->get_length();
-
-	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_src);
-	{
-		unsigned char hash[16];
-		CryptoCore::md5(data.ptr(), data.size(), hash);
-		pf.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			pf.md5.write[i] = hash[i];
-		}
-	}
 	pf.encrypted = p_encrypt;
+	// MD5 is computed for all files at once when flushing.
 
 	uint64_t _size = pf.size;
 	if (p_encrypt) { // Add encryption overhead.
@@ -151,9 +144,51 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	return OK;
 }
 
+void PCKPacker::_compute_md5(uint32_t p_index, File *p_files) {
+	File &pf = p_files[p_index];
+
+	Ref<FileAccess> src = FileAccess::open(pf.src_path, FileAccess::READ);
+	if (src.is_null()) {
+		return;
+	}
+
+	CryptoCore::MD5Context ctx;
+	ctx.start();
+
+	const uint64_t buf_max = 65536;
+	LocalVector<uint8_t> buf;
+	buf.resize(MIN(pf.size, buf_max));
+	uint64_t to_read = pf.size;
+	while (to_read > 0) {
+		uint64_t read = src->get_buffer(buf.ptr(), MIN(to_read, buf_max));
+		if (read == 0) {
+			break;
+		}
+		ctx.update(buf.ptr(), read);
+		to_read -= read;
+	}
+
+	pf.md5.resize(16);
+	ctx.finish(pf.md5.ptrw());
+}
+
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
+	// Hash all files in parallel, results are stored per file so the output stays deterministic.
+	// Like FileAccessCompressed, only do so when not called from a pool thread.
+	if (files.size() > 1 && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &PCKPacker::_compute_md5, files.ptrw(), files.size(), -1, false, SNAME("PCKPackerHash"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (int i = 0; i < files.size(); i++) {
+			_compute_md5(i, files.ptrw());
+		}
+	}
+	for (int i = 0; i < files.size(); i++) {
+		ERR_FAIL_COND_V_MSG(files[i].md5.size() != 16, ERR_FILE_CANT_READ, "Can't open file to read: " + files[i].src_path + ".");
+	}
+
 	int64_t file_base_ofs = file->get_position();
 	file->store_64(0); // files base
 
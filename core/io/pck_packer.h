@@ -57,6 +57,8 @@ class PCKPacker : public RefCounted {
 	};
 	Vector<File> files;
 
+	void _compute_md5(uint32_t p_index, File *p_files);
+
 public:
 	Error pck_start(const String &p_file, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false);
@@ -404,6 +404,15 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 					if (using_named_scene_ids) { // New format.
 						ERR_FAIL_INDEX_V((int)index, internal_resources.size(), ERR_PARSE_ERROR);
+						if (!sub_resource_id.is_empty() && (int)index < internal_resources.size() - 1 && internal_resources[index].path.begins_with("local://")) {
+							// Not decoded yet, load it now and resume reading this variant.
+							uint64_t pos = f->get_position();
+							Error err = _load_internal_resource(index);
+							if (err != OK) {
+								return err;
+							}
+							f->seek(pos);
+						}
 						path = internal_resources[index].path;
 					} else {
 						path += res_path + "::" + itos(index);
@@ -448,6 +457,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
+						if (!external_resources[erindex].load_started) {
+							Error err = _start_external_load(erindex);
+							if (err != OK) {
+								return err;
+							}
+						}
 						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
 						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
 							Error err;
@@ -680,211 +695,238 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
-Error ResourceLoaderBinary::load() {
-	if (error != OK) {
-		return error;
-	}
+Error ResourceLoaderBinary::_start_external_load(int p_index) {
+	external_resources.write[p_index].load_started = true;
 
-	for (int i = 0; i < external_resources.size(); i++) {
-		String path = external_resources[i].path;
+	String path = external_resources[p_index].path;
 
-		if (remaps.has(path)) {
-			path = remaps[path];
-		}
+	if (remaps.has(path)) {
+		path = remaps[path];
+	}
 
-		if (!path.contains("://") && path.is_relative_path()) {
-			// path is relative to file being loaded, so convert to a resource path
-			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
-		}
+	if (!path.contains("://") && path.is_relative_path()) {
+		// path is relative to file being loaded, so convert to a resource path
+		path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[p_index].path));
+	}
 
-		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
-		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
-		if (!external_resources[i].load_token.is_valid()) {
-			if (!ResourceLoader::get_abort_on_missing_resources()) {
-				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
-			} else {
-				error = ERR_FILE_MISSING_DEPENDENCIES;
-				ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
-			}
+	external_resources.write[p_index].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+	external_resources.write[p_index].load_token = ResourceLoader::_load_start(path, external_resources[p_index].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
+	if (!external_resources[p_index].load_token.is_valid()) {
+		if (!ResourceLoader::get_abort_on_missing_resources()) {
+			ResourceLoader::notify_dependency_error(local_path, path, external_resources[p_index].type);
+		} else {
+			error = ERR_FILE_MISSING_DEPENDENCIES;
+			ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
 		}
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+	return OK;
+}
 
-		//maybe it is loaded already
-		String path;
-		String id;
+Error ResourceLoaderBinary::_load_internal_resource(int p_index) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-		if (!main) {
-			path = internal_resources[i].path;
+	//maybe it is loaded already
+	String path;
+	String id;
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+	if (!main) {
+		path = internal_resources[p_index].path;
 
-				internal_resources.write[i].path = path; // Update path.
-			}
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
-			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+			internal_resources.write[p_index].path = path; // Update path.
+		}
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				error = OK;
+				internal_index_cache[path] = cached;
+				return OK;
 			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-		uint64_t offset = internal_resources[i].offset;
+	uint64_t offset = internal_resources[p_index].offset;
 
-		f->seek(offset);
+	f->seek(offset);
 
-		String t = get_unicode_string();
+	String t = get_unicode_string();
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+	Ref<Resource> res;
+	Resource *r = nullptr;
 
-		MissingResource *missing_resource = nullptr;
+	MissingResource *missing_resource = nullptr;
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
-		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
+	if (main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
+		}
 
-			if (res.is_null()) {
-				//did not replace
-
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-					}
-				}
-
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					missing_resource = memnew(MissingResource);
+					missing_resource->set_original_class(t);
+					missing_resource->set_recording_properties(true);
+					obj = missing_resource;
+				} else {
 					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
 				}
+			}
 
-				res = Ref<Resource>(r);
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				error = ERR_FILE_CORRUPT;
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
 			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
-				} else {
-					r->set_path_cache(path);
-				}
+	if (r) {
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
 			}
-			r->set_scene_unique_id(id);
 		}
+		r->set_scene_unique_id(id);
+	}
 
-		if (!main) {
-			internal_index_cache[path] = res;
-		}
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
 
-		int pc = f->get_32();
+	int pc = f->get_32();
 
-		//set properties
+	//set properties
 
-		Dictionary missing_resource_properties;
+	Dictionary missing_resource_properties;
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+		if (name == StringName()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
 
-			Variant value;
+		Variant value;
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+		error = parse_variant(value);
+		if (error) {
+			return error;
+		}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
+		}
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 				}
 			}
-
-			if (set_valid) {
-				res->set(name, value);
-			}
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		if (set_valid) {
+			res->set(name, value);
 		}
+	}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
-		}
+	if (missing_resource) {
+		missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
 
 #ifdef TOOLS_ENABLED
-		res->set_edited(false);
+	res->set_edited(false);
 #endif
 
+	resource_cache.push_back(res);
+
+	if (main) {
+		f.unref();
+		resource = res;
+		resource->set_as_translation_remapped(translation_remapped);
+	}
+
+	error = OK;
+	return OK;
+}
+
+Error ResourceLoaderBinary::load() {
+	if (error != OK) {
+		return error;
+	}
+
+	if (!sub_resource_id.is_empty()) {
+		return _load_sub_resource();
+	}
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		Error err = _start_external_load(i);
+		if (err != OK) {
+			return err;
+		}
+	}
+
+	for (int i = 0; i < internal_resources.size(); i++) {
+		Error err = _load_internal_resource(i);
+		if (err != OK) {
+			return err;
+		}
+
 		if (progress) {
 			*progress = (i + 1) / float(internal_resources.size());
 		}
 
-		resource_cache.push_back(res);
-
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
+		if (resource.is_valid()) {
 			return OK;
 		}
 	}
@@ -892,6 +934,32 @@ Error ResourceLoaderBinary::load() {
 	return ERR_FILE_EOF;
 }
 
+Error ResourceLoaderBinary::_load_sub_resource() {
+	// Only the requested sub-resource is decoded. Internal and external resources it
+	// references are loaded on demand from parse_variant(), everything else is skipped.
+	ERR_FAIL_COND_V_MSG(!using_named_scene_ids, ERR_UNAVAILABLE, local_path + ": Loading a single sub-resource requires a file saved with named scene IDs.");
+
+	String sub_path = "local://" + sub_resource_id;
+	for (int i = 0; i < internal_resources.size() - 1; i++) {
+		if (internal_resources[i].path != sub_path) {
+			continue;
+		}
+
+		Error err = _load_internal_resource(i);
+		if (err != OK) {
+			return err;
+		}
+
+		f.unref();
+		resource = internal_index_cache[internal_resources[i].path];
+		error = OK;
+		return OK;
+	}
+
+	error = ERR_DOES_NOT_EXIST;
+	ERR_FAIL_V_MSG(error, local_path + ": Sub-resource not found: " + sub_resource_id + ".");
+}
+
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
 	translation_remapped = p_remapped;
 }
@@ -1208,10 +1276,14 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 		*r_error = ERR_FILE_CANT_OPEN;
 	}
 
+	// A "path::id" path loads only that sub-resource from the file.
+	String file_path = p_path.get_slice("::", 0);
+	String sub_resource_id = p_path.contains("::") ? p_path.get_slice("::", 1) : String();
+
 	Error err;
-	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ, &err);
 
-	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), "Cannot open file '" + p_path + "'.");
+	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), "Cannot open file '" + file_path + "'.");
 
 	ResourceLoaderBinary loader;
 	switch (p_cache_mode) {
@@ -1232,9 +1304,10 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	}
 	loader.use_sub_threads = p_use_sub_threads;
 	loader.progress = r_progress;
-	String path = !p_original_path.is_empty() ? p_original_path : p_path;
+	String path = !p_original_path.is_empty() ? p_original_path.get_slice("::", 0) : file_path;
 	loader.local_path = ProjectSettings::get_singleton()->localize_path(path);
 	loader.res_path = loader.local_path;
+	loader.sub_resource_id = sub_resource_id;
 	loader.open(f);
 
 	err = loader.load();
@@ -1277,6 +1350,11 @@ void ResourceFormatLoaderBinary::get_recognized_extensions(List<String> *p_exten
 	}
 }
 
+bool ResourceFormatLoaderBinary::recognize_path(const String &p_path, const String &p_for_type) const {
+	// Also accept "path::id", which loads a single sub-resource.
+	return ResourceFormatLoader::recognize_path(p_path.get_slice("::", 0), p_for_type);
+}
+
 bool ResourceFormatLoaderBinary::handles_type(const String &p_type) const {
 	return true; //handles all
 }
@@ -61,6 +61,7 @@ class ResourceLoaderBinary {
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		bool load_started = false;
 	};
 
 	bool using_named_scene_ids = false;
@@ -68,6 +69,7 @@ class ResourceLoaderBinary {
 	String script_class;
 	bool use_sub_threads = false;
 	float *progress = nullptr;
+	String sub_resource_id;
 	Vector<ExtResource> external_resources;
 
 	struct IntResource {
@@ -91,6 +93,10 @@ class ResourceLoaderBinary {
 
 	Error parse_variant(Variant &r_v);
 
+	Error _start_external_load(int p_index);
+	Error _load_internal_resource(int p_index);
+	Error _load_sub_resource();
+
 	HashMap<String, Ref<Resource>> dependency_cache;
 
 public:
@@ -113,6 +119,7 @@ public:
 	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override;
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const override;
 	virtual void get_recognized_extensions(List<String> *p_extensions) const override;
+	virtual bool recognize_path(const String &p_path, const String &p_for_type = String()) const override;
 	virtual bool handles_type(const String &p_type) const override;
 	virtual String get_resource_type(const String &p_path) const override;
 	virtual String get_resource_script_class(const String &p_path) const override;
@@ -143,6 +143,7 @@ public:
 	virtual bool can_import_threaded() const { return true; }
 	virtual void import_threaded_begin() {}
 	virtual void import_threaded_end() {}
+	virtual bool can_use_import_cache(const HashMap<StringName, Variant> &p_options) const { return false; }
 
 	virtual Error import_group_file(const String &p_group_file, const HashMap<String, HashMap<StringName, Variant>> &p_source_file_options, const HashMap<String, String> &p_base_paths) { return ERR_UNAVAILABLE; }
 	virtual bool are_import_settings_valid(const String &p_path) const { return true; }
@@ -72,6 +72,7 @@ public:
 
 	int get_available_bytes() const override;
 	Status get_status() const;
+	Ref<NetSocket> get_socket() const { return _sock; }
 
 	void set_no_delay(bool p_enabled);
 
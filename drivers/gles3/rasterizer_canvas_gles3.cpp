@@ -874,6 +874,16 @@ void RasterizerCanvasGLES3::_record_item_commands(const Item *p_item, RID p_rend
 		state.canvas_instance_batches[state.current_batch_index].lights_disabled = lights_disabled;
 	}
 
+	// Items that did not change since the last frame reuse the instance data recorded back then.
+	bool use_cache = _get_item_cache_key(p_item, base_transform, base_color, lights, base_flags, p_offset, state.item_cache_key);
+	if (use_cache && p_item->instance_cache && p_item->instance_cache->matches(p_item->version, state.item_cache_key)) {
+		_replay_item_commands(p_item, base_color, p_blend_mode, r_index, r_batch_broken);
+		return;
+	}
+
+	uint32_t record_from = r_index;
+	uint32_t record_instance_buffer = state.current_instance_buffer_index;
+
 	const Item::Command *c = p_item->commands;
 	while (c) {
 		if (skipping && c->type != Item::Command::TYPE_ANIMATION_SLICE) {
@@ -907,39 +917,12 @@ void RasterizerCanvasGLES3::_record_item_commands(const Item *p_item, RID p_rend
 
 		state.instance_data_array[r_index].flags = base_flags | (state.instance_data_array[r_index == 0 ? 0 : r_index - 1].flags & (FLAGS_DEFAULT_NORMAL_MAP_USED | FLAGS_DEFAULT_SPECULAR_MAP_USED)); // Reset on each command for safety, keep canvastexture binding config.
 
-		Color blend_color = base_color;
-		GLES3::CanvasShaderData::BlendMode blend_mode = p_blend_mode;
-		if (c->type == Item::Command::TYPE_RECT) {
-			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
-			if (rect->flags & CANVAS_RECT_LCD) {
-				blend_mode = GLES3::CanvasShaderData::BLEND_MODE_LCD;
-				blend_color = rect->modulate * base_color;
-			}
-		}
-
-		if (blend_mode != state.canvas_instance_batches[state.current_batch_index].blend_mode || blend_color != state.canvas_instance_batches[state.current_batch_index].blend_color) {
-			_new_batch(r_batch_broken);
-			state.canvas_instance_batches[state.current_batch_index].blend_mode = blend_mode;
-			state.canvas_instance_batches[state.current_batch_index].blend_color = blend_color;
-		}
+		_batch_item_command(c, base_color, p_blend_mode, r_batch_broken);
 
 		switch (c->type) {
 			case Item::Command::TYPE_RECT: {
 				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
 
-				if (rect->flags & CANVAS_RECT_TILE && state.canvas_instance_batches[state.current_batch_index].repeat != RenderingServer::CanvasItemTextureRepeat::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED) {
-					_new_batch(r_batch_broken);
-					state.canvas_instance_batches[state.current_batch_index].repeat = RenderingServer::CanvasItemTextureRepeat::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED;
-				}
-
-				if (rect->texture != state.canvas_instance_batches[state.current_batch_index].tex || state.canvas_instance_batches[state.current_batch_index].command_type != Item::Command::TYPE_RECT) {
-					_new_batch(r_batch_broken);
-					state.canvas_instance_batches[state.current_batch_index].tex = rect->texture;
-					state.canvas_instance_batches[state.current_batch_index].command_type = Item::Command::TYPE_RECT;
-					state.canvas_instance_batches[state.current_batch_index].command = c;
-					state.canvas_instance_batches[state.current_batch_index].shader_variant = CanvasShaderGLES3::MODE_QUAD;
-				}
-
 				_prepare_canvas_texture(rect->texture, state.canvas_instance_batches[state.current_batch_index].filter, state.canvas_instance_batches[state.current_batch_index].repeat, r_index, texpixel_size);
 
 				Rect2 src_rect;
@@ -1022,14 +1005,6 @@ void RasterizerCanvasGLES3::_record_item_commands(const Item *p_item, RID p_rend
 			case Item::Command::TYPE_NINEPATCH: {
 				const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(c);
 
-				if (np->texture != state.canvas_instance_batches[state.current_batch_index].tex || state.canvas_instance_batches[state.current_batch_index].command_type != Item::Command::TYPE_NINEPATCH) {
-					_new_batch(r_batch_broken);
-					state.canvas_instance_batches[state.current_batch_index].tex = np->texture;
-					state.canvas_instance_batches[state.current_batch_index].command_type = Item::Command::TYPE_NINEPATCH;
-					state.canvas_instance_batches[state.current_batch_index].command = c;
-					state.canvas_instance_batches[state.current_batch_index].shader_variant = CanvasShaderGLES3::MODE_NINEPATCH;
-				}
-
 				_prepare_canvas_texture(np->texture, state.canvas_instance_batches[state.current_batch_index].filter, state.canvas_instance_batches[state.current_batch_index].repeat, r_index, texpixel_size);
 
 				Rect2 src_rect;
@@ -1272,6 +1247,132 @@ void RasterizerCanvasGLES3::_record_item_commands(const Item *p_item, RID p_rend
 		//will make it re-enable clipping if needed afterwards
 		current_clip = nullptr;
 	}
+
+	// Only keep the records if they all ended up in the same instance buffer, otherwise part of them was already flushed.
+	if (use_cache && record_instance_buffer == state.current_instance_buffer_index && r_index >= record_from) {
+		if (!p_item->instance_cache) {
+			p_item->instance_cache = memnew(Item::InstanceCache);
+		}
+		p_item->instance_cache->store(p_item->version, state.item_cache_key, state.instance_data_array + record_from, r_index - record_from);
+
+		// The normal and specular map flags are carried over from the previous record, which may belong to
+		// another item. Keep them out of the cache, replaying derives them from the texture state in the key.
+		InstanceData *records = p_item->instance_cache->get_records_w<InstanceData>();
+		for (uint32_t i = 0; i < r_index - record_from; i++) {
+			records[i].flags &= ~(FLAGS_DEFAULT_NORMAL_MAP_USED | FLAGS_DEFAULT_SPECULAR_MAP_USED);
+		}
+	}
+}
+
+void RasterizerCanvasGLES3::_get_item_cache_texture_state(void *p_userdata, RID p_texture, Item::InstanceCache::TextureState &r_state) {
+	Size2 texpixel_size;
+	static_cast<RasterizerCanvasGLES3 *>(p_userdata)->_get_canvas_texture_state(p_texture, texpixel_size, r_state.flags, r_state.specular_shininess);
+	r_state.texpixel_size[0] = texpixel_size.x;
+	r_state.texpixel_size[1] = texpixel_size.y;
+}
+
+bool RasterizerCanvasGLES3::_get_item_cache_key(const Item *p_item, const Transform2D &p_base_transform, const Color &p_base_color, const uint32_t *p_lights, uint32_t p_base_flags, const Point2 &p_offset, LocalVector<uint8_t> &r_key) {
+	ItemCacheKey key;
+	_update_transform_2d_to_mat2x3(p_base_transform, key.world);
+	key.modulation[0] = p_base_color.r;
+	key.modulation[1] = p_base_color.g;
+	key.modulation[2] = p_base_color.b;
+	key.modulation[3] = p_base_color.a;
+	for (int i = 0; i < 4; i++) {
+		key.lights[i] = p_lights[i];
+	}
+	key.flags = p_base_flags;
+
+	return Item::InstanceCache::build_key(p_item, p_offset, &key, sizeof(ItemCacheKey), _get_item_cache_texture_state, this, r_key);
+}
+
+void RasterizerCanvasGLES3::_batch_item_command(const Item::Command *p_command, const Color &p_base_color, GLES3::CanvasShaderData::BlendMode p_blend_mode, bool &r_batch_broken) {
+	// Starts a new batch if the command can't be drawn with the current one.
+	// Shared by recording and replaying, so cached items batch exactly like freshly recorded ones.
+	Color blend_color = p_base_color;
+	GLES3::CanvasShaderData::BlendMode blend_mode = p_blend_mode;
+	if (p_command->type == Item::Command::TYPE_RECT) {
+		const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+		if (rect->flags & CANVAS_RECT_LCD) {
+			blend_mode = GLES3::CanvasShaderData::BLEND_MODE_LCD;
+			blend_color = rect->modulate * p_base_color;
+		}
+	}
+
+	if (blend_mode != state.canvas_instance_batches[state.current_batch_index].blend_mode || blend_color != state.canvas_instance_batches[state.current_batch_index].blend_color) {
+		_new_batch(r_batch_broken);
+		state.canvas_instance_batches[state.current_batch_index].blend_mode = blend_mode;
+		state.canvas_instance_batches[state.current_batch_index].blend_color = blend_color;
+	}
+
+	switch (p_command->type) {
+		case Item::Command::TYPE_RECT: {
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(p_command);
+
+			if (rect->flags & CANVAS_RECT_TILE && state.canvas_instance_batches[state.current_batch_index].repeat != RenderingServer::CanvasItemTextureRepeat::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED) {
+				_new_batch(r_batch_broken);
+				state.canvas_instance_batches[state.current_batch_index].repeat = RenderingServer::CanvasItemTextureRepeat::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED;
+			}
+
+			if (rect->texture != state.canvas_instance_batches[state.current_batch_index].tex || state.canvas_instance_batches[state.current_batch_index].command_type != Item::Command::TYPE_RECT) {
+				_new_batch(r_batch_broken);
+				state.canvas_instance_batches[state.current_batch_index].tex = rect->texture;
+				state.canvas_instance_batches[state.current_batch_index].command_type = Item::Command::TYPE_RECT;
+				state.canvas_instance_batches[state.current_batch_index].command = p_command;
+				state.canvas_instance_batches[state.current_batch_index].shader_variant = CanvasShaderGLES3::MODE_QUAD;
+			}
+		} break;
+
+		case Item::Command::TYPE_NINEPATCH: {
+			const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(p_command);
+
+			if (np->texture != state.canvas_instance_batches[state.current_batch_index].tex || state.canvas_instance_batches[state.current_batch_index].command_type != Item::Command::TYPE_NINEPATCH) {
+				_new_batch(r_batch_broken);
+				state.canvas_instance_batches[state.current_batch_index].tex = np->texture;
+				state.canvas_instance_batches[state.current_batch_index].command_type = Item::Command::TYPE_NINEPATCH;
+				state.canvas_instance_batches[state.current_batch_index].command = p_command;
+				state.canvas_instance_batches[state.current_batch_index].shader_variant = CanvasShaderGLES3::MODE_NINEPATCH;
+			}
+		} break;
+
+		default: {
+			// Other commands set up their batch while recording.
+		} break;
+	}
+}
+
+void RasterizerCanvasGLES3::_replay_item_commands(const Item *p_item, const Color &p_base_color, GLES3::CanvasShaderData::BlendMode p_blend_mode, uint32_t &r_index, bool &r_batch_broken) {
+	// Makes the same batching decisions as _record_item_commands(), but copies the instance data from the cache.
+	const InstanceData *records = p_item->instance_cache->get_records<InstanceData>();
+	uint32_t record_count = p_item->instance_cache->get_record_count<InstanceData>();
+	uint32_t record = 0;
+
+	// Texture changes are walked like Item::InstanceCache::build_key() does, to find the texture state of each record.
+	Item::InstanceCache::TextureState texture_state;
+	uint32_t texture_change = 0;
+	RID last_texture;
+	bool first = true;
+
+	for (const Item::Command *c = p_item->commands; c; c = c->next) {
+		_batch_item_command(c, p_base_color, p_blend_mode, r_batch_broken);
+
+		if (c->type == Item::Command::TYPE_RECT || c->type == Item::Command::TYPE_NINEPATCH) {
+			ERR_FAIL_COND(record >= record_count);
+
+			RID texture = c->type == Item::Command::TYPE_RECT ? static_cast<const Item::CommandRect *>(c)->texture : static_cast<const Item::CommandNinePatch *>(c)->texture;
+			if (first || texture != last_texture) {
+				texture_state = p_item->instance_cache->get_texture_state(sizeof(ItemCacheKey), texture_change++);
+				first = false;
+				last_texture = texture;
+			}
+
+			state.instance_data_array[r_index] = records[record++];
+			state.instance_data_array[r_index].flags |= texture_state.flags & (FLAGS_DEFAULT_NORMAL_MAP_USED | FLAGS_DEFAULT_SPECULAR_MAP_USED);
+			_add_to_batch(r_index, r_batch_broken);
+		}
+
+		r_batch_broken = false;
+	}
 }
 
 _FORCE_INLINE_ static uint32_t _indices_to_primitives(RS::PrimitiveType p_primitive, uint32_t p_indices) {
@@ -2299,7 +2400,7 @@ void RasterizerCanvasGLES3::_bind_canvas_texture(RID p_texture, RS::CanvasItemTe
 	}
 }
 
-void RasterizerCanvasGLES3::_prepare_canvas_texture(RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat, uint32_t &r_index, Size2 &r_texpixel_size) {
+void RasterizerCanvasGLES3::_get_canvas_texture_state(RID p_texture, Size2 &r_texpixel_size, uint32_t &r_flags, uint32_t &r_specular_shininess) {
 	GLES3::TextureStorage *texture_storage = GLES3::TextureStorage::get_singleton();
 
 	if (p_texture == RID()) {
@@ -2324,7 +2425,7 @@ void RasterizerCanvasGLES3::_prepare_canvas_texture(RID p_texture, RS::CanvasIte
 
 	if (!ct) {
 		// Invalid Texture RID.
-		_prepare_canvas_texture(default_canvas_texture, p_base_filter, p_base_repeat, r_index, r_texpixel_size);
+		_get_canvas_texture_state(default_canvas_texture, r_texpixel_size, r_flags, r_specular_shininess);
 		return;
 	}
 
@@ -2344,25 +2445,31 @@ void RasterizerCanvasGLES3::_prepare_canvas_texture(RID p_texture, RS::CanvasIte
 
 	GLES3::Texture *normal_map = texture_storage->get_texture(ct->normal_map);
 
+	r_flags = 0;
 	if (ct->specular_color.a < 0.999) {
-		state.instance_data_array[r_index].flags |= FLAGS_DEFAULT_SPECULAR_MAP_USED;
-	} else {
-		state.instance_data_array[r_index].flags &= ~FLAGS_DEFAULT_SPECULAR_MAP_USED;
+		r_flags |= FLAGS_DEFAULT_SPECULAR_MAP_USED;
 	}
-
 	if (normal_map) {
-		state.instance_data_array[r_index].flags |= FLAGS_DEFAULT_NORMAL_MAP_USED;
-	} else {
-		state.instance_data_array[r_index].flags &= ~FLAGS_DEFAULT_NORMAL_MAP_USED;
+		r_flags |= FLAGS_DEFAULT_NORMAL_MAP_USED;
 	}
 
-	state.instance_data_array[r_index].specular_shininess = uint32_t(CLAMP(ct->specular_color.a * 255.0, 0, 255)) << 24;
-	state.instance_data_array[r_index].specular_shininess |= uint32_t(CLAMP(ct->specular_color.b * 255.0, 0, 255)) << 16;
-	state.instance_data_array[r_index].specular_shininess |= uint32_t(CLAMP(ct->specular_color.g * 255.0, 0, 255)) << 8;
-	state.instance_data_array[r_index].specular_shininess |= uint32_t(CLAMP(ct->specular_color.r * 255.0, 0, 255));
+	r_specular_shininess = uint32_t(CLAMP(ct->specular_color.a * 255.0, 0, 255)) << 24;
+	r_specular_shininess |= uint32_t(CLAMP(ct->specular_color.b * 255.0, 0, 255)) << 16;
+	r_specular_shininess |= uint32_t(CLAMP(ct->specular_color.g * 255.0, 0, 255)) << 8;
+	r_specular_shininess |= uint32_t(CLAMP(ct->specular_color.r * 255.0, 0, 255));
 
 	r_texpixel_size.x = 1.0 / float(size_cache.x);
 	r_texpixel_size.y = 1.0 / float(size_cache.y);
+}
+
+void RasterizerCanvasGLES3::_prepare_canvas_texture(RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat, uint32_t &r_index, Size2 &r_texpixel_size) {
+	uint32_t flags = 0;
+	uint32_t specular_shininess = 0;
+	_get_canvas_texture_state(p_texture, r_texpixel_size, flags, specular_shininess);
+
+	state.instance_data_array[r_index].flags &= ~(FLAGS_DEFAULT_SPECULAR_MAP_USED | FLAGS_DEFAULT_NORMAL_MAP_USED);
+	state.instance_data_array[r_index].flags |= flags;
+	state.instance_data_array[r_index].specular_shininess = specular_shininess;
 
 	state.instance_data_array[r_index].color_texture_pixel_size[0] = r_texpixel_size.x;
 	state.instance_data_array[r_index].color_texture_pixel_size[1] = r_texpixel_size.y;
@@ -235,6 +235,14 @@ public:
 
 	static_assert(sizeof(InstanceData) == 128, "2D instance data struct size must be 128 bytes");
 
+	// State the instance data of an item depends on besides its commands and textures, see Item::InstanceCache.
+	struct ItemCacheKey {
+		float world[6];
+		float modulation[4];
+		uint32_t lights[4];
+		uint32_t flags;
+	};
+
 	struct Data {
 		GLuint canvas_quad_vertices;
 		GLuint canvas_quad_array;
@@ -323,6 +331,8 @@ public:
 
 		RS::CanvasItemTextureFilter default_filter = RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT;
 		RS::CanvasItemTextureRepeat default_repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT;
+
+		LocalVector<uint8_t> item_cache_key;
 	} state;
 
 	Item *items[MAX_RENDER_ITEMS];
@@ -358,11 +368,16 @@ public:
 	void update() override;
 
 	void _bind_canvas_texture(RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat);
+	void _get_canvas_texture_state(RID p_texture, Size2 &r_texpixel_size, uint32_t &r_flags, uint32_t &r_specular_shininess);
 	void _prepare_canvas_texture(RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat, uint32_t &r_index, Size2 &r_texpixel_size);
 
 	void canvas_render_items(RID p_to_render_target, Item *p_item_list, const Color &p_modulate, Light *p_light_list, Light *p_directional_list, const Transform2D &p_canvas_transform, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, bool &r_sdf_used, RenderingMethod::RenderInfo *r_render_info = nullptr) override;
 	void _render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool &r_sdf_used, bool p_to_backbuffer = false, RenderingMethod::RenderInfo *r_render_info = nullptr);
 	void _record_item_commands(const Item *p_item, RID p_render_target, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, GLES3::CanvasShaderData::BlendMode p_blend_mode, Light *p_lights, uint32_t &r_index, bool &r_break_batch, bool &r_sdf_used, const Point2 &p_offset);
+	static void _get_item_cache_texture_state(void *p_userdata, RID p_texture, Item::InstanceCache::TextureState &r_state);
+	bool _get_item_cache_key(const Item *p_item, const Transform2D &p_base_transform, const Color &p_base_color, const uint32_t *p_lights, uint32_t p_base_flags, const Point2 &p_offset, LocalVector<uint8_t> &r_key);
+	void _batch_item_command(const Item::Command *p_command, const Color &p_base_color, GLES3::CanvasShaderData::BlendMode p_blend_mode, bool &r_batch_broken);
+	void _replay_item_commands(const Item *p_item, const Color &p_base_color, GLES3::CanvasShaderData::BlendMode p_blend_mode, uint32_t &r_index, bool &r_batch_broken);
 	void _render_batch(Light *p_lights, uint32_t p_index, RenderingMethod::RenderInfo *r_render_info = nullptr);
 	bool _bind_material(GLES3::CanvasMaterialData *p_material_data, CanvasShaderGLES3::ShaderVariant p_variant, uint64_t p_specialization);
 	void _new_batch(bool &r_batch_broken);
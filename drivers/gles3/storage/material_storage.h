@@ -620,6 +620,7 @@ public:
 	virtual bool material_casts_shadows(RID p_material) override;
 
 	virtual void material_get_instance_shader_parameters(RID p_material, List<InstanceShaderParam> *r_parameters) override;
+	virtual void material_get_textures(RID p_material, LocalVector<RID> *r_textures) override;
 
 	virtual void material_update_dependency(RID p_material, DependencyTracker *p_instance) override;
 
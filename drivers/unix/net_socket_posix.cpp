@@ -70,6 +70,12 @@
 #define SOCK_CLOSE ::close
 #define SOCK_CONNECT(p_sock, p_addr, p_addr_len) ::connect(p_sock, p_addr, p_addr_len)
 
+// Linux and Android can move several datagrams per system call.
+#if defined(MSG_WAITFORONE) && !defined(WEB_ENABLED)
+#define SOCK_MMSG_ENABLED
+#define SOCK_MMSG_MAX 64
+#endif
+
 /* Windows */
 #elif defined(WINDOWS_ENABLED)
 #include <winsock2.h>
@@ -160,6 +166,9 @@ void NetSocketPosix::make_default() {
 	}
 #endif
 	_create = _create_func;
+#ifdef NET_SOCKET_EPOLL_ENABLED
+	NetSocketPollerEpoll::make_default();
+#endif
 }
 
 void NetSocketPosix::cleanup() {
@@ -652,6 +661,108 @@ Error NetSocketPosix::sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP
 	return OK;
 }
 
+Error NetSocketPosix::recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received) {
+#ifdef SOCK_MMSG_ENABLED
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+	r_received = 0;
+	p_count = MIN(p_count, SOCK_MMSG_MAX);
+	if (p_count <= 0) {
+		return OK;
+	}
+
+	struct mmsghdr msgs[SOCK_MMSG_MAX];
+	struct iovec iovs[SOCK_MMSG_MAX];
+	struct sockaddr_storage from[SOCK_MMSG_MAX];
+	memset(msgs, 0, sizeof(struct mmsghdr) * p_count);
+	for (int i = 0; i < p_count; i++) {
+		iovs[i].iov_base = p_datagrams[i].buffer;
+		iovs[i].iov_len = p_datagrams[i].size;
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &from[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+	}
+
+	// MSG_WAITFORONE keeps blocking sockets from waiting for the whole batch.
+	int ret = ::recvmmsg(_sock, msgs, p_count, MSG_WAITFORONE, nullptr);
+
+	if (ret < 0) {
+		NetError err = _get_socket_error();
+		if (err == ERR_NET_WOULD_BLOCK) {
+			return ERR_BUSY;
+		}
+		if (err == ERR_NET_BUFFER_TOO_SMALL) {
+			return ERR_OUT_OF_MEMORY;
+		}
+
+		return FAILED;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		p_datagrams[i].transferred = msgs[i].msg_len;
+		_set_ip_port(&from[i], &p_datagrams[i].ip, &p_datagrams[i].port);
+	}
+	r_received = ret;
+
+	return OK;
+#else
+	return NetSocket::recvfrom_batch(p_datagrams, p_count, r_received);
+#endif
+}
+
+Error NetSocketPosix::sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent) {
+#ifdef SOCK_MMSG_ENABLED
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+	r_sent = 0;
+	while (r_sent < p_count) {
+		const int count = MIN(p_count - r_sent, SOCK_MMSG_MAX);
+		const Datagram *datagrams = p_datagrams + r_sent;
+
+		struct mmsghdr msgs[SOCK_MMSG_MAX];
+		struct iovec iovs[SOCK_MMSG_MAX];
+		struct sockaddr_storage to[SOCK_MMSG_MAX];
+		memset(msgs, 0, sizeof(struct mmsghdr) * count);
+		for (int i = 0; i < count; i++) {
+			iovs[i].iov_base = datagrams[i].buffer;
+			iovs[i].iov_len = datagrams[i].size;
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+			msgs[i].msg_hdr.msg_name = &to[i];
+			msgs[i].msg_hdr.msg_namelen = _set_addr_storage(&to[i], datagrams[i].ip, datagrams[i].port, _ip_type);
+		}
+
+		int ret = ::sendmmsg(_sock, msgs, count, 0);
+
+		if (ret < 0) {
+			if (r_sent > 0) {
+				return OK;
+			}
+			NetError err = _get_socket_error();
+			if (err == ERR_NET_WOULD_BLOCK) {
+				return ERR_BUSY;
+			}
+			if (err == ERR_NET_BUFFER_TOO_SMALL) {
+				return ERR_OUT_OF_MEMORY;
+			}
+
+			return FAILED;
+		}
+
+		r_sent += ret;
+		if (ret < count) {
+			// The send buffer is full, let the caller retry the rest later.
+			break;
+		}
+	}
+
+	return OK;
+#else
+	return NetSocket::sendto_batch(p_datagrams, p_count, r_sent);
+#endif
+}
+
 Error NetSocketPosix::set_broadcasting_enabled(bool p_enabled) {
 	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
 	// IPv6 has no broadcast support.
@@ -795,4 +906,115 @@ Error NetSocketPosix::leave_multicast_group(const IPAddress &p_multi_address, co
 	return _change_multicast_group(p_multi_address, p_if_name, false);
 }
 
+#ifdef NET_SOCKET_EPOLL_ENABLED
+uint32_t NetSocketPollerEpoll::_get_epoll_events(NetSocket::PollType p_type) {
+	switch (p_type) {
+		case NetSocket::POLL_TYPE_IN:
+			return EPOLLIN;
+		case NetSocket::POLL_TYPE_OUT:
+			return EPOLLOUT;
+		case NetSocket::POLL_TYPE_IN_OUT:
+			return EPOLLIN | EPOLLOUT;
+	}
+	return EPOLLIN;
+}
+
+NetSocketPoller *NetSocketPollerEpoll::_create_func() {
+	return memnew(NetSocketPollerEpoll);
+}
+
+void NetSocketPollerEpoll::make_default() {
+	_create = _create_func;
+}
+
+Error NetSocketPollerEpoll::add(const Ref<NetSocket> &p_socket, uint64_t p_id, NetSocket::PollType p_type) {
+	ERR_FAIL_COND_V(epoll_fd < 0, ERR_UNCONFIGURED);
+	Error err = NetSocketPoller::add(p_socket, p_id, p_type);
+	if (err != OK) {
+		return err;
+	}
+	// All sockets are created by NetSocketPosix::_create_func() (or a subclass of it) on this platform.
+	const NetSocketPosix *sock = static_cast<const NetSocketPosix *>(p_socket.ptr());
+	struct epoll_event ev = {};
+	ev.events = _get_epoll_events(p_type);
+	ev.data.u64 = p_id;
+	if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sock->_sock, &ev) != 0) {
+		NetSocketPoller::remove(p_id);
+		ERR_FAIL_V_MSG(FAILED, "Unable to add socket to epoll set.");
+	}
+	return OK;
+}
+
+Error NetSocketPollerEpoll::modify(uint64_t p_id, NetSocket::PollType p_type) {
+	Entry *entry = sockets.getptr(p_id);
+	ERR_FAIL_NULL_V(entry, ERR_DOES_NOT_EXIST);
+	if (entry->type == p_type) {
+		return OK;
+	}
+	const NetSocketPosix *sock = static_cast<const NetSocketPosix *>(entry->socket.ptr());
+	struct epoll_event ev = {};
+	ev.events = _get_epoll_events(p_type);
+	ev.data.u64 = p_id;
+	if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, sock->_sock, &ev) != 0) {
+		return FAILED; // Most likely closed, and thus already dropped by the kernel.
+	}
+	entry->type = p_type;
+	return OK;
+}
+
+void NetSocketPollerEpoll::remove(uint64_t p_id) {
+	Entry *entry = sockets.getptr(p_id);
+	if (!entry) {
+		return;
+	}
+	const NetSocketPosix *sock = static_cast<const NetSocketPosix *>(entry->socket.ptr());
+	if (sock->_sock != SOCK_EMPTY) {
+		// Closed sockets are removed from the set by the kernel.
+		epoll_ctl(epoll_fd, EPOLL_CTL_DEL, sock->_sock, nullptr);
+	}
+	sockets.erase(p_id);
+}
+
+void NetSocketPollerEpoll::clear() {
+	while (sockets.size()) {
+		remove(sockets.begin()->key);
+	}
+}
+
+Error NetSocketPollerEpoll::wait(LocalVector<Event> &r_events, int p_timeout) {
+	ERR_FAIL_COND_V(epoll_fd < 0, ERR_UNCONFIGURED);
+	r_events.clear();
+	if (sockets.is_empty()) {
+		return OK;
+	}
+	events.resize(MIN(sockets.size(), 1024u));
+	int ret = epoll_wait(epoll_fd, events.ptr(), events.size(), p_timeout);
+	if (ret < 0) {
+		return errno == EINTR ? OK : FAILED;
+	}
+	r_events.resize(ret);
+	for (int i = 0; i < ret; i++) {
+		const struct epoll_event &ev = events[i];
+		Event &out = r_events[i];
+		out.id = ev.data.u64;
+		out.readable = ev.events & EPOLLIN;
+		out.writable = ev.events & EPOLLOUT;
+		out.error = ev.events & (EPOLLERR | EPOLLHUP);
+	}
+	return OK;
+}
+
+NetSocketPollerEpoll::NetSocketPollerEpoll() {
+	epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	ERR_FAIL_COND_MSG(epoll_fd < 0, "Unable to create epoll instance.");
+}
+
+NetSocketPollerEpoll::~NetSocketPollerEpoll() {
+	clear();
+	if (epoll_fd >= 0) {
+		::close(epoll_fd);
+	}
+}
+#endif // NET_SOCKET_EPOLL_ENABLED
+
 #endif // UNIX_SOCKET_UNAVAILABLE
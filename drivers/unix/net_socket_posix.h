@@ -44,7 +44,16 @@
 
 #endif
 
+#if defined(__linux__) && !defined(WEB_ENABLED)
+#include <sys/epoll.h>
+#define NET_SOCKET_EPOLL_ENABLED
+#endif
+
 class NetSocketPosix : public NetSocket {
+#ifdef NET_SOCKET_EPOLL_ENABLED
+	friend class NetSocketPollerEpoll;
+#endif
+
 private:
 	SOCKET_TYPE _sock; // NOLINT - the default value is defined in the .cpp
 	IP::Type _ip_type = IP::TYPE_NONE;
@@ -87,6 +96,8 @@ public:
 	virtual Error send(const uint8_t *p_buffer, int p_len, int &r_sent);
 	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IPAddress p_ip, uint16_t p_port);
 	virtual Ref<NetSocket> accept(IPAddress &r_ip, uint16_t &r_port);
+	virtual Error recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received);
+	virtual Error sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent);
 
 	virtual bool is_open() const;
 	virtual int get_available_bytes() const;
@@ -105,4 +116,28 @@ public:
 	~NetSocketPosix();
 };
 
+#ifdef NET_SOCKET_EPOLL_ENABLED
+class NetSocketPollerEpoll : public NetSocketPoller {
+	int epoll_fd = -1;
+	LocalVector<struct epoll_event> events;
+
+	static uint32_t _get_epoll_events(NetSocket::PollType p_type);
+
+protected:
+	static NetSocketPoller *_create_func();
+
+public:
+	static void make_default();
+
+	virtual Error add(const Ref<NetSocket> &p_socket, uint64_t p_id, NetSocket::PollType p_type = NetSocket::POLL_TYPE_IN) override;
+	virtual Error modify(uint64_t p_id, NetSocket::PollType p_type) override;
+	virtual void remove(uint64_t p_id) override;
+	virtual void clear() override;
+	virtual Error wait(LocalVector<Event> &r_events, int p_timeout = 0) override;
+
+	NetSocketPollerEpoll();
+	~NetSocketPollerEpoll();
+};
+#endif // NET_SOCKET_EPOLL_ENABLED
+
 #endif // NET_SOCKET_POSIX_H
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/extension/gdextension_manager.h"
+#include "core/io/config_file.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_importer.h"
 #include "core/io/resource_loader.h"
@@ -39,6 +40,7 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/variant/variant_parser.h"
+#include "core/version.h"
 #include "editor/editor_help.h"
 #include "editor/editor_node.h"
 #include "editor/editor_paths.h"
@@ -2464,7 +2466,26 @@ Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<Strin
 	List<String> import_variants;
 	List<String> gen_files;
 	Variant meta;
-	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+	Error err = OK;
+
+	String cache_key;
+	if (!import_cache_path.is_empty() && importer->can_use_import_cache(params)) {
+		cache_key = get_import_cache_key(p_file, importer, opts, params);
+	}
+
+	if (!cache_key.is_empty() && _import_cache_fetch(cache_key, base_path, importer, &import_variants, &meta)) {
+		import_cache_hits.increment();
+		print_verbose(vformat("EditorFileSystem: \"%s\" fetched from import cache.", p_file));
+	} else {
+		err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+		if (!cache_key.is_empty()) {
+			import_cache_misses.increment();
+			// Generated files live outside of the imported folder and can't be restored from the cache.
+			if (err == OK && gen_files.is_empty()) {
+				_import_cache_store(cache_key, base_path, importer, import_variants, meta);
+			}
+		}
+	}
 
 	// As import is complete, save the .import file.
 
@@ -2608,6 +2629,145 @@ Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<Strin
 	return OK;
 }
 
+String EditorFileSystem::get_import_cache_key(const String &p_file, const Ref<ResourceImporter> &p_importer, const List<ResourceImporter::ImportOption> &p_options, const HashMap<StringName, Variant> &p_params) {
+	String source_hash = FileAccess::get_sha256(p_file);
+	if (source_hash.is_empty()) {
+		return String();
+	}
+
+	// The source path is left out on purpose, so renamed or moved files still hit the cache.
+	String key = source_hash;
+	key += "\n" + p_importer->get_importer_name() + ":" + itos(p_importer->get_format_version());
+	key += "\n" + p_importer->get_import_settings_string();
+	key += "\n" + String(VERSION_FULL_BUILD);
+
+	// Project settings used when encoding lossless images.
+	static const char *project_settings[] = {
+		"rendering/textures/lossless_compression/force_png",
+		"rendering/textures/webp_compression/compression_method",
+		"rendering/textures/webp_compression/lossless_compression_factor",
+		nullptr,
+	};
+	for (int i = 0; project_settings[i]; i++) {
+		String value_text;
+		VariantWriter::write_to_string(ProjectSettings::get_singleton()->get_setting(project_settings[i]), value_text);
+		key += "\n" + String(project_settings[i]) + "=" + value_text;
+	}
+
+	for (const ResourceImporter::ImportOption &E : p_options) {
+		if (!p_params.has(E.option.name)) {
+			continue;
+		}
+		const Variant &value = p_params[E.option.name];
+		String value_text;
+		VariantWriter::write_to_string(value, value_text);
+		key += "\n" + E.option.name + "=" + value_text;
+
+		// Options can point to other files (e.g. the normal map used to generate roughness), so their contents are part of the key too.
+		if (value.get_type() == Variant::STRING) {
+			String path = value;
+			if (path.begins_with("res://") && FileAccess::exists(path)) {
+				key += ":" + FileAccess::get_sha256(path);
+			}
+		}
+	}
+
+	return key.sha256_text();
+}
+
+Vector<String> EditorFileSystem::_get_import_cache_suffixes(const Ref<ResourceImporter> &p_importer, const List<String> &p_variants) const {
+	// Must match the destination paths written to the .import file.
+	Vector<String> suffixes;
+	if (p_importer->get_save_extension().is_empty()) {
+		return suffixes;
+	}
+
+	if (p_variants.size()) {
+		for (const String &E : p_variants) {
+			suffixes.push_back("." + E + "." + p_importer->get_save_extension());
+		}
+	} else {
+		suffixes.push_back("." + p_importer->get_save_extension());
+	}
+	return suffixes;
+}
+
+bool EditorFileSystem::_import_cache_fetch(const String &p_key, const String &p_base_path, const Ref<ResourceImporter> &p_importer, List<String> *r_variants, Variant *r_meta) const {
+	String entry_path = import_cache_path.path_join(p_key.substr(0, 2)).path_join(p_key);
+
+	Ref<ConfigFile> cf;
+	cf.instantiate();
+	if (cf->load(entry_path.path_join("import_cache.cfg")) != OK) {
+		return false;
+	}
+
+	List<String> variants;
+	Vector<String> variant_list = cf->get_value("cache", "variants", Vector<String>());
+	for (const String &E : variant_list) {
+		variants.push_back(E);
+	}
+
+	Vector<String> suffixes = _get_import_cache_suffixes(p_importer, variants);
+	for (const String &E : suffixes) {
+		if (DirAccess::copy_absolute(entry_path.path_join("data" + E), p_base_path + E) != OK) {
+			return false;
+		}
+	}
+
+	*r_variants = variants;
+	*r_meta = cf->get_value("cache", "metadata", Variant());
+	return true;
+}
+
+void EditorFileSystem::_import_cache_store(const String &p_key, const String &p_base_path, const Ref<ResourceImporter> &p_importer, const List<String> &p_variants, const Variant &p_meta) const {
+	String bucket_path = import_cache_path.path_join(p_key.substr(0, 2));
+	String entry_path = bucket_path.path_join(p_key);
+	if (DirAccess::dir_exists_absolute(entry_path)) {
+		return;
+	}
+
+	// Write to a temporary folder first and move it in place once complete, so other editors sharing the cache never see partial entries.
+	String temp_path = bucket_path.path_join(p_key + ".tmp" + itos(OS::get_singleton()->get_process_id()) + "_" + itos(Thread::get_caller_id()));
+	Error err = DirAccess::make_dir_recursive_absolute(temp_path);
+	ERR_FAIL_COND_MSG(err != OK, "Cannot create import cache folder '" + temp_path + "'.");
+
+	Vector<String> suffixes = _get_import_cache_suffixes(p_importer, p_variants);
+	for (const String &E : suffixes) {
+		err = DirAccess::copy_absolute(p_base_path + E, temp_path.path_join("data" + E));
+		if (err != OK) {
+			break;
+		}
+	}
+
+	if (err == OK) {
+		Vector<String> variant_list;
+		for (const String &E : p_variants) {
+			variant_list.push_back(E);
+		}
+
+		Ref<ConfigFile> cf;
+		cf.instantiate();
+		cf->set_value("cache", "variants", variant_list);
+		if (p_meta != Variant()) {
+			cf->set_value("cache", "metadata", p_meta);
+		}
+		err = cf->save(temp_path.path_join("import_cache.cfg"));
+	}
+
+	if (err == OK) {
+		err = DirAccess::rename_absolute(temp_path, entry_path);
+	}
+
+	if (err != OK) {
+		// Either the copy failed or another editor stored the same entry first.
+		Ref<DirAccess> da = DirAccess::open(temp_path);
+		if (da.is_valid()) {
+			da->erase_contents_recursive();
+		}
+		DirAccess::remove_absolute(temp_path);
+	}
+}
+
 void EditorFileSystem::_find_group_files(EditorFileSystemDirectory *efd, HashMap<String, Vector<String>> &group_files, HashSet<String> &groups_to_reimport) {
 	int fc = efd->files.size();
 	const EditorFileSystemDirectory::FileInfo *const *files = efd->files.ptr();
@@ -2696,6 +2856,14 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	reimport_files.sort();
 
+	import_cache_path = EDITOR_GET("filesystem/import/shared_cache_path");
+	if (!import_cache_path.is_empty() && !DirAccess::dir_exists_absolute(import_cache_path)) {
+		WARN_PRINT(vformat("Import cache folder \"%s\" doesn't exist, the import cache will not be used.", import_cache_path));
+		import_cache_path = String();
+	}
+	import_cache_hits.set(0);
+	import_cache_misses.set(0);
+
 	// Emit the resource_reimporting signal for the single file before the actual importation.
 	emit_signal(SNAME("resources_reimporting"), reloads);
 
@@ -2779,6 +2947,10 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 		}
 	}
 
+	if (import_cache_hits.get() + import_cache_misses.get() > 0) {
+		print_verbose(vformat("Import cache: %d hit(s), %d miss(es).", import_cache_hits.get(), import_cache_misses.get()));
+	}
+
 	ResourceUID::get_singleton()->update_cache(); // After reimporting, update the cache.
 
 	_save_filesystem_cache();
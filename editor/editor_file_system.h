@@ -32,6 +32,7 @@
 #define EDITOR_FILE_SYSTEM_H
 
 #include "core/io/dir_access.h"
+#include "core/io/resource_importer.h"
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/hash_set.h"
@@ -259,6 +260,14 @@ class EditorFileSystem : public Node {
 
 	bool reimport_on_missing_imported_files;
 
+	String import_cache_path;
+	SafeNumeric<uint32_t> import_cache_hits;
+	SafeNumeric<uint32_t> import_cache_misses;
+
+	Vector<String> _get_import_cache_suffixes(const Ref<ResourceImporter> &p_importer, const List<String> &p_variants) const;
+	bool _import_cache_fetch(const String &p_key, const String &p_base_path, const Ref<ResourceImporter> &p_importer, List<String> *r_variants, Variant *r_meta) const;
+	void _import_cache_store(const String &p_key, const String &p_base_path, const Ref<ResourceImporter> &p_importer, const List<String> &p_variants, const Variant &p_meta) const;
+
 	Vector<String> _get_dependencies(const String &p_path);
 
 	struct ImportFile {
@@ -361,6 +370,8 @@ public:
 
 	static bool _should_skip_directory(const String &p_path);
 
+	static String get_import_cache_key(const String &p_file, const Ref<ResourceImporter> &p_importer, const List<ResourceImporter::ImportOption> &p_options, const HashMap<StringName, Variant> &p_params);
+
 	void add_import_format_support_query(Ref<EditorFileSystemImportFormatSupportQuery> p_query);
 	void remove_import_format_support_query(Ref<EditorFileSystemImportFormatSupportQuery> p_query);
 	EditorFileSystem();
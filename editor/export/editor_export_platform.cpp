@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/crypto/crypto_core.h"
 #include "core/extension/gdextension.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/io/zip_io.h"
@@ -61,6 +62,13 @@ static int _get_pad(int p_alignment, int p_n) {
 
 #define PCK_PADDING 16
 
+// Files up to this size are compressed with a dictionary shared by the whole pack, when enabled.
+#define PCK_DICTIONARY_MAX_FILE_SIZE (64 * 1024)
+#define PCK_DICTIONARY_SIZE (112 * 1024)
+// Amount of data the dictionary is built from, more doesn't improve it much.
+// Small files are held in memory until this much is collected, later ones are compressed as they are saved.
+#define PCK_DICTIONARY_SAMPLES_SIZE (8 * 1024 * 1024)
+
 bool EditorExportPlatform::fill_log_messages(RichTextLabel *p_log, Error p_err) {
 	bool has_messages = false;
 
@@ -244,29 +252,39 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 		}
 	}
 
-	Ref<FileAccessEncrypted> fae;
-	Ref<FileAccess> ftmp = pd->f;
+	bool use_dictionary = pd->use_dictionary && !sd.encrypted && p_data.size() > 0 && p_data.size() <= PCK_DICTIONARY_MAX_FILE_SIZE;
+	if (use_dictionary && pd->dictionary_built) {
+		_store_pack_file_with_dictionary(pd, sd, p_data);
+	} else if (use_dictionary) {
+		// Held back until there is enough data to build the dictionary from, see _compress_pack_files().
+		pd->pending_files.push_back(pd->file_ofs.size());
+		pd->pending_data.push_back(p_data);
+		pd->pending_size += p_data.size();
+	} else {
+		Ref<FileAccessEncrypted> fae;
+		Ref<FileAccess> ftmp = pd->f;
 
-	if (sd.encrypted) {
-		fae.instantiate();
-		ERR_FAIL_COND_V(fae.is_null(), ERR_SKIP);
+		if (sd.encrypted) {
+			fae.instantiate();
+			ERR_FAIL_COND_V(fae.is_null(), ERR_SKIP);
 
-		Error err = fae->open_and_parse(ftmp, p_key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-		ERR_FAIL_COND_V(err != OK, ERR_SKIP);
-		ftmp = fae;
-	}
+			Error err = fae->open_and_parse(ftmp, p_key, FileAccessEncrypted::MODE_WRITE_AES256, false);
+			ERR_FAIL_COND_V(err != OK, ERR_SKIP);
+			ftmp = fae;
+		}
 
-	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
+		// Store file content.
+		ftmp->store_buffer(p_data.ptr(), p_data.size());
 
-	if (fae.is_valid()) {
-		ftmp.unref();
-		fae.unref();
-	}
+		if (fae.is_valid()) {
+			ftmp.unref();
+			fae.unref();
+		}
 
-	int pad = _get_pad(PCK_PADDING, pd->f->get_position());
-	for (int i = 0; i < pad; i++) {
-		pd->f->store_8(0);
+		int pad = _get_pad(PCK_PADDING, pd->f->get_position());
+		for (int i = 0; i < pad; i++) {
+			pd->f->store_8(0);
+		}
 	}
 
 	// Store MD5 of original file.
@@ -281,6 +299,11 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 
 	pd->file_ofs.push_back(sd);
 
+	if (!pd->dictionary_built && pd->pending_size >= PCK_DICTIONARY_SAMPLES_SIZE) {
+		Error err = _compress_pack_files(pd);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+
 	// TRANSLATORS: This is an editor progress label describing the storing of a file.
 	if (pd->ep->step(vformat(TTR("Storing File: %s"), p_path), 2 + p_file * 100 / p_total, false)) {
 		return ERR_SKIP;
@@ -289,6 +312,68 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 	return OK;
 }
 
+void EditorExportPlatform::_store_pack_file_with_dictionary(PackData *p_pack_data, SavedData &r_sd, const Vector<uint8_t> &p_data) {
+	Ref<FileAccess> f = p_pack_data->f;
+	r_sd.ofs = f->get_position();
+
+	// Only keep the compressed version if it's smaller, including the stream header (magic, mode, block size, length, block table and trailing magic).
+	bool compress = false;
+	if (p_pack_data->dictionary) {
+		Vector<uint8_t> compressed;
+		compressed.resize(Compression::get_max_compressed_buffer_size(p_data.size(), Compression::MODE_ZSTD));
+		int compressed_size = p_pack_data->dictionary->compress(compressed.ptrw(), p_data.ptr(), p_data.size());
+		compress = compressed_size >= 0 && compressed_size + 24 < p_data.size();
+	}
+
+	if (compress) {
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure(PACK_COMPRESSED_FILE_MAGIC, Compression::MODE_ZSTD, PCK_DICTIONARY_MAX_FILE_SIZE);
+		fac->set_dictionary(p_pack_data->dictionary);
+		fac->open_for_write(f);
+		fac->store_buffer(p_data.ptr(), p_data.size());
+		fac->close();
+		r_sd.compressed = true;
+	} else {
+		f->store_buffer(p_data.ptr(), p_data.size());
+	}
+
+	int pad = _get_pad(PCK_PADDING, f->get_position());
+	for (int i = 0; i < pad; i++) {
+		f->store_8(0);
+	}
+}
+
+Error EditorExportPlatform::_compress_pack_files(PackData *p_pack_data) {
+	ERR_FAIL_COND_V(p_pack_data->dictionary_built, ERR_ALREADY_EXISTS);
+
+	Vector<uint8_t> dictionary_data = ZstdDictionary::build(p_pack_data->pending_data, PCK_DICTIONARY_SIZE);
+	p_pack_data->dictionary_built = true;
+
+	Ref<FileAccess> f = p_pack_data->f;
+	if (!dictionary_data.is_empty()) {
+		p_pack_data->dictionary = memnew(ZstdDictionary(dictionary_data, true));
+
+		p_pack_data->dictionary_ofs = f->get_position();
+		p_pack_data->dictionary_size = dictionary_data.size();
+		f->store_buffer(dictionary_data.ptr(), dictionary_data.size());
+		int pad = _get_pad(PCK_PADDING, f->get_position());
+		for (int i = 0; i < pad; i++) {
+			f->store_8(0);
+		}
+	}
+
+	for (int i = 0; i < p_pack_data->pending_files.size(); i++) {
+		_store_pack_file_with_dictionary(p_pack_data, p_pack_data->file_ofs.write[p_pack_data->pending_files[i]], p_pack_data->pending_data[i]);
+	}
+
+	p_pack_data->pending_files.clear();
+	p_pack_data->pending_data.clear();
+	p_pack_data->pending_size = 0;
+
+	return OK;
+}
+
 Error EditorExportPlatform::_save_zip_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key) {
 	ERR_FAIL_COND_V_MSG(p_total < 1, ERR_PARAMETER_RANGE_ERROR, "Must select at least one file to export.");
 
@@ -1569,8 +1654,12 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.use_dictionary = GLOBAL_GET("editor/export/compress_small_files_with_dictionary");
 
 	Error err = export_project_files(p_preset, p_debug, _save_pack_file, &pd, _add_shared_object);
+	if (err == OK && !pd.dictionary_built && !pd.pending_files.is_empty()) {
+		err = _compress_pack_files(&pd);
+	}
 
 	// Close temp file.
 	pd.f.unref();
@@ -1634,12 +1723,17 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	if (p_embed) {
 		pack_flags |= PACK_REL_FILEBASE;
 	}
+	if (pd.dictionary_size) {
+		pack_flags |= PACK_ZSTD_DICTIONARY;
+	}
 	f->store_32(pack_flags); // flags
 
 	uint64_t file_base_ofs = f->get_position();
 	f->store_64(0); // files base
 
-	for (int i = 0; i < 16; i++) {
+	f->store_64(pd.dictionary_ofs);
+	f->store_32(pd.dictionary_size);
+	for (int i = 0; i < 13; i++) {
 		//reserved
 		f->store_32(0);
 	}
@@ -1710,6 +1804,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		if (pd.file_ofs[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (pd.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -34,6 +34,7 @@
 class EditorFileSystemDirectory;
 struct EditorProgress;
 
+#include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/zip_io.h"
 #include "core/os/shared_object.h"
@@ -74,6 +75,7 @@ private:
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
 		CharString path_utf8;
 
@@ -87,6 +89,22 @@ private:
 		Vector<SavedData> file_ofs;
 		EditorProgress *ep = nullptr;
 		Vector<SharedObject> *so_files = nullptr;
+
+		// Small files waiting to be compressed with a dictionary trained on them.
+		bool use_dictionary = false;
+		Vector<int> pending_files;
+		Vector<Vector<uint8_t>> pending_data;
+		uint64_t pending_size = 0;
+		bool dictionary_built = false;
+		ZstdDictionary *dictionary = nullptr;
+		uint64_t dictionary_ofs = 0;
+		uint32_t dictionary_size = 0;
+
+		~PackData() {
+			if (dictionary) {
+				memdelete(dictionary);
+			}
+		}
 	};
 
 	struct ZipData {
@@ -101,6 +119,8 @@ private:
 	void _export_find_dependencies(const String &p_path, HashSet<String> &p_paths);
 
 	static Error _save_pack_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key);
+	static void _store_pack_file_with_dictionary(PackData *p_pack_data, SavedData &r_sd, const Vector<uint8_t> &p_data);
+	static Error _compress_pack_files(PackData *p_pack_data);
 	static Error _save_zip_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key);
 
 	void _edit_files_with_filter(Ref<DirAccess> &da, const Vector<String> &p_filters, HashSet<String> &r_list, bool exclude);
@@ -204,7 +204,7 @@ bool ResourceImporterTexture::get_option_visibility(const String &p_path, const
 		if (compress_mode == COMPRESS_LOSSLESS) {
 			return false;
 		}
-	} else if (p_option == "mipmaps/limit") {
+	} else if (p_option == "mipmaps/limit" || p_option == "mipmaps/streaming") {
 		return p_options["mipmaps/generate"];
 	}
 
@@ -234,6 +234,7 @@ void ResourceImporterTexture::get_import_options(const String &p_path, List<Impo
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "compress/channel_pack", PROPERTY_HINT_ENUM, "sRGB Friendly,Optimized"), 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "mipmaps/generate"), (p_preset == PRESET_3D ? true : false)));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "mipmaps/limit", PROPERTY_HINT_RANGE, "-1,256"), -1));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "mipmaps/streaming"), false));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "roughness/mode", PROPERTY_HINT_ENUM, "Detect,Disabled,Red,Green,Blue,Alpha,Gray"), 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::STRING, "roughness/src_normal", PROPERTY_HINT_FILE, "*.bmp,*.dds,*.exr,*.jpeg,*.jpg,*.hdr,*.png,*.svg,*.tga,*.webp"), ""));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "process/fix_alpha_border"), p_preset != PRESET_3D));
@@ -452,8 +453,7 @@ Error ResourceImporterTexture::import(const String &p_source_file, const String
 	const bool fix_alpha_border = p_options["process/fix_alpha_border"];
 	const bool premult_alpha = p_options["process/premult_alpha"];
 	const bool normal_map_invert_y = p_options["process/normal_map_invert_y"];
-	// Support for texture streaming is not implemented yet.
-	const bool stream = false;
+	const bool stream = mipmaps && bool(p_options["mipmaps/streaming"]);
 	const int size_limit = p_options["process/size_limit"];
 	const bool hdr_as_srgb = p_options["process/hdr_as_srgb"];
 	if (hdr_as_srgb) {
@@ -719,6 +719,13 @@ Error ResourceImporterTexture::import(const String &p_source_file, const String
 	return OK;
 }
 
+bool ResourceImporterTexture::can_use_import_cache(const HashMap<StringName, Variant> &p_options) const {
+	// Editor variants depend on the editor scale and theme, which are not part of the import options.
+	bool use_editor_scale = p_options.has("editor/scale_with_editor_scale") && p_options["editor/scale_with_editor_scale"];
+	bool convert_editor_colors = p_options.has("editor/convert_colors_with_editor_theme") && p_options["editor/convert_colors_with_editor_theme"];
+	return !use_editor_scale && !convert_editor_colors;
+}
+
 const char *ResourceImporterTexture::compression_formats[] = {
 	"s3tc_bptc",
 	"etc2_astc",
@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  shader_cache_export_plugin.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "shader_cache_export_plugin.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "scene/resources/canvas_item_material.h"
+#include "scene/resources/material.h"
+#include "scene/resources/particle_process_material.h"
+#include "servers/rendering/renderer_rd/shader_rd.h"
+#include "servers/rendering/renderer_rd/storage_rd/material_storage.h"
+
+void ShaderCacheExportPlugin::_find_variant_shaders(const Variant &p_value, HashSet<const Resource *> &r_visited, HashSet<RID> &r_shaders) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			Ref<Resource> res = p_value;
+			if (res.is_null() || r_visited.has(res.ptr())) {
+				return;
+			}
+			r_visited.insert(res.ptr());
+
+			Ref<Material> material = res;
+			if (material.is_valid()) {
+				RID shader = material->get_shader_rid();
+				if (shader.is_valid()) {
+					r_shaders.insert(shader);
+				}
+			}
+
+			// Materials reach their next pass and shader, meshes their surfaces and
+			// packed scenes their bundled resources through stored properties.
+			List<PropertyInfo> properties;
+			res->get_property_list(&properties);
+			for (const PropertyInfo &E : properties) {
+				if ((E.usage & PROPERTY_USAGE_STORAGE) && (E.type == Variant::OBJECT || E.type == Variant::ARRAY || E.type == Variant::DICTIONARY)) {
+					_find_variant_shaders(res->get(E.name), r_visited, r_shaders);
+				}
+			}
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				_find_variant_shaders(array[i], r_visited, r_shaders);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dictionary = p_value;
+			List<Variant> keys;
+			dictionary.get_key_list(&keys);
+			for (const Variant &E : keys) {
+				_find_variant_shaders(E, r_visited, r_shaders);
+				_find_variant_shaders(dictionary[E], r_visited, r_shaders);
+			}
+		} break;
+		default: {
+		}
+	}
+}
+
+void ShaderCacheExportPlugin::get_resource_shaders(const Ref<Resource> &p_resource, HashSet<RID> &r_shaders) {
+	HashSet<const Resource *> visited;
+	_find_variant_shaders(p_resource, visited, r_shaders);
+}
+
+void ShaderCacheExportPlugin::_export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) {
+	exported_cache_files.clear();
+
+	enabled = GLOBAL_GET("rendering/shader_compiler/shader_cache/include_in_export");
+	if (!enabled) {
+		return;
+	}
+
+	if (RenderingServer::get_singleton()->get_rendering_device() == nullptr || ShaderRD::get_shader_cache_dir().is_empty()) {
+		// The editor is not using RenderingDevice, so it has no compiled variants to offer.
+		enabled = false;
+		return;
+	}
+
+	if (String(GLOBAL_GET("rendering/renderer/rendering_method")) == "gl_compatibility") {
+		enabled = false;
+		return;
+	}
+}
+
+void ShaderCacheExportPlugin::_export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) {
+	if (!enabled) {
+		return;
+	}
+
+	if (!ClassDB::is_parent_class(p_type, "PackedScene") && !ClassDB::is_parent_class(p_type, "Material") && !ClassDB::is_parent_class(p_type, "Shader") && !ClassDB::is_parent_class(p_type, "Mesh")) {
+		return;
+	}
+
+	Ref<Resource> res = ResourceLoader::load(p_path);
+	if (res.is_null()) {
+		return;
+	}
+
+	// Make sure the materials have created their shaders and the rendering server has
+	// received their code, so the ShaderRD versions (and their cache file names) exist.
+	BaseMaterial3D::flush_changes();
+	CanvasItemMaterial::flush_changes();
+	ParticleProcessMaterial::flush_changes();
+	RenderingServer::get_singleton()->sync();
+
+	HashSet<RID> shaders;
+	get_resource_shaders(res, shaders);
+
+	const String cache_dir = ShaderRD::get_shader_cache_dir();
+	const String packed_dir = ProjectSettings::get_singleton()->get_project_data_path().path_join("shader_cache");
+	for (const RID &shader : shaders) {
+		Vector<String> files = RendererRD::MaterialStorage::get_singleton()->shader_get_cache_files(shader);
+		for (const String &file : files) {
+			if (exported_cache_files.has(file)) {
+				continue;
+			}
+			exported_cache_files.insert(file);
+
+			Error err;
+			Vector<uint8_t> data = FileAccess::get_file_as_bytes(cache_dir.path_join(file), &err);
+			if (err != OK) {
+				continue; // Never compiled by the editor, nothing to ship.
+			}
+			add_file(packed_dir.path_join(file), data, false);
+		}
+	}
+}
+
+void ShaderCacheExportPlugin::_export_end() {
+	enabled = false;
+	exported_cache_files.clear();
+}
@@ -0,0 +1,61 @@
+/**************************************************************************/
+/*  shader_cache_export_plugin.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SHADER_CACHE_EXPORT_PLUGIN_H
+#define SHADER_CACHE_EXPORT_PLUGIN_H
+
+#include "editor/export/editor_export.h"
+
+// Ships the RenderingDevice shader cache entries of the materials used by the exported
+// scenes and resources inside the PCK, so exported projects don't have to compile those
+// variants the first time they are drawn. Only entries produced by the editor's own
+// rendering driver and method are available, so this helps exports that match them.
+class ShaderCacheExportPlugin : public EditorExportPlugin {
+private:
+	bool enabled = false;
+	HashSet<String> exported_cache_files;
+
+	static void _find_variant_shaders(const Variant &p_value, HashSet<const Resource *> &r_visited, HashSet<RID> &r_shaders);
+
+protected:
+	String get_name() const override { return "ShaderCache"; }
+
+	void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override;
+	void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override;
+	void _export_end() override;
+
+public:
+	// Collects the shaders of every material reachable through the stored properties of
+	// p_resource, including those nested in arrays and dictionaries (like mesh surfaces
+	// and packed scene resources).
+	static void get_resource_shaders(const Ref<Resource> &p_resource, HashSet<RID> &r_shaders);
+};
+
+#endif // SHADER_CACHE_EXPORT_PLUGIN_H
@@ -238,6 +238,8 @@ static int frame_delay = 0;
 static int audio_output_latency = 0;
 static bool disable_render_loop = false;
 static int fixed_fps = -1;
+static bool server_tick = false;
+static ServerTickSync server_tick_sync;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
@@ -625,6 +627,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--fixed-fps <fps>", "Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	print_help_option("--delta-smoothing <enable>", "Enable or disable frame delta smoothing [\"enable\", \"disable\"].\n");
 	print_help_option("--print-fps", "Print the frames per second to the stdout.\n");
+	print_help_option("--server-tick", "Run the main loop at a fixed physics tick rate without frame pacing or rendering. Only effective in headless mode.\n");
 
 	print_help_title("Standalone tools");
 	print_help_option("-s, --script <script>", "Run a script.\n");
@@ -1673,6 +1676,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			disable_vsync = true;
 		} else if (arg == "--print-fps") {
 			print_fps = true;
+		} else if (arg == "--server-tick") {
+			server_tick = true;
 		} else if (arg == "--profile-gpu") {
 			profile_gpu = true;
 		} else if (arg == "--disable-crash-handler") {
@@ -2414,6 +2419,10 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			GLOBAL_DEF(PropertyInfo(Variant::INT, "application/run/low_processor_mode_sleep_usec", PROPERTY_HINT_RANGE, "0,33200,1,or_greater"), 6900)); // Roughly 144 FPS
 
 	GLOBAL_DEF("application/run/delta_smoothing", true);
+	if (GLOBAL_DEF("application/run/server_tick_mode", false)) {
+		server_tick = true; // Also enabled by --server-tick.
+	}
+	server_tick_sync.set_spin_usec(GLOBAL_DEF(PropertyInfo(Variant::INT, "application/run/server_tick_spin_usec", PROPERTY_HINT_RANGE, "0,10000,1,or_greater"), 0));
 	if (!delta_smoothing_override) {
 		OS::get_singleton()->set_delta_smoothing(GLOBAL_GET("application/run/delta_smoothing"));
 	}
@@ -3955,6 +3964,16 @@ int Main::start() {
 		movie_writer->begin(DisplayServer::get_singleton()->window_get_size(), fixed_fps, Engine::get_singleton()->get_write_movie_path());
 	}
 
+	if (server_tick) {
+		// Nothing is ever drawn without a display, so the loop only needs to follow the physics ticks.
+		server_tick = !editor && !project_manager && !movie_writer && DisplayServer::get_singleton()->get_name() == NULL_DISPLAY_DRIVER;
+		if (!server_tick) {
+			WARN_PRINT("Server tick mode is only supported when running a project in headless mode, ignoring.");
+		} else {
+			print_verbose(vformat("Server tick mode enabled at %d ticks per second.", Engine::get_singleton()->get_physics_ticks_per_second()));
+		}
+	}
+
 	if (minimum_time_msec) {
 		uint64_t minimum_time = 1000 * minimum_time_msec;
 		uint64_t elapsed_time = OS::get_singleton()->get_ticks_usec();
@@ -3995,6 +4014,21 @@ static uint64_t physics_process_max = 0;
 static uint64_t process_max = 0;
 static uint64_t navigation_process_max = 0;
 
+// Server tick mode, sleeps until the next tick is due.
+static void _server_tick_wait(uint64_t p_tick_usec, int p_max_late_ticks) {
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	const uint64_t target = server_tick_sync.schedule_next_tick(now, p_tick_usec, p_max_late_ticks);
+	const uint64_t sleep_usec = server_tick_sync.get_sleep_usec(now, target);
+	if (sleep_usec) {
+		OS::get_singleton()->delay_usec(sleep_usec);
+	}
+	if (server_tick_sync.get_spin_usec()) {
+		while (OS::get_singleton()->get_ticks_usec() < target) {
+			OS::get_singleton()->yield();
+		}
+	}
+}
+
 // Return false means iterating further, returning true means `OS::run`
 // will terminate the program. In case of failure, the OS exit code needs
 // to be set explicitly here (defaults to EXIT_SUCCESS).
@@ -4013,7 +4047,15 @@ bool Main::iteration() {
 
 	const double time_scale = Engine::get_singleton()->get_time_scale();
 
-	MainFrameTime advance = main_timer_sync.advance(physics_step, physics_ticks_per_second);
+	MainFrameTime advance;
+	if (server_tick) {
+		// Exactly one physics and one process step per iteration, paced by _server_tick_wait().
+		advance.process_step = physics_step;
+		advance.physics_steps = 1;
+		advance.interpolation_fraction = 0;
+	} else {
+		advance = main_timer_sync.advance(physics_step, physics_ticks_per_second);
+	}
 	double process_step = advance.process_step;
 	double scaled_step = process_step * time_scale;
 
@@ -4113,9 +4155,11 @@ bool Main::iteration() {
 	}
 	message_queue->flush();
 
-	RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
+	if (!server_tick) {
+		RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
+	}
 
-	if ((DisplayServer::get_singleton()->can_any_window_draw() || DisplayServer::get_singleton()->has_additional_outputs()) &&
+	if (!server_tick && (DisplayServer::get_singleton()->can_any_window_draw() || DisplayServer::get_singleton()->has_additional_outputs()) &&
 			RenderingServer::get_singleton()->is_render_loop_enabled()) {
 		if ((!force_redraw_requested) && OS::get_singleton()->is_in_low_processor_usage_mode()) {
 			if (RenderingServer::get_singleton()->has_changed()) {
@@ -4139,6 +4183,10 @@ bool Main::iteration() {
 
 	AudioServer::get_singleton()->update();
 
+	if (server_tick) {
+		server_tick_sync.add_tick_time(OS::get_singleton()->get_ticks_usec() - ticks);
+	}
+
 	if (EngineDebugger::is_active()) {
 		EngineDebugger::get_singleton()->iteration(frame_time, process_ticks, physics_process_ticks, physics_step);
 	}
@@ -4168,6 +4216,11 @@ bool Main::iteration() {
 		physics_process_max = 0;
 		navigation_process_max = 0;
 
+		if (server_tick && server_tick_sync.get_tick_count()) {
+			performance->set_server_tick_times(server_tick_sync.get_tick_time_percentile(0.5), server_tick_sync.get_tick_time_percentile(0.99), server_tick_sync.get_max_tick_time(), server_tick_sync.get_overruns());
+			server_tick_sync.clear_stats();
+		}
+
 		frame %= 1000000;
 		frames = 0;
 	}
@@ -4198,7 +4251,11 @@ bool Main::iteration() {
 		return exit;
 	}
 
-	OS::get_singleton()->add_frame_delay(DisplayServer::get_singleton()->window_can_draw());
+	if (server_tick) {
+		_server_tick_wait(1000000 / physics_ticks_per_second, max_physics_steps);
+	} else {
+		OS::get_singleton()->add_frame_delay(DisplayServer::get_singleton()->window_can_draw());
+	}
 
 #ifdef TOOLS_ENABLED
 	if (auto_build_solutions) {
@@ -534,3 +534,54 @@ MainFrameTime MainTimerSync::advance(double p_physics_step, int p_physics_ticks_
 
 	return advance_checked(p_physics_step, p_physics_ticks_per_second, cpu_process_step);
 }
+
+uint64_t ServerTickSync::schedule_next_tick(uint64_t p_now_usec, uint64_t p_tick_usec, int p_max_late_ticks) {
+	if (target_usec == 0) {
+		target_usec = p_now_usec;
+	}
+	target_usec += p_tick_usec;
+	if (p_now_usec >= target_usec) {
+		overruns++;
+		if (p_now_usec - target_usec > p_tick_usec * p_max_late_ticks) {
+			target_usec = p_now_usec;
+		}
+		return p_now_usec;
+	}
+	return target_usec;
+}
+
+uint64_t ServerTickSync::get_sleep_usec(uint64_t p_now_usec, uint64_t p_target_usec) const {
+	if (p_target_usec <= p_now_usec + spin_usec) {
+		return 0;
+	}
+	return p_target_usec - p_now_usec - spin_usec;
+}
+
+void ServerTickSync::add_tick_time(uint64_t p_usec) {
+	histogram[MIN(p_usec / BUCKET_USEC, uint64_t(BUCKETS - 1))]++;
+	tick_count++;
+	max_tick_usec = MAX(p_usec, max_tick_usec);
+}
+
+double ServerTickSync::get_tick_time_percentile(double p_fraction) const {
+	const uint32_t target = uint32_t(Math::ceil(tick_count * p_fraction));
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < BUCKETS - 1; i++) {
+		count += histogram[i];
+		if (count >= target) {
+			return USEC_TO_SEC((i + 1) * BUCKET_USEC);
+		}
+	}
+	return get_max_tick_time();
+}
+
+double ServerTickSync::get_max_tick_time() const {
+	return USEC_TO_SEC(max_tick_usec);
+}
+
+void ServerTickSync::clear_stats() {
+	memset(histogram, 0, sizeof(histogram));
+	tick_count = 0;
+	overruns = 0;
+	max_tick_usec = 0;
+}
@@ -162,4 +162,40 @@ public:
 	MainFrameTime advance(double p_physics_step, int p_physics_ticks_per_second);
 };
 
+// Paces the main loop in server tick mode, where each iteration is exactly one
+// physics tick, and keeps a histogram of the tick durations.
+class ServerTickSync {
+public:
+	static const uint64_t BUCKET_USEC = 50;
+	static const uint32_t BUCKETS = 1024; // Last bucket holds all ticks longer than ~51 ms.
+
+private:
+	uint64_t target_usec = 0;
+	uint64_t spin_usec = 0;
+	uint32_t histogram[BUCKETS] = {};
+	uint32_t tick_count = 0;
+	uint32_t overruns = 0;
+	uint64_t max_tick_usec = 0;
+
+public:
+	// Schedules the next tick and returns when it is due. Late ticks are counted
+	// as overruns and due right away, unless more than p_max_late_ticks behind,
+	// in which case the schedule restarts from p_now_usec.
+	uint64_t schedule_next_tick(uint64_t p_now_usec, uint64_t p_tick_usec, int p_max_late_ticks);
+
+	// Sleeping is not precise, the last p_usec before a tick can be spent spinning instead. 0 sleeps until the tick is due.
+	void set_spin_usec(uint64_t p_usec) { spin_usec = p_usec; }
+	uint64_t get_spin_usec() const { return spin_usec; }
+	// How long to sleep before a tick due at p_target_usec, the rest of the wait being spun.
+	uint64_t get_sleep_usec(uint64_t p_now_usec, uint64_t p_target_usec) const;
+
+	void add_tick_time(uint64_t p_usec);
+	// Upper bound of the bucket holding the given fraction of the ticks, in seconds.
+	double get_tick_time_percentile(double p_fraction) const;
+	double get_max_tick_time() const;
+	uint32_t get_tick_count() const { return tick_count; }
+	uint32_t get_overruns() const { return overruns; }
+	void clear_stats();
+};
+
 #endif // MAIN_TIMER_SYNC_H
@@ -91,6 +91,10 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(TIME_SERVER_TICK_MEDIAN);
+	BIND_ENUM_CONSTANT(TIME_SERVER_TICK_P99);
+	BIND_ENUM_CONSTANT(TIME_SERVER_TICK_MAX);
+	BIND_ENUM_CONSTANT(TIME_SERVER_TICK_OVERRUNS);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -141,6 +145,10 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation/edges_merged"),
 		PNAME("navigation/edges_connected"),
 		PNAME("navigation/edges_free"),
+		PNAME("time/server_tick_median"),
+		PNAME("time/server_tick_p99"),
+		PNAME("time/server_tick_max"),
+		PNAME("time/server_tick_overruns"),
 
 	};
 
@@ -225,6 +233,14 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case TIME_SERVER_TICK_MEDIAN:
+			return _server_tick_time_median;
+		case TIME_SERVER_TICK_P99:
+			return _server_tick_time_p99;
+		case TIME_SERVER_TICK_MAX:
+			return _server_tick_time_max;
+		case TIME_SERVER_TICK_OVERRUNS:
+			return _server_tick_overruns;
 
 		default: {
 		}
@@ -272,6 +288,10 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
@@ -290,6 +310,13 @@ void Performance::set_navigation_process_time(double p_pt) {
 	_navigation_process_time = p_pt;
 }
 
+void Performance::set_server_tick_times(double p_median, double p_p99, double p_max, uint32_t p_overruns) {
+	_server_tick_time_median = p_median;
+	_server_tick_time_p99 = p_p99;
+	_server_tick_time_max = p_max;
+	_server_tick_overruns = p_overruns;
+}
+
 void Performance::add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args) {
 	ERR_FAIL_COND_MSG(has_custom_monitor(p_id), "Custom monitor with id '" + String(p_id) + "' already exists.");
 	_monitor_map.insert(p_id, MonitorCall(p_callable, p_args));
@@ -337,6 +364,10 @@ Performance::Performance() {
 	_process_time = 0;
 	_physics_process_time = 0;
 	_navigation_process_time = 0;
+	_server_tick_time_median = 0;
+	_server_tick_time_p99 = 0;
+	_server_tick_time_max = 0;
+	_server_tick_overruns = 0;
 	_monitor_modification_time = 0;
 	singleton = this;
 }
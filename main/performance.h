@@ -51,6 +51,10 @@ class Performance : public Object {
 	double _process_time;
 	double _physics_process_time;
 	double _navigation_process_time;
+	double _server_tick_time_median;
+	double _server_tick_time_p99;
+	double _server_tick_time_max;
+	uint32_t _server_tick_overruns;
 
 	class MonitorCall {
 		Callable _callable;
@@ -100,6 +104,10 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		TIME_SERVER_TICK_MEDIAN,
+		TIME_SERVER_TICK_P99,
+		TIME_SERVER_TICK_MAX,
+		TIME_SERVER_TICK_OVERRUNS,
 		MONITOR_MAX
 	};
 
@@ -117,6 +125,7 @@ public:
 	void set_process_time(double p_pt);
 	void set_physics_process_time(double p_pt);
 	void set_navigation_process_time(double p_pt);
+	void set_server_tick_times(double p_median, double p_p99, double p_max, uint32_t p_overruns);
 
 	void add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args);
 	void remove_custom_monitor(const StringName &p_id);
@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  enet_memory_pool.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "enet_memory_pool.h"
+
+#include "core/os/memory.h"
+#include "core/os/spin_lock.h"
+#include "core/typedefs.h"
+
+namespace {
+
+// Each block is preceded by a header holding its size class, padded to keep
+// the returned memory aligned like the system allocator does.
+union BlockHeader {
+	uint32_t size_class;
+	max_align_t align;
+};
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+const uint32_t MIN_BLOCK_SHIFT = 5; // 32 bytes.
+const uint32_t SIZE_CLASSES = 7; // Up to 2048 bytes, more than a datagram.
+const uint32_t LARGE_BLOCK = UINT32_MAX;
+const uint32_t MAX_FREE_BLOCKS = 1024; // Per size class.
+
+struct SizeClass {
+	SpinLock lock;
+	FreeBlock *free_list = nullptr;
+	uint32_t free_count = 0;
+};
+
+SizeClass size_classes[SIZE_CLASSES];
+
+uint32_t _get_size_class(size_t p_size) {
+	uint32_t size_class = 0;
+	size_t block_size = size_t(1) << MIN_BLOCK_SHIFT;
+	while (block_size < p_size) {
+		block_size <<= 1;
+		size_class++;
+	}
+	return size_class < SIZE_CLASSES ? size_class : LARGE_BLOCK;
+}
+
+} // namespace
+
+void *ENetMemoryPool::allocate(size_t p_size) {
+	const uint32_t size_class = _get_size_class(p_size);
+	BlockHeader *header = nullptr;
+	if (size_class != LARGE_BLOCK) {
+		SizeClass &sc = size_classes[size_class];
+		sc.lock.lock();
+		FreeBlock *block = sc.free_list;
+		if (block) {
+			sc.free_list = block->next;
+			sc.free_count--;
+		}
+		sc.lock.unlock();
+		if (block) {
+			header = (BlockHeader *)block;
+		} else {
+			header = (BlockHeader *)memalloc(sizeof(BlockHeader) + (size_t(1) << (size_class + MIN_BLOCK_SHIFT)));
+		}
+	} else {
+		header = (BlockHeader *)memalloc(sizeof(BlockHeader) + p_size);
+	}
+	if (!header) {
+		return nullptr;
+	}
+	header->size_class = size_class;
+	return header + 1;
+}
+
+void ENetMemoryPool::free(void *p_memory) {
+	if (!p_memory) {
+		return;
+	}
+	BlockHeader *header = (BlockHeader *)p_memory - 1;
+	const uint32_t size_class = header->size_class;
+	if (size_class != LARGE_BLOCK) {
+		SizeClass &sc = size_classes[size_class];
+		sc.lock.lock();
+		if (sc.free_count < MAX_FREE_BLOCKS) {
+			FreeBlock *block = (FreeBlock *)header;
+			block->next = sc.free_list;
+			sc.free_list = block;
+			sc.free_count++;
+			header = nullptr;
+		}
+		sc.lock.unlock();
+	}
+	if (header) {
+		memfree(header);
+	}
+}
+
+void ENetMemoryPool::clear() {
+	for (SizeClass &sc : size_classes) {
+		sc.lock.lock();
+		FreeBlock *block = sc.free_list;
+		sc.free_list = nullptr;
+		sc.free_count = 0;
+		sc.lock.unlock();
+		while (block) {
+			FreeBlock *next = block->next;
+			memfree(block);
+			block = next;
+		}
+	}
+}
+
+uint32_t ENetMemoryPool::get_cached_block_count() {
+	uint32_t count = 0;
+	for (SizeClass &sc : size_classes) {
+		sc.lock.lock();
+		count += sc.free_count;
+		sc.lock.unlock();
+	}
+	return count;
+}
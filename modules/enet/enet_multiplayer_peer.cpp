@@ -40,21 +40,21 @@ void ENetMultiplayerPeer::set_target_peer(int p_peer) {
 
 int ENetMultiplayerPeer::get_packet_peer() const {
 	ERR_FAIL_COND_V_MSG(!_is_active(), 1, "The multiplayer instance isn't currently active.");
-	ERR_FAIL_COND_V(incoming_packets.is_empty(), 1);
+	ERR_FAIL_COND_V(incoming_packets_head >= incoming_packets.size(), 1);
 
-	return incoming_packets.front()->get().from;
+	return incoming_packets[incoming_packets_head].from;
 }
 
 MultiplayerPeer::TransferMode ENetMultiplayerPeer::get_packet_mode() const {
 	ERR_FAIL_COND_V_MSG(!_is_active(), TRANSFER_MODE_RELIABLE, "The multiplayer instance isn't currently active.");
-	ERR_FAIL_COND_V(incoming_packets.is_empty(), TRANSFER_MODE_RELIABLE);
-	return incoming_packets.front()->get().transfer_mode;
+	ERR_FAIL_COND_V(incoming_packets_head >= incoming_packets.size(), TRANSFER_MODE_RELIABLE);
+	return incoming_packets[incoming_packets_head].transfer_mode;
 }
 
 int ENetMultiplayerPeer::get_packet_channel() const {
 	ERR_FAIL_COND_V_MSG(!_is_active(), 1, "The multiplayer instance isn't currently active.");
-	ERR_FAIL_COND_V(incoming_packets.is_empty(), 1);
-	int ch = incoming_packets.front()->get().channel;
+	ERR_FAIL_COND_V(incoming_packets_head >= incoming_packets.size(), 1);
+	int ch = incoming_packets[incoming_packets_head].channel;
 	if (ch >= SYSCH_MAX) { // First 2 channels are reserved.
 		return ch - SYSCH_MAX + 1;
 	}
@@ -144,6 +144,15 @@ void ENetMultiplayerPeer::_store_packet(int32_t p_source, ENetConnection::Event
 		packet.transfer_mode = TRANSFER_MODE_UNRELIABLE_ORDERED;
 	}
 	packet.packet->referenceCount++;
+	if (incoming_packets_head && incoming_packets_head * 2 >= incoming_packets.size()) {
+		// Drop the consumed packets once they make up most of the queue.
+		const uint32_t remaining = incoming_packets.size() - incoming_packets_head;
+		for (uint32_t i = 0; i < remaining; i++) {
+			incoming_packets[i] = incoming_packets[incoming_packets_head + i];
+		}
+		incoming_packets.resize(remaining);
+		incoming_packets_head = 0;
+	}
 	incoming_packets.push_back(packet);
 }
 
@@ -309,6 +318,7 @@ void ENetMultiplayerPeer::close() {
 
 	active_mode = MODE_NONE;
 	incoming_packets.clear();
+	incoming_packets_head = 0;
 	peers.clear();
 	hosts.clear();
 	unique_id = 0;
@@ -317,16 +327,20 @@ void ENetMultiplayerPeer::close() {
 }
 
 int ENetMultiplayerPeer::get_available_packet_count() const {
-	return incoming_packets.size();
+	return incoming_packets.size() - incoming_packets_head;
 }
 
 Error ENetMultiplayerPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
-	ERR_FAIL_COND_V_MSG(incoming_packets.is_empty(), ERR_UNAVAILABLE, "No incoming packets available.");
+	ERR_FAIL_COND_V_MSG(incoming_packets_head >= incoming_packets.size(), ERR_UNAVAILABLE, "No incoming packets available.");
 
 	_pop_current_packet();
 
-	current_packet = incoming_packets.front()->get();
-	incoming_packets.pop_front();
+	current_packet = incoming_packets[incoming_packets_head++];
+	if (incoming_packets_head == incoming_packets.size()) {
+		// Fully consumed, keep the capacity for the next poll.
+		incoming_packets.clear();
+		incoming_packets_head = 0;
+	}
 
 	*r_buffer = (const uint8_t *)(current_packet.packet->data);
 	r_buffer_size = current_packet.packet->dataLength;
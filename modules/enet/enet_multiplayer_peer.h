@@ -78,7 +78,9 @@ private:
 		TransferMode transfer_mode = TRANSFER_MODE_RELIABLE;
 	};
 
-	List<Packet> incoming_packets;
+	// Consumed from incoming_packets_head, so popping a packet doesn't move or free anything.
+	LocalVector<Packet> incoming_packets;
+	uint32_t incoming_packets_head = 0;
 
 	Packet current_packet;
 
@@ -85,18 +85,21 @@ int ENetPacketPeer::get_max_packet_size() const {
 }
 
 int ENetPacketPeer::get_available_packet_count() const {
-	return packet_queue.size();
+	return packet_queue.size() - packet_queue_head;
 }
 
 Error ENetPacketPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
 	ERR_FAIL_NULL_V(peer, ERR_UNCONFIGURED);
-	ERR_FAIL_COND_V(packet_queue.is_empty(), ERR_UNAVAILABLE);
+	ERR_FAIL_COND_V(packet_queue_head >= packet_queue.size(), ERR_UNAVAILABLE);
 	if (last_packet) {
 		enet_packet_destroy(last_packet);
 		last_packet = nullptr;
 	}
-	last_packet = packet_queue.front()->get();
-	packet_queue.pop_front();
+	last_packet = packet_queue[packet_queue_head++];
+	if (packet_queue_head == packet_queue.size()) {
+		packet_queue.clear();
+		packet_queue_head = 0;
+	}
 	*r_buffer = (const uint8_t *)(last_packet->data);
 	r_buffer_size = last_packet->dataLength;
 	return OK;
@@ -184,6 +187,15 @@ void ENetPacketPeer::_on_disconnect() {
 
 void ENetPacketPeer::_queue_packet(ENetPacket *p_packet) {
 	ERR_FAIL_NULL(peer);
+	if (packet_queue_head && packet_queue_head * 2 >= packet_queue.size()) {
+		// Drop the consumed packets once they make up most of the queue.
+		const uint32_t remaining = packet_queue.size() - packet_queue_head;
+		for (uint32_t i = 0; i < remaining; i++) {
+			packet_queue[i] = packet_queue[packet_queue_head + i];
+		}
+		packet_queue.resize(remaining);
+		packet_queue_head = 0;
+	}
 	packet_queue.push_back(p_packet);
 }
 
@@ -258,8 +270,9 @@ ENetPacketPeer::~ENetPacketPeer() {
 		enet_packet_destroy(last_packet);
 		last_packet = nullptr;
 	}
-	for (List<ENetPacket *>::Element *E = packet_queue.front(); E; E = E->next()) {
-		enet_packet_destroy(E->get());
+	for (uint32_t i = packet_queue_head; i < packet_queue.size(); i++) {
+		enet_packet_destroy(packet_queue[i]);
 	}
 	packet_queue.clear();
+	packet_queue_head = 0;
 }
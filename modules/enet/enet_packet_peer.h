@@ -32,6 +32,7 @@
 #define ENET_PACKET_PEER_H
 
 #include "core/io/packet_peer.h"
+#include "core/templates/local_vector.h"
 
 #include <enet/enet.h>
 
@@ -40,7 +41,8 @@ class ENetPacketPeer : public PacketPeer {
 
 private:
 	ENetPeer *peer = nullptr;
-	List<ENetPacket *> packet_queue;
+	LocalVector<ENetPacket *> packet_queue; // Consumed from packet_queue_head.
+	uint32_t packet_queue_head = 0;
 	ENetPacket *last_packet = nullptr;
 
 	static void _bind_methods();
@@ -31,6 +31,7 @@
 #include "register_types.h"
 
 #include "enet_connection.h"
+#include "enet_memory_pool.h"
 #include "enet_multiplayer_peer.h"
 #include "enet_packet_peer.h"
 
@@ -43,7 +44,10 @@ void initialize_enet_module(ModuleInitializationLevel p_level) {
 		return;
 	}
 
-	if (enet_initialize() != 0) {
+	ENetCallbacks callbacks = {};
+	callbacks.malloc = &ENetMemoryPool::allocate;
+	callbacks.free = &ENetMemoryPool::free;
+	if (enet_initialize_with_callbacks(ENET_VERSION, &callbacks) != 0) {
 		ERR_PRINT("ENet initialization failure");
 	} else {
 		enet_ok = true;
@@ -62,4 +66,5 @@ void uninitialize_enet_module(ModuleInitializationLevel p_level) {
 	if (enet_ok) {
 		enet_deinitialize();
 	}
+	ENetMemoryPool::clear();
 }
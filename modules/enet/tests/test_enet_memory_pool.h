@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*  test_enet_memory_pool.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ENET_MEMORY_POOL_H
+#define TEST_ENET_MEMORY_POOL_H
+
+#include "../enet_memory_pool.h"
+
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestENetMemoryPool {
+
+TEST_CASE("[ENetMemoryPool] Blocks are recycled by size class") {
+	ENetMemoryPool::clear();
+	REQUIRE(ENetMemoryPool::get_cached_block_count() == 0);
+
+	SUBCASE("Freed blocks are reused for sizes of the same class") {
+		uint8_t *block = (uint8_t *)ENetMemoryPool::allocate(40);
+		REQUIRE(block);
+		CHECK(uintptr_t(block) % alignof(max_align_t) == 0);
+		memset(block, 0xAB, 64); // The whole size class is usable.
+		ENetMemoryPool::free(block);
+		CHECK(ENetMemoryPool::get_cached_block_count() == 1);
+
+		// A smaller class doesn't take it.
+		void *small = ENetMemoryPool::allocate(32);
+		CHECK(small != block);
+		CHECK(ENetMemoryPool::get_cached_block_count() == 1);
+
+		void *reused = ENetMemoryPool::allocate(64);
+		CHECK(reused == block);
+		CHECK(ENetMemoryPool::get_cached_block_count() == 0);
+		ENetMemoryPool::free(reused);
+		ENetMemoryPool::free(small);
+		CHECK(ENetMemoryPool::get_cached_block_count() == 2);
+	}
+
+	SUBCASE("Blocks larger than a datagram are not cached") {
+		void *large = ENetMemoryPool::allocate(4096);
+		REQUIRE(large);
+		ENetMemoryPool::free(large);
+		CHECK(ENetMemoryPool::get_cached_block_count() == 0);
+		ENetMemoryPool::free(nullptr);
+		CHECK(ENetMemoryPool::get_cached_block_count() == 0);
+	}
+
+	SUBCASE("The number of cached blocks is capped") {
+		LocalVector<void *> blocks;
+		for (int i = 0; i < 2000; i++) {
+			blocks.push_back(ENetMemoryPool::allocate(100));
+		}
+		for (void *block : blocks) {
+			ENetMemoryPool::free(block);
+		}
+		CHECK(ENetMemoryPool::get_cached_block_count() == 1024);
+	}
+
+	ENetMemoryPool::clear();
+	CHECK(ENetMemoryPool::get_cached_block_count() == 0);
+}
+
+} // namespace TestENetMemoryPool
+
+#endif // TEST_ENET_MEMORY_POOL_H
@@ -31,6 +31,7 @@
 #include "grid_map.h"
 
 #include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/light_3d.h"
 #include "scene/resources/3d/mesh_library.h"
 #include "scene/resources/3d/primitive_meshes.h"
@@ -83,6 +84,9 @@ bool GridMap::_set(const StringName &p_name, const Variant &p_value) {
 
 		_recreate_octant_data();
 
+	} else if (name == "baked_meshes_unwrap_cache") {
+		baked_meshes_unwrap_cache = p_value;
+
 	} else {
 		return false;
 	}
@@ -119,6 +123,9 @@ bool GridMap::_get(const StringName &p_name, Variant &r_ret) const {
 		}
 		r_ret = ret;
 
+	} else if (name == "baked_meshes_unwrap_cache") {
+		r_ret = baked_meshes_unwrap_cache;
+
 	} else {
 		return false;
 	}
@@ -130,6 +137,9 @@ void GridMap::_get_property_list(List<PropertyInfo> *p_list) const {
 	if (baked_meshes.size()) {
 		p_list->push_back(PropertyInfo(Variant::ARRAY, "baked_meshes", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE));
 	}
+	if (!baked_meshes_unwrap_cache.is_empty()) {
+		p_list->push_back(PropertyInfo(Variant::PACKED_BYTE_ARRAY, "baked_meshes_unwrap_cache", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE));
+	}
 
 	p_list->push_back(PropertyInfo(Variant::DICTIONARY, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE));
 }
@@ -1282,11 +1292,28 @@ void GridMap::make_baked_meshes(bool p_gen_lightmap_uv, float p_lightmap_uv_texe
 		}
 	}
 
+	LocalVector<BakedMeshUnwrap> unwraps;
+	LocalVector<int> unwrap_baked_mesh_indices;
+
 	for (KeyValue<OctantKey, HashMap<Ref<Material>, Ref<SurfaceTool>>> &E : surface_map) {
 		Ref<ArrayMesh> mesh;
 		mesh.instantiate();
-		for (KeyValue<Ref<Material>, Ref<SurfaceTool>> &F : E.value) {
-			F.value->commit(mesh);
+		if (p_gen_lightmap_uv) {
+			// Unwrapped on the worker threads below, ImporterMesh keeps the arrays on the CPU.
+			BakedMeshUnwrap unwrap;
+			unwrap.mesh.instantiate();
+			for (KeyValue<Ref<Material>, Ref<SurfaceTool>> &F : E.value) {
+				unwrap.mesh->add_surface(Mesh::PRIMITIVE_TRIANGLES, F.value->commit_to_arrays(), TypedArray<Array>(), Dictionary(), F.value->get_material());
+			}
+			unwrap.transform = get_global_transform();
+			unwrap.texel_size = p_lightmap_uv_texel_size;
+			unwrap.src_cache = baked_meshes_unwrap_cache;
+			unwraps.push_back(unwrap);
+			unwrap_baked_mesh_indices.push_back(baked_meshes.size());
+		} else {
+			for (KeyValue<Ref<Material>, Ref<SurfaceTool>> &F : E.value) {
+				F.value->commit(mesh);
+			}
 		}
 
 		BakedMesh bm;
@@ -1299,15 +1326,58 @@ void GridMap::make_baked_meshes(bool p_gen_lightmap_uv, float p_lightmap_uv_texe
 			RS::get_singleton()->instance_set_transform(bm.instance, get_global_transform());
 		}
 
-		if (p_gen_lightmap_uv) {
-			mesh->lightmap_unwrap(get_global_transform(), p_lightmap_uv_texel_size);
-		}
 		baked_meshes.push_back(bm);
 	}
 
+	if (p_gen_lightmap_uv) {
+		// xatlas already spreads each unwrap over its own threads, so only overlap a few of
+		// them to fill its serial stages instead of running one per worker thread.
+		const int max_tasks = MIN((int)unwraps.size(), MAX_CONCURRENT_UNWRAPS);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GridMap::_unwrap_baked_mesh, unwraps.ptr(), unwraps.size(), max_tasks, true, SNAME("GridMapUnwrapBakedMeshes"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Keep one cache entry per unwrapped mesh. Entries start with the MD5 of the unwrap input.
+		HashSet<String> cached_hashes;
+		Vector<uint8_t> unwrap_cache;
+		unwrap_cache.resize(sizeof(int));
+		int cache_entries = 0;
+
+		for (uint32_t i = 0; i < unwraps.size(); i++) {
+			Ref<ArrayMesh> mesh = baked_meshes[unwrap_baked_mesh_indices[i]].mesh;
+			unwraps[i].mesh->get_mesh(mesh);
+
+			const Vector<uint8_t> &entry = unwraps[i].dst_cache;
+			if (entry.size() < 16) {
+				continue;
+			}
+			String md5 = String::md5(entry.ptr());
+			if (cached_hashes.has(md5)) {
+				continue;
+			}
+			cached_hashes.insert(md5);
+
+			int offset = unwrap_cache.size();
+			unwrap_cache.resize(offset + entry.size());
+			memcpy(unwrap_cache.ptrw() + offset, entry.ptr(), entry.size());
+			cache_entries++;
+		}
+
+		if (cache_entries > 0) {
+			memcpy(unwrap_cache.ptrw(), &cache_entries, sizeof(int));
+			baked_meshes_unwrap_cache = unwrap_cache;
+		} else {
+			baked_meshes_unwrap_cache.clear();
+		}
+	}
+
 	_recreate_octant_data();
 }
 
+void GridMap::_unwrap_baked_mesh(uint32_t p_index, BakedMeshUnwrap *p_unwraps) {
+	BakedMeshUnwrap &unwrap = p_unwraps[p_index];
+	unwrap.mesh->lightmap_unwrap_cached(unwrap.transform, unwrap.texel_size, unwrap.src_cache, unwrap.dst_cache);
+}
+
 Array GridMap::get_bake_meshes() {
 	if (!baked_meshes.size()) {
 		make_baked_meshes(true);
@@ -32,6 +32,7 @@
 #define GRID_MAP_H
 
 #include "scene/3d/node_3d.h"
+#include "scene/resources/3d/importer_mesh.h"
 #include "scene/resources/3d/mesh_library.h"
 #include "scene/resources/multimesh.h"
 
@@ -218,6 +219,23 @@ class GridMap : public Node3D {
 
 	Vector<BakedMesh> baked_meshes;
 
+	// Lightmap UV2 unwraps of the last baked meshes, in the format used by the unwrap
+	// callback, so rebaking only unwraps the octants that changed since. Saved with the
+	// scene, like the .unwrap_cache files of imported scenes.
+	Vector<uint8_t> baked_meshes_unwrap_cache;
+
+	static const int MAX_CONCURRENT_UNWRAPS = 2;
+
+	struct BakedMeshUnwrap {
+		Ref<ImporterMesh> mesh;
+		Transform3D transform;
+		float texel_size = 0.1;
+		Vector<uint8_t> src_cache;
+		Vector<uint8_t> dst_cache;
+	};
+
+	void _unwrap_baked_mesh(uint32_t p_index, BakedMeshUnwrap *p_unwraps);
+
 protected:
 	bool _set(const StringName &p_name, const Variant &p_value);
 	bool _get(const StringName &p_name, Variant &r_ret) const;
@@ -37,6 +37,7 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/math/geometry_2d.h"
+#include "core/object/worker_thread_pool.h"
 #include "editor/editor_paths.h"
 #include "editor/editor_settings.h"
 #include "servers/rendering/rendering_device_binds.h"
@@ -348,129 +349,226 @@ Lightmapper::BakeError LightmapperRD::_blit_meshes_into_atlas(int p_max_texture_
 	return BAKE_OK;
 }
 
-void LightmapperRD::_create_acceleration_structures(RenderingDevice *rd, Size2i atlas_size, int atlas_slices, AABB &bounds, int grid_size, uint32_t p_cluster_size, Vector<Probe> &p_probe_positions, GenerateProbes p_generate_probes, Vector<int> &slice_triangle_count, Vector<int> &slice_seam_count, RID &vertex_buffer, RID &triangle_buffer, RID &lights_buffer, RID &r_triangle_indices_buffer, RID &r_cluster_indices_buffer, RID &r_cluster_aabbs_buffer, RID &probe_positions_buffer, RID &grid_texture, RID &seams_buffer, BakeStepFunc p_step_function, void *p_bake_userdata) {
-	HashMap<Vertex, uint32_t, VertexHash> vertex_map;
+void LightmapperRD::_gather_mesh_geometry(uint32_t p_mesh_index, MeshGeometry *p_geometry) {
+	const MeshInstance &mi = mesh_instances[p_mesh_index];
+	MeshGeometry &geometry = p_geometry[p_mesh_index];
+	HashMap<Edge, EdgeUV2, EdgeHash> edges;
+
+	const Vector2 uv_scale = geometry.uv_scale;
+	const Vector2 uv_offset = geometry.uv_offset;
+
+	geometry.vertices.reserve(mi.data.points.size());
+	geometry.triangles.reserve(mi.data.points.size() / 3);
+	if (mi.data.points.size()) {
+		geometry.bounds.position = mi.data.points[0];
+	}
+
+	for (int i = 0; i < mi.data.points.size(); i += 3) {
+		Vector3 vtxs[3] = { mi.data.points[i + 0], mi.data.points[i + 1], mi.data.points[i + 2] };
+		Vector2 uvs[3] = { mi.data.uv2[i + 0] * uv_scale + uv_offset, mi.data.uv2[i + 1] * uv_scale + uv_offset, mi.data.uv2[i + 2] * uv_scale + uv_offset };
+		Vector3 normal[3] = { mi.data.normal[i + 0], mi.data.normal[i + 1], mi.data.normal[i + 2] };
+
+		AABB taabb;
+		Triangle t;
+		t.slice = mi.slice;
+		for (int k = 0; k < 3; k++) {
+			geometry.bounds.expand_to(vtxs[k]);
+
+			Vertex v;
+			v.position[0] = vtxs[k].x;
+			v.position[1] = vtxs[k].y;
+			v.position[2] = vtxs[k].z;
+			v.uv[0] = uvs[k].x;
+			v.uv[1] = uvs[k].y;
+			v.normal_xy[0] = normal[k].x;
+			v.normal_xy[1] = normal[k].y;
+			v.normal_z = normal[k].z;
+
+			// Local index, remapped to the shared vertex array when merging.
+			t.indices[k] = geometry.vertices.size();
+			geometry.vertices.push_back(v);
+
+			if (k == 0) {
+				taabb.position = vtxs[k];
+			} else {
+				taabb.expand_to(vtxs[k]);
+			}
+		}
 
-	//fill triangles array and vertex array
-	LocalVector<Triangle> triangles;
-	LocalVector<Vertex> vertex_array;
-	LocalVector<Seam> seams;
+		//compute seams that will need to be blended later
+		for (int k = 0; k < 3; k++) {
+			int n = (k + 1) % 3;
 
-	slice_triangle_count.resize(atlas_slices);
-	slice_seam_count.resize(atlas_slices);
+			Edge edge(vtxs[k], vtxs[n], normal[k], normal[n]);
+			Vector2i edge_indices(t.indices[k], t.indices[n]);
+			EdgeUV2 uv2(uvs[k], uvs[n], edge_indices);
 
-	for (int i = 0; i < atlas_slices; i++) {
-		slice_triangle_count.write[i] = 0;
-		slice_seam_count.write[i] = 0;
-	}
+			if (edge.b == edge.a) {
+				continue; //degenerate, somehow
+			}
+			if (edge.b < edge.a) {
+				SWAP(edge.a, edge.b);
+				SWAP(edge.na, edge.nb);
+				SWAP(uv2.a, uv2.b);
+				SWAP(uv2.indices.x, uv2.indices.y);
+				SWAP(edge_indices.x, edge_indices.y);
+			}
 
-	bounds = AABB();
+			EdgeUV2 *euv2 = edges.getptr(edge);
+			if (!euv2) {
+				edges[edge] = uv2;
+			} else {
+				if (*euv2 == uv2) {
+					continue; // seam shared UV space, no need to blend
+				}
+				if (euv2->seam_found) {
+					continue; //bad geometry
+				}
 
-	for (int m_i = 0; m_i < mesh_instances.size(); m_i++) {
-		if (p_step_function) {
-			float p = float(m_i + 1) / MAX(1, mesh_instances.size()) * 0.1;
-			p_step_function(0.3 + p, vformat(RTR("Plotting mesh into acceleration structure %d/%d"), m_i + 1, mesh_instances.size()), p_bake_userdata, false);
+				Seam seam;
+				seam.a = edge_indices;
+				seam.b = euv2->indices;
+				seam.slice = mi.slice;
+				geometry.seams.push_back(seam);
+				euv2->seam_found = true;
+			}
 		}
 
-		HashMap<Edge, EdgeUV2, EdgeHash> edges;
+		t.min_bounds[0] = taabb.position.x;
+		t.min_bounds[1] = taabb.position.y;
+		t.min_bounds[2] = taabb.position.z;
+		t.max_bounds[0] = taabb.position.x + MAX(taabb.size.x, 0.0001);
+		t.max_bounds[1] = taabb.position.y + MAX(taabb.size.y, 0.0001);
+		t.max_bounds[2] = taabb.position.z + MAX(taabb.size.z, 0.0001);
+		t.pad0 = t.pad1 = 0; //make valgrind not complain
+		geometry.triangles.push_back(t);
+	}
+}
 
-		MeshInstance &mi = mesh_instances.write[m_i];
+void LightmapperRD::_gather_geometry(const Size2i &p_atlas_size, bool p_use_threads, LocalVector<Vertex> &r_vertex_array, LocalVector<Triangle> &r_triangles, LocalVector<Seam> &r_seams, AABB &r_bounds) {
+	LocalVector<MeshGeometry> mesh_geometry;
+	mesh_geometry.resize(mesh_instances.size());
+	for (int m_i = 0; m_i < mesh_instances.size(); m_i++) {
+		const MeshInstance &mi = mesh_instances[m_i];
+		mesh_geometry[m_i].uv_scale = Vector2(mi.data.albedo_on_uv2->get_width(), mi.data.albedo_on_uv2->get_height()) / Vector2(p_atlas_size);
+		mesh_geometry[m_i].uv_offset = Vector2(mi.offset) / Vector2(p_atlas_size);
+	}
 
-		Vector2 uv_scale = Vector2(mi.data.albedo_on_uv2->get_width(), mi.data.albedo_on_uv2->get_height()) / Vector2(atlas_size);
-		Vector2 uv_offset = Vector2(mi.offset) / Vector2(atlas_size);
-		if (m_i == 0) {
-			bounds.position = mi.data.points[0];
+	if (p_use_threads) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &LightmapperRD::_gather_mesh_geometry, mesh_geometry.ptr(), mesh_geometry.size(), -1, true, SNAME("LightmapperGatherMeshes"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t m_i = 0; m_i < mesh_geometry.size(); m_i++) {
+			_gather_mesh_geometry(m_i, mesh_geometry.ptr());
 		}
+	}
 
-		for (int i = 0; i < mi.data.points.size(); i += 3) {
-			Vector3 vtxs[3] = { mi.data.points[i + 0], mi.data.points[i + 1], mi.data.points[i + 2] };
-			Vector2 uvs[3] = { mi.data.uv2[i + 0] * uv_scale + uv_offset, mi.data.uv2[i + 1] * uv_scale + uv_offset, mi.data.uv2[i + 2] * uv_scale + uv_offset };
-			Vector3 normal[3] = { mi.data.normal[i + 0], mi.data.normal[i + 1], mi.data.normal[i + 2] };
+	// Merge in mesh order, so the result does not depend on scheduling.
+	HashMap<Vertex, uint32_t, VertexHash> vertex_map;
 
-			AABB taabb;
-			Triangle t;
-			t.slice = mi.slice;
-			for (int k = 0; k < 3; k++) {
-				bounds.expand_to(vtxs[k]);
-
-				Vertex v;
-				v.position[0] = vtxs[k].x;
-				v.position[1] = vtxs[k].y;
-				v.position[2] = vtxs[k].z;
-				v.uv[0] = uvs[k].x;
-				v.uv[1] = uvs[k].y;
-				v.normal_xy[0] = normal[k].x;
-				v.normal_xy[1] = normal[k].y;
-				v.normal_z = normal[k].z;
-
-				uint32_t *indexptr = vertex_map.getptr(v);
-
-				if (indexptr) {
-					t.indices[k] = *indexptr;
-				} else {
-					uint32_t new_index = vertex_map.size();
-					t.indices[k] = new_index;
-					vertex_map[v] = new_index;
-					vertex_array.push_back(v);
-				}
+	bool bounds_set = false;
+	LocalVector<uint32_t> vertex_remap;
+	for (uint32_t m_i = 0; m_i < mesh_geometry.size(); m_i++) {
+		MeshGeometry &geometry = mesh_geometry[m_i];
+		if (geometry.triangles.is_empty()) {
+			continue;
+		}
 
-				if (k == 0) {
-					taabb.position = vtxs[k];
-				} else {
-					taabb.expand_to(vtxs[k]);
-				}
+		if (!bounds_set) {
+			r_bounds = geometry.bounds;
+			bounds_set = true;
+		} else {
+			r_bounds.merge_with(geometry.bounds);
+		}
+
+		vertex_remap.resize(geometry.vertices.size());
+		for (uint32_t i = 0; i < geometry.vertices.size(); i++) {
+			const Vertex &v = geometry.vertices[i];
+			uint32_t *indexptr = vertex_map.getptr(v);
+
+			if (indexptr) {
+				vertex_remap[i] = *indexptr;
+			} else {
+				uint32_t new_index = vertex_map.size();
+				vertex_remap[i] = new_index;
+				vertex_map[v] = new_index;
+				r_vertex_array.push_back(v);
 			}
+		}
 
-			//compute seams that will need to be blended later
+		for (Triangle &t : geometry.triangles) {
 			for (int k = 0; k < 3; k++) {
-				int n = (k + 1) % 3;
+				t.indices[k] = vertex_remap[t.indices[k]];
+			}
+			r_triangles.push_back(t);
+		}
 
-				Edge edge(vtxs[k], vtxs[n], normal[k], normal[n]);
-				Vector2i edge_indices(t.indices[k], t.indices[n]);
-				EdgeUV2 uv2(uvs[k], uvs[n], edge_indices);
+		for (Seam &seam : geometry.seams) {
+			seam.a = Vector2i(vertex_remap[seam.a.x], vertex_remap[seam.a.y]);
+			seam.b = Vector2i(vertex_remap[seam.b.x], vertex_remap[seam.b.y]);
+			r_seams.push_back(seam);
+		}
 
-				if (edge.b == edge.a) {
-					continue; //degenerate, somehow
-				}
-				if (edge.b < edge.a) {
-					SWAP(edge.a, edge.b);
-					SWAP(edge.na, edge.nb);
-					SWAP(uv2.a, uv2.b);
-					SWAP(uv2.indices.x, uv2.indices.y);
-					SWAP(edge_indices.x, edge_indices.y);
-				}
+		// Not needed anymore, release it early as the scene may be large.
+		geometry = MeshGeometry();
+	}
+}
 
-				EdgeUV2 *euv2 = edges.getptr(edge);
-				if (!euv2) {
-					edges[edge] = uv2;
-				} else {
-					if (*euv2 == uv2) {
-						continue; // seam shared UV space, no need to blend
-					}
-					if (euv2->seam_found) {
-						continue; //bad geometry
-					}
+void LightmapperRD::_plot_triangle_chunk(uint32_t p_chunk, TrianglePlotData *p_data) {
+	const LocalVector<Triangle> &triangles = *p_data->triangles;
+	const LocalVector<Vertex> &vertex_array = *p_data->vertices;
+	LocalVector<TriangleSort> &triangle_sort = p_data->chunks[p_chunk];
 
-					Seam seam;
-					seam.a = edge_indices;
-					seam.b = euv2->indices;
-					seam.slice = mi.slice;
-					seams.push_back(seam);
-					slice_seam_count.write[mi.slice]++;
-					euv2->seam_found = true;
-				}
-			}
+	uint32_t from = p_chunk * p_data->chunk_size;
+	uint32_t to = MIN(from + p_data->chunk_size, triangles.size());
+	for (uint32_t i = from; i < to; i++) {
+		const Triangle &t = triangles[i];
+		Vector3 face[3] = {
+			Vector3(vertex_array[t.indices[0]].position[0], vertex_array[t.indices[0]].position[1], vertex_array[t.indices[0]].position[2]),
+			Vector3(vertex_array[t.indices[1]].position[0], vertex_array[t.indices[1]].position[1], vertex_array[t.indices[1]].position[2]),
+			Vector3(vertex_array[t.indices[2]].position[0], vertex_array[t.indices[2]].position[1], vertex_array[t.indices[2]].position[2])
+		};
+		_plot_triangle_into_triangle_index_list(p_data->grid_size, Vector3i(), p_data->bounds, face, i, triangle_sort, p_data->grid_size);
+	}
+}
 
-			t.min_bounds[0] = taabb.position.x;
-			t.min_bounds[1] = taabb.position.y;
-			t.min_bounds[2] = taabb.position.z;
-			t.max_bounds[0] = taabb.position.x + MAX(taabb.size.x, 0.0001);
-			t.max_bounds[1] = taabb.position.y + MAX(taabb.size.y, 0.0001);
-			t.max_bounds[2] = taabb.position.z + MAX(taabb.size.z, 0.0001);
-			t.pad0 = t.pad1 = 0; //make valgrind not complain
-			triangles.push_back(t);
-			slice_triangle_count.write[t.slice]++;
-		}
+void LightmapperRD::_build_cell_clusters(uint32_t p_cell, ClusterBuildData *p_data) {
+	// Cells own disjoint ranges of triangles and clusters, so they can be built in parallel.
+	const ClusterCell &cell = p_data->cells[p_cell];
+	_sort_triangle_clusters(p_data->cluster_size, cell.cluster_index, cell.index_start, cell.triangle_count, *p_data->triangle_sort, *p_data->cluster_aabbs);
+
+	const LocalVector<TriangleSort> &triangle_sort = *p_data->triangle_sort;
+	for (uint32_t j = 0; j < cell.triangle_count; j++) {
+		p_data->triangle_indices[cell.index_start + j] = triangle_sort[cell.index_start + j].triangle_index;
+	}
+}
+
+void LightmapperRD::_create_acceleration_structures(RenderingDevice *rd, Size2i atlas_size, int atlas_slices, AABB &bounds, int grid_size, uint32_t p_cluster_size, Vector<Probe> &p_probe_positions, GenerateProbes p_generate_probes, Vector<int> &slice_triangle_count, Vector<int> &slice_seam_count, RID &vertex_buffer, RID &triangle_buffer, RID &lights_buffer, RID &r_triangle_indices_buffer, RID &r_cluster_indices_buffer, RID &r_cluster_aabbs_buffer, RID &probe_positions_buffer, RID &grid_texture, RID &seams_buffer, BakeStepFunc p_step_function, void *p_bake_userdata) {
+	//fill triangles array and vertex array
+	LocalVector<Triangle> triangles;
+	LocalVector<Vertex> vertex_array;
+	LocalVector<Seam> seams;
+
+	slice_triangle_count.resize(atlas_slices);
+	slice_seam_count.resize(atlas_slices);
+
+	for (int i = 0; i < atlas_slices; i++) {
+		slice_triangle_count.write[i] = 0;
+		slice_seam_count.write[i] = 0;
+	}
+
+	bounds = AABB();
+
+	if (p_step_function) {
+		p_step_function(0.3, RTR("Plotting meshes into acceleration structure"), p_bake_userdata, false);
+	}
+
+	_gather_geometry(atlas_size, true, vertex_array, triangles, seams, bounds);
+	for (const Triangle &t : triangles) {
+		slice_triangle_count.write[t.slice]++;
+	}
+	for (const Seam &seam : seams) {
+		slice_seam_count.write[seam.slice]++;
 	}
 
 	//also consider probe positions for bounds
@@ -489,14 +587,30 @@ void LightmapperRD::_create_acceleration_structures(RenderingDevice *rd, Size2i
 
 	//fill list of triangles in grid
 	LocalVector<TriangleSort> triangle_sort;
-	for (uint32_t i = 0; i < triangles.size(); i++) {
-		const Triangle &t = triangles[i];
-		Vector3 face[3] = {
-			Vector3(vertex_array[t.indices[0]].position[0], vertex_array[t.indices[0]].position[1], vertex_array[t.indices[0]].position[2]),
-			Vector3(vertex_array[t.indices[1]].position[0], vertex_array[t.indices[1]].position[1], vertex_array[t.indices[1]].position[2]),
-			Vector3(vertex_array[t.indices[2]].position[0], vertex_array[t.indices[2]].position[1], vertex_array[t.indices[2]].position[2])
-		};
-		_plot_triangle_into_triangle_index_list(grid_size, Vector3i(), bounds, face, i, triangle_sort, grid_size);
+	{
+		TrianglePlotData plot_data;
+		plot_data.triangles = &triangles;
+		plot_data.vertices = &vertex_array;
+		plot_data.bounds = bounds;
+		plot_data.grid_size = grid_size;
+		plot_data.chunk_size = 1024;
+		plot_data.chunks.resize((triangles.size() + plot_data.chunk_size - 1) / plot_data.chunk_size);
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &LightmapperRD::_plot_triangle_chunk, &plot_data, plot_data.chunks.size(), -1, true, SNAME("LightmapperPlotTriangles"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		uint32_t triangle_sort_count = 0;
+		for (const LocalVector<TriangleSort> &chunk : plot_data.chunks) {
+			triangle_sort_count += chunk.size();
+		}
+		triangle_sort.resize(triangle_sort_count);
+		uint32_t offset = 0;
+		for (const LocalVector<TriangleSort> &chunk : plot_data.chunks) {
+			for (uint32_t i = 0; i < chunk.size(); i++) {
+				triangle_sort[offset + i] = chunk[i];
+			}
+			offset += chunk.size();
+		}
 	}
 	//sort it
 	triangle_sort.sort();
@@ -544,10 +658,12 @@ void LightmapperRD::_create_acceleration_structures(RenderingDevice *rd, Size2i
 		cluster_indices.resize(solid_cell_count * 2);
 		cluster_aabbs.resize(cluster_count);
 
+		LocalVector<ClusterCell> cells;
+		cells.resize(solid_cell_count);
+
 		uint32_t i = 0;
 		uint32_t cluster_index = 0;
 		uint32_t solid_cell_index = 0;
-		uint32_t *tiw = triangle_indices.ptrw();
 		while (i < triangle_sort.size()) {
 			cluster_indices[solid_cell_index * 2] = cluster_index;
 			cluster_indices[solid_cell_index * 2 + 1] = i;
@@ -555,16 +671,24 @@ void LightmapperRD::_create_acceleration_structures(RenderingDevice *rd, Size2i
 			uint32_t cell = triangle_sort[i].cell_index;
 			uint32_t triangle_count = giw[cell * 2];
 			uint32_t cell_cluster_count = (triangle_count + p_cluster_size - 1) / p_cluster_size;
-			_sort_triangle_clusters(p_cluster_size, cluster_index, i, triangle_count, triangle_sort, cluster_aabbs);
-
-			for (uint32_t j = 0; j < triangle_count; j++) {
-				tiw[i + j] = triangle_sort[i + j].triangle_index;
-			}
+			cells[solid_cell_index].index_start = i;
+			cells[solid_cell_index].triangle_count = triangle_count;
+			cells[solid_cell_index].cluster_index = cluster_index;
 
 			i += triangle_count;
 			cluster_index += cell_cluster_count;
 			solid_cell_index++;
 		}
+
+		ClusterBuildData cluster_data;
+		cluster_data.cluster_size = p_cluster_size;
+		cluster_data.cells = cells.ptr();
+		cluster_data.triangle_sort = &triangle_sort;
+		cluster_data.cluster_aabbs = &cluster_aabbs;
+		cluster_data.triangle_indices = triangle_indices.ptrw();
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &LightmapperRD::_build_cell_clusters, &cluster_data, cells.size(), -1, true, SNAME("LightmapperBuildClusters"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 	}
 #if 0
 	for (int i = 0; i < grid_size; i++) {
@@ -790,9 +914,8 @@ LightmapperRD::BakeError LightmapperRD::_dilate(RenderingDevice *rd, Ref<RDShade
 	return BAKE_OK;
 }
 
-Error LightmapperRD::_store_pfm(RenderingDevice *p_rd, RID p_atlas_tex, int p_index, const Size2i &p_atlas_size, const String &p_name) {
-	Vector<uint8_t> data = p_rd->texture_get_data(p_atlas_tex, p_index);
-	Ref<Image> img = Image::create_from_data(p_atlas_size.width, p_atlas_size.height, false, Image::FORMAT_RGBAH, data);
+Error LightmapperRD::_store_pfm(const Vector<uint8_t> &p_data, const Size2i &p_atlas_size, const String &p_name) {
+	Ref<Image> img = Image::create_from_data(p_atlas_size.width, p_atlas_size.height, false, Image::FORMAT_RGBAH, p_data);
 	img->convert(Image::FORMAT_RGBF);
 	Vector<uint8_t> data_float = img->get_data();
 
@@ -849,19 +972,80 @@ Ref<Image> LightmapperRD::_read_pfm(const String &p_name) {
 	return img;
 }
 
+void LightmapperRD::_store_pfm_threaded(uint32_t p_index, DenoiseFileData *p_data) {
+	DenoiseFile &file = p_data->files[p_index];
+	file.error = _store_pfm(file.data, p_data->atlas_size, file.path);
+	file.data = Vector<uint8_t>();
+}
+
+void LightmapperRD::_read_pfm_threaded(uint32_t p_index, DenoiseFileData *p_data) {
+	DenoiseFile &file = p_data->files[p_index];
+	Ref<Image> img = _read_pfm(file.path);
+	if (img.is_null()) {
+		file.error = ERR_FILE_CORRUPT;
+		return;
+	}
+
+	Vector<uint8_t> new_data = img->get_data();
+	img.unref(); // Avoid copy on write.
+
+	// Keep the alpha channel of the source layer.
+	uint32_t count = file.alpha_source.size() / 2;
+	const uint16_t *src = (const uint16_t *)file.alpha_source.ptr();
+	uint16_t *dst = (uint16_t *)new_data.ptrw();
+	for (uint32_t k = 0; k < count; k += 4) {
+		dst[k + 3] = src[k + 3];
+	}
+
+	file.data = new_data;
+	file.alpha_source = Vector<uint8_t>();
+}
+
 LightmapperRD::BakeError LightmapperRD::_denoise_oidn(RenderingDevice *p_rd, RID p_source_light_tex, RID p_source_normal_tex, RID p_dest_light_tex, const Size2i &p_atlas_size, int p_atlas_slices, bool p_bake_sh, const String &p_exe) {
 	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
 
+	const int layer_count = p_bake_sh ? 4 : 1;
+
+	DenoiseFileData file_data;
+	file_data.atlas_size = p_atlas_size;
+
 	for (int i = 0; i < p_atlas_slices; i++) {
+		// Texture data has to be read on this thread, but encoding and writing the files for
+		// the normal and light layers of the slice happens in parallel.
+		LocalVector<DenoiseFile> input_files;
+		input_files.resize(1 + layer_count);
+
 		String fname_norm_in = EditorPaths::get_singleton()->get_cache_dir().path_join(vformat("temp_norm_%d.pfm", i));
-		_store_pfm(p_rd, p_source_normal_tex, i, p_atlas_size, fname_norm_in);
+		input_files[0].path = fname_norm_in;
+		input_files[0].data = p_rd->texture_get_data(p_source_normal_tex, i);
 
-		for (int j = 0; j < (p_bake_sh ? 4 : 1); j++) {
-			int index = i * (p_bake_sh ? 4 : 1) + j;
-			String fname_light_in = EditorPaths::get_singleton()->get_cache_dir().path_join(vformat("temp_light_%d.pfm", index));
-			String fname_out = EditorPaths::get_singleton()->get_cache_dir().path_join(vformat("temp_denoised_%d.pfm", index));
+		for (int j = 0; j < layer_count; j++) {
+			int index = i * layer_count + j;
+			input_files[1 + j].path = EditorPaths::get_singleton()->get_cache_dir().path_join(vformat("temp_light_%d.pfm", index));
+			input_files[1 + j].data = p_rd->texture_get_data(p_source_light_tex, index);
+		}
+
+		file_data.files = input_files.ptr();
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &LightmapperRD::_store_pfm_threaded, &file_data, input_files.size(), -1, true, SNAME("LightmapperStoreDenoiserInput"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (const DenoiseFile &file : input_files) {
+			if (file.error != OK) {
+				for (const DenoiseFile &remove_file : input_files) {
+					da->remove(remove_file.path);
+				}
+				ERR_FAIL_V_MSG(BAKE_ERROR_LIGHTMAP_CANT_PRE_BAKE_MESHES, vformat("Can't save denoiser input at path: '%s'.", file.path));
+			}
+		}
 
-			_store_pfm(p_rd, p_source_light_tex, index, p_atlas_size, fname_light_in);
+		// OIDN already uses every core, so the layers are denoised one at a time.
+		LocalVector<DenoiseFile> output_files;
+		output_files.resize(layer_count);
+
+		for (int j = 0; j < layer_count; j++) {
+			int index = i * layer_count + j;
+			String fname_light_in = input_files[1 + j].path;
+			String fname_out = EditorPaths::get_singleton()->get_cache_dir().path_join(vformat("temp_denoised_%d.pfm", index));
 
 			List<String> args;
 			args.push_back("--device");
@@ -888,29 +1072,34 @@ LightmapperRD::BakeError LightmapperRD::_denoise_oidn(RenderingDevice *p_rd, RID
 
 			if (err != OK || exitcode != 0) {
 				da->remove(fname_out);
+				for (int k = 0; k < j; k++) {
+					da->remove(output_files[k].path);
+				}
+				for (int k = j + 1; k < layer_count; k++) {
+					da->remove(input_files[1 + k].path);
+				}
+				da->remove(fname_norm_in);
 				print_verbose(str);
 				ERR_FAIL_V_MSG(BAKE_ERROR_LIGHTMAP_CANT_PRE_BAKE_MESHES, vformat("OIDN denoiser failed, return code: %d", exitcode));
 			}
 
-			Ref<Image> img = _read_pfm(fname_out);
-			da->remove(fname_out);
-
-			ERR_FAIL_COND_V(img.is_null(), BAKE_ERROR_LIGHTMAP_CANT_PRE_BAKE_MESHES);
+			output_files[j].path = fname_out;
+			output_files[j].alpha_source = p_rd->texture_get_data(p_source_light_tex, index);
+		}
+		da->remove(fname_norm_in);
 
-			Vector<uint8_t> old_data = p_rd->texture_get_data(p_source_light_tex, index);
-			Vector<uint8_t> new_data = img->get_data();
-			img.unref(); // Avoid copy on write.
+		file_data.files = output_files.ptr();
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &LightmapperRD::_read_pfm_threaded, &file_data, output_files.size(), -1, true, SNAME("LightmapperReadDenoiserOutput"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-			uint32_t count = old_data.size() / 2;
-			const uint16_t *src = (const uint16_t *)old_data.ptr();
-			uint16_t *dst = (uint16_t *)new_data.ptrw();
-			for (uint32_t k = 0; k < count; k += 4) {
-				dst[k + 3] = src[k + 3];
-			}
+		for (const DenoiseFile &file : output_files) {
+			da->remove(file.path);
+		}
 
-			p_rd->texture_update(p_dest_light_tex, index, new_data);
+		for (int j = 0; j < layer_count; j++) {
+			ERR_FAIL_COND_V(output_files[j].error != OK, BAKE_ERROR_LIGHTMAP_CANT_PRE_BAKE_MESHES);
+			p_rd->texture_update(p_dest_light_tex, i * layer_count + j, output_files[j].data);
 		}
-		da->remove(fname_norm_in);
 	}
 	return BAKE_OK;
 }
@@ -40,6 +40,8 @@ class RDShaderFile;
 class LightmapperRD : public Lightmapper {
 	GDCLASS(LightmapperRD, Lightmapper)
 
+	friend class TestLightmapperRDInternalsAccessor;
+
 	struct BakeParameters {
 		float world_size[3] = {};
 		float bias = 0.0;
@@ -220,6 +222,48 @@ class LightmapperRD : public Lightmapper {
 		}
 	};
 
+	// Triangles, vertices and seams of a single mesh instance, gathered on the worker
+	// threads. Triangle and seam indices refer to this mesh's vertices until merged.
+	struct MeshGeometry {
+		Vector2 uv_scale;
+		Vector2 uv_offset;
+		LocalVector<Vertex> vertices;
+		LocalVector<Triangle> triangles;
+		LocalVector<Seam> seams;
+		AABB bounds;
+	};
+
+	struct TrianglePlotData {
+		const LocalVector<Triangle> *triangles = nullptr;
+		const LocalVector<Vertex> *vertices = nullptr;
+		AABB bounds;
+		int grid_size = 0;
+		uint32_t chunk_size = 0;
+		LocalVector<LocalVector<TriangleSort>> chunks;
+	};
+
+	struct ClusterCell {
+		uint32_t index_start = 0;
+		uint32_t triangle_count = 0;
+		uint32_t cluster_index = 0;
+	};
+
+	struct ClusterBuildData {
+		uint32_t cluster_size = 0;
+		const ClusterCell *cells = nullptr;
+		LocalVector<TriangleSort> *triangle_sort = nullptr;
+		LocalVector<ClusterAABB> *cluster_aabbs = nullptr;
+		uint32_t *triangle_indices = nullptr;
+	};
+
+	void _gather_mesh_geometry(uint32_t p_mesh_index, MeshGeometry *p_geometry);
+	// Fills the deduplicated vertex array, the triangles and the UV2 seams of all the mesh
+	// instances. Meshes are gathered on the worker threads when p_use_threads is set, and
+	// merged in mesh order either way.
+	void _gather_geometry(const Size2i &p_atlas_size, bool p_use_threads, LocalVector<Vertex> &r_vertex_array, LocalVector<Triangle> &r_triangles, LocalVector<Seam> &r_seams, AABB &r_bounds);
+	void _plot_triangle_chunk(uint32_t p_chunk, TrianglePlotData *p_data);
+	void _build_cell_clusters(uint32_t p_cell, ClusterBuildData *p_data);
+
 	void _plot_triangle_into_triangle_index_list(int p_size, const Vector3i &p_ofs, const AABB &p_bounds, const Vector3 p_points[3], uint32_t p_triangle_index, LocalVector<TriangleSort> &triangles, uint32_t p_grid_size);
 	void _sort_triangle_clusters(uint32_t p_cluster_size, uint32_t p_cluster_index, uint32_t p_index_start, uint32_t p_count, LocalVector<TriangleSort> &p_triangle_sort, LocalVector<ClusterAABB> &p_cluster_aabb);
 
@@ -274,7 +318,23 @@ class LightmapperRD : public Lightmapper {
 	BakeError _dilate(RenderingDevice *rd, Ref<RDShaderFile> &compute_shader, RID &compute_base_uniform_set, PushConstant &push_constant, RID &source_light_tex, RID &dest_light_tex, const Size2i &atlas_size, int atlas_slices);
 	BakeError _denoise(RenderingDevice *p_rd, Ref<RDShaderFile> &p_compute_shader, const RID &p_compute_base_uniform_set, PushConstant &p_push_constant, RID p_source_light_tex, RID p_source_normal_tex, RID p_dest_light_tex, float p_denoiser_strength, int p_denoiser_range, const Size2i &p_atlas_size, int p_atlas_slices, bool p_bake_sh, BakeStepFunc p_step_function);
 
-	Error _store_pfm(RenderingDevice *p_rd, RID p_atlas_tex, int p_index, const Size2i &p_atlas_size, const String &p_name);
+	// Layers passed to and from the OIDN executable, encoded and decoded on the worker threads.
+	struct DenoiseFile {
+		String path;
+		Vector<uint8_t> data;
+		Vector<uint8_t> alpha_source;
+		Error error = OK;
+	};
+
+	struct DenoiseFileData {
+		DenoiseFile *files = nullptr;
+		Size2i atlas_size;
+	};
+
+	void _store_pfm_threaded(uint32_t p_index, DenoiseFileData *p_data);
+	void _read_pfm_threaded(uint32_t p_index, DenoiseFileData *p_data);
+
+	Error _store_pfm(const Vector<uint8_t> &p_data, const Size2i &p_atlas_size, const String &p_name);
 	Ref<Image> _read_pfm(const String &p_name);
 	BakeError _denoise_oidn(RenderingDevice *p_rd, RID p_source_light_tex, RID p_source_normal_tex, RID p_dest_light_tex, const Size2i &p_atlas_size, int p_atlas_slices, bool p_bake_sh, const String &p_exe);
 
@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*  test_lightmapper_rd.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_LIGHTMAPPER_RD_H
+#define TEST_LIGHTMAPPER_RD_H
+
+#include "../lightmapper_rd.h"
+
+#include "tests/test_macros.h"
+
+class TestLightmapperRDInternalsAccessor {
+public:
+	typedef LightmapperRD::Vertex Vertex;
+	typedef LightmapperRD::Triangle Triangle;
+	typedef LightmapperRD::Seam Seam;
+
+	static void gather_geometry(LightmapperRD *p_lightmapper, const Size2i &p_atlas_size, bool p_use_threads, LocalVector<Vertex> &r_vertex_array, LocalVector<Triangle> &r_triangles, LocalVector<Seam> &r_seams, AABB &r_bounds) {
+		p_lightmapper->_gather_geometry(p_atlas_size, p_use_threads, r_vertex_array, r_triangles, r_seams, r_bounds);
+	}
+};
+
+namespace TestLightmapperRD {
+
+typedef TestLightmapperRDInternalsAccessor Accessor;
+
+// Flat quad made of two triangles. UV2 follows the position, so quads sharing an edge share
+// its vertices. When p_split_uv is set, the second triangle is moved in UV2, making the
+// diagonal a seam.
+static Lightmapper::MeshData make_quad(const Vector3 &p_origin, bool p_split_uv) {
+	const Vector3 corners[4] = { p_origin, p_origin + Vector3(1, 0, 0), p_origin + Vector3(1, 0, 1), p_origin + Vector3(0, 0, 1) };
+	const int indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+	Lightmapper::MeshData mesh;
+	for (int i = 0; i < 6; i++) {
+		const Vector3 &point = corners[indices[i]];
+		Vector2 uv = Vector2(point.x, point.z) * 0.1;
+		if (p_split_uv && i >= 3) {
+			uv += Vector2(0.05, 0);
+		}
+		mesh.points.push_back(point);
+		mesh.uv2.push_back(uv);
+		mesh.normal.push_back(Vector3(0, 1, 0));
+	}
+	mesh.albedo_on_uv2 = Image::create_empty(4, 4, false, Image::FORMAT_RGBA8);
+	mesh.emission_on_uv2 = Image::create_empty(4, 4, false, Image::FORMAT_RGBA8);
+	return mesh;
+}
+
+TEST_CASE("[LightmapperRD] Threaded geometry gathering matches the serial path") {
+	Ref<LightmapperRD> lightmapper;
+	lightmapper.instantiate();
+	const int size = 6;
+	for (int z = 0; z < size; z++) {
+		for (int x = 0; x < size; x++) {
+			lightmapper->add_mesh(make_quad(Vector3(x, 0, z), (x + z) % 2 == 0));
+		}
+	}
+
+	const Size2i atlas_size(16, 16);
+	LocalVector<Accessor::Vertex> serial_vertices;
+	LocalVector<Accessor::Triangle> serial_triangles;
+	LocalVector<Accessor::Seam> serial_seams;
+	AABB serial_bounds;
+	Accessor::gather_geometry(lightmapper.ptr(), atlas_size, false, serial_vertices, serial_triangles, serial_seams, serial_bounds);
+
+	REQUIRE(serial_triangles.size() == size * size * 2);
+	CHECK_MESSAGE(serial_vertices.size() < serial_triangles.size() * 3, "Vertices shared between meshes should be merged.");
+	CHECK_MESSAGE(serial_seams.size() == (size * size + 1) / 2, "Each quad with split UV2 should have one seam.");
+	CHECK(serial_bounds.is_equal_approx(AABB(Vector3(), Vector3(size, 0, size))));
+
+	LocalVector<Accessor::Vertex> vertices;
+	LocalVector<Accessor::Triangle> triangles;
+	LocalVector<Accessor::Seam> seams;
+	AABB bounds;
+	Accessor::gather_geometry(lightmapper.ptr(), atlas_size, true, vertices, triangles, seams, bounds);
+
+	CHECK(bounds == serial_bounds);
+
+	REQUIRE(vertices.size() == serial_vertices.size());
+	uint32_t vertex_mismatches = 0;
+	for (uint32_t i = 0; i < vertices.size(); i++) {
+		vertex_mismatches += !(vertices[i] == serial_vertices[i]);
+	}
+	CHECK(vertex_mismatches == 0);
+
+	REQUIRE(triangles.size() == serial_triangles.size());
+	uint32_t triangle_mismatches = 0;
+	for (uint32_t i = 0; i < triangles.size(); i++) {
+		const Accessor::Triangle &a = triangles[i];
+		const Accessor::Triangle &b = serial_triangles[i];
+		bool same = a.slice == b.slice;
+		for (int k = 0; k < 3; k++) {
+			same = same && a.indices[k] == b.indices[k] && a.min_bounds[k] == b.min_bounds[k] && a.max_bounds[k] == b.max_bounds[k];
+		}
+		triangle_mismatches += !same;
+	}
+	CHECK(triangle_mismatches == 0);
+
+	REQUIRE(seams.size() == serial_seams.size());
+	uint32_t seam_mismatches = 0;
+	for (uint32_t i = 0; i < seams.size(); i++) {
+		seam_mismatches += !(seams[i].a == serial_seams[i].a && seams[i].b == serial_seams[i].b && seams[i].slice == serial_seams[i].slice);
+	}
+	CHECK(seam_mismatches == 0);
+}
+
+} // namespace TestLightmapperRD
+
+#endif // TEST_LIGHTMAPPER_RD_H
@@ -58,6 +58,7 @@ public:
 	static Ref<AudioStreamMP3> import_mp3(const String &p_path);
 
 	virtual Error import(const String &p_source_file, const String &p_save_path, const HashMap<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files = nullptr, Variant *r_metadata = nullptr) override;
+	virtual bool can_use_import_cache(const HashMap<StringName, Variant> &p_options) const override { return true; }
 
 	ResourceImporterMP3();
 };
@@ -235,9 +235,10 @@ void EditorNetworkProfiler::add_sync_frame_data(const SyncInfo &p_frame) {
 	}
 }
 
-void EditorNetworkProfiler::set_bandwidth(int p_incoming, int p_outgoing) {
+void EditorNetworkProfiler::set_bandwidth(int p_incoming, int p_outgoing, int p_rpc_packets_saved) {
 	incoming_bandwidth_text->set_text(vformat(TTR("%s/s"), String::humanize_size(p_incoming)));
 	outgoing_bandwidth_text->set_text(vformat(TTR("%s/s"), String::humanize_size(p_outgoing)));
+	outgoing_bandwidth_text->set_tooltip_text(vformat(TTR("Packets saved by RPC batching: %d/s"), p_rpc_packets_saved));
 
 	// Make labels more prominent when the bandwidth is greater than 0 to attract user attention
 	incoming_bandwidth_text->add_theme_color_override(
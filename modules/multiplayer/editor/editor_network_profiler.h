@@ -109,7 +109,7 @@ public:
 	void add_node_data(const NodeInfo &p_info);
 	void add_rpc_frame_data(const RPCNodeInfo &p_frame);
 	void add_sync_frame_data(const SyncInfo &p_frame);
-	void set_bandwidth(int p_incoming, int p_outgoing);
+	void set_bandwidth(int p_incoming, int p_outgoing, int p_rpc_packets_saved = 0);
 	bool is_profiling();
 
 	EditorNetworkProfiler();
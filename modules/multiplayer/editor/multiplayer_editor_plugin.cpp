@@ -85,7 +85,7 @@ bool MultiplayerEditorDebugger::capture(const String &p_message, const Array &p_
 		return true;
 	} else if (p_message == "multiplayer:bandwidth") {
 		ERR_FAIL_COND_V(p_data.size() < 2, false);
-		profiler->set_bandwidth(p_data[0], p_data[1]);
+		profiler->set_bandwidth(p_data[0], p_data[1], p_data.size() > 2 ? int(p_data[2]) : 0);
 		return true;
 	}
 	return false;
@@ -110,6 +110,7 @@ int MultiplayerDebugger::BandwidthProfiler::bandwidth_usage(const Vector<Bandwid
 }
 
 void MultiplayerDebugger::BandwidthProfiler::toggle(bool p_enable, const Array &p_opts) {
+	rpc_packets_saved = 0;
 	if (!p_enable) {
 		bandwidth_in.clear();
 		bandwidth_out.clear();
@@ -140,12 +141,17 @@ void MultiplayerDebugger::BandwidthProfiler::add(const Array &p_data) {
 		bandwidth_out.write[bandwidth_out_ptr].timestamp = time;
 		bandwidth_out.write[bandwidth_out_ptr].packet_size = size;
 		bandwidth_out_ptr = (bandwidth_out_ptr + 1) % bandwidth_out.size();
+	} else if (inout == "rpc_batch") {
+		rpc_packets_saved += size;
 	}
 }
 
 void MultiplayerDebugger::BandwidthProfiler::tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) {
 	uint64_t pt = OS::get_singleton()->get_ticks_msec();
 	if (pt - last_bandwidth_time > 200) {
+		// Packets saved by RPC batching, per second.
+		int rpc_saved = rpc_packets_saved * 1000 / (pt - last_bandwidth_time);
+		rpc_packets_saved = 0;
 		last_bandwidth_time = pt;
 		int incoming_bandwidth = bandwidth_usage(bandwidth_in, bandwidth_in_ptr);
 		int outgoing_bandwidth = bandwidth_usage(bandwidth_out, bandwidth_out_ptr);
@@ -153,6 +159,7 @@ void MultiplayerDebugger::BandwidthProfiler::tick(double p_frame_time, double p_
 		Array arr;
 		arr.push_back(incoming_bandwidth);
 		arr.push_back(outgoing_bandwidth);
+		arr.push_back(rpc_saved);
 		EngineDebugger::get_singleton()->send_message("multiplayer:bandwidth", arr);
 	}
 }
@@ -90,6 +90,7 @@ private:
 		int bandwidth_out_ptr = 0;
 		Vector<BandwidthFrame> bandwidth_out;
 		uint64_t last_bandwidth_time = 0;
+		int rpc_packets_saved = 0;
 
 		int bandwidth_usage(const Vector<BandwidthFrame> &p_buffer, int p_pointer);
 
@@ -110,6 +110,7 @@ void MultiplayerSynchronizer::reset() {
 	last_watch_usec = 0;
 	sync_started = false;
 	watchers.clear();
+	state_history.clear();
 }
 
 uint32_t MultiplayerSynchronizer::get_net_id() const {
@@ -120,6 +121,11 @@ void MultiplayerSynchronizer::set_net_id(uint32_t p_net_id) {
 	net_id = p_net_id;
 }
 
+bool MultiplayerSynchronizer::is_outbound_sync_due(uint64_t p_usec) const {
+	// Also due when already synced this frame, e.g. to another peer.
+	return last_sync_usec == p_usec || p_usec >= last_sync_usec + sync_interval_usec;
+}
+
 bool MultiplayerSynchronizer::update_outbound_sync_time(uint64_t p_usec) {
 	if (last_sync_usec == p_usec) {
 		// last_sync_usec has been updated in this frame.
@@ -252,6 +258,21 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_delta_interval", "milliseconds"), &MultiplayerSynchronizer::set_delta_interval);
 	ClassDB::bind_method(D_METHOD("get_delta_interval"), &MultiplayerSynchronizer::get_delta_interval);
 
+	ClassDB::bind_method(D_METHOD("set_interest_priority", "priority"), &MultiplayerSynchronizer::set_interest_priority);
+	ClassDB::bind_method(D_METHOD("get_interest_priority"), &MultiplayerSynchronizer::get_interest_priority);
+
+	ClassDB::bind_method(D_METHOD("set_prediction_mode", "mode"), &MultiplayerSynchronizer::set_prediction_mode);
+	ClassDB::bind_method(D_METHOD("get_prediction_mode"), &MultiplayerSynchronizer::get_prediction_mode);
+	ClassDB::bind_method(D_METHOD("set_prediction_input", "path"), &MultiplayerSynchronizer::set_prediction_input);
+	ClassDB::bind_method(D_METHOD("get_prediction_input"), &MultiplayerSynchronizer::get_prediction_input);
+	ClassDB::bind_method(D_METHOD("set_prediction_history_size", "size"), &MultiplayerSynchronizer::set_prediction_history_size);
+	ClassDB::bind_method(D_METHOD("get_prediction_history_size"), &MultiplayerSynchronizer::get_prediction_history_size);
+
+	ClassDB::bind_method(D_METHOD("record_state", "tick"), &MultiplayerSynchronizer::record_state);
+	ClassDB::bind_method(D_METHOD("restore_state", "tick"), &MultiplayerSynchronizer::restore_state);
+	ClassDB::bind_method(D_METHOD("has_recorded_state", "tick"), &MultiplayerSynchronizer::has_recorded_state);
+	ClassDB::bind_method(D_METHOD("clear_state_history"), &MultiplayerSynchronizer::clear_state_history);
+
 	ClassDB::bind_method(D_METHOD("set_replication_config", "config"), &MultiplayerSynchronizer::set_replication_config);
 	ClassDB::bind_method(D_METHOD("get_replication_config"), &MultiplayerSynchronizer::get_replication_config);
 
@@ -273,12 +294,24 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "replication_config", PROPERTY_HINT_RESOURCE_TYPE, "SceneReplicationConfig", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT), "set_replication_config", "get_replication_config");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "visibility_update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,None"), "set_visibility_update_mode", "get_visibility_update_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "public_visibility"), "set_visibility_public", "is_visibility_public");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interest_priority", PROPERTY_HINT_RANGE, "0,100,0.01,or_greater"), "set_interest_priority", "get_interest_priority");
+
+	ADD_GROUP("Prediction", "prediction_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "prediction_mode", PROPERTY_HINT_ENUM, "None,Input,State"), "set_prediction_mode", "get_prediction_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "prediction_input", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "MultiplayerSynchronizer"), "set_prediction_input", "get_prediction_input");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "prediction_history_size", PROPERTY_HINT_RANGE, "1,1024,1,or_greater"), "set_prediction_history_size", "get_prediction_history_size");
 
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_IDLE);
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_PHYSICS);
 	BIND_ENUM_CONSTANT(VISIBILITY_PROCESS_NONE);
 
+	BIND_ENUM_CONSTANT(PREDICTION_NONE);
+	BIND_ENUM_CONSTANT(PREDICTION_INPUT);
+	BIND_ENUM_CONSTANT(PREDICTION_STATE);
+
 	ADD_SIGNAL(MethodInfo("synchronized"));
+	ADD_SIGNAL(MethodInfo("simulate_tick", PropertyInfo(Variant::INT, "tick"), PropertyInfo(Variant::BOOL, "resimulating")));
+	ADD_SIGNAL(MethodInfo("reconciled", PropertyInfo(Variant::INT, "tick")));
 	ADD_SIGNAL(MethodInfo("delta_synchronized"));
 	ADD_SIGNAL(MethodInfo("visibility_changed", PropertyInfo(Variant::INT, "for_peer")));
 }
@@ -327,6 +360,97 @@ double MultiplayerSynchronizer::get_delta_interval() const {
 	return double(delta_interval_usec) / 1000.0 / 1000.0;
 }
 
+void MultiplayerSynchronizer::set_interest_priority(float p_priority) {
+	ERR_FAIL_COND_MSG(p_priority < 0, "Interest priority cannot be negative.");
+	interest_priority = p_priority;
+}
+
+float MultiplayerSynchronizer::get_interest_priority() const {
+	return interest_priority;
+}
+
+void MultiplayerSynchronizer::set_prediction_mode(PredictionMode p_mode) {
+	prediction_mode = p_mode;
+}
+
+MultiplayerSynchronizer::PredictionMode MultiplayerSynchronizer::get_prediction_mode() const {
+	return prediction_mode;
+}
+
+void MultiplayerSynchronizer::set_prediction_input(const NodePath &p_path) {
+	prediction_input = p_path;
+}
+
+NodePath MultiplayerSynchronizer::get_prediction_input() const {
+	return prediction_input;
+}
+
+MultiplayerSynchronizer *MultiplayerSynchronizer::get_prediction_input_synchronizer() const {
+	if (prediction_input.is_empty() || !is_inside_tree()) {
+		return nullptr;
+	}
+	return Object::cast_to<MultiplayerSynchronizer>(get_node_or_null(prediction_input));
+}
+
+void MultiplayerSynchronizer::set_prediction_history_size(int p_size) {
+	ERR_FAIL_COND_MSG(p_size < 1, "Prediction history size must be at least 1.");
+	prediction_history_size = p_size;
+	state_history.clear();
+}
+
+int MultiplayerSynchronizer::get_prediction_history_size() const {
+	return prediction_history_size;
+}
+
+Error MultiplayerSynchronizer::record_state(int64_t p_tick) {
+	ERR_FAIL_COND_V(p_tick < 0, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(replication_config.is_null(), ERR_UNCONFIGURED);
+	Node *node = get_root_node();
+	ERR_FAIL_NULL_V(node, ERR_UNCONFIGURED);
+	Vector<Variant> values;
+	Vector<const Variant *> value_ptrs;
+	Error err = get_state(replication_config->get_sync_properties(), node, values, value_ptrs);
+	ERR_FAIL_COND_V(err != OK, err);
+	store_state(p_tick, values);
+	return OK;
+}
+
+Error MultiplayerSynchronizer::restore_state(int64_t p_tick) {
+	const Vector<Variant> *values = get_recorded_state(p_tick);
+	if (!values) {
+		return ERR_DOES_NOT_EXIST;
+	}
+	ERR_FAIL_COND_V(replication_config.is_null(), ERR_UNCONFIGURED);
+	Node *node = get_root_node();
+	ERR_FAIL_NULL_V(node, ERR_UNCONFIGURED);
+	return set_state(replication_config->get_sync_properties(), node, *values);
+}
+
+bool MultiplayerSynchronizer::has_recorded_state(int64_t p_tick) const {
+	return get_recorded_state(p_tick) != nullptr;
+}
+
+void MultiplayerSynchronizer::clear_state_history() {
+	state_history.clear();
+}
+
+void MultiplayerSynchronizer::store_state(int64_t p_tick, const Vector<Variant> &p_values) {
+	if (state_history.is_empty()) {
+		state_history.resize(prediction_history_size);
+	}
+	StateRecord &record = state_history[p_tick % state_history.size()];
+	record.tick = p_tick;
+	record.values = p_values;
+}
+
+const Vector<Variant> *MultiplayerSynchronizer::get_recorded_state(int64_t p_tick) const {
+	if (state_history.is_empty() || p_tick < 0) {
+		return nullptr;
+	}
+	const StateRecord &record = state_history[p_tick % state_history.size()];
+	return record.tick == p_tick ? &record.values : nullptr;
+}
+
 void MultiplayerSynchronizer::set_replication_config(Ref<SceneReplicationConfig> p_config) {
 	replication_config = p_config;
 }
@@ -45,7 +45,18 @@ public:
 		VISIBILITY_PROCESS_NONE,
 	};
 
+	enum PredictionMode {
+		PREDICTION_NONE,
+		PREDICTION_INPUT,
+		PREDICTION_STATE,
+	};
+
 private:
+	struct StateRecord {
+		int64_t tick = -1;
+		Vector<Variant> values;
+	};
+
 	struct Watcher {
 		NodePath prop;
 		uint64_t last_change_usec = 0;
@@ -57,6 +68,11 @@ private:
 	uint64_t sync_interval_usec = 0;
 	uint64_t delta_interval_usec = 0;
 	VisibilityUpdateMode visibility_update_mode = VISIBILITY_PROCESS_IDLE;
+	float interest_priority = 1.0;
+	PredictionMode prediction_mode = PREDICTION_NONE;
+	NodePath prediction_input;
+	int prediction_history_size = 32;
+	LocalVector<StateRecord> state_history; // Ring buffer indexed by tick.
 	HashSet<Callable> visibility_filters;
 	HashSet<int> peer_visibility;
 	Vector<Watcher> watchers;
@@ -88,6 +104,7 @@ public:
 	uint32_t get_net_id() const;
 	void set_net_id(uint32_t p_net_id);
 
+	bool is_outbound_sync_due(uint64_t p_usec) const;
 	bool update_outbound_sync_time(uint64_t p_usec);
 	bool update_inbound_sync_time(uint16_t p_network_time);
 
@@ -99,6 +116,26 @@ public:
 	void set_delta_interval(double p_interval);
 	double get_delta_interval() const;
 
+	void set_interest_priority(float p_priority);
+	float get_interest_priority() const;
+
+	void set_prediction_mode(PredictionMode p_mode);
+	PredictionMode get_prediction_mode() const;
+
+	void set_prediction_input(const NodePath &p_path);
+	NodePath get_prediction_input() const;
+	MultiplayerSynchronizer *get_prediction_input_synchronizer() const;
+
+	void set_prediction_history_size(int p_size);
+	int get_prediction_history_size() const;
+
+	Error record_state(int64_t p_tick);
+	Error restore_state(int64_t p_tick);
+	bool has_recorded_state(int64_t p_tick) const;
+	void clear_state_history();
+	void store_state(int64_t p_tick, const Vector<Variant> &p_values);
+	const Vector<Variant> *get_recorded_state(int64_t p_tick) const;
+
 	void set_replication_config(Ref<SceneReplicationConfig> p_config);
 	Ref<SceneReplicationConfig> get_replication_config();
 
@@ -125,5 +162,6 @@ public:
 };
 
 VARIANT_ENUM_CAST(MultiplayerSynchronizer::VisibilityUpdateMode);
+VARIANT_ENUM_CAST(MultiplayerSynchronizer::PredictionMode);
 
 #endif // MULTIPLAYER_SYNCHRONIZER_H
@@ -165,6 +165,7 @@ Error SceneMultiplayer::poll() {
 	}
 
 	replicator->on_network_process();
+	rpc->flush_batches();
 	return OK;
 }
 
@@ -174,6 +175,7 @@ void SceneMultiplayer::clear() {
 	connected_peers.clear();
 	packet_cache.clear();
 	replicator->on_reset();
+	rpc->on_reset();
 	cache->clear();
 	relay_buffer->clear();
 }
@@ -259,7 +261,21 @@ _FORCE_INLINE_ Error SceneMultiplayer::_send(const uint8_t *p_packet, int p_pack
 }
 #endif
 
+void SceneMultiplayer::_flush_rpc_batches() {
+	if (!rpc->has_pending_batches()) {
+		return;
+	}
+	// Batches set their own channel and transfer mode, keep the ones of the command about to be sent.
+	const int channel = multiplayer_peer->get_transfer_channel();
+	const MultiplayerPeer::TransferMode mode = multiplayer_peer->get_transfer_mode();
+	rpc->flush_batches();
+	multiplayer_peer->set_transfer_channel(channel);
+	multiplayer_peer->set_transfer_mode(mode);
+}
+
 Error SceneMultiplayer::send_command(int p_to, const uint8_t *p_packet, int p_packet_len) {
+	// Queued RPCs were called first, send them before this command.
+	_flush_rpc_batches();
 	if (server_relay && get_unique_id() != 1 && p_to != 1 && multiplayer_peer->is_server_relay_supported()) {
 		// Send relay packet.
 		relay_buffer->seek(0);
@@ -373,6 +389,7 @@ void SceneMultiplayer::_admit_peer(int p_id) {
 		uint8_t buf[SYS_CMD_SIZE];
 		buf[0] = NETWORK_COMMAND_SYS;
 		buf[1] = SYS_COMMAND_ADD_PEER;
+		_flush_rpc_batches();
 		multiplayer_peer->set_transfer_channel(0);
 		multiplayer_peer->set_transfer_mode(MultiplayerPeer::TRANSFER_MODE_RELIABLE);
 		for (const int &P : connected_peers) {
@@ -410,6 +427,7 @@ void SceneMultiplayer::_del_peer(int p_id) {
 		uint8_t buf[SYS_CMD_SIZE];
 		buf[0] = NETWORK_COMMAND_SYS;
 		buf[1] = SYS_COMMAND_DEL_PEER;
+		_flush_rpc_batches();
 		multiplayer_peer->set_transfer_channel(0);
 		multiplayer_peer->set_transfer_mode(MultiplayerPeer::TRANSFER_MODE_RELIABLE);
 		encode_uint32(p_id, &buf[2]);
@@ -423,6 +441,7 @@ void SceneMultiplayer::_del_peer(int p_id) {
 	}
 
 	replicator->on_peer_change(p_id, false);
+	rpc->on_peer_change(p_id, false);
 	cache->on_peer_change(p_id, false);
 	connected_peers.erase(p_id);
 	emit_signal(SNAME("peer_disconnected"), p_id);
@@ -637,6 +656,74 @@ int SceneMultiplayer::get_max_delta_packet_size() const {
 	return replicator->get_max_delta_packet_size();
 }
 
+void SceneMultiplayer::set_rpc_batching_enabled(bool p_enabled) {
+	rpc->set_batching_enabled(p_enabled);
+}
+
+bool SceneMultiplayer::is_rpc_batching_enabled() const {
+	return rpc->is_batching_enabled();
+}
+
+void SceneMultiplayer::set_max_rpc_batch_size(int p_size) {
+	rpc->set_max_batch_size(p_size);
+}
+
+int SceneMultiplayer::get_max_rpc_batch_size() const {
+	return rpc->get_max_batch_size();
+}
+
+void SceneMultiplayer::set_snapshot_delta_enabled(bool p_enabled) {
+	replicator->set_snapshot_delta_enabled(p_enabled);
+}
+
+bool SceneMultiplayer::is_snapshot_delta_enabled() const {
+	return replicator->is_snapshot_delta_enabled();
+}
+
+void SceneMultiplayer::set_interest_management_enabled(bool p_enabled) {
+	replicator->set_interest_management_enabled(p_enabled);
+}
+
+bool SceneMultiplayer::is_interest_management_enabled() const {
+	return replicator->is_interest_management_enabled();
+}
+
+void SceneMultiplayer::set_interest_cell_size(real_t p_size) {
+	replicator->set_interest_cell_size(p_size);
+}
+
+real_t SceneMultiplayer::get_interest_cell_size() const {
+	return replicator->get_interest_cell_size();
+}
+
+void SceneMultiplayer::set_interest_bandwidth_budget(int p_bytes) {
+	replicator->set_interest_bandwidth_budget(p_bytes);
+}
+
+int SceneMultiplayer::get_interest_bandwidth_budget() const {
+	return replicator->get_interest_bandwidth_budget();
+}
+
+void SceneMultiplayer::set_peer_interest(int p_peer, const Vector3 &p_origin, real_t p_radius) {
+	replicator->set_peer_interest(p_peer, p_origin, p_radius);
+}
+
+void SceneMultiplayer::clear_peer_interest(int p_peer) {
+	replicator->clear_peer_interest(p_peer);
+}
+
+void SceneMultiplayer::set_network_tick_rate(int p_rate) {
+	replicator->set_tick_rate(p_rate);
+}
+
+int SceneMultiplayer::get_network_tick_rate() const {
+	return replicator->get_tick_rate();
+}
+
+int64_t SceneMultiplayer::get_network_tick() const {
+	return replicator->get_network_tick();
+}
+
 void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_path", "path"), &SceneMultiplayer::set_root_path);
 	ClassDB::bind_method(D_METHOD("get_root_path"), &SceneMultiplayer::get_root_path);
@@ -665,6 +752,23 @@ void SceneMultiplayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_max_sync_packet_size", "size"), &SceneMultiplayer::set_max_sync_packet_size);
 	ClassDB::bind_method(D_METHOD("get_max_delta_packet_size"), &SceneMultiplayer::get_max_delta_packet_size);
 	ClassDB::bind_method(D_METHOD("set_max_delta_packet_size", "size"), &SceneMultiplayer::set_max_delta_packet_size);
+	ClassDB::bind_method(D_METHOD("set_rpc_batching_enabled", "enabled"), &SceneMultiplayer::set_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("is_rpc_batching_enabled"), &SceneMultiplayer::is_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("set_max_rpc_batch_size", "size"), &SceneMultiplayer::set_max_rpc_batch_size);
+	ClassDB::bind_method(D_METHOD("get_max_rpc_batch_size"), &SceneMultiplayer::get_max_rpc_batch_size);
+	ClassDB::bind_method(D_METHOD("set_snapshot_delta_enabled", "enabled"), &SceneMultiplayer::set_snapshot_delta_enabled);
+	ClassDB::bind_method(D_METHOD("is_snapshot_delta_enabled"), &SceneMultiplayer::is_snapshot_delta_enabled);
+	ClassDB::bind_method(D_METHOD("set_interest_management_enabled", "enabled"), &SceneMultiplayer::set_interest_management_enabled);
+	ClassDB::bind_method(D_METHOD("is_interest_management_enabled"), &SceneMultiplayer::is_interest_management_enabled);
+	ClassDB::bind_method(D_METHOD("set_interest_cell_size", "size"), &SceneMultiplayer::set_interest_cell_size);
+	ClassDB::bind_method(D_METHOD("get_interest_cell_size"), &SceneMultiplayer::get_interest_cell_size);
+	ClassDB::bind_method(D_METHOD("set_interest_bandwidth_budget", "bytes"), &SceneMultiplayer::set_interest_bandwidth_budget);
+	ClassDB::bind_method(D_METHOD("get_interest_bandwidth_budget"), &SceneMultiplayer::get_interest_bandwidth_budget);
+	ClassDB::bind_method(D_METHOD("set_peer_interest", "peer", "origin", "radius"), &SceneMultiplayer::set_peer_interest);
+	ClassDB::bind_method(D_METHOD("clear_peer_interest", "peer"), &SceneMultiplayer::clear_peer_interest);
+	ClassDB::bind_method(D_METHOD("set_network_tick_rate", "rate"), &SceneMultiplayer::set_network_tick_rate);
+	ClassDB::bind_method(D_METHOD("get_network_tick_rate"), &SceneMultiplayer::get_network_tick_rate);
+	ClassDB::bind_method(D_METHOD("get_network_tick"), &SceneMultiplayer::get_network_tick);
 
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY(PropertyInfo(Variant::CALLABLE, "auth_callback"), "set_auth_callback", "get_auth_callback");
@@ -674,6 +778,13 @@ void SceneMultiplayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_sync_packet_size"), "set_max_sync_packet_size", "get_max_sync_packet_size");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_delta_packet_size"), "set_max_delta_packet_size", "get_max_delta_packet_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "rpc_batching_enabled"), "set_rpc_batching_enabled", "is_rpc_batching_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_rpc_batch_size", PROPERTY_HINT_RANGE, "128,32767,1,suffix:B"), "set_max_rpc_batch_size", "get_max_rpc_batch_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "snapshot_delta_enabled"), "set_snapshot_delta_enabled", "is_snapshot_delta_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "interest_management_enabled"), "set_interest_management_enabled", "is_interest_management_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interest_cell_size", PROPERTY_HINT_RANGE, "0.01,1024,0.01,or_greater"), "set_interest_cell_size", "get_interest_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "interest_bandwidth_budget", PROPERTY_HINT_RANGE, "0,65535,1,or_greater,suffix:B"), "set_interest_bandwidth_budget", "get_interest_bandwidth_budget");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "network_tick_rate", PROPERTY_HINT_RANGE, "0,240,1,or_greater,suffix:Hz"), "set_network_tick_rate", "get_network_tick_rate");
 
 	ADD_PROPERTY_DEFAULT("refuse_new_connections", false);
 
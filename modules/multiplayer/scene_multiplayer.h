@@ -148,6 +148,7 @@ protected:
 	void _admit_peer(int p_id);
 	void _del_peer(int p_id);
 	void _update_status();
+	void _flush_rpc_batches();
 
 public:
 	virtual void set_multiplayer_peer(const Ref<MultiplayerPeer> &p_peer) override;
@@ -201,6 +202,31 @@ public:
 	void set_max_delta_packet_size(int p_size);
 	int get_max_delta_packet_size() const;
 
+	void set_rpc_batching_enabled(bool p_enabled);
+	bool is_rpc_batching_enabled() const;
+
+	void set_max_rpc_batch_size(int p_size);
+	int get_max_rpc_batch_size() const;
+
+	void set_snapshot_delta_enabled(bool p_enabled);
+	bool is_snapshot_delta_enabled() const;
+
+	void set_interest_management_enabled(bool p_enabled);
+	bool is_interest_management_enabled() const;
+
+	void set_interest_cell_size(real_t p_size);
+	real_t get_interest_cell_size() const;
+
+	void set_interest_bandwidth_budget(int p_bytes);
+	int get_interest_bandwidth_budget() const;
+
+	void set_peer_interest(int p_peer, const Vector3 &p_origin, real_t p_radius);
+	void clear_peer_interest(int p_peer);
+
+	void set_network_tick_rate(int p_rate);
+	int get_network_tick_rate() const;
+	int64_t get_network_tick() const;
+
 	SceneMultiplayer();
 	~SceneMultiplayer();
 };
@@ -30,6 +30,8 @@
 
 #include "scene_replication_config.h"
 
+#include "scene_replication_schema.h"
+
 #include "scene/main/multiplayer_api.h"
 #include "scene/main/node.h"
 
@@ -55,6 +57,24 @@ bool SceneReplicationConfig::_set(const StringName &p_name, const Variant &p_val
 			ERR_FAIL_COND_V(mode < REPLICATION_MODE_NEVER || mode > REPLICATION_MODE_ON_CHANGE, false);
 			property_set_replication_mode(prop.name, mode);
 			return true;
+		} else if (what == "encoding") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::INT, false);
+			PropertyEncoding encoding = (PropertyEncoding)p_value.operator int();
+			ERR_FAIL_COND_V(encoding < PROPERTY_ENCODING_VARIANT || encoding > PROPERTY_ENCODING_SMALLEST_THREE, false);
+			property_set_encoding(prop.name, encoding);
+			return true;
+		} else if (what == "encoding_type") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::INT, false);
+			property_set_encoding_type(prop.name, (Variant::Type)p_value.operator int());
+			return true;
+		} else if (what == "encoding_bits") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::INT, false);
+			property_set_encoding_bits(prop.name, p_value);
+			return true;
+		} else if (what == "encoding_range") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::VECTOR2, false);
+			property_set_encoding_range(prop.name, p_value);
+			return true;
 		}
 		ERR_FAIL_COND_V(p_value.get_type() != Variant::BOOL, false);
 		if (what == "spawn") {
@@ -90,6 +110,18 @@ bool SceneReplicationConfig::_get(const StringName &p_name, Variant &r_ret) cons
 		} else if (what == "replication_mode") {
 			r_ret = prop.mode;
 			return true;
+		} else if (what == "encoding") {
+			r_ret = prop.schema.encoding;
+			return true;
+		} else if (what == "encoding_type") {
+			r_ret = prop.schema.type;
+			return true;
+		} else if (what == "encoding_bits") {
+			r_ret = prop.schema.bits;
+			return true;
+		} else if (what == "encoding_range") {
+			r_ret = Vector2(prop.schema.range_min, prop.schema.range_max);
+			return true;
 		}
 	}
 	return false;
@@ -100,6 +132,21 @@ void SceneReplicationConfig::_get_property_list(List<PropertyInfo> *p_list) cons
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/path", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/spawn", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/replication_mode", PROPERTY_HINT_ENUM, "Never,Always,On Change", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		// Encoding settings are only stored when they differ from the defaults.
+		const PropertySchema &schema = properties.get(i).schema;
+		const PropertySchema default_schema;
+		if (schema.encoding != default_schema.encoding) {
+			p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/encoding", PROPERTY_HINT_ENUM, "Variant,Varint,Quantized,Smallest Three", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		}
+		if (schema.type != default_schema.type) {
+			p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/encoding_type", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		}
+		if (schema.bits != default_schema.bits) {
+			p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/encoding_bits", PROPERTY_HINT_RANGE, "1,32,1", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		}
+		if (schema.range_min != default_schema.range_min || schema.range_max != default_schema.range_max) {
+			p_list->push_back(PropertyInfo(Variant::VECTOR2, "properties/" + itos(i) + "/encoding_range", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		}
 	}
 }
 
@@ -109,6 +156,10 @@ void SceneReplicationConfig::reset_state() {
 	sync_props.clear();
 	spawn_props.clear();
 	watch_props.clear();
+	sync_schema.clear();
+	watch_schema.clear();
+	sync_packed = false;
+	watch_packed = false;
 }
 
 TypedArray<NodePath> SceneReplicationConfig::get_properties() const {
@@ -225,6 +276,71 @@ void SceneReplicationConfig::property_set_replication_mode(const NodePath &p_pat
 	dirty = true;
 }
 
+SceneReplicationConfig::PropertyEncoding SceneReplicationConfig::property_get_encoding(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, PROPERTY_ENCODING_VARIANT);
+	return E->get().schema.encoding;
+}
+
+void SceneReplicationConfig::property_set_encoding(const NodePath &p_path, PropertyEncoding p_encoding) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	if (E->get().schema.encoding == p_encoding) {
+		return;
+	}
+	E->get().schema.encoding = p_encoding;
+	dirty = true;
+}
+
+Variant::Type SceneReplicationConfig::property_get_encoding_type(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, Variant::NIL);
+	return E->get().schema.type;
+}
+
+void SceneReplicationConfig::property_set_encoding_type(const NodePath &p_path, Variant::Type p_type) {
+	ERR_FAIL_INDEX(p_type, Variant::VARIANT_MAX);
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	if (E->get().schema.type == p_type) {
+		return;
+	}
+	E->get().schema.type = p_type;
+	dirty = true;
+}
+
+int SceneReplicationConfig::property_get_encoding_bits(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, 0);
+	return E->get().schema.bits;
+}
+
+void SceneReplicationConfig::property_set_encoding_bits(const NodePath &p_path, int p_bits) {
+	ERR_FAIL_COND_MSG(p_bits < 1 || p_bits > 32, "Encoding bits must be between 1 and 32.");
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	if (E->get().schema.bits == p_bits) {
+		return;
+	}
+	E->get().schema.bits = p_bits;
+	dirty = true;
+}
+
+Vector2 SceneReplicationConfig::property_get_encoding_range(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, Vector2());
+	return Vector2(E->get().schema.range_min, E->get().schema.range_max);
+}
+
+void SceneReplicationConfig::property_set_encoding_range(const NodePath &p_path, const Vector2 &p_range) {
+	ERR_FAIL_COND_MSG(p_range.x >= p_range.y, "Encoding range minimum must be less than its maximum.");
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	E->get().schema.range_min = p_range.x;
+	E->get().schema.range_max = p_range.y;
+	dirty = true;
+}
+
 void SceneReplicationConfig::_update() {
 	if (!dirty) {
 		return;
@@ -233,16 +349,34 @@ void SceneReplicationConfig::_update() {
 	sync_props.clear();
 	spawn_props.clear();
 	watch_props.clear();
+	sync_schema.clear();
+	watch_schema.clear();
+	sync_packed = false;
+	watch_packed = false;
 	for (const ReplicationProperty &prop : properties) {
 		if (prop.spawn) {
 			spawn_props.push_back(prop.name);
 		}
+		PropertySchema schema = prop.schema;
+		if (schema.encoding != PROPERTY_ENCODING_VARIANT && !SceneReplicationSchema::is_supported(schema)) {
+			if (schema.type == Variant::NIL) {
+				ERR_PRINT(vformat("Replicated property \"%s\" has an encoding but no encoding type, it will be sent as a Variant. Set its type with property_set_encoding_type().", prop.name));
+			} else {
+				ERR_PRINT(vformat("Replicated property \"%s\" has an encoding that does not support its encoding type \"%s\", it will be sent as a Variant.", prop.name, Variant::get_type_name(schema.type)));
+			}
+			schema.encoding = PROPERTY_ENCODING_VARIANT;
+		}
+		bool packed = schema.encoding != PROPERTY_ENCODING_VARIANT;
 		switch (prop.mode) {
 			case REPLICATION_MODE_ALWAYS:
 				sync_props.push_back(prop.name);
+				sync_schema.push_back(schema);
+				sync_packed = sync_packed || packed;
 				break;
 			case REPLICATION_MODE_ON_CHANGE:
 				watch_props.push_back(prop.name);
+				watch_schema.push_back(schema);
+				watch_packed = watch_packed || packed;
 				break;
 			default:
 				break;
@@ -271,6 +405,34 @@ const List<NodePath> &SceneReplicationConfig::get_watch_properties() {
 	return watch_props;
 }
 
+const Vector<SceneReplicationConfig::PropertySchema> &SceneReplicationConfig::get_sync_schema() {
+	if (dirty) {
+		_update();
+	}
+	return sync_schema;
+}
+
+const Vector<SceneReplicationConfig::PropertySchema> &SceneReplicationConfig::get_watch_schema() {
+	if (dirty) {
+		_update();
+	}
+	return watch_schema;
+}
+
+bool SceneReplicationConfig::is_sync_packed() {
+	if (dirty) {
+		_update();
+	}
+	return sync_packed;
+}
+
+bool SceneReplicationConfig::is_watch_packed() {
+	if (dirty) {
+		_update();
+	}
+	return watch_packed;
+}
+
 void SceneReplicationConfig::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_properties"), &SceneReplicationConfig::get_properties);
 	ClassDB::bind_method(D_METHOD("add_property", "path", "index"), &SceneReplicationConfig::add_property, DEFVAL(-1));
@@ -282,10 +444,24 @@ void SceneReplicationConfig::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("property_get_replication_mode", "path"), &SceneReplicationConfig::property_get_replication_mode);
 	ClassDB::bind_method(D_METHOD("property_set_replication_mode", "path", "mode"), &SceneReplicationConfig::property_set_replication_mode);
 
+	ClassDB::bind_method(D_METHOD("property_get_encoding", "path"), &SceneReplicationConfig::property_get_encoding);
+	ClassDB::bind_method(D_METHOD("property_set_encoding", "path", "encoding"), &SceneReplicationConfig::property_set_encoding);
+	ClassDB::bind_method(D_METHOD("property_get_encoding_type", "path"), &SceneReplicationConfig::property_get_encoding_type);
+	ClassDB::bind_method(D_METHOD("property_set_encoding_type", "path", "type"), &SceneReplicationConfig::property_set_encoding_type);
+	ClassDB::bind_method(D_METHOD("property_get_encoding_bits", "path"), &SceneReplicationConfig::property_get_encoding_bits);
+	ClassDB::bind_method(D_METHOD("property_set_encoding_bits", "path", "bits"), &SceneReplicationConfig::property_set_encoding_bits);
+	ClassDB::bind_method(D_METHOD("property_get_encoding_range", "path"), &SceneReplicationConfig::property_get_encoding_range);
+	ClassDB::bind_method(D_METHOD("property_set_encoding_range", "path", "range"), &SceneReplicationConfig::property_set_encoding_range);
+
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_NEVER);
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_ALWAYS);
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_ON_CHANGE);
 
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_VARIANT);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_VARINT);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_QUANTIZED);
+	BIND_ENUM_CONSTANT(PROPERTY_ENCODING_SMALLEST_THREE);
+
 	// Deprecated.
 	ClassDB::bind_method(D_METHOD("property_get_sync", "path"), &SceneReplicationConfig::property_get_sync);
 	ClassDB::bind_method(D_METHOD("property_set_sync", "path", "enabled"), &SceneReplicationConfig::property_set_sync);
@@ -46,11 +46,27 @@ public:
 		REPLICATION_MODE_ON_CHANGE,
 	};
 
+	enum PropertyEncoding {
+		PROPERTY_ENCODING_VARIANT,
+		PROPERTY_ENCODING_VARINT,
+		PROPERTY_ENCODING_QUANTIZED,
+		PROPERTY_ENCODING_SMALLEST_THREE,
+	};
+
+	struct PropertySchema {
+		PropertyEncoding encoding = PROPERTY_ENCODING_VARIANT;
+		Variant::Type type = Variant::NIL; // The encoding only applies to values of this type.
+		int bits = 16;
+		float range_min = -1.0;
+		float range_max = 1.0;
+	};
+
 private:
 	struct ReplicationProperty {
 		NodePath name;
 		bool spawn = true;
 		ReplicationMode mode = REPLICATION_MODE_ALWAYS;
+		PropertySchema schema;
 
 		bool operator==(const ReplicationProperty &p_to) {
 			return name == p_to.name;
@@ -67,6 +83,10 @@ private:
 	List<NodePath> spawn_props;
 	List<NodePath> sync_props;
 	List<NodePath> watch_props;
+	Vector<PropertySchema> sync_schema;
+	Vector<PropertySchema> watch_schema;
+	bool sync_packed = false;
+	bool watch_packed = false;
 	bool dirty = false;
 
 	void _update();
@@ -100,13 +120,33 @@ public:
 	ReplicationMode property_get_replication_mode(const NodePath &p_path);
 	void property_set_replication_mode(const NodePath &p_path, ReplicationMode p_mode);
 
+	PropertyEncoding property_get_encoding(const NodePath &p_path);
+	void property_set_encoding(const NodePath &p_path, PropertyEncoding p_encoding);
+
+	Variant::Type property_get_encoding_type(const NodePath &p_path);
+	void property_set_encoding_type(const NodePath &p_path, Variant::Type p_type);
+
+	int property_get_encoding_bits(const NodePath &p_path);
+	void property_set_encoding_bits(const NodePath &p_path, int p_bits);
+
+	Vector2 property_get_encoding_range(const NodePath &p_path);
+	void property_set_encoding_range(const NodePath &p_path, const Vector2 &p_range);
+
 	const List<NodePath> &get_spawn_properties();
 	const List<NodePath> &get_sync_properties();
 	const List<NodePath> &get_watch_properties();
 
+	// Schemas matching get_sync_properties() and get_watch_properties().
+	const Vector<PropertySchema> &get_sync_schema();
+	const Vector<PropertySchema> &get_watch_schema();
+	// Whether any of the properties uses a non-Variant encoding, in which case the state is bit-packed.
+	bool is_sync_packed();
+	bool is_watch_packed();
+
 	SceneReplicationConfig() {}
 };
 
 VARIANT_ENUM_CAST(SceneReplicationConfig::ReplicationMode);
+VARIANT_ENUM_CAST(SceneReplicationConfig::PropertyEncoding);
 
 #endif // SCENE_REPLICATION_CONFIG_H
@@ -34,6 +34,9 @@
 
 #include "core/debugger/engine_debugger.h"
 #include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
+#include "scene/2d/node_2d.h"
+#include "scene/3d/node_3d.h"
 #include "scene/main/node.h"
 
 #define MAKE_ROOM(m_amount)             \
@@ -125,6 +128,12 @@ void SceneReplicationInterface::on_reset() {
 		sync->reset();
 	}
 	last_net_id = 0;
+	network_tick = 0;
+	clock_usec = 0;
+	tick_accumulator = 0;
+	clock_correction = 0;
+	last_clock_ping = 0;
+	clock_synced = false;
 }
 
 void SceneReplicationInterface::on_network_process() {
@@ -141,16 +150,174 @@ void SceneReplicationInterface::on_network_process() {
 		spawn_queue.clear();
 	}
 
-	// Process syncs.
+	_send_snapshot_acks();
+
 	uint64_t usec = OS::get_singleton()->get_ticks_usec();
+	if (tick_rate > 0) {
+		_process_clock(usec);
+	}
+
+	// Process syncs.
+	if (interest_enabled) {
+		_process_interest(usec);
+		return;
+	}
+	LocalVector<ObjectID> to_sync;
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
-		const HashSet<ObjectID> to_sync = E.value.sync_nodes;
-		if (to_sync.is_empty()) {
+		if (E.value.sync_nodes.is_empty()) {
 			continue; // Nothing to sync
 		}
+		to_sync.clear();
+		for (const ObjectID &oid : E.value.sync_nodes) {
+			to_sync.push_back(oid);
+		}
 		uint16_t sync_net_time = ++E.value.last_sent_sync;
-		_send_sync(E.key, to_sync, sync_net_time, usec);
-		_send_delta(E.key, to_sync, usec, E.value.last_watch_usecs);
+		int budget = INT_MAX;
+		_send_sync(E.key, to_sync, sync_net_time, usec, budget);
+		_send_delta(E.key, to_sync, usec, E.value.last_watch_usecs, budget);
+	}
+}
+
+void SceneReplicationInterface::_update_interest_grid() {
+	interest_candidates.clear();
+	interest_global.clear();
+	interest_grid.clear();
+	for (const ObjectID &oid : sync_nodes) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
+		if (!sync || !_has_authority(sync)) {
+			continue;
+		}
+		InterestCandidate candidate;
+		candidate.id = oid;
+		candidate.priority = sync->get_interest_priority();
+		const Node *root = sync->get_root_node();
+		const Node3D *node_3d = Object::cast_to<Node3D>(root);
+		const Node2D *node_2d = Object::cast_to<Node2D>(root);
+		if (node_3d && node_3d->is_inside_tree()) {
+			candidate.position = node_3d->get_global_position();
+			candidate.spatial = true;
+		} else if (node_2d && node_2d->is_inside_tree()) {
+			const Vector2 pos = node_2d->get_global_position();
+			candidate.position = Vector3(pos.x, pos.y, 0);
+			candidate.spatial = true;
+		}
+		const uint32_t index = interest_candidates.size();
+		interest_candidates.push_back(candidate);
+		if (candidate.spatial) {
+			interest_grid[Vector3i((candidate.position / interest_cell_size).floor())].push_back(index);
+		} else {
+			interest_global.push_back(index);
+		}
+	}
+}
+
+void SceneReplicationInterface::_compute_peer_interest(uint32_t p_index, PeerInfo **p_peers) {
+	// Runs on worker threads: only reads shared state and writes to its own peer.
+	PeerInfo &info = *p_peers[p_index];
+	info.interest_relevant.clear();
+
+	auto add_relevant = [&](const InterestCandidate &p_candidate, float p_score) {
+		if (!info.sync_nodes.has(p_candidate.id)) {
+			return; // Not visible to this peer.
+		}
+		const float *acc = info.interest_accumulator.getptr(p_candidate.id);
+		info.interest_relevant.push_back({ p_candidate.id, p_score + (acc ? *acc : 0) });
+	};
+
+	if (!info.has_view) {
+		// Without a view the peer receives everything it can see, ordered by priority alone.
+		for (const InterestCandidate &candidate : interest_candidates) {
+			add_relevant(candidate, candidate.priority);
+		}
+	} else {
+		for (const uint32_t &index : interest_global) {
+			const InterestCandidate &candidate = interest_candidates[index];
+			add_relevant(candidate, candidate.priority);
+		}
+
+		const real_t radius = info.view_radius;
+		const Vector3 extents(radius, radius, radius);
+		const Vector3i from = Vector3i(((info.view_origin - extents) / interest_cell_size).floor());
+		const Vector3i to = Vector3i(((info.view_origin + extents) / interest_cell_size).floor());
+		const int64_t cell_count = int64_t(to.x - from.x + 1) * int64_t(to.y - from.y + 1) * int64_t(to.z - from.z + 1);
+
+		auto add_cell = [&](const LocalVector<uint32_t> &p_cell) {
+			for (const uint32_t &index : p_cell) {
+				const InterestCandidate &candidate = interest_candidates[index];
+				const real_t distance = candidate.position.distance_to(info.view_origin);
+				if (distance > radius) {
+					continue;
+				}
+				// Objects at the edge of the view keep half of their priority.
+				add_relevant(candidate, candidate.priority * (1.0 - 0.5 * (radius > 0 ? distance / radius : 0)));
+			}
+		};
+
+		if (cell_count > int64_t(interest_grid.size())) {
+			// Cheaper to walk the occupied cells than the covered ones.
+			for (const KeyValue<Vector3i, LocalVector<uint32_t>> &E : interest_grid) {
+				if (E.key.x >= from.x && E.key.x <= to.x && E.key.y >= from.y && E.key.y <= to.y && E.key.z >= from.z && E.key.z <= to.z) {
+					add_cell(E.value);
+				}
+			}
+		} else {
+			for (int x = from.x; x <= to.x; x++) {
+				for (int y = from.y; y <= to.y; y++) {
+					for (int z = from.z; z <= to.z; z++) {
+						const LocalVector<uint32_t> *cell = interest_grid.getptr(Vector3i(x, y, z));
+						if (cell) {
+							add_cell(*cell);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	info.interest_relevant.sort();
+	info.interest_order.resize(info.interest_relevant.size());
+	for (uint32_t i = 0; i < info.interest_relevant.size(); i++) {
+		info.interest_order[i] = info.interest_relevant[i].id;
+	}
+}
+
+void SceneReplicationInterface::_process_interest(uint64_t p_usec) {
+	_update_interest_grid();
+
+	interest_peers.clear();
+	for (KeyValue<int, PeerInfo> &E : peers_info) {
+		if (!E.value.sync_nodes.is_empty()) {
+			interest_peers.push_back(&E.value);
+		}
+	}
+	// Peers are independent, but only spread them when not on a pool thread, see GodotStep3D::set_parallel_islands().
+	if (interest_peers.size() > 1 && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneReplicationInterface::_compute_peer_interest, interest_peers.ptr(), interest_peers.size(), -1, true, SNAME("MultiplayerInterest"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < interest_peers.size(); i++) {
+			_compute_peer_interest(i, interest_peers.ptr());
+		}
+	}
+
+	for (KeyValue<int, PeerInfo> &E : peers_info) {
+		PeerInfo &info = E.value;
+		if (info.sync_nodes.is_empty()) {
+			continue; // Nothing to sync
+		}
+		uint16_t sync_net_time = ++info.last_sent_sync;
+		int budget = interest_budget > 0 ? interest_budget : INT_MAX;
+		interest_deferred.clear();
+		_send_sync(E.key, info.interest_order, sync_net_time, p_usec, budget, &interest_deferred);
+		_send_delta(E.key, info.interest_order, p_usec, info.last_watch_usecs, budget, &interest_deferred);
+
+		// Relevant objects that did not fit the budget get a head start next frame so they are not starved.
+		info.interest_accumulator.clear();
+		for (const InterestEntry &relevant : info.interest_relevant) {
+			if (interest_deferred.has(relevant.id)) {
+				info.interest_accumulator[relevant.id] = relevant.score;
+			}
+		}
 	}
 }
 
@@ -283,6 +450,8 @@ Error SceneReplicationInterface::on_replication_stop(Object *p_obj, Variant p_co
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
 		E.value.sync_nodes.erase(sid);
 		E.value.last_watch_usecs.erase(sid);
+		E.value.sent_snapshots.erase(sid);
+		E.value.recv_snapshots.erase(sid);
 		if (sync->get_net_id()) {
 			E.value.recv_sync_ids.erase(sync->get_net_id());
 		}
@@ -361,6 +530,7 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 			} else {
 				E.value.sync_nodes.erase(sid);
 				E.value.last_watch_usecs.erase(sid);
+				E.value.sent_snapshots.erase(sid); // The remote may despawn it, start over with a full state.
 			}
 		}
 		return OK;
@@ -374,6 +544,7 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 		} else {
 			peers_info[p_peer].sync_nodes.erase(sid);
 			peers_info[p_peer].last_watch_usecs.erase(sid);
+			peers_info[p_peer].sent_snapshots.erase(sid);
 		}
 		return OK;
 	}
@@ -708,11 +879,22 @@ MultiplayerSynchronizer *SceneReplicationInterface::_find_synchronizer(int p_pee
 	return sync;
 }
 
-void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs) {
+void SceneReplicationInterface::_get_delta_schema(SceneReplicationConfig *p_config, uint64_t p_indexes) {
+	const Vector<SceneReplicationConfig::PropertySchema> &watch_schema = p_config->get_watch_schema();
+	delta_schema.clear();
+	for (int i = 0; i < watch_schema.size(); i++) {
+		if (p_indexes & (1ULL << i)) {
+			delta_schema.push_back(watch_schema[i]);
+		}
+	}
+}
+
+void SceneReplicationInterface::_send_delta(int p_peer, const LocalVector<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs, int &r_budget, HashSet<ObjectID> *r_deferred) {
 	MAKE_ROOM(/* header */ 1 + /* element */ 4 + 8 + 4 + delta_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
 	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT);
 	int ofs = 1;
+	bool out_of_budget = false;
 	for (const ObjectID &oid : p_synchronizers) {
 		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
 		ERR_CONTINUE(!sync || !sync->get_replication_config_ptr() || !_has_authority(sync));
@@ -727,6 +909,12 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 		if (!delta.size()) {
 			continue; // Nothing to update.
 		}
+		if (out_of_budget) {
+			if (r_deferred) {
+				r_deferred->insert(oid);
+			}
+			continue;
+		}
 
 		Vector<const Variant *> varp;
 		varp.resize(delta.size());
@@ -737,10 +925,27 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 			i++;
 		}
 		int size;
-		Error err = MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), nullptr, size);
+		Error err;
+		const bool packed = sync->get_replication_config_ptr()->is_watch_packed();
+		if (packed) {
+			_get_delta_schema(sync->get_replication_config_ptr(), indexes);
+			err = SceneReplicationSchema::encode(delta_schema.ptr(), vptr, varp.size(), schema_writer);
+			size = schema_writer.get_size();
+		} else {
+			err = MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), nullptr, size);
+		}
 		ERR_CONTINUE_MSG(err != OK, "Unable to encode delta state.");
 
 		ERR_CONTINUE_MSG(size > delta_mtu, vformat("Synchronizer delta bigger than MTU will not be sent (%d > %d): %s", size, delta_mtu, sync->get_path()));
+		if (4 + 8 + 4 + size > r_budget) {
+			// Out of bandwidth for this frame, the remaining changes are sent later.
+			out_of_budget = true;
+			if (r_deferred) {
+				r_deferred->insert(oid);
+			}
+			continue;
+		}
+		r_budget -= 4 + 8 + 4 + size;
 
 		if (ofs + 4 + 8 + 4 + size > delta_mtu) {
 			// Send what we got, and reset write.
@@ -751,7 +956,11 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
 			ofs += encode_uint64(indexes, &ptr[ofs]);
 			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), &ptr[ofs], size);
+			if (packed) {
+				memcpy(&ptr[ofs], schema_writer.get_data(), size);
+			} else {
+				MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), &ptr[ofs], size);
+			}
 			ofs += size;
 		}
 #ifdef DEBUG_ENABLED
@@ -784,9 +993,16 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 		List<NodePath> props = sync->get_delta_properties(indexes);
 		ERR_FAIL_COND_V(props.is_empty(), ERR_INVALID_DATA);
 		Vector<Variant> vars;
-		vars.resize(props.size());
 		int consumed = 0;
-		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, p_buffer + ofs, size, consumed);
+		Error err;
+		if (sync->get_replication_config_ptr()->is_watch_packed()) {
+			_get_delta_schema(sync->get_replication_config_ptr(), indexes);
+			ERR_FAIL_COND_V(int(delta_schema.size()) != props.size(), ERR_INVALID_DATA);
+			err = SceneReplicationSchema::decode(delta_schema.ptr(), props.size(), p_buffer + ofs, size, vars, consumed);
+		} else {
+			vars.resize(props.size());
+			err = MultiplayerAPI::decode_and_decompress_variants(vars, p_buffer + ofs, size, consumed);
+		}
 		ERR_FAIL_COND_V(err != OK, err);
 		ERR_FAIL_COND_V(uint32_t(consumed) != size, ERR_INVALID_DATA);
 		err = MultiplayerSynchronizer::set_state(props, node, vars);
@@ -800,20 +1016,39 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 	return OK;
 }
 
-void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec) {
-	MAKE_ROOM(/* header */ 3 + /* element */ 4 + 4 + sync_mtu);
+void SceneReplicationInterface::_send_sync(int p_peer, const LocalVector<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec, int &r_budget, HashSet<ObjectID> *r_deferred) {
+	const bool snapshots = snapshot_delta_enabled;
+	const bool ticks = tick_rate > 0;
+	const int header = 3 + (snapshots ? 2 : 0) + (ticks ? 8 : 0);
+	MAKE_ROOM(/* header */ header + /* element */ 4 + 4 + sync_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
-	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC;
+	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (snapshots ? (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT) : 0) | (ticks ? (1 << SceneMultiplayer::CMD_FLAG_2_SHIFT) : 0);
 	int ofs = 1;
 	ofs += encode_uint16(p_sync_net_time, &ptr[1]);
+	PeerInfo &info = peers_info[p_peer];
+	uint16_t snapshot_id = 0;
+	if (snapshots) {
+		snapshot_id = _begin_snapshot_packet(info);
+		ofs += encode_uint16(snapshot_id, &ptr[ofs]);
+	}
+	if (ticks) {
+		ofs += encode_uint64(uint64_t(network_tick), &ptr[ofs]);
+	}
 	// Can only send updates for already notified nodes.
 	// This is a lazy implementation, we could optimize much more here with by grouping by replication config.
+	bool out_of_budget = false;
 	for (const ObjectID &oid : p_synchronizers) {
 		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
 		ERR_CONTINUE(!sync || !sync->get_replication_config_ptr() || !_has_authority(sync));
-		if (!sync->update_outbound_sync_time(p_usec)) {
+		if (!sync->is_outbound_sync_due(p_usec)) {
 			continue; // nothing to sync.
 		}
+		if (out_of_budget) {
+			if (r_deferred) {
+				r_deferred->insert(oid);
+			}
+			continue;
+		}
 
 		Node *node = sync->get_root_node();
 		ERR_CONTINUE(!node);
@@ -822,45 +1057,268 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 			// The path based sync is not yet confirmed, skipping.
 			continue;
 		}
-		int size;
-		Vector<Variant> vars;
-		Vector<const Variant *> varp;
-		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
-		Error err = MultiplayerSynchronizer::get_state(props, node, vars, varp);
-		ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
-		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
-		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
-		// TODO Handle single state above MTU.
-		ERR_CONTINUE_MSG(size > sync_mtu, vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
+		Error err = _encode_sync_state(sync, node, ticks, state_cache);
+		int size = state_cache.size();
+		if (err != OK || size > sync_mtu) {
+			sync->update_outbound_sync_time(p_usec); // Don't retry every frame.
+			ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
+			// TODO Handle single state above MTU.
+			ERR_CONTINUE_MSG(size > sync_mtu, vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
+		}
+		if (snapshots && size) {
+			// Encode against the last state acknowledged by the peer.
+			_make_snapshot_payload(info, oid);
+			size = snapshot_payload.size();
+		}
+		if (4 + 4 + size > r_budget) {
+			// Out of bandwidth for this frame, this and the following states keep their sync time and are sent later.
+			out_of_budget = true;
+			if (r_deferred) {
+				r_deferred->insert(oid);
+			}
+			continue;
+		}
+		r_budget -= 4 + 4 + size;
+		sync->update_outbound_sync_time(p_usec);
 		if (ofs + 4 + 4 + size > sync_mtu) {
 			// Send what we got, and reset write.
 			_send_raw(packet_cache.ptr(), ofs, p_peer, false);
-			ofs = 3;
+			ofs = header;
+			if (snapshots) {
+				snapshot_id = _begin_snapshot_packet(info);
+				encode_uint16(snapshot_id, &ptr[3]);
+			}
 		}
 		if (size) {
 			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
 			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
+			if (snapshots) {
+				memcpy(&ptr[ofs], snapshot_payload.ptr(), size);
+				_store_snapshot(info, oid, snapshot_id);
+			} else {
+				memcpy(&ptr[ofs], state_cache.ptr(), size);
+			}
 			ofs += size;
 		}
 #ifdef DEBUG_ENABLED
 		_profile_node_data("sync_out", oid, size);
 #endif
 	}
-	if (ofs > 3) {
+	if (ofs > header) {
 		// Got some left over to send.
 		_send_raw(packet_cache.ptr(), ofs, p_peer, false);
 	}
 }
 
+Error SceneReplicationInterface::_encode_values(SceneReplicationConfig *p_config, const Variant **p_values, int p_count, LocalVector<uint8_t> &r_buffer) {
+	if (p_config->is_sync_packed()) {
+		Error err = SceneReplicationSchema::encode(p_config->get_sync_schema().ptr(), p_values, p_count, schema_writer);
+		ERR_FAIL_COND_V(err != OK, err);
+		r_buffer.resize(schema_writer.get_size());
+		if (r_buffer.size()) {
+			memcpy(r_buffer.ptr(), schema_writer.get_data(), r_buffer.size());
+		}
+		return OK;
+	}
+	int size;
+	Error err = MultiplayerAPI::encode_and_compress_variants(p_values, p_count, nullptr, size);
+	ERR_FAIL_COND_V(err != OK, err);
+	r_buffer.resize(size);
+	if (size) {
+		MultiplayerAPI::encode_and_compress_variants(p_values, p_count, r_buffer.ptr(), size);
+	}
+	return OK;
+}
+
+Error SceneReplicationInterface::_decode_values(MultiplayerSynchronizer *p_sync, const uint8_t *p_buffer, int p_len, Vector<Variant> &r_values) {
+	SceneReplicationConfig *config = p_sync->get_replication_config_ptr();
+	const List<NodePath> props = config->get_sync_properties();
+	int consumed;
+	if (config->is_sync_packed()) {
+		return SceneReplicationSchema::decode(config->get_sync_schema().ptr(), props.size(), p_buffer, p_len, r_values, consumed);
+	}
+	r_values.resize(props.size());
+	return MultiplayerAPI::decode_and_decompress_variants(r_values, p_buffer, p_len, consumed);
+}
+
+Error SceneReplicationInterface::_encode_sync_state(MultiplayerSynchronizer *p_sync, Node *p_node, bool p_with_ticks, LocalVector<uint8_t> &r_buffer) {
+	SceneReplicationConfig *config = p_sync->get_replication_config_ptr();
+	if (p_with_ticks && p_sync->get_prediction_mode() == MultiplayerSynchronizer::PREDICTION_INPUT) {
+		// Inputs are resent for a few ticks, so the authority can simulate each tick despite packet loss.
+		// Format: count, then (64-bit tick, size, state) for each recorded tick.
+		r_buffer.resize(1);
+		uint8_t count = 0;
+		for (int64_t tick = network_tick; tick >= 0 && tick > network_tick - PREDICTION_INPUT_REDUNDANCY; tick--) {
+			const Vector<Variant> *values = p_sync->get_recorded_state(tick);
+			if (!values) {
+				continue;
+			}
+			Vector<const Variant *> ptrs;
+			ptrs.resize(values->size());
+			for (int i = 0; i < values->size(); i++) {
+				ptrs.write[i] = &values->get(i);
+			}
+			Error err = _encode_values(config, ptrs.ptrw(), ptrs.size(), value_cache);
+			ERR_FAIL_COND_V(err != OK, err);
+			const uint32_t ofs = r_buffer.size();
+			r_buffer.resize(ofs + 12 + value_cache.size());
+			encode_uint64(uint64_t(tick), &r_buffer[ofs]);
+			encode_uint32(value_cache.size(), &r_buffer[ofs + 8]);
+			if (value_cache.size()) {
+				memcpy(&r_buffer[ofs + 12], value_cache.ptr(), value_cache.size());
+			}
+			count++;
+		}
+		r_buffer[0] = count;
+		return OK;
+	}
+	Vector<Variant> vars;
+	Vector<const Variant *> varp;
+	Error err = MultiplayerSynchronizer::get_state(config->get_sync_properties(), p_node, vars, varp);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Unable to retrieve sync state.");
+	return _encode_values(config, varp.ptrw(), varp.size(), r_buffer);
+}
+
+uint16_t SceneReplicationInterface::_begin_snapshot_packet(PeerInfo &p_info) {
+	const uint16_t id = p_info.last_snapshot++;
+	const uint32_t slot = id & (SNAPSHOT_HISTORY - 1);
+	p_info.snapshot_packet_ids[slot] = uint32_t(id) + 1;
+	p_info.snapshot_packets[slot].clear();
+	return id;
+}
+
+void SceneReplicationInterface::_make_snapshot_payload(PeerInfo &p_info, const ObjectID &p_oid) {
+	// Full payload: kind, state. Delta payload: kind, baseline ID, XOR delta of the state.
+	const SnapshotHistory *history = p_info.sent_snapshots.getptr(p_oid);
+	// Baselines that left the history window may have been overwritten by the receiver, or never stored by it.
+	// The receiver drops deltas it can't decode without acknowledging them, so acks stop and we fall back to full states.
+	if (history && history->baseline && uint16_t(p_info.last_snapshot - history->baseline) < SNAPSHOT_HISTORY) {
+		const uint32_t slot = (history->baseline - 1) & (SNAPSHOT_HISTORY - 1);
+		const LocalVector<uint8_t> &base = history->states[slot];
+		if (history->ids[slot] == history->baseline && base.size() == state_cache.size()) {
+			snapshot_payload.resize(3);
+			snapshot_payload[0] = SNAPSHOT_DELTA;
+			encode_uint16(history->baseline - 1, &snapshot_payload[1]);
+			SceneReplicationSchema::encode_xor_delta(state_cache.ptr(), base.ptr(), base.size(), snapshot_payload);
+			if (snapshot_payload.size() <= state_cache.size()) {
+				return; // Only worth it when smaller than a full state.
+			}
+		}
+	}
+	snapshot_payload.resize(state_cache.size() + 1);
+	snapshot_payload[0] = SNAPSHOT_FULL;
+	memcpy(&snapshot_payload[1], state_cache.ptr(), state_cache.size());
+}
+
+void SceneReplicationInterface::_store_snapshot(PeerInfo &p_info, const ObjectID &p_oid, uint16_t p_snapshot_id) {
+	const uint32_t slot = p_snapshot_id & (SNAPSHOT_HISTORY - 1);
+	SnapshotHistory &history = p_info.sent_snapshots[p_oid];
+	history.ids[slot] = uint32_t(p_snapshot_id) + 1;
+	history.states[slot] = state_cache;
+	p_info.snapshot_packets[slot].push_back(p_oid);
+}
+
+Error SceneReplicationInterface::_read_snapshot(PeerInfo &p_info, const ObjectID &p_oid, uint16_t p_snapshot_id, const uint8_t *p_buffer, int p_len) {
+	ERR_FAIL_COND_V(p_len < 1, ERR_INVALID_DATA);
+	SnapshotHistory &history = p_info.recv_snapshots[p_oid];
+	if (p_buffer[0] == SNAPSHOT_FULL) {
+		state_cache.resize(p_len - 1);
+		memcpy(state_cache.ptr(), &p_buffer[1], p_len - 1);
+	} else {
+		ERR_FAIL_COND_V(p_buffer[0] != SNAPSHOT_DELTA || p_len < 3, ERR_INVALID_DATA);
+		const uint16_t baseline = decode_uint16(&p_buffer[1]);
+		const uint32_t slot = baseline & (SNAPSHOT_HISTORY - 1);
+		if (history.ids[slot] != uint32_t(baseline) + 1) {
+			// Baseline no longer available (e.g. the node was respawned). Not an error, the state is not acknowledged and the sender falls back to a full one.
+			return ERR_UNAVAILABLE;
+		}
+		const LocalVector<uint8_t> &base = history.states[slot];
+		state_cache.resize(base.size());
+		Error err = SceneReplicationSchema::decode_xor_delta(&p_buffer[3], p_len - 3, base.ptr(), base.size(), state_cache.ptr());
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	const uint32_t slot = p_snapshot_id & (SNAPSHOT_HISTORY - 1);
+	history.ids[slot] = uint32_t(p_snapshot_id) + 1;
+	history.states[slot] = state_cache;
+	return OK;
+}
+
+void SceneReplicationInterface::_send_snapshot_acks() {
+	for (KeyValue<int, PeerInfo> &E : peers_info) {
+		LocalVector<uint16_t> &acks = E.value.snapshot_acks;
+		if (acks.is_empty()) {
+			continue;
+		}
+		MAKE_ROOM(sync_mtu);
+		uint8_t *ptr = packet_cache.ptrw();
+		ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT) | (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT);
+		int ofs = 1;
+		for (const uint16_t &id : acks) {
+			if (ofs + 2 > sync_mtu) {
+				_send_raw(packet_cache.ptr(), ofs, E.key, false);
+				ofs = 1;
+			}
+			ofs += encode_uint16(id, &ptr[ofs]);
+		}
+		_send_raw(packet_cache.ptr(), ofs, E.key, false);
+		acks.clear();
+	}
+}
+
+Error SceneReplicationInterface::on_snapshot_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	PeerInfo *info = peers_info.getptr(p_from);
+	ERR_FAIL_NULL_V(info, ERR_INVALID_DATA);
+	for (int ofs = 1; ofs + 2 <= p_buffer_len; ofs += 2) {
+		const uint16_t id = decode_uint16(&p_buffer[ofs]);
+		const uint32_t slot = id & (SNAPSHOT_HISTORY - 1);
+		if (info->snapshot_packet_ids[slot] != uint32_t(id) + 1) {
+			continue; // Too old, the packet was forgotten.
+		}
+		for (const ObjectID &oid : info->snapshot_packets[slot]) {
+			SnapshotHistory *history = info->sent_snapshots.getptr(oid);
+			if (!history || history->ids[slot] != uint32_t(id) + 1) {
+				continue;
+			}
+			// Acks arrive unordered, only move the baseline forward (with wrap around).
+			if (!history->baseline || int16_t(id - uint16_t(history->baseline - 1)) > 0) {
+				history->baseline = uint32_t(id) + 1;
+			}
+		}
+	}
+	return OK;
+}
+
 Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
-	ERR_FAIL_COND_V_MSG(p_buffer_len < 11, ERR_INVALID_DATA, "Invalid sync packet received");
 	bool is_delta = (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT)) != 0;
+	bool is_snapshot = (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT)) != 0;
+	if (is_delta && is_snapshot) {
+		return on_snapshot_ack_receive(p_from, p_buffer, p_buffer_len);
+	}
+	if (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_3_SHIFT)) {
+		return on_clock_receive(p_from, p_buffer, p_buffer_len);
+	}
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 11, ERR_INVALID_DATA, "Invalid sync packet received");
 	if (is_delta) {
 		return on_delta_receive(p_from, p_buffer, p_buffer_len);
 	}
 	uint16_t time = decode_uint16(&p_buffer[1]);
 	int ofs = 3;
+	uint16_t snapshot_id = 0;
+	PeerInfo *info = nullptr;
+	bool snapshot_complete = true;
+	if (is_snapshot) {
+		info = peers_info.getptr(p_from);
+		ERR_FAIL_NULL_V(info, ERR_INVALID_DATA);
+		snapshot_id = decode_uint16(&p_buffer[3]);
+		ofs = 5;
+	}
+	const bool has_tick = (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_2_SHIFT)) != 0;
+	int64_t tick = -1;
+	if (has_tick) {
+		ERR_FAIL_COND_V_MSG(ofs + 8 > p_buffer_len, ERR_INVALID_DATA, "Invalid sync packet received");
+		tick = int64_t(decode_uint64(&p_buffer[ofs]));
+		ofs += 8;
+	}
 	while (ofs + 8 < p_buffer_len) {
 		uint32_t net_id = decode_uint32(&p_buffer[ofs]);
 		ofs += 4;
@@ -871,26 +1329,48 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 		if (!sync) {
 			// Not received yet.
 			ofs += size;
+			snapshot_complete = false;
 			continue;
 		}
 		Node *node = sync->get_root_node();
 		if (sync->get_multiplayer_authority() != p_from || !node) {
 			// Not valid for me.
 			ofs += size;
+			snapshot_complete = false;
 			ERR_CONTINUE_MSG(true, "Ignoring sync data from non-authority or for missing node.");
 		}
+		const uint8_t *state = &p_buffer[ofs];
+		int state_size = size;
+		if (is_snapshot) {
+			// Keep the state as a baseline even if it is too old to be applied, the sender may delta against it once acknowledged.
+			if (_read_snapshot(*info, sync->get_instance_id(), snapshot_id, &p_buffer[ofs], size) != OK) {
+				ofs += size;
+				snapshot_complete = false;
+				continue;
+			}
+			state = state_cache.ptr();
+			state_size = state_cache.size();
+		}
+		if (has_tick && sync->get_prediction_mode() == MultiplayerSynchronizer::PREDICTION_INPUT) {
+			// Inputs are stored per tick regardless of arrival order, and consumed when the tick is simulated.
+			Error err = _receive_inputs(sync, node, state, state_size);
+			ERR_FAIL_COND_V(err, err);
+			ofs += size;
+			continue;
+		}
 		if (!sync->update_inbound_sync_time(time)) {
 			// State is too old.
 			ofs += size;
 			continue;
 		}
-		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
 		Vector<Variant> vars;
-		vars.resize(props.size());
-		int consumed;
-		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, &p_buffer[ofs], size, consumed);
+		Error err = _decode_values(sync, state, state_size, vars);
 		ERR_FAIL_COND_V(err, err);
-		err = MultiplayerSynchronizer::set_state(props, node, vars);
+		if (has_tick && tick_rate > 0 && _is_predicting(sync)) {
+			err = _reconcile(sync, node, tick, state, state_size, vars);
+		} else {
+			err = MultiplayerSynchronizer::set_state(sync->get_replication_config_ptr()->get_sync_properties(), node, vars);
+		}
 		ERR_FAIL_COND_V(err, err);
 		ofs += size;
 		sync->emit_signal(SNAME("synchronized"));
@@ -898,6 +1378,177 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 		_profile_node_data("sync_in", sync->get_instance_id(), size);
 #endif
 	}
+	if (is_snapshot && snapshot_complete) {
+		// Only acknowledge snapshots whose states were all stored, so every baseline is available.
+		info->snapshot_acks.push_back(snapshot_id);
+	}
+	return OK;
+}
+
+bool SceneReplicationInterface::_is_predicting(MultiplayerSynchronizer *p_sync) {
+	if (p_sync->get_prediction_mode() != MultiplayerSynchronizer::PREDICTION_STATE || _has_authority(p_sync)) {
+		return false;
+	}
+	// Only the peer owning the inputs can simulate ahead of the authority.
+	MultiplayerSynchronizer *input = p_sync->get_prediction_input_synchronizer();
+	return input && _has_authority(input);
+}
+
+Error SceneReplicationInterface::_receive_inputs(MultiplayerSynchronizer *p_sync, Node *p_node, const uint8_t *p_buffer, int p_len) {
+	ERR_FAIL_COND_V(p_len < 1, ERR_INVALID_DATA);
+	const int count = p_buffer[0];
+	const int64_t history = p_sync->get_prediction_history_size();
+	int ofs = 1;
+	for (int i = 0; i < count; i++) {
+		ERR_FAIL_COND_V(ofs + 12 > p_len, ERR_INVALID_DATA);
+		const int64_t tick = int64_t(decode_uint64(&p_buffer[ofs]));
+		const uint32_t size = decode_uint32(&p_buffer[ofs + 8]);
+		ofs += 12;
+		ERR_FAIL_COND_V(size > uint32_t(p_len - ofs), ERR_INVALID_DATA);
+		// Inputs outside the history window would overwrite ones still needed.
+		if (tick > network_tick - history && tick < network_tick + history && !p_sync->has_recorded_state(tick)) {
+			Vector<Variant> values;
+			Error err = _decode_values(p_sync, &p_buffer[ofs], size, values);
+			ERR_FAIL_COND_V(err, err);
+			p_sync->store_state(tick, values);
+		}
+		ofs += size;
+	}
+	return OK;
+}
+
+Error SceneReplicationInterface::_reconcile(MultiplayerSynchronizer *p_sync, Node *p_node, int64_t p_tick, const uint8_t *p_buffer, int p_len, const Vector<Variant> &p_values) {
+	const Vector<Variant> *predicted = p_sync->get_recorded_state(p_tick);
+	if (predicted) {
+		// Compare encoded states, so packed properties match within their quantization step.
+		Vector<const Variant *> ptrs;
+		ptrs.resize(predicted->size());
+		for (int i = 0; i < predicted->size(); i++) {
+			ptrs.write[i] = &predicted->get(i);
+		}
+		Error err = _encode_values(p_sync->get_replication_config_ptr(), ptrs.ptrw(), ptrs.size(), value_cache);
+		if (err == OK && int(value_cache.size()) == p_len && (p_len == 0 || memcmp(value_cache.ptr(), p_buffer, p_len) == 0)) {
+			return OK; // Prediction was right.
+		}
+	}
+	Error err = MultiplayerSynchronizer::set_state(p_sync->get_replication_config_ptr()->get_sync_properties(), p_node, p_values);
+	ERR_FAIL_COND_V(err, err);
+	p_sync->store_state(p_tick, p_values);
+	MultiplayerSynchronizer *input = p_sync->get_prediction_input_synchronizer();
+	if (input && p_tick < network_tick && network_tick - p_tick < p_sync->get_prediction_history_size()) {
+		// Re-simulate the ticks predicted since the authoritative state, with the inputs used back then.
+		for (int64_t tick = p_tick + 1; tick <= network_tick; tick++) {
+			input->restore_state(tick);
+			p_sync->emit_signal(SNAME("simulate_tick"), tick, true);
+			p_sync->record_state(tick);
+		}
+		input->restore_state(network_tick);
+	}
+	p_sync->emit_signal(SNAME("reconciled"), p_tick);
+	return OK;
+}
+
+void SceneReplicationInterface::_run_tick(int64_t p_tick) {
+	// Signal handlers may add or remove synchronizers.
+	LocalVector<ObjectID> syncs;
+	for (const ObjectID &oid : sync_nodes) {
+		syncs.push_back(oid);
+	}
+	// Inputs first, so the simulation of this tick sees them.
+	for (const ObjectID &oid : syncs) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
+		if (sync && sync->get_prediction_mode() == MultiplayerSynchronizer::PREDICTION_INPUT && _has_authority(sync)) {
+			sync->record_state(p_tick);
+		}
+	}
+	for (const ObjectID &oid : syncs) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(oid);
+		if (!sync || sync->get_prediction_mode() != MultiplayerSynchronizer::PREDICTION_STATE) {
+			continue;
+		}
+		if (_has_authority(sync)) {
+			MultiplayerSynchronizer *input = sync->get_prediction_input_synchronizer();
+			if (input && !_has_authority(input)) {
+				// Keep the last known input when the one for this tick is missing.
+				input->restore_state(p_tick);
+			}
+		} else if (!_is_predicting(sync)) {
+			continue;
+		}
+		sync->emit_signal(SNAME("simulate_tick"), p_tick, false);
+		sync->record_state(p_tick);
+	}
+}
+
+void SceneReplicationInterface::_process_clock(uint64_t p_usec) {
+	if (clock_usec == 0) {
+		clock_usec = p_usec;
+	}
+	const uint64_t tick_usec = 1000000 / tick_rate;
+	tick_accumulator += p_usec - clock_usec;
+	clock_usec = p_usec;
+	int64_t ticks = tick_accumulator / tick_usec;
+	tick_accumulator -= ticks * tick_usec;
+	if (ticks > CLOCK_MAX_TICKS_PER_FRAME) {
+		ticks = CLOCK_MAX_TICKS_PER_FRAME; // Don't spiral after a hitch.
+	}
+
+	if (multiplayer->has_multiplayer_peer() && !multiplayer->is_server()) {
+		if (p_usec - last_clock_ping >= CLOCK_PING_MSEC * 1000 || last_clock_ping == 0) {
+			last_clock_ping = p_usec;
+			uint8_t buf[6];
+			buf[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_3_SHIFT);
+			buf[1] = CLOCK_PING;
+			encode_uint32(uint32_t(p_usec / 1000), &buf[2]);
+			_send_raw(buf, sizeof(buf), MultiplayerPeer::TARGET_PEER_SERVER, false);
+		}
+		// Converge to the server clock one tick per frame, unless too far off.
+		if (clock_correction > CLOCK_MAX_DRIFT || clock_correction < -CLOCK_MAX_DRIFT) {
+			network_tick = MAX(0, network_tick + clock_correction);
+			clock_correction = 0;
+		} else if (clock_correction > 0) {
+			ticks++;
+			clock_correction--;
+		} else if (clock_correction < 0 && ticks > 0) {
+			ticks--;
+			clock_correction++;
+		}
+	}
+
+	for (int64_t i = 0; i < ticks; i++) {
+		network_tick++;
+		_run_tick(network_tick);
+	}
+}
+
+Error SceneReplicationInterface::on_clock_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 6, ERR_INVALID_DATA, "Invalid clock packet received");
+	if (tick_rate <= 0) {
+		return OK; // Ticks disabled.
+	}
+	if (p_buffer[1] == CLOCK_PING) {
+		ERR_FAIL_COND_V(!multiplayer->is_server(), ERR_INVALID_DATA);
+		uint8_t buf[14];
+		buf[0] = p_buffer[0];
+		buf[1] = CLOCK_PONG;
+		memcpy(&buf[2], &p_buffer[2], 4);
+		encode_uint64(uint64_t(network_tick), &buf[6]);
+		return _send_raw(buf, sizeof(buf), p_from, false);
+	}
+	ERR_FAIL_COND_V(p_buffer[1] != CLOCK_PONG || p_buffer_len < 14, ERR_INVALID_DATA);
+	ERR_FAIL_COND_V(p_from != MultiplayerPeer::TARGET_PEER_SERVER, ERR_INVALID_DATA);
+	const uint32_t rtt_msec = uint32_t(OS::get_singleton()->get_ticks_usec() / 1000) - decode_uint32(&p_buffer[2]);
+	const int64_t server_tick = int64_t(decode_uint64(&p_buffer[6]));
+	// The pong took half a round trip to arrive, and inputs take another half to reach the server.
+	// Run ahead by a full round trip plus a margin, so inputs arrive before their tick is simulated.
+	const int64_t target = server_tick + (int64_t(rtt_msec) * tick_rate) / 1000 + CLOCK_MARGIN_TICKS;
+	if (!clock_synced) {
+		network_tick = target;
+		clock_synced = true;
+		clock_correction = 0;
+	} else {
+		clock_correction = target - network_tick;
+	}
 	return OK;
 }
 
@@ -918,3 +1569,79 @@ void SceneReplicationInterface::set_max_delta_packet_size(int p_size) {
 int SceneReplicationInterface::get_max_delta_packet_size() const {
 	return delta_mtu;
 }
+
+void SceneReplicationInterface::set_snapshot_delta_enabled(bool p_enabled) {
+	snapshot_delta_enabled = p_enabled;
+	if (!snapshot_delta_enabled) {
+		for (KeyValue<int, PeerInfo> &E : peers_info) {
+			E.value.sent_snapshots.clear();
+		}
+	}
+}
+
+bool SceneReplicationInterface::is_snapshot_delta_enabled() const {
+	return snapshot_delta_enabled;
+}
+
+void SceneReplicationInterface::set_interest_management_enabled(bool p_enabled) {
+	interest_enabled = p_enabled;
+	if (!interest_enabled) {
+		for (KeyValue<int, PeerInfo> &E : peers_info) {
+			E.value.interest_accumulator.clear();
+			E.value.interest_relevant.clear();
+			E.value.interest_order.clear();
+		}
+	}
+}
+
+bool SceneReplicationInterface::is_interest_management_enabled() const {
+	return interest_enabled;
+}
+
+void SceneReplicationInterface::set_interest_cell_size(real_t p_size) {
+	ERR_FAIL_COND_MSG(p_size <= 0, "Interest cell size must be greater than zero.");
+	interest_cell_size = p_size;
+}
+
+real_t SceneReplicationInterface::get_interest_cell_size() const {
+	return interest_cell_size;
+}
+
+void SceneReplicationInterface::set_interest_bandwidth_budget(int p_bytes) {
+	ERR_FAIL_COND_MSG(p_bytes < 0, "Interest bandwidth budget cannot be negative.");
+	interest_budget = p_bytes;
+}
+
+int SceneReplicationInterface::get_interest_bandwidth_budget() const {
+	return interest_budget;
+}
+
+void SceneReplicationInterface::set_peer_interest(int p_peer, const Vector3 &p_origin, real_t p_radius) {
+	ERR_FAIL_COND_MSG(p_radius < 0, "Interest radius cannot be negative.");
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_NULL_MSG(info, vformat("Unknown peer: %d", p_peer));
+	info->has_view = true;
+	info->view_origin = p_origin;
+	info->view_radius = p_radius;
+}
+
+void SceneReplicationInterface::clear_peer_interest(int p_peer) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_NULL_MSG(info, vformat("Unknown peer: %d", p_peer));
+	info->has_view = false;
+}
+
+void SceneReplicationInterface::set_tick_rate(int p_rate) {
+	ERR_FAIL_COND_MSG(p_rate < 0, "Tick rate must be positive, or 0 to disable network ticks.");
+	tick_rate = p_rate;
+	clock_usec = 0;
+	tick_accumulator = 0;
+}
+
+int SceneReplicationInterface::get_tick_rate() const {
+	return tick_rate;
+}
+
+int64_t SceneReplicationInterface::get_network_tick() const {
+	return network_tick;
+}
@@ -33,6 +33,7 @@
 
 #include "multiplayer_spawner.h"
 #include "multiplayer_synchronizer.h"
+#include "scene_replication_schema.h"
 
 #include "core/object/ref_counted.h"
 
@@ -60,6 +61,39 @@ private:
 		}
 	};
 
+	enum {
+		SNAPSHOT_HISTORY = 64, // Must be a power of two.
+		PREDICTION_INPUT_REDUNDANCY = 4, // Most recent input ticks sent in every packet.
+		CLOCK_MAX_TICKS_PER_FRAME = 8,
+		CLOCK_MAX_DRIFT = 8, // Ticks, beyond this the clock jumps instead of converging.
+		CLOCK_MARGIN_TICKS = 2, // Extra lead of clients, so inputs reach the server in time.
+		CLOCK_PING_MSEC = 500,
+	};
+
+	enum ClockCommand {
+		CLOCK_PING,
+		CLOCK_PONG,
+	};
+
+	enum SnapshotKind {
+		SNAPSHOT_FULL,
+		SNAPSHOT_DELTA,
+	};
+
+	// Ring buffer of the encoded states of one synchronizer, indexed by snapshot ID.
+	struct SnapshotHistory {
+		uint32_t ids[SNAPSHOT_HISTORY] = {}; // Snapshot ID + 1, 0 when unused.
+		LocalVector<uint8_t> states[SNAPSHOT_HISTORY];
+		uint32_t baseline = 0; // Latest snapshot ID + 1 acknowledged by the remote, 0 if none.
+	};
+
+	struct InterestEntry {
+		ObjectID id;
+		float score = 0;
+
+		bool operator<(const InterestEntry &p_other) const { return score > p_other.score; } // Highest priority first.
+	};
+
 	struct PeerInfo {
 		HashSet<ObjectID> sync_nodes;
 		HashSet<ObjectID> spawn_nodes;
@@ -67,6 +101,30 @@ private:
 		HashMap<uint32_t, ObjectID> recv_sync_ids;
 		HashMap<uint32_t, ObjectID> recv_nodes;
 		uint16_t last_sent_sync = 0;
+
+		// Snapshot deltas, as sender.
+		uint16_t last_snapshot = 0;
+		uint32_t snapshot_packet_ids[SNAPSHOT_HISTORY] = {}; // Snapshot ID + 1, 0 when unused.
+		LocalVector<ObjectID> snapshot_packets[SNAPSHOT_HISTORY]; // Synchronizers sent in each snapshot packet.
+		HashMap<ObjectID, SnapshotHistory> sent_snapshots;
+		// Snapshot deltas, as receiver.
+		HashMap<ObjectID, SnapshotHistory> recv_snapshots;
+		LocalVector<uint16_t> snapshot_acks;
+
+		// Interest management.
+		bool has_view = false;
+		Vector3 view_origin;
+		real_t view_radius = 0;
+		HashMap<ObjectID, float> interest_accumulator; // Priority carried over from frames where the object did not fit the budget.
+		LocalVector<InterestEntry> interest_relevant; // Sorted by descending priority.
+		LocalVector<ObjectID> interest_order;
+	};
+
+	struct InterestCandidate {
+		ObjectID id;
+		Vector3 position;
+		float priority = 1.0;
+		bool spatial = false;
 	};
 
 	// Replication state.
@@ -90,8 +148,33 @@ private:
 	SceneMultiplayer *multiplayer = nullptr;
 	SceneCacheInterface *multiplayer_cache = nullptr;
 	PackedByteArray packet_cache;
+	SceneReplicationSchema::BitWriter schema_writer;
+	LocalVector<SceneReplicationConfig::PropertySchema> delta_schema;
 	int sync_mtu = 1350; // Highly dependent on underlying protocol.
 	int delta_mtu = 65535;
+	bool snapshot_delta_enabled = false;
+	LocalVector<uint8_t> state_cache;
+	LocalVector<uint8_t> snapshot_payload;
+	LocalVector<uint8_t> value_cache;
+
+	// Network clock.
+	int tick_rate = 0;
+	int64_t network_tick = 0;
+	uint64_t clock_usec = 0;
+	uint64_t tick_accumulator = 0;
+	int64_t clock_correction = 0;
+	uint64_t last_clock_ping = 0;
+	bool clock_synced = false;
+
+	// Interest management.
+	bool interest_enabled = false;
+	real_t interest_cell_size = 64;
+	int interest_budget = 0; // Bytes per peer per network frame, 0 is unlimited.
+	LocalVector<InterestCandidate> interest_candidates;
+	HashSet<ObjectID> interest_deferred;
+	LocalVector<uint32_t> interest_global; // Candidates without a spatial root, relevant to every peer.
+	HashMap<Vector3i, LocalVector<uint32_t>> interest_grid;
+	LocalVector<PeerInfo *> interest_peers;
 
 	TrackedNode &_track(const ObjectID &p_id);
 	void _untrack(const ObjectID &p_id);
@@ -101,8 +184,28 @@ private:
 	bool _verify_synchronizer(int p_peer, MultiplayerSynchronizer *p_sync, uint32_t &r_net_id);
 	MultiplayerSynchronizer *_find_synchronizer(int p_peer, uint32_t p_net_ida);
 
-	void _send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec);
-	void _send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs);
+	void _get_delta_schema(SceneReplicationConfig *p_config, uint64_t p_indexes);
+	// Synchronizers that have something to send but don't fit r_budget are added to r_deferred.
+	void _send_sync(int p_peer, const LocalVector<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec, int &r_budget, HashSet<ObjectID> *r_deferred = nullptr);
+	void _send_delta(int p_peer, const LocalVector<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs, int &r_budget, HashSet<ObjectID> *r_deferred = nullptr);
+	Error _encode_values(SceneReplicationConfig *p_config, const Variant **p_values, int p_count, LocalVector<uint8_t> &r_buffer);
+	Error _decode_values(MultiplayerSynchronizer *p_sync, const uint8_t *p_buffer, int p_len, Vector<Variant> &r_values);
+	Error _encode_sync_state(MultiplayerSynchronizer *p_sync, Node *p_node, bool p_with_ticks, LocalVector<uint8_t> &r_buffer);
+
+	void _process_clock(uint64_t p_usec);
+	void _run_tick(int64_t p_tick);
+	bool _is_predicting(MultiplayerSynchronizer *p_sync);
+	Error _receive_inputs(MultiplayerSynchronizer *p_sync, Node *p_node, const uint8_t *p_buffer, int p_len);
+	Error _reconcile(MultiplayerSynchronizer *p_sync, Node *p_node, int64_t p_tick, const uint8_t *p_buffer, int p_len, const Vector<Variant> &p_values);
+
+	uint16_t _begin_snapshot_packet(PeerInfo &p_info);
+	void _make_snapshot_payload(PeerInfo &p_info, const ObjectID &p_oid);
+	void _store_snapshot(PeerInfo &p_info, const ObjectID &p_oid, uint16_t p_snapshot_id);
+	Error _read_snapshot(PeerInfo &p_info, const ObjectID &p_oid, uint16_t p_snapshot_id, const uint8_t *p_buffer, int p_len);
+	void _send_snapshot_acks();
+	void _update_interest_grid();
+	void _compute_peer_interest(uint32_t p_index, PeerInfo **p_peers);
+	void _process_interest(uint64_t p_usec);
 	Error _make_spawn_packet(Node *p_node, MultiplayerSpawner *p_spawner, int &r_len);
 	Error _make_despawn_packet(Node *p_node, int &r_len);
 	Error _send_raw(const uint8_t *p_buffer, int p_size, int p_peer, bool p_reliable);
@@ -137,6 +240,8 @@ public:
 	Error on_despawn_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 	Error on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 	Error on_delta_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
+	Error on_snapshot_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
+	Error on_clock_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 
 	bool is_rpc_visible(const ObjectID &p_oid, int p_peer) const;
 
@@ -146,6 +251,25 @@ public:
 	void set_max_delta_packet_size(int p_size);
 	int get_max_delta_packet_size() const;
 
+	void set_tick_rate(int p_rate);
+	int get_tick_rate() const;
+	int64_t get_network_tick() const;
+
+	void set_snapshot_delta_enabled(bool p_enabled);
+	bool is_snapshot_delta_enabled() const;
+
+	void set_interest_management_enabled(bool p_enabled);
+	bool is_interest_management_enabled() const;
+
+	void set_interest_cell_size(real_t p_size);
+	real_t get_interest_cell_size() const;
+
+	void set_interest_bandwidth_budget(int p_bytes);
+	int get_interest_bandwidth_budget() const;
+
+	void set_peer_interest(int p_peer, const Vector3 &p_origin, real_t p_radius);
+	void clear_peer_interest(int p_peer);
+
 	SceneReplicationInterface(SceneMultiplayer *p_multiplayer, SceneCacheInterface *p_cache) {
 		multiplayer = p_multiplayer;
 		multiplayer_cache = p_cache;
@@ -0,0 +1,420 @@
+/**************************************************************************/
+/*  scene_replication_schema.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_replication_schema.h"
+
+#include "core/io/marshalls.h"
+
+void SceneReplicationSchema::BitWriter::write_bits(uint64_t p_value, int p_bits) {
+	while (p_bits > 0) {
+		uint32_t shift = bit_count & 7;
+		if (shift == 0) {
+			data.push_back(0);
+		}
+		int n = MIN(8 - int(shift), p_bits);
+		data[bit_count >> 3] |= uint8_t((p_value & ((1 << n) - 1)) << shift);
+		p_value >>= n;
+		p_bits -= n;
+		bit_count += n;
+	}
+}
+
+void SceneReplicationSchema::BitWriter::write_varint(uint64_t p_value) {
+	do {
+		uint8_t byte = p_value & 0x7F;
+		p_value >>= 7;
+		write_bits(byte | (p_value ? 0x80 : 0), 8);
+	} while (p_value);
+}
+
+void SceneReplicationSchema::BitWriter::write_bytes(const uint8_t *p_data, int p_size) {
+	for (int i = 0; i < p_size; i++) {
+		write_bits(p_data[i], 8);
+	}
+}
+
+void SceneReplicationSchema::BitWriter::clear() {
+	data.clear();
+	bit_count = 0;
+}
+
+uint64_t SceneReplicationSchema::BitReader::read_bits(int p_bits) {
+	uint64_t value = 0;
+	int read = 0;
+	while (p_bits > 0) {
+		uint32_t byte = bit_count >> 3;
+		if (byte >= uint32_t(size)) {
+			error = true;
+			return 0;
+		}
+		uint32_t shift = bit_count & 7;
+		int n = MIN(8 - int(shift), p_bits);
+		value |= uint64_t((data[byte] >> shift) & ((1 << n) - 1)) << read;
+		read += n;
+		p_bits -= n;
+		bit_count += n;
+	}
+	return value;
+}
+
+uint64_t SceneReplicationSchema::BitReader::read_varint() {
+	uint64_t value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		uint64_t byte = read_bits(8);
+		value |= (byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			return value;
+		}
+	}
+	error = true;
+	return 0;
+}
+
+void SceneReplicationSchema::BitReader::read_bytes(uint8_t *r_data, int p_size) {
+	for (int i = 0; i < p_size; i++) {
+		r_data[i] = read_bits(8);
+	}
+}
+
+static _FORCE_INLINE_ uint64_t _zigzag_encode(int64_t p_value) {
+	return (uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63);
+}
+
+static _FORCE_INLINE_ int64_t _zigzag_decode(uint64_t p_value) {
+	return int64_t(p_value >> 1) ^ -int64_t(p_value & 1);
+}
+
+bool SceneReplicationSchema::is_supported(const PropertySchema &p_schema) {
+	const Variant::Type type = p_schema.type;
+	switch (p_schema.encoding) {
+		case SceneReplicationConfig::PROPERTY_ENCODING_VARINT:
+			return type == Variant::BOOL || type == Variant::INT || type == Variant::VECTOR2I || type == Variant::VECTOR3I || type == Variant::VECTOR4I;
+		case SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED:
+			return type == Variant::FLOAT || type == Variant::VECTOR2 || type == Variant::VECTOR3 || type == Variant::VECTOR4 || type == Variant::COLOR || type == Variant::QUATERNION;
+		case SceneReplicationConfig::PROPERTY_ENCODING_SMALLEST_THREE:
+			return type == Variant::QUATERNION;
+		default:
+			return false;
+	}
+}
+
+void SceneReplicationSchema::_write_quantized(BitWriter &p_writer, real_t p_value, real_t p_min, real_t p_max, int p_bits) {
+	const uint64_t steps = (uint64_t(1) << p_bits) - 1;
+	double t = (CLAMP(p_value, p_min, p_max) - p_min) / double(p_max - p_min);
+	p_writer.write_bits(uint64_t(Math::round(t * steps)), p_bits);
+}
+
+real_t SceneReplicationSchema::_read_quantized(BitReader &p_reader, real_t p_min, real_t p_max, int p_bits) {
+	const uint64_t steps = (uint64_t(1) << p_bits) - 1;
+	return p_min + (p_max - p_min) * (double(p_reader.read_bits(p_bits)) / steps);
+}
+
+Error SceneReplicationSchema::_encode_value(BitWriter &p_writer, const PropertySchema &p_schema, const Variant &p_value) {
+	if (!is_supported(p_schema)) {
+		int len = 0;
+		Error err = encode_variant(p_value, nullptr, len, false);
+		ERR_FAIL_COND_V(err != OK, err);
+		Vector<uint8_t> buf;
+		buf.resize(len);
+		encode_variant(p_value, buf.ptrw(), len, false);
+		p_writer.write_varint(len);
+		p_writer.write_bytes(buf.ptr(), len);
+		return OK;
+	}
+
+	Variant value = p_value;
+	if (value.get_type() != p_schema.type) {
+		// The receiver decodes using the schema type, so the value has to be sent as such.
+		ERR_FAIL_COND_V_MSG(!Variant::can_convert_strict(value.get_type(), p_schema.type), ERR_INVALID_PARAMETER, vformat("Can't encode a %s value as %s.", Variant::get_type_name(value.get_type()), Variant::get_type_name(p_schema.type)));
+		Callable::CallError ce;
+		const Variant *args[1] = { &p_value };
+		Variant::construct(p_schema.type, value, args, 1, ce);
+		ERR_FAIL_COND_V(ce.error != Callable::CallError::CALL_OK, ERR_INVALID_PARAMETER);
+	}
+
+	const real_t min = p_schema.range_min;
+	const real_t max = p_schema.range_max;
+	const int bits = p_schema.bits;
+
+	switch (p_schema.type) {
+		case Variant::BOOL: {
+			p_writer.write_bits(value.operator bool() ? 1 : 0, 1);
+		} break;
+		case Variant::INT: {
+			p_writer.write_varint(_zigzag_encode(value));
+		} break;
+		case Variant::VECTOR2I: {
+			Vector2i v = value;
+			p_writer.write_varint(_zigzag_encode(v.x));
+			p_writer.write_varint(_zigzag_encode(v.y));
+		} break;
+		case Variant::VECTOR3I: {
+			Vector3i v = value;
+			for (int i = 0; i < 3; i++) {
+				p_writer.write_varint(_zigzag_encode(v[i]));
+			}
+		} break;
+		case Variant::VECTOR4I: {
+			Vector4i v = value;
+			for (int i = 0; i < 4; i++) {
+				p_writer.write_varint(_zigzag_encode(v[i]));
+			}
+		} break;
+		case Variant::FLOAT: {
+			_write_quantized(p_writer, value, min, max, bits);
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v = value;
+			_write_quantized(p_writer, v.x, min, max, bits);
+			_write_quantized(p_writer, v.y, min, max, bits);
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = value;
+			for (int i = 0; i < 3; i++) {
+				_write_quantized(p_writer, v[i], min, max, bits);
+			}
+		} break;
+		case Variant::VECTOR4: {
+			Vector4 v = value;
+			for (int i = 0; i < 4; i++) {
+				_write_quantized(p_writer, v[i], min, max, bits);
+			}
+		} break;
+		case Variant::COLOR: {
+			Color c = value;
+			for (int i = 0; i < 4; i++) {
+				_write_quantized(p_writer, c.components[i], min, max, bits);
+			}
+		} break;
+		case Variant::QUATERNION: {
+			Quaternion q = value;
+			if (p_schema.encoding == SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED) {
+				for (int i = 0; i < 4; i++) {
+					_write_quantized(p_writer, q[i], -1.0, 1.0, bits);
+				}
+				break;
+			}
+			// Smallest three: the largest component is implied by the others since the quaternion is normalized.
+			q.normalize();
+			int largest = 0;
+			for (int i = 1; i < 4; i++) {
+				if (Math::abs(q[i]) > Math::abs(q[largest])) {
+					largest = i;
+				}
+			}
+			if (q[largest] < 0) {
+				q = -q;
+			}
+			p_writer.write_bits(largest, 2);
+			for (int i = 0; i < 4; i++) {
+				if (i != largest) {
+					_write_quantized(p_writer, q[i], -Math_SQRT12, Math_SQRT12, bits);
+				}
+			}
+		} break;
+		default: {
+			ERR_FAIL_V(ERR_BUG);
+		}
+	}
+	return OK;
+}
+
+Error SceneReplicationSchema::_decode_value(BitReader &p_reader, const PropertySchema &p_schema, Variant &r_value) {
+	if (!is_supported(p_schema)) {
+		uint64_t len = p_reader.read_varint();
+		ERR_FAIL_COND_V(p_reader.has_error() || len > (1 << 24), ERR_INVALID_DATA);
+		Vector<uint8_t> buf;
+		buf.resize(len);
+		p_reader.read_bytes(buf.ptrw(), len);
+		ERR_FAIL_COND_V(p_reader.has_error(), ERR_INVALID_DATA);
+		return decode_variant(r_value, buf.ptr(), len, nullptr, false);
+	}
+
+	const real_t min = p_schema.range_min;
+	const real_t max = p_schema.range_max;
+	const int bits = p_schema.bits;
+
+	switch (p_schema.type) {
+		case Variant::BOOL: {
+			r_value = p_reader.read_bits(1) != 0;
+		} break;
+		case Variant::INT: {
+			r_value = _zigzag_decode(p_reader.read_varint());
+		} break;
+		case Variant::VECTOR2I: {
+			Vector2i v;
+			v.x = _zigzag_decode(p_reader.read_varint());
+			v.y = _zigzag_decode(p_reader.read_varint());
+			r_value = v;
+		} break;
+		case Variant::VECTOR3I: {
+			Vector3i v;
+			for (int i = 0; i < 3; i++) {
+				v[i] = _zigzag_decode(p_reader.read_varint());
+			}
+			r_value = v;
+		} break;
+		case Variant::VECTOR4I: {
+			Vector4i v;
+			for (int i = 0; i < 4; i++) {
+				v[i] = _zigzag_decode(p_reader.read_varint());
+			}
+			r_value = v;
+		} break;
+		case Variant::FLOAT: {
+			r_value = _read_quantized(p_reader, min, max, bits);
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v;
+			v.x = _read_quantized(p_reader, min, max, bits);
+			v.y = _read_quantized(p_reader, min, max, bits);
+			r_value = v;
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v;
+			for (int i = 0; i < 3; i++) {
+				v[i] = _read_quantized(p_reader, min, max, bits);
+			}
+			r_value = v;
+		} break;
+		case Variant::VECTOR4: {
+			Vector4 v;
+			for (int i = 0; i < 4; i++) {
+				v[i] = _read_quantized(p_reader, min, max, bits);
+			}
+			r_value = v;
+		} break;
+		case Variant::COLOR: {
+			Color c;
+			for (int i = 0; i < 4; i++) {
+				c.components[i] = _read_quantized(p_reader, min, max, bits);
+			}
+			r_value = c;
+		} break;
+		case Variant::QUATERNION: {
+			Quaternion q;
+			if (p_schema.encoding == SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED) {
+				for (int i = 0; i < 4; i++) {
+					q[i] = _read_quantized(p_reader, -1.0, 1.0, bits);
+				}
+				r_value = q;
+				break;
+			}
+			int largest = p_reader.read_bits(2);
+			real_t sum = 0;
+			for (int i = 0; i < 4; i++) {
+				if (i != largest) {
+					q[i] = _read_quantized(p_reader, -Math_SQRT12, Math_SQRT12, bits);
+					sum += q[i] * q[i];
+				}
+			}
+			q[largest] = Math::sqrt(MAX(0, 1 - sum));
+			r_value = q;
+		} break;
+		default: {
+			ERR_FAIL_V(ERR_BUG);
+		}
+	}
+	return p_reader.has_error() ? ERR_INVALID_DATA : OK;
+}
+
+Error SceneReplicationSchema::encode(const PropertySchema *p_schema, const Variant **p_values, int p_count, BitWriter &r_writer) {
+	r_writer.clear();
+	for (int i = 0; i < p_count; i++) {
+		Error err = _encode_value(r_writer, p_schema[i], *p_values[i]);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	return OK;
+}
+
+Error SceneReplicationSchema::decode(const PropertySchema *p_schema, int p_count, const uint8_t *p_buffer, int p_len, Vector<Variant> &r_values, int &r_consumed) {
+	BitReader reader(p_buffer, p_len);
+	r_values.resize(p_count);
+	Variant *ptrw = r_values.ptrw();
+	for (int i = 0; i < p_count; i++) {
+		Error err = _decode_value(reader, p_schema[i], ptrw[i]);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	r_consumed = reader.get_bytes_read();
+	return OK;
+}
+
+// Each token is a byte: with the high bit set it stands for (low bits + 1) unchanged bytes,
+// otherwise it is followed by (token + 1) XORed bytes.
+void SceneReplicationSchema::encode_xor_delta(const uint8_t *p_state, const uint8_t *p_baseline, int p_size, LocalVector<uint8_t> &r_delta) {
+	int i = 0;
+	while (i < p_size) {
+		int run = 0;
+		while (i + run < p_size && run < 128 && p_state[i + run] == p_baseline[i + run]) {
+			run++;
+		}
+		if (run) {
+			r_delta.push_back(0x80 | (run - 1));
+			i += run;
+			continue;
+		}
+		// Literals absorb isolated unchanged bytes, a run token would not be shorter.
+		int literal = 0;
+		while (i + literal < p_size && literal < 128) {
+			const int at = i + literal;
+			if (p_state[at] == p_baseline[at] && (at + 1 >= p_size || p_state[at + 1] == p_baseline[at + 1])) {
+				break;
+			}
+			literal++;
+		}
+		r_delta.push_back(literal - 1);
+		for (int j = 0; j < literal; j++) {
+			r_delta.push_back(p_state[i + j] ^ p_baseline[i + j]);
+		}
+		i += literal;
+	}
+}
+
+Error SceneReplicationSchema::decode_xor_delta(const uint8_t *p_delta, int p_delta_len, const uint8_t *p_baseline, int p_size, uint8_t *r_state) {
+	int ofs = 0;
+	int i = 0;
+	while (ofs < p_delta_len) {
+		const uint8_t token = p_delta[ofs++];
+		const int count = (token & 0x7F) + 1;
+		ERR_FAIL_COND_V(i + count > p_size, ERR_INVALID_DATA);
+		if (token & 0x80) {
+			memcpy(&r_state[i], &p_baseline[i], count);
+		} else {
+			ERR_FAIL_COND_V(ofs + count > p_delta_len, ERR_INVALID_DATA);
+			for (int j = 0; j < count; j++) {
+				r_state[i + j] = p_baseline[i + j] ^ p_delta[ofs + j];
+			}
+			ofs += count;
+		}
+		i += count;
+	}
+	ERR_FAIL_COND_V(i != p_size, ERR_INVALID_DATA);
+	return OK;
+}
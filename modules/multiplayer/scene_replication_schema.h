@@ -0,0 +1,97 @@
+/**************************************************************************/
+/*  scene_replication_schema.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SCENE_REPLICATION_SCHEMA_H
+#define SCENE_REPLICATION_SCHEMA_H
+
+#include "scene_replication_config.h"
+
+#include "core/templates/local_vector.h"
+
+// Bit-packs synchronizer states according to the property schemas of a SceneReplicationConfig.
+// Properties whose schema type is not supported by their encoding fall back to the Variant encoding.
+// Both sides only rely on the schema to know how each value is encoded.
+class SceneReplicationSchema {
+public:
+	class BitWriter {
+		LocalVector<uint8_t> data;
+		uint32_t bit_count = 0;
+
+	public:
+		void write_bits(uint64_t p_value, int p_bits);
+		void write_varint(uint64_t p_value);
+		void write_bytes(const uint8_t *p_data, int p_size);
+
+		const uint8_t *get_data() const { return data.ptr(); }
+		int get_size() const { return data.size(); }
+		void clear();
+	};
+
+	class BitReader {
+		const uint8_t *data = nullptr;
+		int size = 0;
+		uint32_t bit_count = 0;
+		bool error = false;
+
+	public:
+		uint64_t read_bits(int p_bits);
+		uint64_t read_varint();
+		void read_bytes(uint8_t *r_data, int p_size);
+
+		bool has_error() const { return error; }
+		int get_bytes_read() const { return (bit_count + 7) >> 3; }
+
+		BitReader(const uint8_t *p_data, int p_size) {
+			data = p_data;
+			size = p_size;
+		}
+	};
+
+private:
+	typedef SceneReplicationConfig::PropertySchema PropertySchema;
+
+	static void _write_quantized(BitWriter &p_writer, real_t p_value, real_t p_min, real_t p_max, int p_bits);
+	static real_t _read_quantized(BitReader &p_reader, real_t p_min, real_t p_max, int p_bits);
+	static Error _encode_value(BitWriter &p_writer, const PropertySchema &p_schema, const Variant &p_value);
+	static Error _decode_value(BitReader &p_reader, const PropertySchema &p_schema, Variant &r_value);
+
+public:
+	// Whether the schema type can be encoded with the schema encoding.
+	static bool is_supported(const PropertySchema &p_schema);
+	static Error encode(const PropertySchema *p_schema, const Variant **p_values, int p_count, BitWriter &r_writer);
+	static Error decode(const PropertySchema *p_schema, int p_count, const uint8_t *p_buffer, int p_len, Vector<Variant> &r_values, int &r_consumed);
+
+	// Snapshot deltas are the XOR of a state with its baseline, with runs of unchanged bytes collapsed.
+	// The encoded delta is appended to r_delta.
+	static void encode_xor_delta(const uint8_t *p_state, const uint8_t *p_baseline, int p_size, LocalVector<uint8_t> &r_delta);
+	static Error decode_xor_delta(const uint8_t *p_delta, int p_delta_len, const uint8_t *p_baseline, int p_size, uint8_t *r_state);
+};
+
+#endif // SCENE_REPLICATION_SCHEMA_H
@@ -164,6 +164,11 @@ void SceneRPCInterface::process_rpc(int p_from, const uint8_t *p_packet, int p_p
 	int node_id_compression = (p_packet[0] & NODE_ID_COMPRESSION_FLAG) >> NODE_ID_COMPRESSION_SHIFT;
 	int name_id_compression = (p_packet[0] & NAME_ID_COMPRESSION_FLAG) >> NAME_ID_COMPRESSION_SHIFT;
 
+	if (node_id_compression == NETWORK_NODE_ID_COMPRESSION_BATCH) {
+		_process_batch(p_from, p_packet, p_packet_len);
+		return;
+	}
+
 	switch (node_id_compression) {
 		case NETWORK_NODE_ID_COMPRESSION_8:
 			packet_min_size += 1;
@@ -228,6 +233,52 @@ void SceneRPCInterface::process_rpc(int p_from, const uint8_t *p_packet, int p_p
 	_process_rpc(node, name_id, p_from, p_packet, packet_len, packet_min_size);
 }
 
+int SceneRPCInterface::get_batch_entry_size(int p_packet_len) {
+	return (p_packet_len < 0x80 ? 1 : 2) + p_packet_len;
+}
+
+void SceneRPCInterface::encode_batch_entry(const uint8_t *p_packet, int p_packet_len, LocalVector<uint8_t> &r_batch) {
+	ERR_FAIL_COND(p_packet_len < 1 || p_packet_len > BATCH_ENTRY_MAX_SIZE);
+	if (p_packet_len < 0x80) {
+		r_batch.push_back(p_packet_len);
+	} else {
+		r_batch.push_back(0x80 | (p_packet_len >> 8));
+		r_batch.push_back(p_packet_len & 0xFF);
+	}
+	const uint32_t ofs = r_batch.size();
+	r_batch.resize(ofs + p_packet_len);
+	memcpy(&r_batch[ofs], p_packet, p_packet_len);
+}
+
+Error SceneRPCInterface::decode_batch_entry(const uint8_t *p_batch, int p_batch_len, int &r_ofs, const uint8_t *&r_packet, int &r_packet_len) {
+	ERR_FAIL_COND_V_MSG(r_ofs >= p_batch_len, ERR_INVALID_DATA, "Invalid RPC batch received. Size too small.");
+	int len = p_batch[r_ofs++];
+	if (len & 0x80) {
+		ERR_FAIL_COND_V_MSG(r_ofs >= p_batch_len, ERR_INVALID_DATA, "Invalid RPC batch received. Size too small.");
+		len = ((len & 0x7F) << 8) | p_batch[r_ofs++];
+	}
+	ERR_FAIL_COND_V_MSG(len < 1 || len > p_batch_len - r_ofs, ERR_INVALID_DATA, "Invalid RPC batch received. Size too small.");
+	r_packet = &p_batch[r_ofs];
+	r_packet_len = len;
+	r_ofs += len;
+	return OK;
+}
+
+void SceneRPCInterface::_process_batch(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	// Batch meta, followed by each RPC packet.
+	int ofs = 1;
+	while (ofs < p_packet_len) {
+		const uint8_t *packet = nullptr;
+		int len = 0;
+		if (decode_batch_entry(p_packet, p_packet_len, ofs, packet, len) != OK) {
+			return;
+		}
+		ERR_CONTINUE_MSG((packet[0] & SceneMultiplayer::CMD_MASK) != SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL, "Invalid RPC batch received. Only RPCs can be batched.");
+		ERR_CONTINUE_MSG(((packet[0] & NODE_ID_COMPRESSION_FLAG) >> NODE_ID_COMPRESSION_SHIFT) == NETWORK_NODE_ID_COMPRESSION_BATCH, "Invalid RPC batch received. Batches cannot be nested.");
+		process_rpc(p_from, packet, len);
+	}
+}
+
 void SceneRPCInterface::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset) {
 	ERR_FAIL_COND_MSG(p_offset > p_packet_len, "Invalid packet received. Size too small.");
 
@@ -429,7 +480,7 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 
 	if (has_all_peers) {
 		for (const int P : targets) {
-			multiplayer->send_command(P, packet_cache.ptr(), ofs);
+			_send_command(P, p_config, packet_cache.ptr(), ofs);
 		}
 	} else {
 		// Unreachable because the node ID is never compressed if the peers doesn't know it.
@@ -449,16 +500,130 @@ void SceneRPCInterface::_send_rpc(Node *p_node, int p_to, uint16_t p_rpc_id, con
 			if (confirmed) {
 				// This one confirmed path, so use id.
 				encode_uint32(psc_id, &(packet_cache.write[1]));
-				multiplayer->send_command(P, packet_cache.ptr(), ofs);
+				_send_command(P, p_config, packet_cache.ptr(), ofs);
 			} else {
 				// This one did not confirm path yet, so use entire path (sorry!).
 				encode_uint32(0x80000000 | ofs, &(packet_cache.write[1])); // Offset to path and flag.
-				multiplayer->send_command(P, packet_cache.ptr(), ofs + path_len);
+				_send_command(P, p_config, packet_cache.ptr(), ofs + path_len);
 			}
 		}
 	}
 }
 
+void SceneRPCInterface::_send_command(int p_to, const RPCConfig &p_config, const uint8_t *p_packet, int p_packet_len) {
+	if (!batching_enabled) {
+		multiplayer->send_command(p_to, p_packet, p_packet_len);
+		return;
+	}
+	const uint64_t key = (uint64_t(uint32_t(p_to)) << 32) | (uint64_t(uint16_t(p_config.channel)) << 8) | uint64_t(p_config.transfer_mode);
+	RPCBatch *batch = batches.getptr(key);
+	if (!batch) {
+		batch = &batches[key];
+		batch->peer = p_to;
+		batch->channel = p_config.channel;
+		batch->transfer_mode = p_config.transfer_mode;
+	}
+	const int entry_size = get_batch_entry_size(p_packet_len);
+	if (1 + entry_size > batch_mtu) {
+		// Too big to be batched, preserve ordering by sending what was queued first.
+		_flush_batch(*batch);
+		Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
+		peer->set_transfer_channel(p_config.channel);
+		peer->set_transfer_mode(p_config.transfer_mode);
+		multiplayer->send_command(p_to, p_packet, p_packet_len);
+		return;
+	}
+	if (int(batch->data.size()) + entry_size > batch_mtu) {
+		_flush_batch(*batch);
+	}
+	if (batch->data.is_empty()) {
+		batch->data.push_back(SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL | (NETWORK_NODE_ID_COMPRESSION_BATCH << NODE_ID_COMPRESSION_SHIFT));
+	}
+	encode_batch_entry(p_packet, p_packet_len, batch->data);
+	batch->count++;
+	batches_pending = true;
+}
+
+void SceneRPCInterface::_flush_batch(RPCBatch &p_batch) {
+	if (p_batch.data.is_empty()) {
+		return;
+	}
+	Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
+	peer->set_transfer_channel(p_batch.channel);
+	peer->set_transfer_mode(p_batch.transfer_mode);
+	flushing = true; // Sending the batch must not flush the other ones.
+	if (p_batch.count == 1) {
+		// No need for the batch meta.
+		const int header = p_batch.data[1] & 0x80 ? 3 : 2;
+		multiplayer->send_command(p_batch.peer, &p_batch.data[header], p_batch.data.size() - header);
+	} else {
+		multiplayer->send_command(p_batch.peer, p_batch.data.ptr(), p_batch.data.size());
+	}
+	flushing = false;
+#ifdef DEBUG_ENABLED
+	if (EngineDebugger::is_profiling("multiplayer:bandwidth")) {
+		Array values;
+		values.push_back("rpc_batch");
+		values.push_back(OS::get_singleton()->get_ticks_msec());
+		values.push_back(p_batch.count - 1); // Packets saved.
+		EngineDebugger::profiler_add_frame_data("multiplayer:bandwidth", values);
+	}
+#endif
+	p_batch.data.clear();
+	p_batch.count = 0;
+}
+
+void SceneRPCInterface::flush_batches() {
+	if (!has_pending_batches()) {
+		return;
+	}
+	for (KeyValue<uint64_t, RPCBatch> &E : batches) {
+		_flush_batch(E.value);
+	}
+	batches_pending = false;
+}
+
+void SceneRPCInterface::on_peer_change(int p_id, bool p_connected) {
+	if (p_connected) {
+		return;
+	}
+	// Drop what was queued for the peer.
+	LocalVector<uint64_t> to_erase;
+	for (const KeyValue<uint64_t, RPCBatch> &E : batches) {
+		if (E.value.peer == p_id) {
+			to_erase.push_back(E.key);
+		}
+	}
+	for (const uint64_t &key : to_erase) {
+		batches.erase(key);
+	}
+}
+
+void SceneRPCInterface::on_reset() {
+	batches.clear();
+	batches_pending = false;
+}
+
+void SceneRPCInterface::set_batching_enabled(bool p_enabled) {
+	if (batching_enabled && !p_enabled) {
+		flush_batches();
+	}
+	batching_enabled = p_enabled;
+}
+
+bool SceneRPCInterface::is_batching_enabled() const {
+	return batching_enabled;
+}
+
+void SceneRPCInterface::set_max_batch_size(int p_size) {
+	ERR_FAIL_COND_MSG(p_size < 128 || p_size > 32767, "RPC batch maximum size must be between 128 and 32767 bytes.");
+	batch_mtu = p_size;
+}
+
+int SceneRPCInterface::get_max_batch_size() const {
+	return batch_mtu;
+}
+
 Error SceneRPCInterface::rpcp(Object *p_obj, int p_peer_id, const StringName &p_method, const Variant **p_arg, int p_argcount) {
 	Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
 	ERR_FAIL_COND_V_MSG(!peer.is_valid(), ERR_UNCONFIGURED, "Trying to call an RPC while no multiplayer peer is active.");
@@ -71,6 +71,7 @@ private:
 		NETWORK_NODE_ID_COMPRESSION_8 = 0,
 		NETWORK_NODE_ID_COMPRESSION_16,
 		NETWORK_NODE_ID_COMPRESSION_32,
+		NETWORK_NODE_ID_COMPRESSION_BATCH, // Not a node ID, the packet contains multiple RPCs.
 	};
 
 	enum NetworkNameIdCompression {
@@ -84,6 +85,21 @@ private:
 
 	Vector<uint8_t> packet_cache;
 
+	// RPCs to the same peer, channel, and transfer mode, waiting to be sent together.
+	struct RPCBatch {
+		int peer = 0;
+		int channel = 0;
+		MultiplayerPeer::TransferMode transfer_mode = MultiplayerPeer::TRANSFER_MODE_RELIABLE;
+		LocalVector<uint8_t> data;
+		int count = 0;
+	};
+
+	bool batching_enabled = false;
+	int batch_mtu = 1350;
+	HashMap<uint64_t, RPCBatch> batches;
+	bool batches_pending = false;
+	bool flushing = false;
+
 	HashMap<ObjectID, RPCConfigCache> rpc_cache;
 
 #ifdef DEBUG_ENABLED
@@ -93,6 +109,10 @@ private:
 protected:
 	void _process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 
+	void _send_command(int p_to, const RPCConfig &p_config, const uint8_t *p_packet, int p_packet_len);
+	void _flush_batch(RPCBatch &p_batch);
+	void _process_batch(int p_from, const uint8_t *p_packet, int p_packet_len);
+
 	void _send_rpc(Node *p_from, int p_to, uint16_t p_rpc_id, const RPCConfig &p_config, const StringName &p_name, const Variant **p_arg, int p_argcount);
 	Node *_process_get_node(int p_from, const uint8_t *p_packet, uint32_t p_node_target, int p_packet_len);
 
@@ -100,10 +120,29 @@ protected:
 	const RPCConfigCache &_get_node_config(const Node *p_node);
 
 public:
+	// RPCs in a batch are prefixed by their size, one byte, or two if the high bit is set.
+	static constexpr int BATCH_ENTRY_MAX_SIZE = 0x7FFF;
+
+	static int get_batch_entry_size(int p_packet_len);
+	static void encode_batch_entry(const uint8_t *p_packet, int p_packet_len, LocalVector<uint8_t> &r_batch);
+	static Error decode_batch_entry(const uint8_t *p_batch, int p_batch_len, int &r_ofs, const uint8_t *&r_packet, int &r_packet_len);
+
 	Error rpcp(Object *p_obj, int p_peer_id, const StringName &p_method, const Variant **p_arg, int p_argcount);
 	void process_rpc(int p_from, const uint8_t *p_packet, int p_packet_len);
 	String get_rpc_md5(const Object *p_obj);
 
+	// Other commands must flush the batches before they are sent, so reliable ordering is preserved.
+	bool has_pending_batches() const { return batches_pending && !flushing; }
+	void flush_batches();
+	void on_peer_change(int p_id, bool p_connected);
+	void on_reset();
+
+	void set_batching_enabled(bool p_enabled);
+	bool is_batching_enabled() const;
+
+	void set_max_batch_size(int p_size);
+	int get_max_batch_size() const;
+
 	SceneRPCInterface(SceneMultiplayer *p_multiplayer, SceneCacheInterface *p_cache, SceneReplicationInterface *p_replicator) {
 		multiplayer = p_multiplayer;
 		multiplayer_cache = p_cache;
@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*  test_multiplayer_synchronizer.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MULTIPLAYER_SYNCHRONIZER_H
+#define TEST_MULTIPLAYER_SYNCHRONIZER_H
+
+#include "../multiplayer_synchronizer.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMultiplayerSynchronizer {
+
+static Vector<Variant> make_state(int p_value) {
+	Vector<Variant> state;
+	state.push_back(p_value);
+	return state;
+}
+
+TEST_CASE("[MultiplayerSynchronizer] State history") {
+	MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+	sync->set_prediction_history_size(4);
+
+	CHECK_FALSE(sync->has_recorded_state(0));
+	CHECK(sync->restore_state(0) == ERR_DOES_NOT_EXIST);
+
+	SUBCASE("Recorded states are found by tick") {
+		for (int i = 0; i < 4; i++) {
+			sync->store_state(i, make_state(i * 10));
+		}
+		for (int i = 0; i < 4; i++) {
+			const Vector<Variant> *state = sync->get_recorded_state(i);
+			REQUIRE(state);
+			CHECK(int((*state)[0]) == i * 10);
+		}
+		CHECK_FALSE(sync->has_recorded_state(4));
+		CHECK_FALSE(sync->has_recorded_state(-1));
+	}
+
+	SUBCASE("Older states are overwritten") {
+		for (int i = 0; i < 6; i++) {
+			sync->store_state(i, make_state(i));
+		}
+		CHECK_FALSE(sync->has_recorded_state(0));
+		CHECK_FALSE(sync->has_recorded_state(1));
+		for (int i = 2; i < 6; i++) {
+			CHECK(sync->has_recorded_state(i));
+		}
+	}
+
+	SUBCASE("Clearing and resizing drop the history") {
+		sync->store_state(1, make_state(1));
+		sync->clear_state_history();
+		CHECK_FALSE(sync->has_recorded_state(1));
+
+		sync->store_state(2, make_state(2));
+		sync->set_prediction_history_size(8);
+		CHECK(sync->get_prediction_history_size() == 8);
+		CHECK_FALSE(sync->has_recorded_state(2));
+	}
+
+	memdelete(sync);
+}
+
+} // namespace TestMultiplayerSynchronizer
+
+#endif // TEST_MULTIPLAYER_SYNCHRONIZER_H
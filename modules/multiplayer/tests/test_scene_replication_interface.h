@@ -0,0 +1,505 @@
+/**************************************************************************/
+/*  test_scene_replication_interface.h                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_REPLICATION_INTERFACE_H
+#define TEST_SCENE_REPLICATION_INTERFACE_H
+
+#include "../multiplayer_synchronizer.h"
+#include "../scene_multiplayer.h"
+
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneReplicationInterface {
+
+// Server side peer connected to a single client (ID 2), which confirms every path it is sent.
+class TestReplicationPeer : public MultiplayerPeer {
+	GDCLASS(TestReplicationPeer, MultiplayerPeer);
+
+	List<Vector<uint8_t>> incoming;
+	Vector<uint8_t> current;
+
+public:
+	LocalVector<Vector<uint8_t>> sync_packets;
+
+	virtual int get_available_packet_count() const override { return incoming.size(); }
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override {
+		ERR_FAIL_COND_V(incoming.is_empty(), ERR_UNAVAILABLE);
+		current = incoming.front()->get();
+		incoming.pop_front();
+		*r_buffer = current.ptr();
+		r_buffer_size = current.size();
+		return OK;
+	}
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+		ERR_FAIL_COND_V(p_buffer_size < 1, ERR_INVALID_PARAMETER);
+		const uint8_t cmd = p_buffer[0] & SceneMultiplayer::CMD_MASK;
+		if (cmd == SceneMultiplayer::NETWORK_COMMAND_SIMPLIFY_PATH) {
+			// Command, methods MD5 (32 characters and terminator), then the path ID.
+			ERR_FAIL_COND_V(p_buffer_size < 1 + 33 + 4, ERR_INVALID_DATA);
+			Vector<uint8_t> confirm;
+			confirm.resize(6);
+			confirm.write[0] = SceneMultiplayer::NETWORK_COMMAND_CONFIRM_PATH;
+			confirm.write[1] = 1; // Valid RPC checksum.
+			memcpy(confirm.ptrw() + 2, p_buffer + 1 + 33, 4);
+			incoming.push_back(confirm);
+		} else if (cmd == SceneMultiplayer::NETWORK_COMMAND_SYNC) {
+			Vector<uint8_t> packet;
+			packet.resize(p_buffer_size);
+			memcpy(packet.ptrw(), p_buffer, p_buffer_size);
+			sync_packets.push_back(packet);
+		}
+		return OK;
+	}
+	virtual int get_max_packet_size() const override { return 1 << 24; }
+
+	void push_snapshot_ack(uint16_t p_snapshot_id) {
+		Vector<uint8_t> ack;
+		ack.resize(3);
+		ack.write[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT) | (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT);
+		encode_uint16(p_snapshot_id, ack.ptrw() + 1);
+		incoming.push_back(ack);
+	}
+
+	virtual void set_target_peer(int p_peer_id) override {}
+	virtual int get_packet_peer() const override { return 2; }
+	virtual TransferMode get_packet_mode() const override { return TRANSFER_MODE_RELIABLE; }
+	virtual int get_packet_channel() const override { return 0; }
+	virtual void disconnect_peer(int p_peer, bool p_force = false) override {}
+	virtual bool is_server() const override { return true; }
+	virtual void poll() override {}
+	virtual void close() override {}
+	virtual int get_unique_id() const override { return TARGET_PEER_SERVER; }
+	virtual ConnectionStatus get_connection_status() const override { return CONNECTION_CONNECTED; }
+};
+
+// Peer of one of two SceneMultiplayer instances in the same process, delivering packets straight to the other one.
+class TestLoopbackPeer : public MultiplayerPeer {
+	GDCLASS(TestLoopbackPeer, MultiplayerPeer);
+
+	List<Vector<uint8_t>> incoming;
+	Vector<uint8_t> current;
+
+public:
+	int unique_id = TARGET_PEER_SERVER;
+	TestLoopbackPeer *remote = nullptr;
+	bool drop_syncs = false; // Simulates the loss of the sync packets sent while set.
+
+	virtual int get_available_packet_count() const override { return incoming.size(); }
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override {
+		ERR_FAIL_COND_V(incoming.is_empty(), ERR_UNAVAILABLE);
+		current = incoming.front()->get();
+		incoming.pop_front();
+		*r_buffer = current.ptr();
+		r_buffer_size = current.size();
+		return OK;
+	}
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+		ERR_FAIL_COND_V(!remote || p_buffer_size < 1, ERR_UNCONFIGURED);
+		if (drop_syncs && (p_buffer[0] & SceneMultiplayer::CMD_MASK) == SceneMultiplayer::NETWORK_COMMAND_SYNC) {
+			return OK;
+		}
+		Vector<uint8_t> packet;
+		packet.resize(p_buffer_size);
+		memcpy(packet.ptrw(), p_buffer, p_buffer_size);
+		remote->incoming.push_back(packet);
+		return OK;
+	}
+	virtual int get_max_packet_size() const override { return 1 << 24; }
+
+	virtual void set_target_peer(int p_peer_id) override {}
+	virtual int get_packet_peer() const override { return remote->unique_id; }
+	virtual TransferMode get_packet_mode() const override { return TRANSFER_MODE_RELIABLE; }
+	virtual int get_packet_channel() const override { return 0; }
+	virtual void disconnect_peer(int p_peer, bool p_force = false) override {}
+	virtual bool is_server() const override { return unique_id == TARGET_PEER_SERVER; }
+	virtual void poll() override {}
+	virtual void close() override {}
+	virtual int get_unique_id() const override { return unique_id; }
+	virtual ConnectionStatus get_connection_status() const override { return CONNECTION_CONNECTED; }
+};
+
+// Returns the net IDs of the states in a sync packet without snapshots or ticks.
+static LocalVector<uint32_t> get_synced_ids(const Vector<uint8_t> &p_packet) {
+	LocalVector<uint32_t> ids;
+	int ofs = 3;
+	while (ofs + 8 <= p_packet.size()) {
+		ids.push_back(decode_uint32(&p_packet[ofs]));
+		ofs += 8 + decode_uint32(&p_packet[ofs + 4]);
+	}
+	return ids;
+}
+
+struct SnapshotInfo {
+	uint16_t id = 0;
+	bool delta = false;
+	uint16_t baseline = 0;
+	int size = 0;
+};
+
+// Returns the snapshot ID of a sync packet without ticks, and how its first state is encoded.
+static SnapshotInfo get_snapshot_info(const Vector<uint8_t> &p_packet) {
+	// Command, time, snapshot ID, then net ID, size and payload of each state.
+	// Payloads start with their kind (0 full, 1 delta), deltas are followed by their baseline ID.
+	SnapshotInfo info;
+	info.id = decode_uint16(&p_packet[3]);
+	info.size = decode_uint32(&p_packet[9]);
+	info.delta = p_packet[13] == 1;
+	if (info.delta) {
+		info.baseline = decode_uint16(&p_packet[14]);
+	}
+	return info;
+}
+
+static SnapshotInfo poll_snapshot(const Ref<SceneMultiplayer> &p_multiplayer, const Ref<TestReplicationPeer> &p_peer) {
+	p_peer->sync_packets.clear();
+	p_multiplayer->poll();
+	if (p_peer->sync_packets.size() != 1) {
+		return SnapshotInfo();
+	}
+	return get_snapshot_info(p_peer->sync_packets[0]);
+}
+
+static MultiplayerSynchronizer *add_synchronized_node(Node *p_parent, float p_priority) {
+	Node2D *node = memnew(Node2D);
+	MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(":position"));
+	sync->set_replication_config(config);
+	sync->set_interest_priority(p_priority);
+	node->add_child(sync);
+	p_parent->add_child(node);
+	return sync;
+}
+
+static int resimulated_ticks = 0;
+
+static void simulate_player(int64_t p_tick, bool p_resimulating, Object *p_player, Object *p_input) {
+	Node2D *player = Object::cast_to<Node2D>(p_player);
+	Node2D *input = Object::cast_to<Node2D>(p_input);
+	player->set_position(player->get_position() + Vector2(input->get_rotation(), 0));
+	if (p_resimulating) {
+		resimulated_ticks++;
+	}
+}
+
+// Adds a player moving by the rotation of its Input child every tick, the inputs being owned by peer 2.
+static Node2D *add_predicted_player(Node *p_parent) {
+	Node2D *player = memnew(Node2D);
+	player->set_name("Player");
+	Node2D *input = memnew(Node2D);
+	input->set_name("Input");
+	player->add_child(input);
+
+	MultiplayerSynchronizer *input_sync = memnew(MultiplayerSynchronizer);
+	input_sync->set_name("InputSync");
+	input_sync->set_root_path(NodePath("../Input"));
+	Ref<SceneReplicationConfig> input_config;
+	input_config.instantiate();
+	input_config->add_property(NodePath(":rotation"));
+	input_sync->set_replication_config(input_config);
+	input_sync->set_prediction_mode(MultiplayerSynchronizer::PREDICTION_INPUT);
+	input_sync->set_multiplayer_authority(2);
+	player->add_child(input_sync);
+
+	MultiplayerSynchronizer *state_sync = memnew(MultiplayerSynchronizer);
+	state_sync->set_name("StateSync");
+	Ref<SceneReplicationConfig> state_config;
+	state_config.instantiate();
+	state_config->add_property(NodePath(":position"));
+	state_sync->set_replication_config(state_config);
+	state_sync->set_prediction_mode(MultiplayerSynchronizer::PREDICTION_STATE);
+	state_sync->set_prediction_input(NodePath("../InputSync"));
+	state_sync->connect(SNAME("simulate_tick"), callable_mp_static(&simulate_player).bind(player, input));
+	player->add_child(state_sync);
+
+	p_parent->add_child(player);
+	return player;
+}
+
+// Polls both instances until the server simulated the given number of ticks.
+static void run_ticks(const Ref<SceneMultiplayer> &p_server, const Ref<SceneMultiplayer> &p_client, int p_ticks) {
+	const int64_t target = p_server->get_network_tick() + p_ticks;
+	for (int i = 0; i < 10000 && p_server->get_network_tick() < target; i++) {
+		p_client->poll();
+		p_server->poll();
+		OS::get_singleton()->delay_usec(1000);
+	}
+	REQUIRE(p_server->get_network_tick() >= target);
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Client-side prediction between two instances") {
+	Window *root = SceneTree::get_singleton()->get_root();
+	Node *server_root = memnew(Node);
+	server_root->set_name("Server");
+	root->add_child(server_root);
+	Node *client_root = memnew(Node);
+	client_root->set_name("Client");
+	root->add_child(client_root);
+	const NodePath server_path = server_root->get_path();
+	const NodePath client_path = client_root->get_path();
+
+	Ref<SceneMultiplayer> server;
+	server.instantiate();
+	Ref<SceneMultiplayer> client;
+	client.instantiate();
+	SceneTree::get_singleton()->set_multiplayer(server, server_path);
+	SceneTree::get_singleton()->set_multiplayer(client, client_path);
+	server->set_network_tick_rate(60);
+	client->set_network_tick_rate(60);
+
+	Ref<TestLoopbackPeer> server_peer;
+	server_peer.instantiate();
+	Ref<TestLoopbackPeer> client_peer;
+	client_peer.instantiate();
+	client_peer->unique_id = 2;
+	server_peer->remote = client_peer.ptr();
+	client_peer->remote = server_peer.ptr();
+	server->set_multiplayer_peer(server_peer);
+	client->set_multiplayer_peer(client_peer);
+	server_peer->emit_signal(SNAME("peer_connected"), 2);
+	client_peer->emit_signal(SNAME("peer_connected"), 1);
+
+	Node2D *server_player = add_predicted_player(server_root);
+	Node2D *client_player = add_predicted_player(client_root);
+	Node2D *client_input = Object::cast_to<Node2D>(client_player->get_node(NodePath("Input")));
+	client_input->set_rotation(1.0);
+	MultiplayerSynchronizer *server_input_sync = Object::cast_to<MultiplayerSynchronizer>(server_player->get_node(NodePath("InputSync")));
+	resimulated_ticks = 0;
+
+	// Let the server clock run on its own first.
+	for (int i = 0; i < 10000 && server->get_network_tick() < 5; i++) {
+		server->poll();
+		OS::get_singleton()->delay_usec(1000);
+	}
+	REQUIRE(server->get_network_tick() >= 5);
+	CHECK(client->get_network_tick() == 0);
+
+	// The client pings, the server answers with its tick, and the client jumps ahead of it by the round trip and a margin of 2 ticks.
+	client->poll();
+	const int64_t server_tick = server->get_network_tick();
+	server->poll();
+	client->poll();
+	CHECK(client->get_network_tick() >= server_tick + 2);
+	CHECK(client->get_network_tick() <= server_tick + 3);
+
+	// Both clocks then advance together, the client staying ahead.
+	run_ticks(server, client, 10);
+	const int64_t lead = client->get_network_tick() - server->get_network_tick();
+	CHECK(lead >= 1);
+	CHECK(lead <= 4);
+
+	// Inputs are resent for a few ticks, so the ones of lost packets arrive with the next packets.
+	const int64_t dropped = client->get_network_tick() + 1;
+	client_peer->drop_syncs = true;
+	for (int i = 0; i < 10000 && client->get_network_tick() < dropped + 1; i++) {
+		client->poll();
+		server->poll();
+		OS::get_singleton()->delay_usec(1000);
+	}
+	client_peer->drop_syncs = false;
+	CHECK_FALSE(server_input_sync->has_recorded_state(dropped));
+	run_ticks(server, client, 3);
+	for (int64_t tick = dropped; tick <= dropped + 1; tick++) {
+		const Vector<Variant> *input = server_input_sync->get_recorded_state(tick);
+		REQUIRE(input);
+		CHECK(double((*input)[0]) == doctest::Approx(1.0));
+	}
+
+	// A misprediction is corrected by the next authoritative state, and the ticks predicted since then are simulated again.
+	resimulated_ticks = 0;
+	client_player->set_position(client_player->get_position() + Vector2(1000, 0));
+	run_ticks(server, client, 8);
+	CHECK(resimulated_ticks > 0);
+	CHECK(client_player->get_position().x < 1000);
+	CHECK(client_player->get_position().x >= server_player->get_position().x);
+
+	memdelete(server_root);
+	memdelete(client_root);
+	server->set_multiplayer_peer(Ref<MultiplayerPeer>());
+	client->set_multiplayer_peer(Ref<MultiplayerPeer>());
+	SceneTree::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>(), server_path);
+	SceneTree::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>(), client_path);
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Synchronizers share the interest bandwidth budget") {
+	Ref<SceneMultiplayer> multiplayer;
+	multiplayer.instantiate();
+	SceneTree::get_singleton()->set_multiplayer(multiplayer);
+	Ref<TestReplicationPeer> peer;
+	peer.instantiate();
+	multiplayer->set_multiplayer_peer(peer);
+	peer->emit_signal(SNAME("peer_connected"), 2);
+	multiplayer->set_interest_management_enabled(true);
+
+	Node *root = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+	MultiplayerSynchronizer *high = add_synchronized_node(root, 1.5);
+	MultiplayerSynchronizer *low = add_synchronized_node(root, 1.0);
+
+	// Paths are sent and confirmed first, after that both states fit in an unlimited budget.
+	multiplayer->poll();
+	CHECK(peer->sync_packets.is_empty());
+	multiplayer->poll();
+	REQUIRE(peer->sync_packets.size() == 1);
+	const LocalVector<uint32_t> all = get_synced_ids(peer->sync_packets[0]);
+	REQUIRE(all.size() == 2);
+	CHECK(all[0] == high->get_net_id());
+	CHECK(all[1] == low->get_net_id());
+	const int state_size = (peer->sync_packets[0].size() - 3) / 2;
+
+	SUBCASE("States that don't fit are deferred and get a head start") {
+		multiplayer->set_interest_bandwidth_budget(state_size + state_size / 2);
+		const uint32_t expected[] = { high->get_net_id(), low->get_net_id(), high->get_net_id(), low->get_net_id() };
+		for (const uint32_t &id : expected) {
+			peer->sync_packets.clear();
+			multiplayer->poll();
+			REQUIRE(peer->sync_packets.size() == 1);
+			CHECK(peer->sync_packets[0].size() - 3 <= state_size + state_size / 2);
+			const LocalVector<uint32_t> ids = get_synced_ids(peer->sync_packets[0]);
+			REQUIRE(ids.size() == 1);
+			CHECK(ids[0] == id);
+		}
+	}
+
+	SUBCASE("Nothing is sent when no state fits") {
+		multiplayer->set_interest_bandwidth_budget(state_size - 1);
+		peer->sync_packets.clear();
+		multiplayer->poll();
+		CHECK(peer->sync_packets.is_empty());
+
+		// Both are still due once the budget allows it.
+		multiplayer->set_interest_bandwidth_budget(0);
+		multiplayer->poll();
+		REQUIRE(peer->sync_packets.size() == 1);
+		CHECK(get_synced_ids(peer->sync_packets[0]).size() == 2);
+	}
+
+	memdelete(root);
+	multiplayer->set_multiplayer_peer(Ref<MultiplayerPeer>());
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Snapshots are sent as deltas against acknowledged states") {
+	Ref<SceneMultiplayer> multiplayer;
+	multiplayer.instantiate();
+	SceneTree::get_singleton()->set_multiplayer(multiplayer);
+	Ref<TestReplicationPeer> peer;
+	peer.instantiate();
+	multiplayer->set_multiplayer_peer(peer);
+	peer->emit_signal(SNAME("peer_connected"), 2);
+	multiplayer->set_snapshot_delta_enabled(true);
+
+	Node *root = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+	add_synchronized_node(root, 1.0);
+
+	// Paths are sent and confirmed first.
+	multiplayer->poll();
+	CHECK(peer->sync_packets.is_empty());
+	multiplayer->poll();
+	REQUIRE(peer->sync_packets.size() == 1);
+	const SnapshotInfo first = get_snapshot_info(peer->sync_packets[0]);
+	CHECK_FALSE(first.delta);
+
+	// Without an acknowledged baseline, states stay full.
+	SnapshotInfo unacked = poll_snapshot(multiplayer, peer);
+	CHECK(unacked.id == uint16_t(first.id + 1));
+	CHECK_FALSE(unacked.delta);
+
+	SUBCASE("Deltas use the acknowledged baseline") {
+		peer->push_snapshot_ack(first.id);
+		const SnapshotInfo next = poll_snapshot(multiplayer, peer);
+		CHECK(next.delta);
+		CHECK(next.baseline == first.id);
+		CHECK(next.size < first.size);
+	}
+
+	SUBCASE("Dropped acks keep the previous baseline") {
+		peer->push_snapshot_ack(first.id);
+		const SnapshotInfo second = poll_snapshot(multiplayer, peer);
+		CHECK(second.baseline == first.id);
+		// The ack of the second snapshot is dropped.
+		const SnapshotInfo third = poll_snapshot(multiplayer, peer);
+		CHECK(third.delta);
+		CHECK(third.baseline == first.id);
+
+		// Late acks of older snapshots don't move the baseline back.
+		peer->push_snapshot_ack(third.id);
+		peer->push_snapshot_ack(second.id);
+		const SnapshotInfo fourth = poll_snapshot(multiplayer, peer);
+		CHECK(fourth.delta);
+		CHECK(fourth.baseline == third.id);
+
+		// Once all acks are lost for a whole history window, the baseline is given up for full states.
+		SnapshotInfo last;
+		for (int i = 0; i < 64; i++) {
+			last = poll_snapshot(multiplayer, peer);
+		}
+		CHECK_FALSE(last.delta);
+	}
+
+	SUBCASE("Snapshot IDs wrap around") {
+		SnapshotInfo last = unacked;
+		bool acked_deltas = true;
+		while (acked_deltas && last.id != UINT16_MAX) {
+			peer->push_snapshot_ack(last.id);
+			const SnapshotInfo next = poll_snapshot(multiplayer, peer);
+			acked_deltas = acked_deltas && next.delta && next.baseline == last.id && next.id == uint16_t(last.id + 1);
+			last = next;
+		}
+		REQUIRE(acked_deltas);
+
+		peer->push_snapshot_ack(last.id);
+		const SnapshotInfo wrapped = poll_snapshot(multiplayer, peer);
+		CHECK(wrapped.id == 0);
+		CHECK(wrapped.delta);
+		CHECK(wrapped.baseline == UINT16_MAX);
+
+		// Snapshots from before the wrap are older, their acks don't move the baseline back.
+		peer->push_snapshot_ack(wrapped.id);
+		peer->push_snapshot_ack(UINT16_MAX - 1);
+		const SnapshotInfo next = poll_snapshot(multiplayer, peer);
+		CHECK(next.id == 1);
+		CHECK(next.delta);
+		CHECK(next.baseline == 0);
+	}
+
+	memdelete(root);
+	multiplayer->set_multiplayer_peer(Ref<MultiplayerPeer>());
+}
+
+} // namespace TestSceneReplicationInterface
+
+#endif // TEST_SCENE_REPLICATION_INTERFACE_H
@@ -0,0 +1,285 @@
+/**************************************************************************/
+/*  test_scene_replication_schema.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_REPLICATION_SCHEMA_H
+#define TEST_SCENE_REPLICATION_SCHEMA_H
+
+#include "../scene_replication_schema.h"
+
+#include "core/io/marshalls.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneReplicationSchema {
+
+typedef SceneReplicationConfig::PropertySchema PropertySchema;
+
+static PropertySchema make_schema(SceneReplicationConfig::PropertyEncoding p_encoding, Variant::Type p_type, int p_bits = 16, float p_min = -1.0, float p_max = 1.0) {
+	PropertySchema schema;
+	schema.encoding = p_encoding;
+	schema.type = p_type;
+	schema.bits = p_bits;
+	schema.range_min = p_min;
+	schema.range_max = p_max;
+	return schema;
+}
+
+static Vector<Variant> round_trip(const Vector<PropertySchema> &p_schema, const Vector<Variant> &p_values, int &r_size) {
+	Vector<const Variant *> ptrs;
+	for (const Variant &v : p_values) {
+		ptrs.push_back(&v);
+	}
+	SceneReplicationSchema::BitWriter writer;
+	REQUIRE(SceneReplicationSchema::encode(p_schema.ptr(), ptrs.ptrw(), ptrs.size(), writer) == OK);
+	r_size = writer.get_size();
+
+	Vector<Variant> decoded;
+	int consumed = 0;
+	REQUIRE(SceneReplicationSchema::decode(p_schema.ptr(), p_schema.size(), writer.get_data(), writer.get_size(), decoded, consumed) == OK);
+	CHECK(consumed == r_size);
+	return decoded;
+}
+
+TEST_CASE("[SceneReplicationSchema] Bit writer and reader") {
+	SceneReplicationSchema::BitWriter writer;
+	writer.write_bits(1, 1);
+	writer.write_bits(5, 3);
+	writer.write_varint(300);
+	writer.write_bits(0x1234, 13);
+	CHECK(writer.get_size() == 5);
+
+	SceneReplicationSchema::BitReader reader(writer.get_data(), writer.get_size());
+	CHECK(reader.read_bits(1) == 1);
+	CHECK(reader.read_bits(3) == 5);
+	CHECK(reader.read_varint() == 300);
+	CHECK(reader.read_bits(13) == 0x1234);
+	CHECK_FALSE(reader.has_error());
+
+	reader.read_bits(16);
+	CHECK_MESSAGE(reader.has_error(), "Reading past the end of the buffer should fail.");
+}
+
+TEST_CASE("[SceneReplicationSchema] Varint encoding") {
+	Vector<PropertySchema> schema;
+	Vector<Variant> values;
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_VARINT, Variant::BOOL));
+	values.push_back(true);
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_VARINT, Variant::INT));
+	values.push_back(-3);
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_VARINT, Variant::INT));
+	values.push_back(int64_t(1) << 40);
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_VARINT, Variant::VECTOR3I));
+	values.push_back(Vector3i(1, -2, 3));
+
+	int size = 0;
+	Vector<Variant> decoded = round_trip(schema, values, size);
+	CHECK(decoded == values);
+	// 1 bit, 1 byte, 6 bytes and 3 bytes.
+	CHECK(size == 11);
+}
+
+TEST_CASE("[SceneReplicationSchema] Quantized encoding") {
+	Vector<PropertySchema> schema;
+	Vector<Variant> values;
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED, Variant::FLOAT, 16, -100, 100));
+	values.push_back(42.5);
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED, Variant::VECTOR3, 12, -1024, 1024));
+	values.push_back(Vector3(10.25, -512, 1000));
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED, Variant::COLOR, 8, 0, 1));
+	values.push_back(Color(0.5, 0.25, 1, 2)); // Alpha is clamped.
+
+	int size = 0;
+	Vector<Variant> decoded = round_trip(schema, values, size);
+	CHECK(double(decoded[0]) == doctest::Approx(42.5).epsilon(0.001));
+	CHECK((Vector3(decoded[1]) - Vector3(10.25, -512, 1000)).length() < 1.0);
+	const Color color = decoded[2];
+	CHECK(color.r == doctest::Approx(0.5).epsilon(0.01));
+	CHECK(color.g == doctest::Approx(0.25).epsilon(0.01));
+	CHECK(color.b == doctest::Approx(1.0));
+	CHECK(color.a == doctest::Approx(1.0));
+	// 16 + 3 * 12 + 4 * 8 bits.
+	CHECK(size == 11);
+}
+
+TEST_CASE("[SceneReplicationSchema] Smallest three quaternion encoding") {
+	Vector<PropertySchema> schema;
+	Vector<Variant> values;
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_SMALLEST_THREE, Variant::QUATERNION, 10));
+	Quaternion q = Quaternion(Vector3(1, 2, 3).normalized(), -2.0);
+	values.push_back(q);
+
+	int size = 0;
+	Vector<Variant> decoded = round_trip(schema, values, size);
+	Quaternion result = decoded[0];
+	// q and -q represent the same rotation.
+	CHECK(Math::abs(result.dot(q)) > 0.999);
+	// 2 + 3 * 10 bits.
+	CHECK(size == 4);
+}
+
+TEST_CASE("[SceneReplicationSchema] Unsupported types fall back to Variant encoding") {
+	Vector<PropertySchema> schema;
+	Vector<Variant> values;
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED, Variant::STRING));
+	values.push_back(String("Godot"));
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_VARINT, Variant::NIL));
+	values.push_back(false);
+
+	int size = 0;
+	Vector<Variant> decoded = round_trip(schema, values, size);
+	CHECK(decoded == values);
+}
+
+TEST_CASE("[SceneReplicationSchema] Values are sent as the schema type") {
+	Vector<PropertySchema> schema;
+	Vector<Variant> values;
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED, Variant::FLOAT, 16, -100, 100));
+	values.push_back(25);
+	schema.push_back(make_schema(SceneReplicationConfig::PROPERTY_ENCODING_VARINT, Variant::INT));
+	values.push_back(7.0);
+
+	int size = 0;
+	Vector<Variant> decoded = round_trip(schema, values, size);
+	CHECK(decoded[0].get_type() == Variant::FLOAT);
+	CHECK(double(decoded[0]) == doctest::Approx(25.0).epsilon(0.001));
+	CHECK(decoded[1].get_type() == Variant::INT);
+	CHECK(int(decoded[1]) == 7);
+
+	// Values that can't be converted to the schema type are rejected instead of being misread by the receiver.
+	values.write[1] = String("7");
+	Vector<const Variant *> ptrs;
+	for (const Variant &v : values) {
+		ptrs.push_back(&v);
+	}
+	SceneReplicationSchema::BitWriter writer;
+	ERR_PRINT_OFF;
+	CHECK(SceneReplicationSchema::encode(schema.ptr(), ptrs.ptrw(), ptrs.size(), writer) != OK);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[SceneReplicationConfig] Encoding settings are only stored when not default") {
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(".:position"));
+	config->add_property(NodePath(".:rotation"));
+	config->property_set_encoding(NodePath(".:rotation"), SceneReplicationConfig::PROPERTY_ENCODING_SMALLEST_THREE);
+	config->property_set_encoding_type(NodePath(".:rotation"), Variant::QUATERNION);
+
+	List<PropertyInfo> props;
+	config->get_property_list(&props);
+	HashSet<String> names;
+	for (const PropertyInfo &E : props) {
+		names.insert(E.name);
+	}
+	CHECK_FALSE(names.has("properties/0/encoding"));
+	CHECK_FALSE(names.has("properties/0/encoding_type"));
+	CHECK_FALSE(names.has("properties/0/encoding_bits"));
+	CHECK_FALSE(names.has("properties/0/encoding_range"));
+	CHECK(names.has("properties/1/encoding"));
+	CHECK(names.has("properties/1/encoding_type"));
+	CHECK_FALSE(names.has("properties/1/encoding_bits"));
+	CHECK_FALSE(names.has("properties/1/encoding_range"));
+
+	Ref<SceneReplicationConfig> copy = config->duplicate();
+	CHECK(copy->property_get_encoding(NodePath(".:rotation")) == SceneReplicationConfig::PROPERTY_ENCODING_SMALLEST_THREE);
+	CHECK(copy->property_get_encoding_type(NodePath(".:rotation")) == Variant::QUATERNION);
+	CHECK(copy->get_sync_schema()[1].type == Variant::QUATERNION);
+}
+
+TEST_CASE("[SceneReplicationConfig] Encodings without a supported type are rejected") {
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(".:position"));
+	config->add_property(NodePath(".:visible"));
+	config->property_set_encoding(NodePath(".:position"), SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED);
+	config->property_set_encoding(NodePath(".:visible"), SceneReplicationConfig::PROPERTY_ENCODING_VARINT);
+
+	// Neither property has an encoding type, so both are sent as Variants instead of silently dropping the encoding.
+	ERR_PRINT_OFF;
+	CHECK_FALSE(config->is_sync_packed());
+	ERR_PRINT_ON;
+	CHECK(config->get_sync_schema()[0].encoding == SceneReplicationConfig::PROPERTY_ENCODING_VARIANT);
+	CHECK(config->get_sync_schema()[1].encoding == SceneReplicationConfig::PROPERTY_ENCODING_VARIANT);
+	// The configured encoding is kept, so setting the type later enables it.
+	CHECK(config->property_get_encoding(NodePath(".:position")) == SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED);
+
+	config->property_set_encoding_type(NodePath(".:visible"), Variant::BOOL);
+	ERR_PRINT_OFF;
+	CHECK(config->is_sync_packed());
+	ERR_PRINT_ON;
+	CHECK(config->get_sync_schema()[0].encoding == SceneReplicationConfig::PROPERTY_ENCODING_VARIANT);
+	CHECK(config->get_sync_schema()[1].encoding == SceneReplicationConfig::PROPERTY_ENCODING_VARINT);
+
+	// A type the encoding can't handle is rejected the same way.
+	config->property_set_encoding_type(NodePath(".:visible"), Variant::STRING);
+	ERR_PRINT_OFF;
+	CHECK_FALSE(config->is_sync_packed());
+	ERR_PRINT_ON;
+
+	config->property_set_encoding_type(NodePath(".:position"), Variant::VECTOR2);
+	config->property_set_encoding_type(NodePath(".:visible"), Variant::BOOL);
+	CHECK(config->is_sync_packed());
+	CHECK(config->get_sync_schema()[0].encoding == SceneReplicationConfig::PROPERTY_ENCODING_QUANTIZED);
+	CHECK(config->get_sync_schema()[0].type == Variant::VECTOR2);
+}
+
+TEST_CASE("[SceneReplicationSchema] XOR delta encoding") {
+	uint8_t baseline[300];
+	uint8_t state[300];
+	for (int i = 0; i < 300; i++) {
+		baseline[i] = i * 7;
+		state[i] = baseline[i];
+	}
+	state[0] = 1;
+	state[150] ^= 0xFF;
+	state[151] ^= 0x0F;
+	state[299] = 42;
+
+	LocalVector<uint8_t> delta;
+	SceneReplicationSchema::encode_xor_delta(state, baseline, 300, delta);
+	CHECK(delta.size() < 16);
+
+	uint8_t decoded[300];
+	CHECK(SceneReplicationSchema::decode_xor_delta(delta.ptr(), delta.size(), baseline, 300, decoded) == OK);
+	CHECK(memcmp(decoded, state, 300) == 0);
+
+	// Unchanged state only needs run tokens.
+	delta.clear();
+	SceneReplicationSchema::encode_xor_delta(baseline, baseline, 300, delta);
+	CHECK(delta.size() == 3);
+
+	ERR_PRINT_OFF;
+	CHECK(SceneReplicationSchema::decode_xor_delta(delta.ptr(), delta.size(), baseline, 200, decoded) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestSceneReplicationSchema
+
+#endif // TEST_SCENE_REPLICATION_SCHEMA_H
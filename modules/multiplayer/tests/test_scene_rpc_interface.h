@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  test_scene_rpc_interface.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_RPC_INTERFACE_H
+#define TEST_SCENE_RPC_INTERFACE_H
+
+#include "../scene_multiplayer.h"
+#include "../scene_rpc_interface.h"
+
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneRPCInterface {
+
+static Vector<uint8_t> make_packet(int p_size) {
+	Vector<uint8_t> packet;
+	packet.resize(p_size);
+	for (int i = 0; i < p_size; i++) {
+		packet.write[i] = i % 251;
+	}
+	return packet;
+}
+
+// Server side peer connected to a single client (ID 2), which records the commands it is sent.
+class TestRPCPeer : public MultiplayerPeer {
+	GDCLASS(TestRPCPeer, MultiplayerPeer);
+
+public:
+	LocalVector<uint8_t> commands;
+
+	virtual int get_available_packet_count() const override { return 0; }
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override { return ERR_UNAVAILABLE; }
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+		ERR_FAIL_COND_V(p_buffer_size < 1, ERR_INVALID_PARAMETER);
+		commands.push_back(p_buffer[0] & SceneMultiplayer::CMD_MASK);
+		return OK;
+	}
+	virtual int get_max_packet_size() const override { return 1 << 24; }
+
+	virtual void set_target_peer(int p_peer_id) override {}
+	virtual int get_packet_peer() const override { return 2; }
+	virtual TransferMode get_packet_mode() const override { return TRANSFER_MODE_RELIABLE; }
+	virtual int get_packet_channel() const override { return 0; }
+	virtual void disconnect_peer(int p_peer, bool p_force = false) override {}
+	virtual bool is_server() const override { return true; }
+	virtual void poll() override {}
+	virtual void close() override {}
+	virtual int get_unique_id() const override { return TARGET_PEER_SERVER; }
+	virtual ConnectionStatus get_connection_status() const override { return CONNECTION_CONNECTED; }
+};
+
+TEST_CASE("[SceneRPCInterface] Batch entries") {
+	const Vector<uint8_t> small = make_packet(0x7F);
+	const Vector<uint8_t> large = make_packet(0x80);
+	const Vector<uint8_t> largest = make_packet(SceneRPCInterface::BATCH_ENTRY_MAX_SIZE);
+
+	LocalVector<uint8_t> batch;
+	SceneRPCInterface::encode_batch_entry(small.ptr(), small.size(), batch);
+	CHECK(int(batch.size()) == SceneRPCInterface::get_batch_entry_size(small.size()));
+	CHECK(batch.size() == 1 + 0x7F);
+	SceneRPCInterface::encode_batch_entry(large.ptr(), large.size(), batch);
+	SceneRPCInterface::encode_batch_entry(largest.ptr(), largest.size(), batch);
+	CHECK(int(batch.size()) == SceneRPCInterface::get_batch_entry_size(small.size()) + SceneRPCInterface::get_batch_entry_size(large.size()) + SceneRPCInterface::get_batch_entry_size(largest.size()));
+	CHECK(SceneRPCInterface::get_batch_entry_size(large.size()) == 2 + 0x80);
+
+	SUBCASE("Entries are decoded in order") {
+		const Vector<uint8_t> expected[] = { small, large, largest };
+		int ofs = 0;
+		for (const Vector<uint8_t> &packet : expected) {
+			const uint8_t *entry = nullptr;
+			int len = 0;
+			REQUIRE(SceneRPCInterface::decode_batch_entry(batch.ptr(), batch.size(), ofs, entry, len) == OK);
+			REQUIRE(len == packet.size());
+			CHECK(memcmp(entry, packet.ptr(), len) == 0);
+		}
+		CHECK(ofs == int(batch.size()));
+	}
+
+	SUBCASE("Truncated batches are rejected") {
+		const uint8_t *entry = nullptr;
+		int len = 0;
+		int ofs = 0;
+		ERR_PRINT_OFF;
+		// Missing the last byte of the first entry.
+		CHECK(SceneRPCInterface::decode_batch_entry(batch.ptr(), 0x7F, ofs, entry, len) == ERR_INVALID_DATA);
+		// Missing the second size byte of the second entry.
+		ofs = 1 + 0x7F;
+		CHECK(SceneRPCInterface::decode_batch_entry(batch.ptr(), 1 + 0x7F + 1, ofs, entry, len) == ERR_INVALID_DATA);
+		// Nothing left to decode.
+		ofs = batch.size();
+		CHECK(SceneRPCInterface::decode_batch_entry(batch.ptr(), batch.size(), ofs, entry, len) == ERR_INVALID_DATA);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Sizes past the end of the batch are rejected") {
+		const uint8_t oversized[] = { 0xFF, 0xFF, 1, 2, 3 };
+		const uint8_t empty[] = { 0, 1, 2 };
+		const uint8_t *entry = nullptr;
+		int len = 0;
+		int ofs = 0;
+		ERR_PRINT_OFF;
+		CHECK(SceneRPCInterface::decode_batch_entry(oversized, sizeof(oversized), ofs, entry, len) == ERR_INVALID_DATA);
+		ofs = 0;
+		CHECK(SceneRPCInterface::decode_batch_entry(empty, sizeof(empty), ofs, entry, len) == ERR_INVALID_DATA);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Packets too big for an entry are not encoded") {
+		const Vector<uint8_t> oversized = make_packet(SceneRPCInterface::BATCH_ENTRY_MAX_SIZE + 1);
+		const uint32_t size = batch.size();
+		ERR_PRINT_OFF;
+		SceneRPCInterface::encode_batch_entry(oversized.ptr(), oversized.size(), batch);
+		ERR_PRINT_ON;
+		CHECK(batch.size() == size);
+	}
+}
+
+TEST_CASE("[SceneTree][SceneRPCInterface] Batched RPCs are sent before other commands") {
+	Ref<SceneMultiplayer> multiplayer;
+	multiplayer.instantiate();
+	SceneTree::get_singleton()->set_multiplayer(multiplayer);
+	Ref<TestRPCPeer> peer;
+	peer.instantiate();
+	multiplayer->set_multiplayer_peer(peer);
+	peer->emit_signal(SNAME("peer_connected"), 2);
+	multiplayer->set_rpc_batching_enabled(true);
+
+	Node *node = memnew(Node);
+	Dictionary config;
+	config["rpc_mode"] = MultiplayerAPI::RPC_MODE_AUTHORITY;
+	node->rpc_config("set_name", config);
+	SceneTree::get_singleton()->get_root()->add_child(node);
+
+	peer->commands.clear();
+	CHECK(node->rpc_id(2, "set_name", "A") == OK);
+	CHECK(node->rpc_id(2, "set_name", "B") == OK);
+	Vector<uint8_t> bytes;
+	bytes.push_back(1);
+	CHECK(multiplayer->send_bytes(bytes, 2) == OK);
+
+	// The path is sent first, then both RPCs in a single batch, then the raw bytes.
+	REQUIRE(peer->commands.size() == 3);
+	CHECK(peer->commands[0] == SceneMultiplayer::NETWORK_COMMAND_SIMPLIFY_PATH);
+	CHECK(peer->commands[1] == SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL);
+	CHECK(peer->commands[2] == SceneMultiplayer::NETWORK_COMMAND_RAW);
+
+	// Nothing is left to send at the end of the frame.
+	multiplayer->poll();
+	CHECK(peer->commands.size() == 3);
+
+	// RPCs alone still wait for the end of the frame.
+	CHECK(node->rpc_id(2, "set_name", "C") == OK);
+	CHECK(peer->commands.size() == 3);
+	multiplayer->poll();
+	REQUIRE(peer->commands.size() == 4);
+	CHECK(peer->commands[3] == SceneMultiplayer::NETWORK_COMMAND_REMOTE_CALL);
+
+	memdelete(node);
+	multiplayer->set_multiplayer_peer(Ref<MultiplayerPeer>());
+}
+
+} // namespace TestSceneRPCInterface
+
+#endif // TEST_SCENE_RPC_INTERFACE_H
@@ -220,24 +220,7 @@ void RaycastOcclusionCull::occluder_initialize(RID p_occluder) {
 }
 
 void RaycastOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
-	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
-	ERR_FAIL_NULL(occluder);
-
-	occluder->vertices = p_vertices;
-	occluder->indices = p_indices;
-
-	for (const InstanceID &E : occluder->users) {
-		RID scenario_rid = E.scenario;
-		RID instance_rid = E.instance;
-		ERR_CONTINUE(!scenarios.has(scenario_rid));
-		Scenario &scenario = scenarios[scenario_rid];
-		ERR_CONTINUE(!scenario.instances.has(instance_rid));
-
-		if (!scenario.dirty_instances.has(instance_rid)) {
-			scenario.dirty_instances.insert(instance_rid);
-			scenario.dirty_instances_array.push_back(instance_rid);
-		}
-	}
+	_occluder_set_mesh(p_occluder, p_vertices, p_indices);
 }
 
 void RaycastOcclusionCull::free_occluder(RID p_occluder) {
@@ -261,81 +244,19 @@ void RaycastOcclusionCull::remove_scenario(RID p_scenario) {
 	scenarios.erase(p_scenario);
 }
 
-void RaycastOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
-	ERR_FAIL_COND(!scenarios.has(p_scenario));
-	Scenario &scenario = scenarios[p_scenario];
-
-	if (!scenario.instances.has(p_instance)) {
-		scenario.instances[p_instance] = OccluderInstance();
-	}
-
-	OccluderInstance &instance = scenario.instances[p_instance];
-
-	bool changed = false;
-
-	if (instance.removed) {
-		instance.removed = false;
-		scenario.removed_instances.erase(p_instance);
-		changed = true; // It was removed and re-added, we might have missed some changes
-	}
-
-	if (instance.occluder != p_occluder) {
-		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
-		if (old_occluder) {
-			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
-		}
-
-		instance.occluder = p_occluder;
-
-		if (p_occluder.is_valid()) {
-			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
-			ERR_FAIL_NULL(occluder);
-			occluder->users.insert(InstanceID(p_scenario, p_instance));
-		}
-		changed = true;
-	}
-
-	if (instance.xform != p_xform) {
-		scenario.instances[p_instance].xform = p_xform;
-		changed = true;
-	}
-
-	if (instance.enabled != p_enabled) {
-		instance.enabled = p_enabled;
-		scenario.dirty = true; // The scenario needs a scene re-build, but the instance doesn't need update
-	}
-
-	if (changed && !scenario.dirty_instances.has(p_instance)) {
-		scenario.dirty_instances.insert(p_instance);
-		scenario.dirty_instances_array.push_back(p_instance);
-		scenario.dirty = true;
-	}
+RendererSceneOcclusionCull::OccluderScenario *RaycastOcclusionCull::_get_occluder_scenario(RID p_scenario) {
+	return scenarios.getptr(p_scenario);
 }
 
-void RaycastOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
-	ERR_FAIL_COND(!scenarios.has(p_scenario));
-	Scenario &scenario = scenarios[p_scenario];
-
-	if (scenario.instances.has(p_instance)) {
-		OccluderInstance &instance = scenario.instances[p_instance];
-
-		if (!instance.removed) {
-			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
-			if (occluder) {
-				occluder->users.erase(InstanceID(p_scenario, p_instance));
-			}
-
-			scenario.removed_instances.push_back(p_instance);
-			instance.removed = true;
-		}
-	}
+void RaycastOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	_scenario_set_instance(p_scenario, p_instance, p_occluder, p_xform, p_enabled);
 }
 
-void RaycastOcclusionCull::Scenario::_update_dirty_instance_thread(int p_idx, RID *p_instances) {
-	_update_dirty_instance(p_idx, p_instances);
+void RaycastOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	_scenario_remove_instance(p_scenario, p_instance);
 }
 
-void RaycastOcclusionCull::Scenario::_update_dirty_instance(int p_idx, RID *p_instances) {
+void RaycastOcclusionCull::Scenario::_update_dirty_instance(uint32_t p_idx, RID *p_instances) {
 	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
 
 	if (!occ_inst) {
@@ -428,30 +349,10 @@ void RaycastOcclusionCull::Scenario::update() {
 		}
 	}
 
-	if (!dirty && removed_instances.is_empty() && dirty_instances_array.is_empty()) {
+	if (!update_instances(SNAME("RaycastOcclusionCullUpdate"))) {
 		return;
 	}
 
-	for (const RID &scenario : removed_instances) {
-		instances.erase(scenario);
-	}
-
-	if (dirty_instances_array.size() / WorkerThreadPool::get_singleton()->get_thread_count() > 128) {
-		// Lots of instances, use per-instance threading
-		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance_thread, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RaycastOcclusionCullUpdate"));
-		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-	} else {
-		// Few instances, use threading on the vertex transforms
-		for (unsigned int i = 0; i < dirty_instances_array.size(); i++) {
-			_update_dirty_instance(i, dirty_instances_array.ptr());
-		}
-	}
-
-	dirty_instances.clear();
-	dirty_instances_array.clear();
-	removed_instances.clear();
-
 	if (raycast_singleton->ebr_device == nullptr) {
 		raycast_singleton->_init_embree();
 	}
@@ -538,64 +439,6 @@ void RaycastOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size)
 	buffers[p_buffer].resize(p_size);
 }
 
-Projection RaycastOcclusionCull::_jitter_projection(const Projection &p_cam_projection, const Size2i &p_viewport_size) {
-	if (!_jitter_enabled) {
-		return p_cam_projection;
-	}
-
-	// Prevent divide by zero when using NULL viewport.
-	if ((p_viewport_size.x <= 0) || (p_viewport_size.y <= 0)) {
-		return p_cam_projection;
-	}
-
-	Projection p = p_cam_projection;
-
-	int32_t frame = Engine::get_singleton()->get_frames_drawn();
-	frame %= 9;
-
-	Vector2 jitter;
-
-	switch (frame) {
-		default:
-			break;
-		case 1: {
-			jitter = Vector2(-1, -1);
-		} break;
-		case 2: {
-			jitter = Vector2(1, -1);
-		} break;
-		case 3: {
-			jitter = Vector2(-1, 1);
-		} break;
-		case 4: {
-			jitter = Vector2(1, 1);
-		} break;
-		case 5: {
-			jitter = Vector2(-0.5f, -0.5f);
-		} break;
-		case 6: {
-			jitter = Vector2(0.5f, -0.5f);
-		} break;
-		case 7: {
-			jitter = Vector2(-0.5f, 0.5f);
-		} break;
-		case 8: {
-			jitter = Vector2(0.5f, 0.5f);
-		} break;
-	}
-
-	// The multiplier here determines the divergence from center,
-	// and is to some extent a balancing act.
-	// Higher divergence gives fewer false hidden, but more false shown.
-	// False hidden is obvious to viewer, false shown is not.
-	// False shown can lower percentage that are occluded, and therefore performance.
-	jitter *= Vector2(1 / (float)p_viewport_size.x, 1 / (float)p_viewport_size.y) * 0.05f;
-
-	p.add_jitter_offset(jitter);
-
-	return p;
-}
-
 void RaycastOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
 	if (!buffers.has(p_buffer)) {
 		return;
@@ -658,7 +501,6 @@ void RaycastOcclusionCull::_init_embree() {
 RaycastOcclusionCull::RaycastOcclusionCull() {
 	raycast_singleton = this;
 	int default_quality = GLOBAL_GET("rendering/occlusion_culling/bvh_build_quality");
-	_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 	build_quality = RS::ViewportOcclusionCullingBuildQuality(default_quality);
 }
 
@@ -82,40 +82,7 @@ public:
 	};
 
 private:
-	struct InstanceID {
-		RID scenario;
-		RID instance;
-
-		static uint32_t hash(const InstanceID &p_ins) {
-			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
-			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
-		}
-		bool operator==(const InstanceID &rhs) const {
-			return instance == rhs.instance && rhs.scenario == scenario;
-			;
-		}
-
-		InstanceID() {}
-		InstanceID(RID s, RID i) :
-				scenario(s), instance(i) {}
-	};
-
-	struct Occluder {
-		PackedVector3Array vertices;
-		PackedInt32Array indices;
-		HashSet<InstanceID, InstanceID> users;
-	};
-
-	struct OccluderInstance {
-		RID occluder;
-		LocalVector<uint32_t> indices;
-		LocalVector<Vector3> xformed_vertices;
-		Transform3D xform;
-		bool enabled = true;
-		bool removed = false;
-	};
-
-	struct Scenario {
+	struct Scenario : public OccluderScenario {
 		struct RaycastThreadData {
 			CameraRayTile *rays = nullptr;
 			const uint32_t *masks;
@@ -131,18 +98,11 @@ private:
 
 		Thread *commit_thread = nullptr;
 		bool commit_done = true;
-		bool dirty = false;
 
 		RTCScene ebr_scene[2] = { nullptr, nullptr };
 		int current_scene_idx = 0;
 
-		HashMap<RID, OccluderInstance> instances;
-		HashSet<RID> dirty_instances; // To avoid duplicates
-		LocalVector<RID> dirty_instances_array; // To iterate and split into threads
-		LocalVector<RID> removed_instances;
-
-		void _update_dirty_instance_thread(int p_idx, RID *p_instances);
-		void _update_dirty_instance(int p_idx, RID *p_instances);
+		virtual void _update_dirty_instance(uint32_t p_idx, RID *p_instances) override;
 		void _transform_vertices_thread(uint32_t p_thread, TransformThreadData *p_data);
 		void _transform_vertices_range(const Vector3 *p_read, Vector3 *p_write, const Transform3D &p_xform, int p_from, int p_to);
 		static void _commit_scene(void *p_ud);
@@ -159,14 +119,13 @@ private:
 	static const int TILE_RAYS = TILE_SIZE * TILE_SIZE;
 
 	RTCDevice ebr_device = nullptr;
-	RID_PtrOwner<Occluder> occluder_owner;
 	HashMap<RID, Scenario> scenarios;
 	HashMap<RID, RaycastHZBuffer> buffers;
 	RS::ViewportOcclusionCullingBuildQuality build_quality;
-	bool _jitter_enabled = false;
 
 	void _init_embree();
-	Projection _jitter_projection(const Projection &p_cam_projection, const Size2i &p_viewport_size);
+
+	virtual OccluderScenario *_get_occluder_scenario(RID p_scenario) override;
 
 public:
 	virtual bool is_occluder(RID p_rid) override;
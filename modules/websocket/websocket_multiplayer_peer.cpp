@@ -57,6 +57,9 @@ void WebSocketMultiplayerPeer::_clear() {
 	tcp_server.unref();
 	pending_peers.clear();
 	tls_server_options.unref();
+	poller.unref();
+	poll_events.clear();
+	dirty_peers.clear();
 	if (current_packet.data != nullptr) {
 		memfree(current_packet.data);
 		current_packet.data = nullptr;
@@ -96,6 +99,9 @@ void WebSocketMultiplayerPeer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_max_queued_packets", "max_queued_packets"), &WebSocketMultiplayerPeer::set_max_queued_packets);
 	ClassDB::bind_method(D_METHOD("get_max_queued_packets"), &WebSocketMultiplayerPeer::get_max_queued_packets);
 
+	ClassDB::bind_method(D_METHOD("set_event_driven", "enable"), &WebSocketMultiplayerPeer::set_event_driven);
+	ClassDB::bind_method(D_METHOD("is_event_driven"), &WebSocketMultiplayerPeer::is_event_driven);
+
 	ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "supported_protocols"), "set_supported_protocols", "get_supported_protocols");
 	ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "handshake_headers"), "set_handshake_headers", "get_handshake_headers");
 
@@ -105,6 +111,8 @@ void WebSocketMultiplayerPeer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "handshake_timeout"), "set_handshake_timeout", "get_handshake_timeout");
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_queued_packets"), "set_max_queued_packets", "get_max_queued_packets");
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "event_driven"), "set_event_driven", "is_event_driven");
 }
 
 //
@@ -142,12 +150,18 @@ Error WebSocketMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer
 		if (target_peer > 0) {
 			ERR_FAIL_COND_V_MSG(!peers_map.has(target_peer), ERR_INVALID_PARAMETER, "Peer not found: " + itos(target_peer));
 			get_peer(target_peer)->put_packet(p_buffer, p_buffer_size);
+			if (poller.is_valid()) {
+				dirty_peers.insert(target_peer);
+			}
 		} else {
 			for (KeyValue<int, Ref<WebSocketPeer>> &E : peers_map) {
 				if (target_peer && -target_peer == E.key) {
 					continue; // Excluded.
 				}
 				E.value->put_packet(p_buffer, p_buffer_size);
+				if (poller.is_valid()) {
+					dirty_peers.insert(E.key);
+				}
 			}
 		}
 		return OK;
@@ -187,6 +201,16 @@ Error WebSocketMultiplayerPeer::create_server(int p_port, IPAddress p_bind_ip, R
 		tcp_server.unref();
 		return err;
 	}
+	if (event_driven) {
+		poller = Ref<NetSocketPoller>(NetSocketPoller::create());
+		err = poller->add(tcp_server->get_socket(), LISTENER_SOCKET_ID);
+		if (err != OK) {
+			tcp_server->stop();
+			tcp_server.unref();
+			poller.unref();
+			return err;
+		}
+	}
 	unique_id = 1;
 	connection_status = CONNECTION_CONNECTED;
 	tls_server_options = p_options;
@@ -278,13 +302,41 @@ void WebSocketMultiplayerPeer::_poll_server() {
 	ERR_FAIL_COND(connection_status != CONNECTION_CONNECTED); // Bug.
 	ERR_FAIL_COND(tcp_server.is_null() || !tcp_server->is_listening()); // Bug.
 
+	if (poller.is_valid()) {
+		poller->wait(poll_events);
+	}
+
 	// Accept new connections.
-	if (!is_refusing_new_connections() && tcp_server->is_connection_available()) {
-		PendingPeer peer;
-		peer.time = OS::get_singleton()->get_ticks_msec();
-		peer.tcp = tcp_server->take_connection();
-		peer.connection = peer.tcp;
-		pending_peers[generate_unique_id()] = peer;
+	if (poller.is_null()) {
+		if (!is_refusing_new_connections() && tcp_server->is_connection_available()) {
+			PendingPeer peer;
+			peer.time = OS::get_singleton()->get_ticks_msec();
+			peer.tcp = tcp_server->take_connection();
+			peer.connection = peer.tcp;
+			pending_peers[generate_unique_id()] = peer;
+		}
+	} else if (!is_refusing_new_connections()) {
+		// The listener is only reported when there is something to accept, so drain the whole backlog.
+		for (const NetSocketPoller::Event &ev : poll_events) {
+			if (ev.id != LISTENER_SOCKET_ID) {
+				continue;
+			}
+			while (tcp_server->is_connection_available()) {
+				PendingPeer peer;
+				peer.time = OS::get_singleton()->get_ticks_msec();
+				peer.tcp = tcp_server->take_connection();
+				if (peer.tcp.is_null()) {
+					break;
+				}
+				peer.connection = peer.tcp;
+				int id = generate_unique_id();
+				if (poller->add(peer.tcp->get_socket(), id) != OK) {
+					continue;
+				}
+				pending_peers[id] = peer;
+			}
+			break;
+		}
 	}
 
 	// Process pending peers.
@@ -313,6 +365,9 @@ void WebSocketMultiplayerPeer::_poll_server() {
 				Error err = peer.ws->put_packet((const uint8_t *)&peer_id, sizeof(peer_id));
 				if (err == OK) {
 					peers_map[id] = peer.ws;
+					if (poller.is_valid()) {
+						dirty_peers.insert(id);
+					}
 					emit_signal("peer_connected", id);
 				} else {
 					ERR_PRINT("Failed to send ID to newly connected peer.");
@@ -361,41 +416,71 @@ void WebSocketMultiplayerPeer::_poll_server() {
 	// Remove disconnected pending peers.
 	for (const int &pid : to_remove) {
 		pending_peers.erase(pid);
+		if (poller.is_valid() && !peers_map.has(pid)) {
+			poller->remove(pid);
+		}
 	}
 	to_remove.clear();
 
 	// Process connected peers.
-	for (KeyValue<int, Ref<WebSocketPeer>> &E : peers_map) {
-		Ref<WebSocketPeer> ws = E.value;
-		int id = E.key;
-		ws->poll();
-		if (ws->get_ready_state() != WebSocketPeer::STATE_OPEN) {
-			to_remove.insert(id); // Disconnected.
-			continue;
+	if (poller.is_null()) {
+		for (KeyValue<int, Ref<WebSocketPeer>> &E : peers_map) {
+			_poll_peer(E.key, E.value, to_remove);
 		}
-		// Fetch packets
-		int pkts = ws->get_available_packet_count();
-		while (pkts > 0 && ws->get_ready_state() == WebSocketPeer::STATE_OPEN) {
-			const uint8_t *in_buffer;
-			int size = 0;
-			Error err = ws->get_packet(&in_buffer, size);
-			if (err != OK || size <= 0) {
-				break;
+	} else {
+		// Only visit peers with socket activity, or that were written to since the last poll.
+		for (const NetSocketPoller::Event &ev : poll_events) {
+			if (ev.id == LISTENER_SOCKET_ID) {
+				continue;
 			}
-			Packet packet;
-			packet.data = (uint8_t *)memalloc(size);
-			memcpy(packet.data, in_buffer, size);
-			packet.size = size;
-			packet.source = E.key;
-			incoming_packets.push_back(packet);
-			pkts--;
+			dirty_peers.insert(ev.id);
 		}
+		for (const int &pid : dirty_peers) {
+			HashMap<int, Ref<WebSocketPeer>>::Iterator E = peers_map.find(pid);
+			if (!E) {
+				continue; // Still pending, or gone.
+			}
+			_poll_peer(E->key, E->value, to_remove);
+			if (!to_remove.has(pid)) {
+				// Wait for the socket to drain if the outbound data did not fit.
+				poller->modify(pid, E->value->get_current_outbound_buffered_amount() > 0 ? NetSocket::POLL_TYPE_IN_OUT : NetSocket::POLL_TYPE_IN);
+			}
+		}
+		dirty_peers.clear();
 	}
 
 	// Remove disconnected peers.
 	for (const int &pid : to_remove) {
 		emit_signal(SNAME("peer_disconnected"), pid);
 		peers_map.erase(pid);
+		if (poller.is_valid()) {
+			poller->remove(pid);
+		}
+	}
+}
+
+void WebSocketMultiplayerPeer::_poll_peer(int p_peer_id, const Ref<WebSocketPeer> &p_ws, HashSet<int> &r_to_remove) {
+	p_ws->poll();
+	if (p_ws->get_ready_state() != WebSocketPeer::STATE_OPEN) {
+		r_to_remove.insert(p_peer_id); // Disconnected.
+		return;
+	}
+	// Fetch packets
+	int pkts = p_ws->get_available_packet_count();
+	while (pkts > 0 && p_ws->get_ready_state() == WebSocketPeer::STATE_OPEN) {
+		const uint8_t *in_buffer;
+		int size = 0;
+		Error err = p_ws->get_packet(&in_buffer, size);
+		if (err != OK || size <= 0) {
+			break;
+		}
+		Packet packet;
+		packet.data = (uint8_t *)memalloc(size);
+		memcpy(packet.data, in_buffer, size);
+		packet.size = size;
+		packet.source = p_peer_id;
+		incoming_packets.push_back(packet);
+		pkts--;
 	}
 }
 
@@ -468,6 +553,14 @@ void WebSocketMultiplayerPeer::set_handshake_timeout(float p_timeout) {
 	handshake_timeout = p_timeout * 1000;
 }
 
+void WebSocketMultiplayerPeer::set_event_driven(bool p_enable) {
+	event_driven = p_enable;
+}
+
+bool WebSocketMultiplayerPeer::is_event_driven() const {
+	return event_driven;
+}
+
 IPAddress WebSocketMultiplayerPeer::get_peer_address(int p_peer_id) const {
 	ERR_FAIL_COND_V(!peers_map.has(p_peer_id), IPAddress());
 	return peers_map[p_peer_id]->get_connected_host();
@@ -483,9 +576,15 @@ void WebSocketMultiplayerPeer::disconnect_peer(int p_peer_id, bool p_force) {
 	peers_map[p_peer_id]->close();
 	if (p_force) {
 		peers_map.erase(p_peer_id);
+		if (poller.is_valid()) {
+			poller->remove(p_peer_id);
+			dirty_peers.erase(p_peer_id);
+		}
 		if (!is_server()) {
 			_clear();
 		}
+	} else if (poller.is_valid()) {
+		dirty_peers.insert(p_peer_id);
 	}
 }
 
@@ -34,6 +34,7 @@
 #include "websocket_peer.h"
 
 #include "core/error/error_list.h"
+#include "core/io/net_socket.h"
 #include "core/io/stream_peer_tls.h"
 #include "core/io/tcp_server.h"
 #include "core/templates/list.h"
@@ -55,6 +56,10 @@ protected:
 		PROTO_SIZE = 9
 	};
 
+	enum {
+		LISTENER_SOCKET_ID = 0, // Peer IDs are always positive.
+	};
+
 	struct Packet {
 		int source = 0;
 		uint8_t *data = nullptr;
@@ -74,6 +79,11 @@ protected:
 	Ref<TCPServer> tcp_server;
 	Ref<TLSOptions> tls_server_options;
 
+	bool event_driven = false;
+	Ref<NetSocketPoller> poller;
+	LocalVector<NetSocketPoller::Event> poll_events;
+	HashSet<int> dirty_peers; // Polled on the next frame even if their socket is idle.
+
 	ConnectionStatus connection_status = CONNECTION_DISCONNECTED;
 
 	List<Packet> incoming_packets;
@@ -87,6 +97,7 @@ protected:
 
 	void _poll_client();
 	void _poll_server();
+	void _poll_peer(int p_peer_id, const Ref<WebSocketPeer> &p_ws, HashSet<int> &r_to_remove);
 	void _clear();
 
 public:
@@ -138,6 +149,9 @@ public:
 	void set_max_queued_packets(int p_max_queued_packets);
 	int get_max_queued_packets() const;
 
+	void set_event_driven(bool p_enable);
+	bool is_event_driven() const;
+
 	WebSocketMultiplayerPeer();
 	~WebSocketMultiplayerPeer();
 };
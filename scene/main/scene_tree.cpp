@@ -54,6 +54,7 @@
 #include "scene/resources/material.h"
 #include "scene/resources/mesh.h"
 #include "scene/resources/packed_scene.h"
+#include "scene/resources/texture_streaming.h"
 #include "scene/resources/world_2d.h"
 #include "servers/display_server.h"
 #include "servers/navigation_server_3d.h"
@@ -543,6 +544,10 @@ bool SceneTree::process(double p_time) {
 
 	_call_idle_callbacks();
 
+	if (TextureStreaming::get_singleton()) {
+		TextureStreaming::get_singleton()->update();
+	}
+
 #ifdef TOOLS_ENABLED
 #ifndef _3D_DISABLED
 	if (Engine::get_singleton()->is_editor_hint()) {
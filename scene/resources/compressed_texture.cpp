@@ -31,8 +31,18 @@
 #include "compressed_texture.h"
 
 #include "scene/resources/bit_map.h"
+#include "scene/resources/texture_streaming.h"
 
-Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit) {
+// Returns the smallest mipmap that is still at least p_size pixels along its largest axis.
+static int _get_mipmap_for_size(int p_width, int p_height, int p_mipmaps, float p_size) {
+	int mipmap = 0;
+	while (mipmap < p_mipmaps && MAX(p_width >> (mipmap + 1), p_height >> (mipmap + 1)) >= p_size) {
+		mipmap++;
+	}
+	return mipmap;
+}
+
+Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit, StreamData *r_stream, int *r_stream_mipmap) {
 	alpha_cache.unref();
 
 	ERR_FAIL_COND_V(image.is_null(), ERR_INVALID_PARAMETER);
@@ -79,6 +89,36 @@ Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r
 		p_size_limit = 0;
 	}
 
+	if (r_stream && (df & FORMAT_BIT_STREAM) && TextureStreaming::get_singleton()) {
+		// Only load the smallest mipmaps, TextureStreaming loads the others when needed.
+		uint64_t data_pos = f->get_position();
+		if (_parse_stream_data(f, *r_stream) == OK) {
+			// Respect the size limit like load_image_from_file() does, larger mipmaps are never streamed in.
+			if (p_size_limit > 0) {
+				while (r_stream->first_mipmap < r_stream->mipmaps && MAX(r_stream->width >> r_stream->first_mipmap, r_stream->height >> r_stream->first_mipmap) > p_size_limit) {
+					r_stream->first_mipmap++;
+				}
+			}
+			int mipmap = _get_mipmap_for_size(r_stream->width, r_stream->height, r_stream->mipmaps, TextureStreaming::get_singleton()->get_min_resident_size());
+			if (mipmap_limit >= 0) {
+				// Mipmaps past the limit are not meant to be used, so don't rest on one of them either.
+				mipmap = MIN(mipmap, mipmap_limit);
+			}
+			mipmap = MAX(mipmap, r_stream->first_mipmap);
+			if (mipmap > 0) {
+				image = _load_stream_mipmaps(f, *r_stream, mipmap);
+				if (image.is_null() || image->is_empty()) {
+					return ERR_CANT_OPEN;
+				}
+				r_stream->format = image->get_format();
+				*r_stream_mipmap = mipmap;
+				return OK;
+			}
+		}
+		*r_stream = StreamData();
+		f->seek(data_pos);
+	}
+
 	image = load_image_from_file(f, p_size_limit);
 
 	if (image.is_null() || image->is_empty()) {
@@ -135,11 +175,20 @@ Error CompressedTexture2D::load(const String &p_path) {
 	bool request_roughness;
 	int mipmap_limit;
 
-	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	StreamData stream_data;
+	int stream_mipmap = 0;
+
+	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, 0, &stream_data, &stream_mipmap);
 	if (err) {
 		return err;
 	}
 
+	bool was_streamed = stream.mipmaps > 0;
+	if (was_streamed && TextureStreaming::get_singleton()) {
+		TextureStreaming::get_singleton()->unregister_texture(this);
+	}
+	stream = stream_data;
+
 	if (texture.is_valid()) {
 		RID new_texture = RS::get_singleton()->texture_2d_create(image);
 		RS::get_singleton()->texture_replace(texture, new_texture);
@@ -155,6 +204,14 @@ Error CompressedTexture2D::load(const String &p_path) {
 	path_to_file = p_path;
 	format = image->get_format();
 
+	if (stream.mipmaps) {
+		TextureStreaming::get_singleton()->register_texture(this, stream_mipmap);
+		// The canvas and scene cull report every frame the texture is drawn in.
+		RS::get_singleton()->texture_set_usage_callback(texture, _stream_usage, this);
+	} else if (was_streamed) {
+		RS::get_singleton()->texture_set_usage_callback(texture, nullptr, nullptr);
+	}
+
 	if (get_path().is_empty()) {
 		//temporarily set path if no path set for resource, helps find errors
 		RenderingServer::get_singleton()->texture_set_path(texture, p_path);
@@ -196,6 +253,58 @@ String CompressedTexture2D::get_load_path() const {
 	return path_to_file;
 }
 
+bool CompressedTexture2D::is_streamed() const {
+	return stream.mipmaps > 0;
+}
+
+void CompressedTexture2D::request_streaming_size(int p_size) {
+	if ((w | h) == 0 || stream.mipmaps == 0 || !TextureStreaming::get_singleton()) {
+		return;
+	}
+	TextureStreaming::get_singleton()->report_usage(this, p_size / float(MAX(w, h)));
+}
+
+void CompressedTexture2D::_stream_usage(void *p_ud, float p_scale) {
+	// Called from the renderer, TextureStreaming ignores textures that were freed meanwhile.
+	if (TextureStreaming::get_singleton()) {
+		TextureStreaming::get_singleton()->report_usage((CompressedTexture2D *)p_ud, p_scale);
+	}
+}
+
+int CompressedTexture2D::_get_stream_mipmap_for_size(float p_size) const {
+	return MAX(_get_mipmap_for_size(stream.width, stream.height, stream.mipmaps, p_size), stream.first_mipmap);
+}
+
+uint64_t CompressedTexture2D::_get_stream_size(int p_first_mipmap) const {
+	if (stream.mipmaps == 0) {
+		return 0;
+	}
+	return Image::get_image_data_size(stream.width, stream.height, stream.format, true) - Image::get_image_mipmap_offset(stream.width, stream.height, stream.format, p_first_mipmap);
+}
+
+Ref<Image> CompressedTexture2D::_load_stream_image(const String &p_path, const StreamData &p_stream, int p_first_mipmap) {
+	ERR_FAIL_COND_V(p_stream.mipmaps == 0, Ref<Image>());
+
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(f.is_null(), Ref<Image>(), vformat("Unable to open file: %s.", p_path));
+
+	Ref<Image> image = _load_stream_mipmaps(f, p_stream, p_first_mipmap);
+	ERR_FAIL_COND_V(image.is_null() || image->is_empty(), Ref<Image>());
+	return image;
+}
+
+Error CompressedTexture2D::_set_resident_image(const Ref<Image> &p_image) {
+	ERR_FAIL_COND_V(stream.mipmaps == 0 || texture.is_null(), ERR_UNCONFIGURED);
+
+	RID new_texture = RS::get_singleton()->texture_2d_create(p_image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+	RS::get_singleton()->texture_set_size_override(texture, w, h);
+	RS::get_singleton()->texture_set_path(texture, get_path().is_empty() ? path_to_file : get_path());
+
+	alpha_cache.unref();
+	return OK;
+}
+
 int CompressedTexture2D::get_width() const {
 	return w;
 }
@@ -450,9 +559,93 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 	return Ref<Image>();
 }
 
+Error CompressedTexture2D::_parse_stream_data(Ref<FileAccess> p_file, StreamData &r_stream) {
+	r_stream.data_format = p_file->get_32();
+	r_stream.width = p_file->get_16();
+	r_stream.height = p_file->get_16();
+	r_stream.mipmaps = p_file->get_32();
+	r_stream.first_mipmap = 0;
+	r_stream.format = Image::Format(p_file->get_32());
+	r_stream.mipmap_offsets.clear();
+	r_stream.mipmap_sizes.clear();
+
+	if (r_stream.mipmaps == 0) {
+		return ERR_UNAVAILABLE;
+	}
+
+	if (r_stream.data_format == DATA_FORMAT_IMAGE) {
+		ERR_FAIL_INDEX_V(r_stream.format, Image::FORMAT_MAX, ERR_FILE_CORRUPT);
+		uint64_t data_pos = p_file->get_position();
+		for (int i = 0; i <= r_stream.mipmaps; i++) {
+			r_stream.mipmap_offsets.push_back(data_pos + Image::get_image_mipmap_offset(r_stream.width, r_stream.height, r_stream.format, i));
+		}
+		return OK;
+	} else if (r_stream.data_format == DATA_FORMAT_PNG || r_stream.data_format == DATA_FORMAT_WEBP) {
+		for (int i = 0; i <= r_stream.mipmaps; i++) {
+			uint32_t size = p_file->get_32();
+			r_stream.mipmap_offsets.push_back(p_file->get_position());
+			r_stream.mipmap_sizes.push_back(size);
+			p_file->seek(p_file->get_position() + size);
+		}
+		ERR_FAIL_COND_V(p_file->get_position() > p_file->get_length(), ERR_FILE_CORRUPT);
+		return OK;
+	}
+
+	// Basis Universal stores all mipmaps in a single blob, it can't be streamed.
+	return ERR_UNAVAILABLE;
+}
+
+Ref<Image> CompressedTexture2D::_load_stream_mipmaps(Ref<FileAccess> p_file, const StreamData &p_stream, int p_first_mipmap) {
+	ERR_FAIL_INDEX_V(p_first_mipmap, p_stream.mipmap_offsets.size(), Ref<Image>());
+
+	int tw, th;
+	int64_t ofs = Image::get_image_mipmap_offset_and_dimensions(p_stream.width, p_stream.height, p_stream.format, p_first_mipmap, tw, th);
+	bool has_mipmaps = p_first_mipmap < p_stream.mipmaps;
+
+	if (p_stream.data_format == DATA_FORMAT_IMAGE) {
+		Vector<uint8_t> data;
+		data.resize(Image::get_image_data_size(p_stream.width, p_stream.height, p_stream.format, true) - ofs);
+
+		p_file->seek(p_stream.mipmap_offsets[p_first_mipmap]);
+		uint64_t read = p_file->get_buffer(data.ptrw(), data.size());
+		ERR_FAIL_COND_V(read != uint64_t(data.size()), Ref<Image>());
+
+		return Image::create_from_data(tw, th, has_mipmaps, p_stream.format, data);
+	}
+
+	// PNG and WebP store each mipmap separately, they need to be combined.
+	Vector<uint8_t> data;
+	Image::Format format = Image::FORMAT_MAX;
+	for (int i = p_first_mipmap; i < p_stream.mipmap_offsets.size(); i++) {
+		Vector<uint8_t> pv;
+		pv.resize(p_stream.mipmap_sizes[i]);
+		p_file->seek(p_stream.mipmap_offsets[i]);
+		p_file->get_buffer(pv.ptrw(), pv.size());
+
+		Ref<Image> img;
+		if (p_stream.data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
+			img = Image::png_unpacker(pv);
+		} else if (p_stream.data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
+			img = Image::webp_unpacker(pv);
+		}
+		ERR_FAIL_COND_V(img.is_null() || img->is_empty(), Ref<Image>());
+
+		if (format == Image::FORMAT_MAX) {
+			format = img->get_format();
+		} else if (img->get_format() != format) {
+			img->convert(format); // All need to be the same format.
+		}
+		data.append_array(img->get_data());
+	}
+
+	return Image::create_from_data(tw, th, has_mipmaps, format, data);
+}
+
 void CompressedTexture2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load", "path"), &CompressedTexture2D::load);
 	ClassDB::bind_method(D_METHOD("get_load_path"), &CompressedTexture2D::get_load_path);
+	ClassDB::bind_method(D_METHOD("is_streamed"), &CompressedTexture2D::is_streamed);
+	ClassDB::bind_method(D_METHOD("request_streaming_size", "size"), &CompressedTexture2D::request_streaming_size);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "load_path", PROPERTY_HINT_FILE, "*.ctex"), "load", "get_load_path");
 }
@@ -460,6 +653,12 @@ void CompressedTexture2D::_bind_methods() {
 CompressedTexture2D::CompressedTexture2D() {}
 
 CompressedTexture2D::~CompressedTexture2D() {
+	if (stream.mipmaps && TextureStreaming::get_singleton()) {
+		TextureStreaming::get_singleton()->unregister_texture(this);
+	}
+	if (stream.mipmaps && texture.is_valid() && RenderingServer::get_singleton()) {
+		RS::get_singleton()->texture_set_usage_callback(texture, nullptr, nullptr);
+	}
 	if (texture.is_valid()) {
 		ERR_FAIL_NULL(RenderingServer::get_singleton());
 		RS::get_singleton()->free(texture);
@@ -67,9 +67,33 @@ private:
 	int h = 0;
 	mutable Ref<BitMap> alpha_cache;
 
-	Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0);
+	// Layout of the mipmaps in the file, only set when the texture is streamed.
+	struct StreamData {
+		uint32_t data_format = 0;
+		int width = 0;
+		int height = 0;
+		int mipmaps = 0;
+		int first_mipmap = 0; // Largest mipmap allowed by the size limit.
+		Image::Format format = Image::FORMAT_L8;
+		Vector<uint64_t> mipmap_offsets;
+		Vector<uint32_t> mipmap_sizes; // Only for PNG and WebP, which store each mipmap separately.
+	};
+	StreamData stream;
+
+	Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0, StreamData *r_stream = nullptr, int *r_stream_mipmap = nullptr);
 	virtual void reload_from_file() override;
 
+	static Error _parse_stream_data(Ref<FileAccess> p_file, StreamData &r_stream);
+	static Ref<Image> _load_stream_mipmaps(Ref<FileAccess> p_file, const StreamData &p_stream, int p_first_mipmap);
+
+	friend class TextureStreaming;
+	int _get_stream_mipmap_for_size(float p_size) const;
+	uint64_t _get_stream_size(int p_first_mipmap) const;
+	static Ref<Image> _load_stream_image(const String &p_path, const StreamData &p_stream, int p_first_mipmap);
+	Error _set_resident_image(const Ref<Image> &p_image);
+
+	static void _stream_usage(void *p_ud, float p_scale);
+
 	static void _requested_3d(void *p_ud);
 	static void _requested_roughness(void *p_ud, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_roughness_channel);
 	static void _requested_normal(void *p_ud);
@@ -92,6 +116,9 @@ public:
 	Error load(const String &p_path);
 	String get_load_path() const;
 
+	bool is_streamed() const;
+	void request_streaming_size(int p_size);
+
 	int get_width() const override;
 	int get_height() const override;
 	virtual RID get_rid() const override;
@@ -0,0 +1,244 @@
+/**************************************************************************/
+/*  texture_streaming.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "texture_streaming.h"
+
+#include "core/config/project_settings.h"
+#include "core/templates/local_vector.h"
+#include "scene/resources/compressed_texture.h"
+
+TextureStreaming *TextureStreaming::singleton = nullptr;
+
+void TextureStreaming::set_memory_budget(uint64_t p_bytes) {
+	MutexLock lock(mutex);
+	memory_budget = p_bytes;
+}
+
+uint64_t TextureStreaming::get_memory_budget() const {
+	MutexLock lock(mutex);
+	return memory_budget;
+}
+
+uint64_t TextureStreaming::get_resident_size() const {
+	MutexLock lock(mutex);
+	return resident_size;
+}
+
+struct TextureStreaming::Load {
+	CompressedTexture2D *texture = nullptr;
+	uint32_t version = 0;
+	int mipmap = 0;
+	int previous_mipmap = 0;
+	String path;
+	CompressedTexture2D::StreamData stream;
+	Ref<Image> image;
+};
+
+void TextureStreaming::register_texture(CompressedTexture2D *p_texture, int p_min_mipmap) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND(textures.has(p_texture));
+
+	Entry entry;
+	entry.min_mipmap = p_min_mipmap;
+	entry.resident_mipmap = p_min_mipmap;
+	entry.requested_mipmap = p_min_mipmap;
+	entry.last_used_frame = frame;
+	entry.version = ++last_version;
+	textures.insert(p_texture, entry);
+
+	resident_size += p_texture->_get_stream_size(p_min_mipmap);
+}
+
+void TextureStreaming::unregister_texture(CompressedTexture2D *p_texture) {
+	MutexLock lock(mutex);
+	HashMap<CompressedTexture2D *, Entry>::Iterator E = textures.find(p_texture);
+	if (!E) {
+		return;
+	}
+
+	resident_size -= p_texture->_get_stream_size(E->value.resident_mipmap);
+	textures.remove(E);
+}
+
+void TextureStreaming::report_usage(const CompressedTexture2D *p_texture, float p_scale) {
+	MutexLock lock(mutex);
+	// Don't touch the texture before it's known to be registered, textures unregister before they are freed.
+	Entry *entry = textures.getptr(const_cast<CompressedTexture2D *>(p_texture));
+	if (!entry) {
+		return;
+	}
+
+	float size = p_scale * MAX(p_texture->stream.width, p_texture->stream.height);
+	int mipmap = MIN(p_texture->_get_stream_mipmap_for_size(size), entry->min_mipmap);
+	if (entry->last_used_frame == frame) {
+		// Several users in the same frame, keep the largest request.
+		entry->requested_mipmap = MIN(entry->requested_mipmap, mipmap);
+	} else {
+		entry->requested_mipmap = mipmap;
+		entry->last_used_frame = frame;
+	}
+}
+
+void TextureStreaming::_queue_load(CompressedTexture2D *p_texture, Entry &r_entry, int p_mipmap, LocalVector<Load> &r_loads) {
+	Load load;
+	load.texture = p_texture;
+	load.version = r_entry.version;
+	load.mipmap = p_mipmap;
+	load.previous_mipmap = r_entry.resident_mipmap;
+	load.path = p_texture->path_to_file;
+	load.stream = p_texture->stream;
+	r_loads.push_back(load);
+
+	// Accounted for right away, reverted if the load fails.
+	r_entry.resident_mipmap = p_mipmap;
+}
+
+uint64_t TextureStreaming::_evict(uint64_t p_size, const CompressedTexture2D *p_except, LocalVector<Load> &r_loads) {
+	LocalVector<Request> candidates;
+	for (const KeyValue<CompressedTexture2D *, Entry> &E : textures) {
+		if (E.key == p_except || E.value.resident_mipmap >= E.value.min_mipmap || E.value.last_used_frame + EVICTION_DELAY_FRAMES > frame) {
+			continue;
+		}
+		Request candidate;
+		candidate.texture = E.key;
+		candidate.last_used_frame = E.value.last_used_frame;
+		candidates.push_back(candidate);
+	}
+
+	// Oldest first.
+	candidates.sort();
+	candidates.invert();
+
+	uint64_t freed = 0;
+	for (const Request &candidate : candidates) {
+		if (freed >= p_size) {
+			break;
+		}
+
+		Entry &entry = textures[candidate.texture];
+		uint64_t size = candidate.texture->_get_stream_size(entry.resident_mipmap) - candidate.texture->_get_stream_size(entry.min_mipmap);
+		_queue_load(candidate.texture, entry, entry.min_mipmap, r_loads);
+		entry.requested_mipmap = entry.min_mipmap;
+		resident_size -= size;
+		freed += size;
+	}
+
+	return freed;
+}
+
+void TextureStreaming::update() {
+	LocalVector<Load> loads;
+
+	{
+		MutexLock lock(mutex);
+		frame++;
+
+		LocalVector<Request> requests;
+		for (const KeyValue<CompressedTexture2D *, Entry> &E : textures) {
+			if (E.value.requested_mipmap >= E.value.resident_mipmap) {
+				continue;
+			}
+			Request request;
+			request.texture = E.key;
+			request.last_used_frame = E.value.last_used_frame;
+			request.size = E.key->_get_stream_size(E.value.requested_mipmap) - E.key->_get_stream_size(E.value.resident_mipmap);
+			requests.push_back(request);
+		}
+
+		// Most recently used first, cheapest first within the same frame.
+		requests.sort();
+
+		uint64_t uploaded = 0;
+		for (const Request &request : requests) {
+			Entry &entry = textures[request.texture];
+			if (entry.requested_mipmap >= entry.resident_mipmap) {
+				continue; // Evicted while making room for another request.
+			}
+
+			if (uploaded > 0 && uploaded + request.size > upload_budget) {
+				break; // The rest is streamed in over the next frames.
+			}
+
+			if (resident_size + request.size > memory_budget) {
+				_evict(resident_size + request.size - memory_budget, request.texture, loads);
+				if (resident_size + request.size > memory_budget) {
+					continue;
+				}
+			}
+
+			_queue_load(request.texture, entry, entry.requested_mipmap, loads);
+			resident_size += request.size;
+			uploaded += request.size;
+		}
+
+		if (resident_size > memory_budget) {
+			// The budget may have been lowered.
+			_evict(resident_size - memory_budget, nullptr, loads);
+		}
+	}
+
+	if (loads.is_empty()) {
+		return;
+	}
+
+	// Read the files without holding the mutex, so the renderer can keep reporting usage.
+	for (Load &load : loads) {
+		load.image = CompressedTexture2D::_load_stream_image(load.path, load.stream, load.mipmap);
+	}
+
+	MutexLock lock(mutex);
+	for (const Load &load : loads) {
+		Entry *entry = textures.getptr(load.texture);
+		if (!entry || entry->version != load.version) {
+			continue; // Freed or loaded again meanwhile.
+		}
+
+		if (load.image.is_valid() && load.texture->_set_resident_image(load.image) == OK) {
+			continue;
+		}
+
+		// Don't retry until usage is reported again.
+		resident_size = resident_size - load.texture->_get_stream_size(entry->resident_mipmap) + load.texture->_get_stream_size(load.previous_mipmap);
+		entry->resident_mipmap = load.previous_mipmap;
+		entry->requested_mipmap = load.previous_mipmap;
+	}
+}
+
+TextureStreaming::TextureStreaming() {
+	singleton = this;
+
+	memory_budget = uint64_t(int(GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/textures/streaming/memory_budget_mb", PROPERTY_HINT_RANGE, "16,65536,1,or_greater,suffix:MiB"), 512))) << 20;
+	upload_budget = uint64_t(int(GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/textures/streaming/max_upload_per_frame_kb", PROPERTY_HINT_RANGE, "64,65536,1,or_greater,suffix:KiB"), 8192))) << 10;
+	min_resident_size = GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/textures/streaming/min_resident_size", PROPERTY_HINT_RANGE, "1,4096,1,suffix:px"), 128);
+}
+
+TextureStreaming::~TextureStreaming() {
+	singleton = nullptr;
+}
@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*  texture_streaming.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEXTURE_STREAMING_H
+#define TEXTURE_STREAMING_H
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+class CompressedTexture2D;
+
+// Decides which mipmaps of streamed CompressedTexture2Ds are resident.
+// Textures start with only their smallest mipmaps loaded, larger mipmaps are
+// streamed in when usage is reported and evicted again (least recently used
+// first) when the memory budget is exceeded.
+class TextureStreaming {
+	static TextureStreaming *singleton;
+
+	struct Entry {
+		int min_mipmap = 0;
+		int resident_mipmap = 0;
+		int requested_mipmap = 0;
+		uint64_t last_used_frame = 0;
+		uint32_t version = 0; // Changes when the texture is registered again.
+	};
+
+	// Mipmaps read from the file outside of the mutex, applied in the same update().
+	struct Load;
+
+	struct Request {
+		CompressedTexture2D *texture = nullptr;
+		uint64_t last_used_frame = 0;
+		uint64_t size = 0;
+
+		bool operator<(const Request &p_other) const {
+			if (last_used_frame != p_other.last_used_frame) {
+				return last_used_frame > p_other.last_used_frame;
+			}
+			return size < p_other.size;
+		}
+	};
+
+	mutable Mutex mutex;
+	HashMap<CompressedTexture2D *, Entry> textures;
+	uint64_t frame = 0;
+	uint64_t resident_size = 0;
+	uint64_t memory_budget = 0;
+	uint64_t upload_budget = 0;
+	int min_resident_size = 0;
+	uint32_t last_version = 0;
+
+	void _queue_load(CompressedTexture2D *p_texture, Entry &r_entry, int p_mipmap, LocalVector<Load> &r_loads);
+	uint64_t _evict(uint64_t p_size, const CompressedTexture2D *p_except, LocalVector<Load> &r_loads);
+
+public:
+	enum {
+		// Textures used within this many frames are never evicted.
+		EVICTION_DELAY_FRAMES = 60,
+	};
+
+	static TextureStreaming *get_singleton() { return singleton; }
+
+	int get_min_resident_size() const { return min_resident_size; }
+
+	void set_memory_budget(uint64_t p_bytes);
+	uint64_t get_memory_budget() const;
+	uint64_t get_resident_size() const;
+
+	void register_texture(CompressedTexture2D *p_texture, int p_min_mipmap);
+	void unregister_texture(CompressedTexture2D *p_texture);
+
+	// p_scale is the on-screen size of a texel, 1.0 requests the full resolution.
+	// Safe to call from any thread, even while the texture is being freed.
+	void report_usage(const CompressedTexture2D *p_texture, float p_scale);
+	void update();
+
+	TextureStreaming();
+	~TextureStreaming();
+};
+
+#endif // TEXTURE_STREAMING_H
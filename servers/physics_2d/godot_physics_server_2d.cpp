@@ -36,6 +36,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1285,6 +1286,11 @@ void GodotPhysicsServer2D::set_active(bool p_active) {
 void GodotPhysicsServer2D::init() {
 	doing_sync = false;
 	stepper = memnew(GodotStep2D);
+	parallel_spaces = GLOBAL_GET("physics/2d/step_spaces_in_parallel");
+}
+
+void GodotPhysicsServer2D::_step_space(uint32_t p_index, void *p_userdata) {
+	space_steppers[p_index]->step(stepping_spaces[p_index], stepping_delta, step_id);
 }
 
 void GodotPhysicsServer2D::step(real_t p_step) {
@@ -1297,8 +1303,29 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	if (parallel_spaces && active_spaces.size() > 1) {
+		// Spaces share no state, so each one is stepped by its own stepper on the thread pool.
+		// Their islands are then solved serially, see GodotStep2D::set_parallel_islands().
+		stepping_spaces.clear();
+		for (const GodotSpace2D *E : active_spaces) {
+			stepping_spaces.push_back(const_cast<GodotSpace2D *>(E));
+		}
+		while (space_steppers.size() < stepping_spaces.size()) {
+			GodotStep2D *space_stepper = memnew(GodotStep2D);
+			space_stepper->set_parallel_islands(false);
+			space_steppers.push_back(space_stepper);
+		}
+		stepping_delta = p_step;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer2D::_step_space, nullptr, stepping_spaces.size(), -1, true, SNAME("Physics2DStepSpaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (const GodotSpace2D *E : active_spaces) {
+			stepper->step(const_cast<GodotSpace2D *>(E), p_step, step_id);
+		}
+	}
+	step_id++;
+
 	for (const GodotSpace2D *E : active_spaces) {
-		stepper->step(const_cast<GodotSpace2D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
@@ -1365,6 +1392,10 @@ void GodotPhysicsServer2D::end_sync() {
 
 void GodotPhysicsServer2D::finish() {
 	memdelete(stepper);
+	for (GodotStep2D *space_stepper : space_steppers) {
+		memdelete(space_stepper);
+	}
+	space_steppers.clear();
 }
 
 void GodotPhysicsServer2D::_update_shapes() {
@@ -57,6 +57,14 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 
 	GodotStep2D *stepper = nullptr;
 	HashSet<const GodotSpace2D *> active_spaces;
+	uint64_t step_id = 1;
+
+	// Stepping independent spaces (e.g. one per World2D) concurrently.
+	bool parallel_spaces = false;
+	LocalVector<GodotStep2D *> space_steppers;
+	LocalVector<GodotSpace2D *> stepping_spaces;
+	real_t stepping_delta = 0.0;
+	void _step_space(uint32_t p_index, void *p_userdata);
 
 	mutable RID_PtrOwner<GodotShape2D, true> shape_owner;
 	mutable RID_PtrOwner<GodotSpace2D, true> space_owner;
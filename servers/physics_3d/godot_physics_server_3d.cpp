@@ -38,7 +38,9 @@
 #include "joints/godot_pin_joint_3d.h"
 #include "joints/godot_slider_joint_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1626,6 +1628,11 @@ void GodotPhysicsServer3D::set_active(bool p_active) {
 
 void GodotPhysicsServer3D::init() {
 	stepper = memnew(GodotStep3D);
+	parallel_spaces = GLOBAL_GET("physics/3d/step_spaces_in_parallel");
+}
+
+void GodotPhysicsServer3D::_step_space(uint32_t p_index, void *p_userdata) {
+	space_steppers[p_index]->step(stepping_spaces[p_index], stepping_delta, step_id);
 }
 
 void GodotPhysicsServer3D::step(real_t p_step) {
@@ -1640,8 +1647,29 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	if (parallel_spaces && active_spaces.size() > 1) {
+		// Spaces share no state, so each one is stepped by its own stepper on the thread pool.
+		// Their islands are then solved serially, see GodotStep3D::set_parallel_islands().
+		stepping_spaces.clear();
+		for (const GodotSpace3D *E : active_spaces) {
+			stepping_spaces.push_back(const_cast<GodotSpace3D *>(E));
+		}
+		while (space_steppers.size() < stepping_spaces.size()) {
+			GodotStep3D *space_stepper = memnew(GodotStep3D);
+			space_stepper->set_parallel_islands(false);
+			space_steppers.push_back(space_stepper);
+		}
+		stepping_delta = p_step;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer3D::_step_space, nullptr, stepping_spaces.size(), -1, true, SNAME("Physics3DStepSpaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (const GodotSpace3D *E : active_spaces) {
+			stepper->step(const_cast<GodotSpace3D *>(E), p_step, step_id);
+		}
+	}
+	step_id++;
+
 	for (const GodotSpace3D *E : active_spaces) {
-		stepper->step(const_cast<GodotSpace3D *>(E), p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
@@ -1712,6 +1740,10 @@ void GodotPhysicsServer3D::end_sync() {
 
 void GodotPhysicsServer3D::finish() {
 	memdelete(stepper);
+	for (GodotStep3D *space_stepper : space_steppers) {
+		memdelete(space_stepper);
+	}
+	space_steppers.clear();
 }
 
 int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
@@ -55,6 +55,14 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 
 	GodotStep3D *stepper = nullptr;
 	HashSet<const GodotSpace3D *> active_spaces;
+	uint64_t step_id = 1;
+
+	// Stepping independent spaces (e.g. one per World3D) concurrently.
+	bool parallel_spaces = false;
+	LocalVector<GodotStep3D *> space_steppers;
+	LocalVector<GodotSpace3D *> stepping_spaces;
+	real_t stepping_delta = 0.0;
+	void _step_space(uint32_t p_index, void *p_userdata);
 
 	mutable RID_PtrOwner<GodotShape3D, true> shape_owner;
 	mutable RID_PtrOwner<GodotSpace3D, true> space_owner;
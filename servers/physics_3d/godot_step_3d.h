@@ -37,6 +37,7 @@
 
 class GodotStep3D {
 	uint64_t _step = 1;
+	bool parallel_islands = true;
 
 	int iterations = 0;
 	real_t delta = 0.0;
@@ -53,7 +54,11 @@ class GodotStep3D {
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
-	void step(GodotSpace3D *p_space, real_t p_delta);
+	// p_step must increase on every physics step, and be the same for all spaces stepped together.
+	void step(GodotSpace3D *p_space, real_t p_delta, uint64_t p_step);
+	// Islands are solved on the WorkerThreadPool unless disabled, e.g. when spaces are already stepped on it.
+	// A pool thread waiting for a nested group task could starve the pool, so work started from one is done serially.
+	void set_parallel_islands(bool p_enabled) { parallel_islands = p_enabled; }
 	GodotStep3D();
 	~GodotStep3D();
 };
@@ -0,0 +1,197 @@
+/**************************************************************************/
+/*  instance_cull_buffer.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "instance_cull_buffer.h"
+
+// Four instances are tested at a time, using SSE2 on x86, NEON on ARM and plain loops
+// elsewhere. Double precision builds always take the scalar path.
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INSTANCE_CULL_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define INSTANCE_CULL_SIMD_NEON
+#endif
+#endif
+
+void InstanceCullBuffer::push_back(const AABB &p_aabb, uint32_t p_layer_mask) {
+	min_x.push_back(p_aabb.position.x);
+	min_y.push_back(p_aabb.position.y);
+	min_z.push_back(p_aabb.position.z);
+	max_x.push_back(p_aabb.position.x + p_aabb.size.x);
+	max_y.push_back(p_aabb.position.y + p_aabb.size.y);
+	max_z.push_back(p_aabb.position.z + p_aabb.size.z);
+	layer_masks.push_back(p_layer_mask);
+}
+
+void InstanceCullBuffer::set_bounds(uint32_t p_index, const AABB &p_aabb) {
+	ERR_FAIL_UNSIGNED_INDEX(p_index, size());
+	min_x[p_index] = p_aabb.position.x;
+	min_y[p_index] = p_aabb.position.y;
+	min_z[p_index] = p_aabb.position.z;
+	max_x[p_index] = p_aabb.position.x + p_aabb.size.x;
+	max_y[p_index] = p_aabb.position.y + p_aabb.size.y;
+	max_z[p_index] = p_aabb.position.z + p_aabb.size.z;
+}
+
+void InstanceCullBuffer::set_layer_mask(uint32_t p_index, uint32_t p_layer_mask) {
+	ERR_FAIL_UNSIGNED_INDEX(p_index, size());
+	layer_masks[p_index] = p_layer_mask;
+}
+
+void InstanceCullBuffer::remove_at_unordered(uint32_t p_index) {
+	ERR_FAIL_UNSIGNED_INDEX(p_index, size());
+	uint32_t last = size() - 1;
+	if (p_index != last) {
+		min_x[p_index] = min_x[last];
+		min_y[p_index] = min_y[last];
+		min_z[p_index] = min_z[last];
+		max_x[p_index] = max_x[last];
+		max_y[p_index] = max_y[last];
+		max_z[p_index] = max_z[last];
+		layer_masks[p_index] = layer_masks[last];
+	}
+	min_x.resize(last);
+	min_y.resize(last);
+	min_z.resize(last);
+	max_x.resize(last);
+	max_y.resize(last);
+	max_z.resize(last);
+	layer_masks.resize(last);
+}
+
+void InstanceCullBuffer::reset() {
+	min_x.reset();
+	min_y.reset();
+	min_z.reset();
+	max_x.reset();
+	max_y.reset();
+	max_z.reset();
+	layer_masks.reset();
+}
+
+template <bool p_pending_only>
+void InstanceCullBuffer::_cull(const Plane *p_planes, uint32_t p_plane_count, uint32_t p_layer_mask, uint32_t p_from, uint32_t p_to, uint8_t *r_visible) const {
+	ERR_FAIL_COND(p_from > p_to || p_to > size());
+
+	// For each plane, pick the box corner furthest towards the inside. If even that corner
+	// is on the outer side, the whole box is. Selecting the arrays up front keeps the
+	// inner loop free of branches.
+	struct PlaneCorner {
+		real_t normal[3];
+		real_t d;
+		const real_t *coords[3];
+	};
+
+	const uint32_t MAX_PLANES = 16;
+	ERR_FAIL_COND(p_plane_count > MAX_PLANES);
+	PlaneCorner corners[MAX_PLANES];
+	for (uint32_t j = 0; j < p_plane_count; j++) {
+		const Plane &plane = p_planes[j];
+		PlaneCorner &corner = corners[j];
+		corner.normal[0] = plane.normal.x;
+		corner.normal[1] = plane.normal.y;
+		corner.normal[2] = plane.normal.z;
+		corner.d = plane.d;
+		corner.coords[0] = plane.normal.x > 0 ? min_x.ptr() : max_x.ptr();
+		corner.coords[1] = plane.normal.y > 0 ? min_y.ptr() : max_y.ptr();
+		corner.coords[2] = plane.normal.z > 0 ? min_z.ptr() : max_z.ptr();
+	}
+
+	const uint32_t *layers = layer_masks.ptr();
+	uint32_t i = p_from;
+
+#if defined(INSTANCE_CULL_SIMD_SSE)
+	for (; i + 4 <= p_to; i += 4) {
+		uint8_t *visible = r_visible + (i - p_from);
+		if (p_pending_only && visible[0] != CULL_PENDING && visible[1] != CULL_PENDING && visible[2] != CULL_PENDING && visible[3] != CULL_PENDING) {
+			continue;
+		}
+		__m128 outside = _mm_setzero_ps();
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const PlaneCorner &corner = corners[j];
+			__m128 dist = _mm_mul_ps(_mm_loadu_ps(corner.coords[0] + i), _mm_set1_ps(corner.normal[0]));
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_loadu_ps(corner.coords[1] + i), _mm_set1_ps(corner.normal[1])));
+			dist = _mm_add_ps(dist, _mm_mul_ps(_mm_loadu_ps(corner.coords[2] + i), _mm_set1_ps(corner.normal[2])));
+			outside = _mm_or_ps(outside, _mm_cmpge_ps(dist, _mm_set1_ps(corner.d)));
+		}
+		int outside_bits = _mm_movemask_ps(outside);
+		for (uint32_t k = 0; k < 4; k++) {
+			if (!p_pending_only || visible[k] == CULL_PENDING) {
+				visible[k] = !((outside_bits >> k) & 1) && (layers[i + k] & p_layer_mask);
+			}
+		}
+	}
+#elif defined(INSTANCE_CULL_SIMD_NEON)
+	for (; i + 4 <= p_to; i += 4) {
+		uint8_t *visible = r_visible + (i - p_from);
+		if (p_pending_only && visible[0] != CULL_PENDING && visible[1] != CULL_PENDING && visible[2] != CULL_PENDING && visible[3] != CULL_PENDING) {
+			continue;
+		}
+		uint32x4_t outside = vdupq_n_u32(0);
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const PlaneCorner &corner = corners[j];
+			float32x4_t dist = vmulq_n_f32(vld1q_f32(corner.coords[0] + i), corner.normal[0]);
+			dist = vaddq_f32(dist, vmulq_n_f32(vld1q_f32(corner.coords[1] + i), corner.normal[1]));
+			dist = vaddq_f32(dist, vmulq_n_f32(vld1q_f32(corner.coords[2] + i), corner.normal[2]));
+			outside = vorrq_u32(outside, vcgeq_f32(dist, vdupq_n_f32(corner.d)));
+		}
+		uint32_t outside_lanes[4];
+		vst1q_u32(outside_lanes, outside);
+		for (uint32_t k = 0; k < 4; k++) {
+			if (!p_pending_only || visible[k] == CULL_PENDING) {
+				visible[k] = !outside_lanes[k] && (layers[i + k] & p_layer_mask);
+			}
+		}
+	}
+#endif
+
+	for (; i < p_to; i++) {
+		if (p_pending_only && r_visible[i - p_from] != CULL_PENDING) {
+			continue;
+		}
+		bool outside = false;
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const PlaneCorner &corner = corners[j];
+			real_t dist = corner.coords[0][i] * corner.normal[0] + corner.coords[1][i] * corner.normal[1] + corner.coords[2][i] * corner.normal[2];
+			outside |= dist >= corner.d;
+		}
+		r_visible[i - p_from] = !outside && (layers[i] & p_layer_mask);
+	}
+}
+
+void InstanceCullBuffer::cull(const Plane *p_planes, uint32_t p_plane_count, uint32_t p_layer_mask, uint32_t p_from, uint32_t p_to, uint8_t *r_visible) const {
+	_cull<false>(p_planes, p_plane_count, p_layer_mask, p_from, p_to, r_visible);
+}
+
+void InstanceCullBuffer::cull_pending(const Plane *p_planes, uint32_t p_plane_count, uint32_t p_layer_mask, uint32_t p_from, uint32_t p_to, uint8_t *r_visible) const {
+	_cull<true>(p_planes, p_plane_count, p_layer_mask, p_from, p_to, r_visible);
+}
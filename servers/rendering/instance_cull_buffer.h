@@ -0,0 +1,78 @@
+/**************************************************************************/
+/*  instance_cull_buffer.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef INSTANCE_CULL_BUFFER_H
+#define INSTANCE_CULL_BUFFER_H
+
+#include "core/math/aabb.h"
+#include "core/math/plane.h"
+#include "core/templates/local_vector.h"
+
+// Structure of arrays copy of the bounds and layer masks of every instance in a
+// scenario, indexed like the scenario instance data. It is updated incrementally
+// as instances change, so the camera frustum test can stream over tightly packed
+// coordinates, four instances at a time.
+class InstanceCullBuffer {
+	LocalVector<real_t> min_x;
+	LocalVector<real_t> min_y;
+	LocalVector<real_t> min_z;
+	LocalVector<real_t> max_x;
+	LocalVector<real_t> max_y;
+	LocalVector<real_t> max_z;
+	LocalVector<uint32_t> layer_masks;
+
+	template <bool p_pending_only>
+	void _cull(const Plane *p_planes, uint32_t p_plane_count, uint32_t p_layer_mask, uint32_t p_from, uint32_t p_to, uint8_t *r_visible) const;
+
+public:
+	// Marks an r_visible entry that cull_pending() still has to test.
+	static const uint8_t CULL_PENDING = 0xFF;
+
+	_FORCE_INLINE_ uint32_t size() const { return layer_masks.size(); }
+
+	void push_back(const AABB &p_aabb, uint32_t p_layer_mask);
+	void set_bounds(uint32_t p_index, const AABB &p_aabb);
+	void set_layer_mask(uint32_t p_index, uint32_t p_layer_mask);
+	// Moves the last instance into p_index, matching how the scenario removes instances.
+	void remove_at_unordered(uint32_t p_index);
+	void reset();
+
+	// Writes 1 to r_visible for each instance in [p_from, p_to) that shares a layer with
+	// p_layer_mask and is not fully outside any of the (outward facing) planes, and 0 otherwise.
+	// This is the same conservative test as RendererSceneCull::InstanceBounds::in_frustum.
+	// r_visible is indexed from p_from.
+	void cull(const Plane *p_planes, uint32_t p_plane_count, uint32_t p_layer_mask, uint32_t p_from, uint32_t p_to, uint8_t *r_visible) const;
+	// Same as cull(), but only tests the instances whose r_visible entry is CULL_PENDING and
+	// leaves the others as they are. Groups of four already decided instances (for example
+	// by their cluster) skip the plane tests entirely.
+	void cull_pending(const Plane *p_planes, uint32_t p_plane_count, uint32_t p_layer_mask, uint32_t p_from, uint32_t p_to, uint8_t *r_visible) const;
+};
+
+#endif // INSTANCE_CULL_BUFFER_H
@@ -0,0 +1,558 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+// Four pixels are shaded at a time, using SSE2 on x86, NEON on ARM and plain floats elsewhere.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RASTER_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define RASTER_SIMD_NEON
+#endif
+
+#if defined(RASTER_SIMD_SSE)
+
+typedef __m128 f32x4;
+typedef __m128 mask32x4;
+
+static _FORCE_INLINE_ f32x4 f32x4_set1(float p_value) { return _mm_set1_ps(p_value); }
+static _FORCE_INLINE_ f32x4 f32x4_ramp(float p_from) { return _mm_add_ps(_mm_set1_ps(p_from), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f)); }
+static _FORCE_INLINE_ f32x4 f32x4_load(const float *p_ptr) { return _mm_loadu_ps(p_ptr); }
+static _FORCE_INLINE_ void f32x4_store(float *p_ptr, f32x4 p_value) { _mm_storeu_ps(p_ptr, p_value); }
+static _FORCE_INLINE_ f32x4 f32x4_madd(f32x4 p_a, f32x4 p_b, f32x4 p_c) { return _mm_add_ps(_mm_mul_ps(p_a, p_b), p_c); }
+static _FORCE_INLINE_ f32x4 f32x4_min(f32x4 p_a, f32x4 p_b) { return _mm_min_ps(p_a, p_b); }
+static _FORCE_INLINE_ f32x4 f32x4_max(f32x4 p_a, f32x4 p_b) { return _mm_max_ps(p_a, p_b); }
+static _FORCE_INLINE_ f32x4 f32x4_rcp(f32x4 p_value) { return _mm_div_ps(_mm_set1_ps(1.0f), p_value); }
+static _FORCE_INLINE_ mask32x4 f32x4_ge(f32x4 p_a, f32x4 p_b) { return _mm_cmpge_ps(p_a, p_b); }
+static _FORCE_INLINE_ mask32x4 mask32x4_and(mask32x4 p_a, mask32x4 p_b) { return _mm_and_ps(p_a, p_b); }
+static _FORCE_INLINE_ bool mask32x4_any(mask32x4 p_mask) { return _mm_movemask_ps(p_mask) != 0; }
+static _FORCE_INLINE_ f32x4 f32x4_select(mask32x4 p_mask, f32x4 p_a, f32x4 p_b) { return _mm_or_ps(_mm_and_ps(p_mask, p_a), _mm_andnot_ps(p_mask, p_b)); }
+
+#elif defined(RASTER_SIMD_NEON)
+
+typedef float32x4_t f32x4;
+typedef uint32x4_t mask32x4;
+
+static _FORCE_INLINE_ f32x4 f32x4_set1(float p_value) { return vdupq_n_f32(p_value); }
+static _FORCE_INLINE_ f32x4 f32x4_ramp(float p_from) {
+	static const float ramp[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+	return vaddq_f32(vdupq_n_f32(p_from), vld1q_f32(ramp));
+}
+static _FORCE_INLINE_ f32x4 f32x4_load(const float *p_ptr) { return vld1q_f32(p_ptr); }
+static _FORCE_INLINE_ void f32x4_store(float *p_ptr, f32x4 p_value) { vst1q_f32(p_ptr, p_value); }
+static _FORCE_INLINE_ f32x4 f32x4_madd(f32x4 p_a, f32x4 p_b, f32x4 p_c) { return vmlaq_f32(p_c, p_a, p_b); }
+static _FORCE_INLINE_ f32x4 f32x4_min(f32x4 p_a, f32x4 p_b) { return vminq_f32(p_a, p_b); }
+static _FORCE_INLINE_ f32x4 f32x4_max(f32x4 p_a, f32x4 p_b) { return vmaxq_f32(p_a, p_b); }
+static _FORCE_INLINE_ f32x4 f32x4_rcp(f32x4 p_value) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+	return vdivq_f32(vdupq_n_f32(1.0f), p_value);
+#else
+	// No division on 32-bit NEON, refine the estimate instead.
+	f32x4 r = vrecpeq_f32(p_value);
+	r = vmulq_f32(vrecpsq_f32(p_value, r), r);
+	return vmulq_f32(vrecpsq_f32(p_value, r), r);
+#endif
+}
+static _FORCE_INLINE_ mask32x4 f32x4_ge(f32x4 p_a, f32x4 p_b) { return vcgeq_f32(p_a, p_b); }
+static _FORCE_INLINE_ mask32x4 mask32x4_and(mask32x4 p_a, mask32x4 p_b) { return vandq_u32(p_a, p_b); }
+static _FORCE_INLINE_ bool mask32x4_any(mask32x4 p_mask) {
+	uint32x2_t m = vorr_u32(vget_low_u32(p_mask), vget_high_u32(p_mask));
+	return vget_lane_u32(vpmax_u32(m, m), 0) != 0;
+}
+static _FORCE_INLINE_ f32x4 f32x4_select(mask32x4 p_mask, f32x4 p_a, f32x4 p_b) { return vbslq_f32(p_mask, p_a, p_b); }
+
+#else
+
+struct f32x4 {
+	float v[4];
+};
+
+struct mask32x4 {
+	bool v[4];
+};
+
+static _FORCE_INLINE_ f32x4 f32x4_set1(float p_value) { return { { p_value, p_value, p_value, p_value } }; }
+static _FORCE_INLINE_ f32x4 f32x4_ramp(float p_from) { return { { p_from, p_from + 1.0f, p_from + 2.0f, p_from + 3.0f } }; }
+static _FORCE_INLINE_ f32x4 f32x4_load(const float *p_ptr) { return { { p_ptr[0], p_ptr[1], p_ptr[2], p_ptr[3] } }; }
+static _FORCE_INLINE_ void f32x4_store(float *p_ptr, f32x4 p_value) {
+	for (int i = 0; i < 4; i++) {
+		p_ptr[i] = p_value.v[i];
+	}
+}
+
+#define RASTER_SIMD_OP(m_name, m_type, m_expr)                         \
+	static _FORCE_INLINE_ m_type m_name(f32x4 p_a, f32x4 p_b) {         \
+		m_type r;                                                       \
+		for (int i = 0; i < 4; i++) {                                   \
+			r.v[i] = m_expr;                                            \
+		}                                                               \
+		return r;                                                       \
+	}
+
+RASTER_SIMD_OP(f32x4_min, f32x4, MIN(p_a.v[i], p_b.v[i]))
+RASTER_SIMD_OP(f32x4_max, f32x4, MAX(p_a.v[i], p_b.v[i]))
+RASTER_SIMD_OP(f32x4_ge, mask32x4, p_a.v[i] >= p_b.v[i])
+#undef RASTER_SIMD_OP
+
+static _FORCE_INLINE_ f32x4 f32x4_madd(f32x4 p_a, f32x4 p_b, f32x4 p_c) {
+	f32x4 r;
+	for (int i = 0; i < 4; i++) {
+		r.v[i] = p_a.v[i] * p_b.v[i] + p_c.v[i];
+	}
+	return r;
+}
+static _FORCE_INLINE_ f32x4 f32x4_rcp(f32x4 p_value) {
+	f32x4 r;
+	for (int i = 0; i < 4; i++) {
+		r.v[i] = 1.0f / p_value.v[i];
+	}
+	return r;
+}
+static _FORCE_INLINE_ mask32x4 mask32x4_and(mask32x4 p_a, mask32x4 p_b) {
+	mask32x4 r;
+	for (int i = 0; i < 4; i++) {
+		r.v[i] = p_a.v[i] && p_b.v[i];
+	}
+	return r;
+}
+static _FORCE_INLINE_ bool mask32x4_any(mask32x4 p_mask) {
+	return p_mask.v[0] || p_mask.v[1] || p_mask.v[2] || p_mask.v[3];
+}
+static _FORCE_INLINE_ f32x4 f32x4_select(mask32x4 p_mask, f32x4 p_a, f32x4 p_b) {
+	f32x4 r;
+	for (int i = 0; i < 4; i++) {
+		r.v[i] = p_mask.v[i] ? p_a.v[i] : p_b.v[i];
+	}
+	return r;
+}
+
+#endif
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	triangles.clear();
+	bands.clear();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	bands.resize((p_size.y + BAND_HEIGHT - 1) / BAND_HEIGHT);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_triangle(const Vector3 p_view[3], const Projection &p_cam_projection, bool p_orthogonal) {
+	const Size2i &size = sizes[0];
+
+	Vector2 p[3];
+	float z[3];
+	float min_depth = FLT_MAX;
+	for (int i = 0; i < 3; i++) {
+		Plane projected = p_cam_projection.xform4(Plane(p_view[i], 1.0));
+		float w = projected.d;
+		p[i].x = (projected.normal.x / w * 0.5f + 0.5f) * size.x;
+		p[i].y = (projected.normal.y / w * 0.5f + 0.5f) * size.y;
+
+		// Depth is linear in screen space for orthogonal projections, its inverse is for perspective ones.
+		float depth = -p_view[i].z;
+		z[i] = p_orthogonal ? depth : 1.0f / depth;
+		min_depth = MIN(min_depth, depth);
+	}
+
+	float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[2].x - p[0].x) * (p[1].y - p[0].y);
+	if (Math::abs(area) < 1e-6f) {
+		return; // Degenerate, or seen edge-on.
+	}
+	if (area < 0.0f) {
+		// Occluders are double sided, make the winding consistent.
+		SWAP(p[1], p[2]);
+		SWAP(z[1], z[2]);
+		area = -area;
+	}
+
+	float min_x = MIN(p[0].x, MIN(p[1].x, p[2].x));
+	float max_x = MAX(p[0].x, MAX(p[1].x, p[2].x));
+	float min_y = MIN(p[0].y, MIN(p[1].y, p[2].y));
+	float max_y = MAX(p[0].y, MAX(p[1].y, p[2].y));
+	if (max_x < 0.0f || max_y < 0.0f || min_x > size.x || min_y > size.y) {
+		return; // Off screen.
+	}
+
+	Triangle t;
+	t.min_x = CLAMP((int)Math::floor(min_x), 0, size.x - 1);
+	t.max_x = CLAMP((int)Math::ceil(max_x), 0, size.x - 1);
+	t.min_y = CLAMP((int)Math::floor(min_y), 0, size.y - 1);
+	t.max_y = CLAMP((int)Math::ceil(max_y), 0, size.y - 1);
+
+	// Edge functions, positive on the inner side of each edge.
+	for (int i = 0; i < 3; i++) {
+		const Vector2 &from = p[i];
+		Vector2 edge = p[(i + 1) % 3] - from;
+		t.edge_a[i] = -edge.y;
+		t.edge_b[i] = edge.x;
+		t.edge_c[i] = edge.y * from.x - edge.x * from.y;
+	}
+
+	float dz1 = z[1] - z[0];
+	float dz2 = z[2] - z[0];
+	t.depth_a = (dz1 * (p[2].y - p[0].y) - dz2 * (p[1].y - p[0].y)) / area;
+	t.depth_b = (dz2 * (p[1].x - p[0].x) - dz1 * (p[2].x - p[0].x)) / area;
+	t.depth_c = z[0] - t.depth_a * p[0].x - t.depth_b * p[0].y;
+	t.depth_min = min_depth;
+
+	uint32_t index = triangles.size();
+	triangles.push_back(t);
+	for (int band = t.min_y / BAND_HEIGHT; band <= t.max_y / BAND_HEIGHT; band++) {
+		bands[band].push_back(index);
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_band(uint32_t p_band, const RasterThreadData *p_data) {
+	const int width = sizes[0].x;
+	const int from_y = p_band * BAND_HEIGHT;
+	const int to_y = MIN(from_y + BAND_HEIGHT, sizes[0].y);
+	float *depth_buffer = mips[0];
+
+	for (int i = from_y * width; i < to_y * width; i++) {
+		depth_buffer[i] = FLT_MAX;
+	}
+
+	const f32x4 zero = f32x4_set1(0.0f);
+
+	for (const uint32_t &index : bands[p_band]) {
+		const Triangle &t = triangles[index];
+		const f32x4 edge_a[3] = { f32x4_set1(t.edge_a[0]), f32x4_set1(t.edge_a[1]), f32x4_set1(t.edge_a[2]) };
+		const f32x4 depth_a = f32x4_set1(t.depth_a);
+		const f32x4 depth_min = f32x4_set1(t.depth_min);
+		const int first_x = t.min_x & ~3;
+
+		for (int y = MAX(t.min_y, from_y); y <= MIN(t.max_y, to_y - 1); y++) {
+			// Sample at pixel centers, like the raycast backend.
+			float py = y + 0.5f;
+			f32x4 edge_row[3];
+			for (int i = 0; i < 3; i++) {
+				edge_row[i] = f32x4_set1(t.edge_b[i] * py + t.edge_c[i]);
+			}
+			f32x4 depth_row = f32x4_set1(t.depth_b * py + t.depth_c);
+			float *row = depth_buffer + y * width;
+
+			for (int x = first_x; x <= t.max_x; x += 4) {
+				if (x + 4 > width) {
+					// Row tail, not enough room for a full vector.
+					for (int tx = x; tx < width; tx++) {
+						float px = tx + 0.5f;
+						bool inside = true;
+						for (int i = 0; i < 3; i++) {
+							inside = inside && (t.edge_a[i] * px + t.edge_b[i] * py + t.edge_c[i]) >= 0.0f;
+						}
+						if (!inside) {
+							continue;
+						}
+						float depth = t.depth_a * px + t.depth_b * py + t.depth_c;
+						depth = MAX(p_data->orthogonal ? depth : 1.0f / depth, t.depth_min);
+						row[tx] = MIN(row[tx], depth);
+					}
+					break;
+				}
+
+				f32x4 px = f32x4_ramp(x + 0.5f);
+				mask32x4 inside = f32x4_ge(f32x4_madd(edge_a[0], px, edge_row[0]), zero);
+				inside = mask32x4_and(inside, f32x4_ge(f32x4_madd(edge_a[1], px, edge_row[1]), zero));
+				inside = mask32x4_and(inside, f32x4_ge(f32x4_madd(edge_a[2], px, edge_row[2]), zero));
+				if (!mask32x4_any(inside)) {
+					continue;
+				}
+
+				f32x4 depth = f32x4_madd(depth_a, px, depth_row);
+				if (!p_data->orthogonal) {
+					depth = f32x4_rcp(depth);
+				}
+				// Interpolation can overshoot at the edges, never write something closer than the triangle.
+				depth = f32x4_max(depth, depth_min);
+
+				f32x4 current = f32x4_load(row + x);
+				f32x4_store(row + x, f32x4_select(inside, f32x4_min(current, depth), current));
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const Mesh *p_meshes, uint32_t p_mesh_count, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (is_empty()) {
+		return;
+	}
+
+	triangles.clear();
+	for (LocalVector<uint32_t> &band : bands) {
+		band.clear();
+	}
+
+	const Transform3D view_xform = p_cam_transform.affine_inverse();
+	const float z_near = p_cam_projection.get_z_near();
+
+	for (uint32_t m = 0; m < p_mesh_count; m++) {
+		const Mesh &mesh = p_meshes[m];
+		for (uint32_t i = 0; i + 2 < mesh.index_count; i += 3) {
+			Vector3 view[3];
+			int inside_count = 0;
+			for (int j = 0; j < 3; j++) {
+				view[j] = view_xform.xform(mesh.vertices[mesh.indices[i + j]]);
+				inside_count += view[j].z <= -z_near ? 1 : 0;
+			}
+
+			if (inside_count == 3) {
+				_setup_triangle(view, p_cam_projection, p_cam_orthogonal);
+				continue;
+			}
+			if (inside_count == 0) {
+				continue;
+			}
+
+			// Clip against the near plane, which leaves a triangle or a quad.
+			Vector3 clipped[4];
+			int clipped_count = 0;
+			for (int j = 0; j < 3; j++) {
+				const Vector3 &a = view[j];
+				const Vector3 &b = view[(j + 1) % 3];
+				bool a_inside = a.z <= -z_near;
+				bool b_inside = b.z <= -z_near;
+				if (a_inside) {
+					clipped[clipped_count++] = a;
+				}
+				if (a_inside != b_inside) {
+					float t = (-z_near - a.z) / (b.z - a.z);
+					clipped[clipped_count++] = a.lerp(b, t);
+				}
+			}
+
+			_setup_triangle(clipped, p_cam_projection, p_cam_orthogonal);
+			if (clipped_count == 4) {
+				const Vector3 second[3] = { clipped[0], clipped[2], clipped[3] };
+				_setup_triangle(second, p_cam_projection, p_cam_orthogonal);
+			}
+		}
+	}
+
+	RasterThreadData td;
+	td.orthogonal = p_cam_orthogonal;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_band, &td, bands.size(), -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	debug_tex_range = p_cam_projection.get_z_far();
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	_occluder_set_mesh(p_occluder, p_vertices, p_indices);
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+RendererSceneOcclusionCull::OccluderScenario *RasterOcclusionCull::_get_occluder_scenario(RID p_scenario) {
+	return scenarios.getptr(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	_scenario_set_instance(p_scenario, p_instance, p_occluder, p_xform, p_enabled);
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	_scenario_remove_instance(p_scenario, p_instance);
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(uint32_t p_idx, RID *p_instances) {
+	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	Occluder *occ = raster_singleton->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ) {
+		return;
+	}
+
+	int vertices_size = occ->vertices.size();
+	occ_inst->xformed_vertices.resize(vertices_size);
+
+	const Vector3 *read_ptr = occ->vertices.ptr();
+	Vector3 *write_ptr = occ_inst->xformed_vertices.ptr();
+	for (int i = 0; i < vertices_size; i++) {
+		write_ptr[i] = occ_inst->xform.xform(read_ptr[i]);
+	}
+
+	// Drop out of range indices once here, so rasterization doesn't have to check them.
+	const int32_t *indices = occ->indices.ptr();
+	int index_count = occ->indices.size() - occ->indices.size() % 3;
+	occ_inst->indices.clear();
+	occ_inst->indices.reserve(index_count);
+	for (int i = 0; i < index_count; i += 3) {
+		if ((uint32_t)indices[i] >= (uint32_t)vertices_size || (uint32_t)indices[i + 1] >= (uint32_t)vertices_size || (uint32_t)indices[i + 2] >= (uint32_t)vertices_size) {
+			continue;
+		}
+		occ_inst->indices.push_back(indices[i]);
+		occ_inst->indices.push_back(indices[i + 1]);
+		occ_inst->indices.push_back(indices[i + 2]);
+	}
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	if (!update_instances(SNAME("RasterOcclusionCullUpdate"))) {
+		return;
+	}
+
+	meshes.clear();
+	for (const KeyValue<RID, OccluderInstance> &E : instances) {
+		const OccluderInstance &occ_inst = E.value;
+		if (!occ_inst.enabled || occ_inst.indices.is_empty()) {
+			continue;
+		}
+		RasterHZBuffer::Mesh mesh;
+		mesh.vertices = occ_inst.xformed_vertices.ptr();
+		mesh.indices = occ_inst.indices.ptr();
+		mesh.index_count = occ_inst.indices.size();
+		meshes.push_back(mesh);
+	}
+
+	dirty = false;
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+	scenario.update();
+
+	Projection jittered_proj = _jitter_projection(p_cam_projection, buffer.get_occlusion_buffer_size());
+
+	buffer.rasterize(scenario.meshes.ptr(), scenario.meshes.size(), p_cam_transform, jittered_proj, p_cam_orthogonal);
+	buffer.update_mips();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	raster_singleton = nullptr;
+}
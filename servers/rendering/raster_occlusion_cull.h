@@ -0,0 +1,127 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RASTER_OCCLUSION_CULL_H
+#define RASTER_OCCLUSION_CULL_H
+
+#include "core/math/projection.h"
+#include "core/templates/local_vector.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Occlusion culling backend that rasterizes the occluder meshes on the CPU into the
+// depth buffer, instead of raytracing them. It has no dependencies, so it works on all
+// platforms and architectures, and is used when the raycast module is not available.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	class RasterHZBuffer : public HZBuffer {
+	public:
+		struct Mesh {
+			const Vector3 *vertices = nullptr; // World space.
+			const uint32_t *indices = nullptr;
+			uint32_t index_count = 0;
+		};
+
+	private:
+		static const int BAND_HEIGHT = 8;
+
+		// Screen space triangle, with edge functions and interpolated depth as planes.
+		struct Triangle {
+			float edge_a[3];
+			float edge_b[3];
+			float edge_c[3];
+			float depth_a;
+			float depth_b;
+			float depth_c;
+			float depth_min;
+			int min_x;
+			int max_x;
+			int min_y;
+			int max_y;
+		};
+
+		struct RasterThreadData {
+			bool orthogonal = false;
+		};
+
+		LocalVector<Triangle> triangles;
+		LocalVector<LocalVector<uint32_t>> bands;
+
+		void _setup_triangle(const Vector3 p_view[3], const Projection &p_cam_projection, bool p_orthogonal);
+		void _rasterize_band(uint32_t p_band, const RasterThreadData *p_data);
+
+	public:
+		RID scenario_rid;
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+		void rasterize(const Mesh *p_meshes, uint32_t p_mesh_count, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal);
+	};
+
+private:
+	struct Scenario : public OccluderScenario {
+		LocalVector<RasterHZBuffer::Mesh> meshes;
+
+		virtual void _update_dirty_instance(uint32_t p_idx, RID *p_instances) override;
+		void update();
+	};
+
+	static RasterOcclusionCull *raster_singleton;
+
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	virtual OccluderScenario *_get_occluder_scenario(RID p_scenario) override;
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RasterOcclusionCull();
+	~RasterOcclusionCull();
+};
+
+#endif // RASTER_OCCLUSION_CULL_H
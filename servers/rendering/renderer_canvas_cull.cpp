@@ -44,7 +44,31 @@
 // while not making lines appear too soft.
 const static float FEATHER_SIZE = 1.25f;
 
-void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info) {
+RendererCanvasRender::Item *RendererCanvasCull::_merge_z_lists(RendererCanvasRender::Item **const *p_z_lists, RendererCanvasRender::Item **const *p_z_last_lists, int p_count) {
+	RendererCanvasRender::Item *list = nullptr;
+	RendererCanvasRender::Item *list_end = nullptr;
+
+	// Lists are joined by z first and then in the order they are given, so the result
+	// is the same as if everything had been culled into a single set of z lists.
+	for (int i = 0; i < z_range; i++) {
+		for (int j = 0; j < p_count; j++) {
+			if (!p_z_lists[j][i]) {
+				continue;
+			}
+			if (!list) {
+				list = p_z_lists[j][i];
+				list_end = p_z_last_lists[j][i];
+			} else {
+				list_end->next = p_z_lists[j][i];
+				list_end = p_z_last_lists[j][i];
+			}
+		}
+	}
+
+	return list;
+}
+
+RendererCanvasRender::Item *RendererCanvasCull::_cull_canvas_item_tree(Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask) {
 	RENDER_TIMESTAMP("Cull CanvasItem Tree");
 
 	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
@@ -54,31 +78,104 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, true, p_canvas_cull_mask, p_child_items[i].mirror, 1);
 	}
 
-	RendererCanvasRender::Item *list = nullptr;
-	RendererCanvasRender::Item *list_end = nullptr;
-
-	for (int i = 0; i < z_range; i++) {
-		if (!z_list[i]) {
-			continue;
-		}
-		if (!list) {
-			list = z_list[i];
-			list_end = z_last_list[i];
-		} else {
-			list_end->next = z_list[i];
-			list_end = z_last_list[i];
-		}
-	}
+	return _merge_z_lists(&z_list, &z_last_list, 1);
+}
 
+void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, RendererCanvasRender::Item *p_item_list, const Transform2D &p_transform, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, RenderingMethod::RenderInfo *r_render_info) {
 	RENDER_TIMESTAMP("Render CanvasItems");
 
 	bool sdf_flag;
-	RSG::canvas_render->canvas_render_items(p_to_render_target, list, p_modulate, p_lights, p_directional_lights, p_transform, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, sdf_flag, r_render_info);
+	RSG::canvas_render->canvas_render_items(p_to_render_target, p_item_list, p_modulate, p_lights, p_directional_lights, p_transform, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, sdf_flag, r_render_info);
 	if (sdf_flag) {
 		sdf_used = true;
 	}
 }
 
+void RendererCanvasCull::_cull_canvas_chunk(uint32_t p_index, CullChunk *p_chunks) {
+	CullChunk &chunk = p_chunks[p_index];
+
+	memset(chunk.z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	memset(chunk.z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+
+	Canvas::ChildItem *child_items = chunk.canvas->child_items.ptrw();
+	for (int i = chunk.from; i < chunk.to; i++) {
+		_cull_canvas_item(child_items[i].item, chunk.transform, chunk.clip_rect, Color(1, 1, 1, 1), 0, chunk.z_list, chunk.z_last_list, nullptr, nullptr, true, chunk.canvas_cull_mask, child_items[i].mirror, 1);
+	}
+}
+
+void RendererCanvasCull::cull_canvases(Canvas *const *p_canvases, const Transform2D *p_transforms, int p_canvas_count, const Rect2 &p_clip_rect, bool p_snap_2d_transforms_to_pixel, uint32_t p_canvas_cull_mask) {
+	RENDER_TIMESTAMP("> Cull Canvases");
+
+	snapping_2d_transforms_to_pixel = p_snap_2d_transforms_to_pixel;
+
+	// Each canvas is split into contiguous ranges of its top level items, so that both
+	// several canvas layers and a single canvas with many subtrees are spread over threads.
+	// Without threading every canvas is culled as a whole, the same as render_canvas() does.
+	uint32_t thread_count = threaded_cull ? MAX(1u, WorkerThreadPool::get_singleton()->get_thread_count()) : 1;
+	cull_chunks.clear();
+
+	for (int i = 0; i < p_canvas_count; i++) {
+		Canvas *canvas = p_canvases[i];
+		if (canvas->children_order_dirty) {
+			canvas->child_items.sort();
+			canvas->children_order_dirty = false;
+		}
+
+		int item_count = canvas->child_items.size();
+		int chunk_count = MIN((uint32_t)item_count, thread_count);
+		for (int j = 0; j < chunk_count; j++) {
+			CullChunk chunk;
+			chunk.canvas = canvas;
+			chunk.transform = p_transforms[i];
+			chunk.clip_rect = p_clip_rect;
+			chunk.canvas_cull_mask = p_canvas_cull_mask;
+			chunk.from = j * item_count / chunk_count;
+			chunk.to = (j + 1) * item_count / chunk_count;
+			cull_chunks.push_back(chunk);
+		}
+	}
+
+	while (cull_chunk_z_lists.size() < cull_chunks.size()) {
+		cull_chunk_z_lists.push_back((RendererCanvasRender::Item **)memalloc(z_range * 2 * sizeof(RendererCanvasRender::Item *)));
+	}
+	for (uint32_t i = 0; i < cull_chunks.size(); i++) {
+		cull_chunks[i].z_list = cull_chunk_z_lists[i];
+		cull_chunks[i].z_last_list = cull_chunk_z_lists[i] + z_range;
+	}
+
+	if (threaded_cull && cull_chunks.size() > 1) {
+		// Resources such as multimeshes may update their bounds lazily when queried, which is not safe from worker threads.
+		RSG::utilities->update_dirty_resources();
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_chunk, cull_chunks.ptr(), cull_chunks.size(), -1, true, SNAME("CullCanvasItems"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < cull_chunks.size(); i++) {
+			_cull_canvas_chunk(i, cull_chunks.ptr());
+		}
+	}
+
+	LocalVector<RendererCanvasRender::Item **> chunk_z_lists;
+	LocalVector<RendererCanvasRender::Item **> chunk_z_last_lists;
+	uint32_t chunk_index = 0;
+	for (int i = 0; i < p_canvas_count; i++) {
+		Canvas *canvas = p_canvases[i];
+
+		chunk_z_lists.clear();
+		chunk_z_last_lists.clear();
+		while (chunk_index < cull_chunks.size() && cull_chunks[chunk_index].canvas == canvas) {
+			chunk_z_lists.push_back(cull_chunks[chunk_index].z_list);
+			chunk_z_last_lists.push_back(cull_chunks[chunk_index].z_last_list);
+			chunk_index++;
+		}
+
+		canvas->cull_list = _merge_z_lists(chunk_z_lists.ptr(), chunk_z_last_lists.ptr(), chunk_z_lists.size());
+		canvas->cull_prepared = true;
+	}
+
+	RENDER_TIMESTAMP("< Cull Canvases");
+}
+
 void _collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, const Transform2D &p_transform, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int p_z) {
 	int child_item_count = p_canvas_item->child_items.size();
 	RendererCanvasCull::Item **child_items = p_canvas_item->child_items.ptrw();
@@ -123,6 +220,172 @@ void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner, RID_Owner<Renderer
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
+bool RendererCanvasCull::_spatial_index_can_index(const Item *p_child) const {
+	// Only leaf items whose visibility depends on nothing but their own bounds can be skipped by the index.
+	// Everything else either draws outside of its rect, has a rect that changes every frame,
+	// or must be visited to update state for its own children.
+	if (!p_child->child_items.is_empty() || p_child->canvas_group != nullptr || p_child->copy_back_buffer != nullptr || p_child->vp_render != nullptr) {
+		return false;
+	}
+	if (p_child->update_when_visible || p_child->repeat_source || p_child->skeleton.is_valid()) {
+		return false;
+	}
+	return !(_interpolation_data.interpolation_enabled && p_child->interpolated);
+}
+
+void RendererCanvasCull::_spatial_index_add_child(Item *p_item, Item *p_child) {
+	DEV_ASSERT(p_child->spatial_owner == nullptr);
+	p_child->spatial_owner = p_item->spatial_index;
+	p_child->mark_spatial_dirty();
+}
+
+void RendererCanvasCull::_spatial_index_remove_child(Item *p_child) {
+	Item::SpatialIndex *index = p_child->spatial_owner;
+	if (!index) {
+		return;
+	}
+
+	if (p_child->spatial_leaf.is_valid()) {
+		index->bvh.remove(p_child->spatial_leaf);
+		p_child->spatial_leaf = DynamicBVH::ID();
+	}
+	if (p_child->spatial_unindexed) {
+		index->unindexed.erase(p_child);
+		p_child->spatial_unindexed = false;
+	}
+	p_child->spatial_dirty_element.remove_from_list();
+	p_child->spatial_owner = nullptr;
+}
+
+void RendererCanvasCull::_spatial_index_create(Item *p_item) {
+	DEV_ASSERT(p_item->spatial_index == nullptr);
+	p_item->spatial_index = memnew(Item::SpatialIndex);
+	p_item->spatial_index->interpolation_enabled = _interpolation_data.interpolation_enabled;
+
+	for (int i = 0; i < p_item->child_items.size(); i++) {
+		_spatial_index_add_child(p_item, p_item->child_items[i]);
+	}
+}
+
+void RendererCanvasCull::_spatial_index_free(Item *p_item) {
+	if (!p_item->spatial_index) {
+		return;
+	}
+
+	for (int i = 0; i < p_item->child_items.size(); i++) {
+		_spatial_index_remove_child(p_item->child_items[i]);
+	}
+
+	memdelete(p_item->spatial_index);
+	p_item->spatial_index = nullptr;
+}
+
+void RendererCanvasCull::_spatial_index_update(Item *p_item) {
+	Item::SpatialIndex *index = p_item->spatial_index;
+
+	if (index->interpolation_enabled != _interpolation_data.interpolation_enabled) {
+		// Interpolated children can only be indexed while interpolation is off, so re-evaluate all of them.
+		index->interpolation_enabled = _interpolation_data.interpolation_enabled;
+		for (int i = 0; i < p_item->child_items.size(); i++) {
+			p_item->child_items[i]->mark_spatial_dirty();
+		}
+	}
+
+	while (index->dirty.first()) {
+		Item *child = index->dirty.first()->self();
+		index->dirty.remove(&child->spatial_dirty_element);
+
+		if (_spatial_index_can_index(child)) {
+			Rect2 rect = child->get_rect();
+			if (child->visibility_notifier && child->visibility_notifier->area.size != Vector2()) {
+				rect = rect.merge(child->visibility_notifier->area);
+			}
+			rect = child->xform_curr.xform(rect);
+			AABB aabb(Vector3(rect.position.x, rect.position.y, 0), Vector3(rect.size.x, rect.size.y, 0));
+
+			if (child->spatial_leaf.is_valid()) {
+				index->bvh.update(child->spatial_leaf, aabb);
+			} else {
+				child->spatial_leaf = index->bvh.insert(aabb, child);
+			}
+			if (child->spatial_unindexed) {
+				index->unindexed.erase(child);
+				child->spatial_unindexed = false;
+			}
+		} else {
+			if (child->spatial_leaf.is_valid()) {
+				index->bvh.remove(child->spatial_leaf);
+				child->spatial_leaf = DynamicBVH::ID();
+			}
+			if (!child->spatial_unindexed) {
+				index->unindexed.push_back(child);
+				child->spatial_unindexed = true;
+			}
+		}
+	}
+}
+
+void RendererCanvasCull::_report_texture_usage(const Item *p_item, const Transform2D &p_transform) {
+	RendererTextureStorage *texture_storage = RSG::texture_storage;
+	const Size2 xform_scale = p_transform.get_scale().abs();
+	const float item_scale = MAX(xform_scale.x, xform_scale.y);
+
+	for (const Item::Command *c = p_item->commands; c; c = c->next) {
+		RID texture;
+		float scale = item_scale;
+
+		switch (c->type) {
+			case Item::Command::TYPE_RECT: {
+				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+				texture = rect->texture;
+				if (texture.is_null() || !texture_storage->texture_has_usage_callback(texture)) {
+					break;
+				}
+				if (rect->flags & RendererCanvasRender::CANVAS_RECT_TILE) {
+					break; // Tiled textures are drawn at their own size.
+				}
+				Size2 source_size = (rect->flags & RendererCanvasRender::CANVAS_RECT_REGION) ? rect->source.size : texture_storage->texture_size_with_proxy(texture);
+				if (source_size.x != 0 && source_size.y != 0) {
+					scale *= MAX(ABS(rect->rect.size.x / source_size.x), ABS(rect->rect.size.y / source_size.y));
+				}
+			} break;
+			case Item::Command::TYPE_NINEPATCH: {
+				texture = static_cast<const Item::CommandNinePatch *>(c)->texture;
+			} break;
+			case Item::Command::TYPE_POLYGON: {
+				texture = static_cast<const Item::CommandPolygon *>(c)->texture;
+			} break;
+			case Item::Command::TYPE_PRIMITIVE: {
+				texture = static_cast<const Item::CommandPrimitive *>(c)->texture;
+			} break;
+			case Item::Command::TYPE_MESH: {
+				texture = static_cast<const Item::CommandMesh *>(c)->texture;
+			} break;
+			case Item::Command::TYPE_MULTIMESH: {
+				texture = static_cast<const Item::CommandMultiMesh *>(c)->texture;
+			} break;
+			case Item::Command::TYPE_PARTICLES: {
+				texture = static_cast<const Item::CommandParticles *>(c)->texture;
+			} break;
+			default: {
+			} break;
+		}
+
+		if (texture.is_valid()) {
+			texture_storage->texture_report_usage(texture, scale);
+		}
+	}
+
+	if (p_item->material.is_valid()) {
+		// The size a shader samples its textures at is unknown.
+		LocalVector<RID> textures;
+		RSG::material_storage->material_get_textures(p_item->material, &textures);
+		for (const RID &texture : textures) {
+			texture_storage->texture_report_usage(texture, 1.0);
+		}
+	}
+}
+
 void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &p_modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from) {
 	if (ci->copy_back_buffer) {
 		ci->copy_back_buffer->screen_rect = p_transform.xform(ci->copy_back_buffer->rect).intersection(p_clip_rect);
@@ -195,6 +458,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		//something to draw?
 
 		if (ci->update_when_visible) {
+			MutexLock lock(cull_mutex);
 			RenderingServerDefault::redraw_request();
 		}
 
@@ -219,10 +483,15 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 			ci->z_final = p_z;
 
 			ci->next = nullptr;
+
+			if (ci->commands != nullptr && RSG::texture_storage->has_texture_usage_callbacks()) {
+				_report_texture_usage(ci, p_transform);
+			}
 		}
 
 		if (ci->visibility_notifier) {
 			if (!ci->visibility_notifier->visible_element.in_list()) {
+				MutexLock lock(cull_mutex);
 				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
 				ci->visibility_notifier->just_visible = true;
 			}
@@ -377,6 +646,36 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			canvas_group_from = r_z_last_list[zidx];
 		}
 
+		if (use_spatial_index && ci->spatial_index == nullptr && child_item_count >= SPATIAL_INDEX_MIN_CHILDREN) {
+			_spatial_index_create(ci);
+		}
+
+		if (ci->spatial_index && repeat_size == Point2() && final_xform.determinant() != 0) {
+			// Only visit the children whose bounds overlap the clip rect, plus the ones the index can't reason about.
+			// Bounds are kept in this item's local space, so the clip rect is brought into it instead.
+			_spatial_index_update(ci);
+
+			Item::SpatialIndex *index = ci->spatial_index;
+			index->cull_result = index->unindexed;
+
+			// Grow by a pixel to account for children snapping their origin.
+			Rect2 local_clip = final_xform.affine_inverse().xform(Rect2(Point2(), p_clip_rect.size)).grow(1.0);
+			struct CullResult {
+				LocalVector<Item *> *result = nullptr;
+				_FORCE_INLINE_ bool operator()(void *p_data) {
+					result->push_back(static_cast<Item *>(p_data));
+					return false;
+				}
+			};
+			CullResult cull_result;
+			cull_result.result = &index->cull_result;
+			index->bvh.aabb_query(AABB(Vector3(local_clip.position.x, local_clip.position.y, 0), Vector3(local_clip.size.x, local_clip.size.y, 0)), cull_result);
+
+			index->cull_result.sort_custom<ItemIndexSort>();
+			child_item_count = index->cull_result.size();
+			child_items = index->cull_result.ptr();
+		}
+
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
@@ -399,15 +698,26 @@ void RendererCanvasCull::render_canvas(RID p_render_target, Canvas *p_canvas, co
 	sdf_used = false;
 	snapping_2d_transforms_to_pixel = p_snap_2d_transforms_to_pixel;
 
-	if (p_canvas->children_order_dirty) {
-		p_canvas->child_items.sort();
-		p_canvas->children_order_dirty = false;
-	}
+	RendererCanvasRender::Item *list = nullptr;
+
+	if (p_canvas->cull_prepared) {
+		// Already culled along with the other canvases of the viewport, see cull_canvases().
+		list = p_canvas->cull_list;
+		p_canvas->cull_list = nullptr;
+		p_canvas->cull_prepared = false;
+	} else {
+		if (p_canvas->children_order_dirty) {
+			p_canvas->child_items.sort();
+			p_canvas->children_order_dirty = false;
+		}
 
-	int l = p_canvas->child_items.size();
-	Canvas::ChildItem *ci = p_canvas->child_items.ptrw();
+		int l = p_canvas->child_items.size();
+		Canvas::ChildItem *ci = p_canvas->child_items.ptrw();
+
+		list = _cull_canvas_item_tree(ci, l, p_transform, p_clip_rect, canvas_cull_mask);
+	}
 
-	_render_canvas_item_tree(p_render_target, ci, l, p_transform, p_clip_rect, p_canvas->modulate, p_lights, p_directional_lights, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, canvas_cull_mask, r_render_info);
+	_render_canvas_item_tree(p_render_target, list, p_transform, p_canvas->modulate, p_lights, p_directional_lights, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, r_render_info);
 
 	RENDER_TIMESTAMP("< Render Canvas");
 }
@@ -441,6 +751,7 @@ void RendererCanvasCull::canvas_set_item_repeat(RID p_item, const Point2 &p_repe
 	canvas_item->repeat_source = true;
 	canvas_item->repeat_size = p_repeat_size;
 	canvas_item->repeat_times = p_repeat_times;
+	canvas_item->mark_spatial_dirty();
 }
 
 void RendererCanvasCull::canvas_set_modulate(RID p_canvas, const Color &p_color) {
@@ -479,6 +790,8 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 		} else if (canvas_item_owner.owns(canvas_item->parent)) {
 			Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
+			_spatial_index_remove_child(canvas_item);
+			item_owner->mark_spatial_dirty();
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -499,6 +812,10 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			Item *item_owner = canvas_item_owner.get_or_null(p_parent);
 			item_owner->child_items.push_back(canvas_item);
 			item_owner->children_order_dirty = true;
+			if (item_owner->spatial_index) {
+				_spatial_index_add_child(item_owner, canvas_item);
+			}
+			item_owner->mark_spatial_dirty();
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -542,6 +859,7 @@ void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D
 	}
 
 	canvas_item->xform_curr = p_transform;
+	canvas_item->mark_spatial_dirty();
 }
 
 void RendererCanvasCull::canvas_item_set_visibility_layer(RID p_item, uint32_t p_visibility_layer) {
@@ -578,6 +896,7 @@ void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
+	canvas_item->mark_spatial_dirty();
 }
 
 void RendererCanvasCull::canvas_item_set_modulate(RID p_item, const Color &p_color) {
@@ -606,6 +925,7 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->update_when_visible = p_update;
+	canvas_item->mark_spatial_dirty();
 }
 
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
@@ -1740,6 +2060,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 		return;
 	}
 	canvas_item->skeleton = p_skeleton;
+	canvas_item->mark_spatial_dirty();
 
 	Item::Command *c = canvas_item->commands;
 
@@ -1777,6 +2098,7 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 		canvas_item->copy_back_buffer->rect = p_rect;
 		canvas_item->copy_back_buffer->full = p_rect == Rect2();
 	}
+	canvas_item->mark_spatial_dirty();
 }
 
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
@@ -1784,6 +2106,7 @@ void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->clear();
+	canvas_item->mark_spatial_dirty();
 #ifdef DEBUG_ENABLED
 	if (debug_redraw) {
 		canvas_item->debug_redraw_time = debug_redraw_time;
@@ -1842,6 +2165,7 @@ void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_
 			canvas_item->visibility_notifier = nullptr;
 		}
 	}
+	canvas_item->mark_spatial_dirty();
 }
 
 void RendererCanvasCull::canvas_item_set_debug_redraw(bool p_enabled) {
@@ -1857,6 +2181,7 @@ void RendererCanvasCull::canvas_item_set_interpolated(RID p_item, bool p_interpo
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 	canvas_item->interpolated = p_interpolated;
+	canvas_item->mark_spatial_dirty();
 }
 
 void RendererCanvasCull::canvas_item_reset_physics_interpolation(RID p_item) {
@@ -1871,6 +2196,7 @@ void RendererCanvasCull::canvas_item_transform_physics_interpolation(RID p_item,
 	ERR_FAIL_NULL(canvas_item);
 	canvas_item->xform_prev = p_transform * canvas_item->xform_prev;
 	canvas_item->xform_curr = p_transform * canvas_item->xform_curr;
+	canvas_item->mark_spatial_dirty();
 }
 
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
@@ -1892,6 +2218,7 @@ void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::Canva
 		canvas_item->canvas_group->blur_mipmaps = p_blur_mipmaps;
 		canvas_item->canvas_group->clear_margin = p_clear_margin;
 	}
+	canvas_item->mark_spatial_dirty();
 }
 
 RID RendererCanvasCull::canvas_light_allocate() {
@@ -2393,6 +2720,8 @@ bool RendererCanvasCull::free(RID p_rid) {
 			} else if (canvas_item_owner.owns(canvas_item->parent)) {
 				Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
+				_spatial_index_remove_child(canvas_item);
+				item_owner->mark_spatial_dirty();
 
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -2400,6 +2729,8 @@ bool RendererCanvasCull::free(RID p_rid) {
 			}
 		}
 
+		_spatial_index_free(canvas_item);
+
 		for (int i = 0; i < canvas_item->child_items.size(); i++) {
 			canvas_item->child_items[i]->parent = RID();
 		}
@@ -2581,9 +2912,15 @@ RendererCanvasCull::RendererCanvasCull() {
 
 	debug_redraw_time = GLOBAL_DEF("debug/canvas_items/debug_redraw_time", 1.0);
 	debug_redraw_color = GLOBAL_DEF("debug/canvas_items/debug_redraw_color", Color(1.0, 0.2, 0.2, 0.5));
+
+	use_spatial_index = GLOBAL_DEF("rendering/2d/culling/use_spatial_index", false);
+	threaded_cull = GLOBAL_DEF("rendering/2d/culling/use_threads", false);
 }
 
 RendererCanvasCull::~RendererCanvasCull() {
 	memfree(z_list);
 	memfree(z_last_list);
+	for (RendererCanvasRender::Item **chunk_z_list : cull_chunk_z_lists) {
+		memfree(chunk_z_list);
+	}
 }
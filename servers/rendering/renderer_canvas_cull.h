@@ -31,7 +31,11 @@
 #ifndef RENDERER_CANVAS_CULL_H
 #define RENDERER_CANVAS_CULL_H
 
+#include "core/math/dynamic_bvh.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/self_list.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
 
@@ -72,7 +76,38 @@ public:
 
 		VisibilityNotifierData *visibility_notifier = nullptr;
 
-		Item() {
+		// Spatial index over the children of this item, in this item's local space.
+		// Lets large flat hierarchies (e.g. tilemaps) be culled without visiting every child.
+		struct SpatialIndex {
+			DynamicBVH bvh;
+			LocalVector<Item *> unindexed; // Children that can't be culled by bounds, always visited.
+			SelfList<Item>::List dirty; // Children whose bounds or eligibility changed.
+			LocalVector<Item *> cull_result;
+			bool interpolation_enabled = false;
+		};
+
+		SpatialIndex *spatial_index = nullptr;
+
+		// State of this item inside its parent's spatial index.
+		SpatialIndex *spatial_owner = nullptr;
+		DynamicBVH::ID spatial_leaf;
+		bool spatial_unindexed = false;
+		SelfList<Item> spatial_dirty_element;
+
+		_FORCE_INLINE_ void mark_spatial_dirty() {
+			if (spatial_owner && !spatial_dirty_element.in_list()) {
+				spatial_owner->dirty.add(&spatial_dirty_element);
+			}
+		}
+
+		template <typename T>
+		T *alloc_command() {
+			mark_spatial_dirty();
+			return RendererCanvasRender::Item::alloc_command<T>();
+		}
+
+		Item() :
+				spatial_dirty_element(this) {
 			children_order_dirty = true;
 			E = nullptr;
 			z_index = 0;
@@ -144,6 +179,10 @@ public:
 		RID parent;
 		float parent_scale;
 
+		// Set by cull_canvases() and consumed by the next render_canvas() call.
+		RendererCanvasRender::Item *cull_list = nullptr;
+		bool cull_prepared = false;
+
 		int find_item(Item *p_item) {
 			for (int i = 0; i < child_items.size(); i++) {
 				if (child_items[i].item == p_item) {
@@ -184,10 +223,23 @@ public:
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
 
+	// Children count from which an item builds a spatial index over them.
+	static constexpr int SPATIAL_INDEX_MIN_CHILDREN = 64;
+	bool use_spatial_index = false;
+
+	bool _spatial_index_can_index(const Item *p_child) const;
+	void _spatial_index_add_child(Item *p_item, Item *p_child);
+	void _spatial_index_remove_child(Item *p_child);
+	void _spatial_index_create(Item *p_item);
+	void _spatial_index_free(Item *p_item);
+	void _spatial_index_update(Item *p_item);
+
+	void _report_texture_usage(const Item *p_item, const Transform2D &p_transform);
 	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
 
 private:
-	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
+	RendererCanvasRender::Item *_cull_canvas_item_tree(Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask);
+	void _render_canvas_item_tree(RID p_to_render_target, RendererCanvasRender::Item *p_item_list, const Transform2D &p_transform, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, RenderingMethod::RenderInfo *r_render_info = nullptr);
 	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool p_allow_y_sort, uint32_t p_canvas_cull_mask, const Point2 &p_repeat_size, int p_repeat_times);
 
 	static constexpr int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
@@ -195,7 +247,32 @@ private:
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	static RendererCanvasRender::Item *_merge_z_lists(RendererCanvasRender::Item **const *p_z_lists, RendererCanvasRender::Item **const *p_z_last_lists, int p_count);
+
+	// A contiguous range of a canvas' top level items, culled by one worker thread into its own z lists.
+	struct CullChunk {
+		Canvas *canvas = nullptr;
+		Transform2D transform;
+		Rect2 clip_rect;
+		uint32_t canvas_cull_mask = 0;
+		int from = 0;
+		int to = 0;
+		RendererCanvasRender::Item **z_list = nullptr;
+		RendererCanvasRender::Item **z_last_list = nullptr;
+	};
+
+	bool threaded_cull = false;
+	LocalVector<CullChunk> cull_chunks;
+	LocalVector<RendererCanvasRender::Item **> cull_chunk_z_lists; // Two z_range sized lists per chunk.
+	BinaryMutex cull_mutex; // Guards the few shared structures touched while culling from worker threads.
+
+	void _cull_canvas_chunk(uint32_t p_index, CullChunk *p_chunks);
+
 public:
+	bool is_threaded_cull_enabled() const { return threaded_cull; }
+	void set_threaded_cull_enabled(bool p_enabled) { threaded_cull = p_enabled; }
+	void cull_canvases(Canvas *const *p_canvases, const Transform2D *p_transforms, int p_canvas_count, const Rect2 &p_clip_rect, bool p_snap_2d_transforms_to_pixel, uint32_t p_canvas_cull_mask);
+
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
 
 	bool was_sdf_used();
@@ -131,6 +131,63 @@ const Rect2 &RendererCanvasRender::Item::get_rect() const {
 	return rect;
 }
 
+bool RendererCanvasRender::Item::InstanceCache::build_key(const Item *p_item, const Point2 &p_offset, const void *p_state, uint32_t p_state_size, TextureStateFunc p_texture_state_func, void *p_userdata, LocalVector<uint8_t> &r_key) {
+	// Repeated items are drawn several times per frame with different offsets.
+	if (p_offset != Point2()) {
+		return false;
+	}
+
+	r_key.resize(p_state_size);
+	memcpy(r_key.ptr(), p_state, p_state_size);
+
+	// Only rects and nine-patches are cached. Their instance data depends on nothing but the command,
+	// the renderer state and the texture, whereas other commands depend on the current batch,
+	// on time or on resources that can change without the item changing.
+	RID last_texture;
+	bool first = true;
+	for (const Command *c = p_item->commands; c; c = c->next) {
+		RID texture;
+		switch (c->type) {
+			case Command::TYPE_RECT: {
+				texture = static_cast<const CommandRect *>(c)->texture;
+			} break;
+			case Command::TYPE_NINEPATCH: {
+				texture = static_cast<const CommandNinePatch *>(c)->texture;
+			} break;
+			case Command::TYPE_TRANSFORM: {
+				continue;
+			} break;
+			default: {
+				return false;
+			}
+		}
+
+		if (!first && texture == last_texture) {
+			continue;
+		}
+		first = false;
+		last_texture = texture;
+
+		TextureState texture_state;
+		p_texture_state_func(p_userdata, texture, texture_state);
+		texture_state.texture = texture;
+
+		uint32_t offset = r_key.size();
+		r_key.resize(offset + sizeof(TextureState));
+		memcpy(r_key.ptr() + offset, &texture_state, sizeof(TextureState));
+	}
+
+	return true;
+}
+
+RendererCanvasRender::Item::InstanceCache::TextureState RendererCanvasRender::Item::InstanceCache::get_texture_state(uint32_t p_state_size, uint32_t p_index) const {
+	TextureState texture_state;
+	uint32_t offset = p_state_size + p_index * sizeof(TextureState);
+	ERR_FAIL_COND_V(offset + sizeof(TextureState) > key.size(), texture_state);
+	memcpy(&texture_state, key.ptr() + offset, sizeof(TextureState));
+	return texture_state;
+}
+
 RendererCanvasRender::Item::CommandMesh::~CommandMesh() {
 	if (mesh_instance.is_valid()) {
 		RSG::mesh_storage->mesh_instance_free(mesh_instance);
@@ -367,6 +367,56 @@ public:
 
 		Rect2 global_rect_cache;
 
+		// Instance data a renderer generated from the commands of this item, kept so an unchanged
+		// item can be drawn again on later frames without regenerating it. It is only valid for the
+		// item version and the renderer state (key) it was built from.
+		struct InstanceCache {
+			// Renderer state of a texture used by the commands. Textures can be resized or get a normal map
+			// without the item changing, so their state is part of the key.
+			struct TextureState {
+				RID texture;
+				float texpixel_size[2] = {};
+				uint32_t flags = 0; // Renderer specific.
+				uint32_t specular_shininess = 0;
+			};
+
+			typedef void (*TextureStateFunc)(void *p_userdata, RID p_texture, TextureState &r_state);
+
+			uint64_t version = 0;
+			LocalVector<uint8_t> key;
+			LocalVector<uint8_t> records;
+
+			// Builds the key of an item drawn with the given renderer state: the state itself, followed by
+			// the state of every texture change in the command list. Returns false if the item can't be cached.
+			static bool build_key(const Item *p_item, const Point2 &p_offset, const void *p_state, uint32_t p_state_size, TextureStateFunc p_texture_state_func, void *p_userdata, LocalVector<uint8_t> &r_key);
+			// Returns the state of the given texture change, as stored by build_key().
+			TextureState get_texture_state(uint32_t p_state_size, uint32_t p_index) const;
+
+			bool matches(uint64_t p_version, const LocalVector<uint8_t> &p_key) const {
+				return version == p_version && key.size() == p_key.size() && memcmp(key.ptr(), p_key.ptr(), key.size()) == 0;
+			}
+
+			template <typename T>
+			void store(uint64_t p_version, const LocalVector<uint8_t> &p_key, const T *p_records, uint32_t p_count) {
+				version = p_version;
+				key = p_key;
+				records.resize(p_count * sizeof(T));
+				memcpy(records.ptr(), p_records, p_count * sizeof(T));
+			}
+
+			template <typename T>
+			uint32_t get_record_count() const { return records.size() / sizeof(T); }
+
+			template <typename T>
+			const T *get_records() const { return reinterpret_cast<const T *>(records.ptr()); }
+
+			template <typename T>
+			T *get_records_w() { return reinterpret_cast<T *>(records.ptr()); }
+		};
+
+		mutable InstanceCache *instance_cache = nullptr;
+		uint64_t version = 1; // Increased every time the commands change.
+
 		const Rect2 &get_rect() const;
 
 		Command *commands = nullptr;
@@ -421,6 +471,7 @@ public:
 			}
 
 			rect_dirty = true;
+			version++;
 			return command;
 		}
 
@@ -451,6 +502,7 @@ public:
 			current_block = 0;
 			clip = false;
 			rect_dirty = true;
+			version++;
 			final_clip_owner = nullptr;
 			material_owner = nullptr;
 			light_masked = false;
@@ -494,6 +546,9 @@ public:
 			if (copy_back_buffer) {
 				memdelete(copy_back_buffer);
 			}
+			if (instance_cache) {
+				memdelete(instance_cache);
+			}
 		}
 	};
 
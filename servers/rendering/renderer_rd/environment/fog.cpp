@@ -368,6 +368,14 @@ RS::ShaderNativeSourceCode Fog::FogShaderData::get_native_source_code() const {
 	return fog_singleton->volumetric_fog.shader.version_get_native_source_code(version);
 }
 
+#ifdef TOOLS_ENABLED
+Vector<String> Fog::FogShaderData::get_cache_files() const {
+	Fog *fog_singleton = Fog::get_singleton();
+
+	return fog_singleton->volumetric_fog.shader.version_get_cache_files(version);
+}
+#endif
+
 Fog::FogShaderData::~FogShaderData() {
 	Fog *fog_singleton = Fog::get_singleton();
 	ERR_FAIL_NULL(fog_singleton);
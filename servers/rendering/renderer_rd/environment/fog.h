@@ -203,6 +203,9 @@ private:
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const;
+#ifdef TOOLS_ENABLED
+		virtual Vector<String> get_cache_files() const;
+#endif
 
 		FogShaderData() {}
 		virtual ~FogShaderData();
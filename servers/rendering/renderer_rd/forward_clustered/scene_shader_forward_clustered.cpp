@@ -427,6 +427,14 @@ RS::ShaderNativeSourceCode SceneShaderForwardClustered::ShaderData::get_native_s
 	return shader_singleton->shader.version_get_native_source_code(version);
 }
 
+#ifdef TOOLS_ENABLED
+Vector<String> SceneShaderForwardClustered::ShaderData::get_cache_files() const {
+	SceneShaderForwardClustered *shader_singleton = (SceneShaderForwardClustered *)SceneShaderForwardClustered::singleton;
+
+	return shader_singleton->shader.version_get_cache_files(version);
+}
+#endif
+
 SceneShaderForwardClustered::ShaderData::ShaderData() :
 		shader_list_element(this) {
 }
@@ -379,6 +379,14 @@ RS::ShaderNativeSourceCode SceneShaderForwardMobile::ShaderData::get_native_sour
 	return shader_singleton->shader.version_get_native_source_code(version);
 }
 
+#ifdef TOOLS_ENABLED
+Vector<String> SceneShaderForwardMobile::ShaderData::get_cache_files() const {
+	SceneShaderForwardMobile *shader_singleton = (SceneShaderForwardMobile *)SceneShaderForwardMobile::singleton;
+
+	return shader_singleton->shader.version_get_cache_files(version);
+}
+#endif
+
 SceneShaderForwardMobile::ShaderData::ShaderData() :
 		shader_list_element(this) {
 }
@@ -144,6 +144,9 @@ public:
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const;
+#ifdef TOOLS_ENABLED
+		virtual Vector<String> get_cache_files() const;
+#endif
 
 		SelfList<ShaderData> shader_list_element;
 
@@ -2389,6 +2389,13 @@ RS::ShaderNativeSourceCode RendererCanvasRenderRD::CanvasShaderData::get_native_
 	return canvas_singleton->shader.canvas_shader.version_get_native_source_code(version);
 }
 
+#ifdef TOOLS_ENABLED
+Vector<String> RendererCanvasRenderRD::CanvasShaderData::get_cache_files() const {
+	RendererCanvasRenderRD *canvas_singleton = static_cast<RendererCanvasRenderRD *>(RendererCanvasRender::singleton);
+	return canvas_singleton->shader.canvas_shader.version_get_cache_files(version);
+}
+#endif
+
 RendererCanvasRenderRD::CanvasShaderData::~CanvasShaderData() {
 	RendererCanvasRenderRD *canvas_singleton = static_cast<RendererCanvasRenderRD *>(RendererCanvasRender::singleton);
 	ERR_FAIL_NULL(canvas_singleton);
@@ -183,6 +183,9 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const;
+#ifdef TOOLS_ENABLED
+		virtual Vector<String> get_cache_files() const;
+#endif
 
 		CanvasShaderData() {}
 		virtual ~CanvasShaderData();
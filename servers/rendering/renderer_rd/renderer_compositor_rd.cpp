@@ -294,6 +294,11 @@ RendererCompositorRD::RendererCompositorRD() {
 					ShaderRD::set_shader_cache_save_compressed(compress);
 					ShaderRD::set_shader_cache_save_compressed_zstd(use_zstd);
 					ShaderRD::set_shader_cache_save_debug(!strip_debug);
+
+					if (!Engine::get_singleton()->is_editor_hint()) {
+						// Precompiled variants exported with the project, see ShaderCacheExportPlugin.
+						ShaderRD::set_shader_cache_packed_dir(ProjectSettings::get_singleton()->get_project_data_path().path_join("shader_cache"));
+					}
 				}
 			}
 		}
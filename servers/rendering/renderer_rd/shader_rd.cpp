@@ -362,6 +362,23 @@ RS::ShaderNativeSourceCode ShaderRD::version_get_native_source_code(RID p_versio
 	return source_code;
 }
 
+#ifdef TOOLS_ENABLED
+Vector<String> ShaderRD::version_get_cache_files(RID p_version) {
+	Vector<String> files;
+	Version *version = version_owner.get_or_null(p_version);
+	if (!version || !shader_cache_dir_valid) {
+		return files; // Materials whose shader has no code yet have no version.
+	}
+
+	for (int i = 0; i < group_enabled.size(); i++) {
+		if (group_enabled[i]) {
+			files.push_back(_get_cache_file_name(version, i));
+		}
+	}
+	return files;
+}
+#endif
+
 String ShaderRD::_version_get_sha1(Version *p_version) const {
 	StringBuilder hash_build;
 
@@ -395,16 +412,19 @@ String ShaderRD::_version_get_sha1(Version *p_version) const {
 static const char *shader_file_header = "GDSC";
 static const uint32_t cache_file_version = 3;
 
-String ShaderRD::_get_cache_file_path(Version *p_version, int p_group) {
+String ShaderRD::_get_cache_file_name(Version *p_version, int p_group) {
 	const String &sha1 = _version_get_sha1(p_version);
 	const String &api_safe_name = String(RD::get_singleton()->get_device_api_name()).validate_filename().to_lower();
-	const String &path = shader_cache_dir.path_join(name).path_join(group_sha256[p_group]).path_join(sha1) + "." + api_safe_name + ".cache";
-	return path;
+	const String &file_name = name.path_join(group_sha256[p_group]).path_join(sha1) + "." + api_safe_name + ".cache";
+	return file_name;
 }
 
 bool ShaderRD::_load_from_cache(Version *p_version, int p_group) {
-	const String &path = _get_cache_file_path(p_version, p_group);
-	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	const String &file_name = _get_cache_file_name(p_version, p_group);
+	Ref<FileAccess> f = FileAccess::open(shader_cache_dir.path_join(file_name), FileAccess::READ);
+	if (f.is_null() && !shader_cache_packed_dir.is_empty()) {
+		f = FileAccess::open(shader_cache_packed_dir.path_join(file_name), FileAccess::READ);
+	}
 	if (f.is_null()) {
 		return false;
 	}
@@ -469,8 +489,8 @@ bool ShaderRD::_load_from_cache(Version *p_version, int p_group) {
 
 void ShaderRD::_save_to_cache(Version *p_version, int p_group) {
 	ERR_FAIL_COND(!shader_cache_dir_valid);
-	const String &path = _get_cache_file_path(p_version, p_group);
-	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	const String &file_name = _get_cache_file_name(p_version, p_group);
+	Ref<FileAccess> f = FileAccess::open(shader_cache_dir.path_join(file_name), FileAccess::WRITE);
 	ERR_FAIL_COND(f.is_null());
 	f->store_buffer((const uint8_t *)shader_file_header, 4);
 	f->store_32(cache_file_version); // File version.
@@ -821,6 +841,14 @@ void ShaderRD::set_shader_cache_dir(const String &p_dir) {
 	shader_cache_dir = p_dir;
 }
 
+String ShaderRD::get_shader_cache_dir() {
+	return shader_cache_dir;
+}
+
+void ShaderRD::set_shader_cache_packed_dir(const String &p_dir) {
+	shader_cache_packed_dir = p_dir;
+}
+
 void ShaderRD::set_shader_cache_save_compressed(bool p_enable) {
 	shader_cache_save_compressed = p_enable;
 }
@@ -834,6 +862,7 @@ void ShaderRD::set_shader_cache_save_debug(bool p_enable) {
 }
 
 String ShaderRD::shader_cache_dir;
+String ShaderRD::shader_cache_packed_dir;
 bool ShaderRD::shader_cache_save_compressed = true;
 bool ShaderRD::shader_cache_save_compressed_zstd = true;
 bool ShaderRD::shader_cache_save_debug = true;
@@ -123,6 +123,7 @@ private:
 	LocalVector<String> group_sha256;
 
 	static String shader_cache_dir;
+	static String shader_cache_packed_dir;
 	static bool shader_cache_cleanup_on_start;
 	static bool shader_cache_save_compressed;
 	static bool shader_cache_save_compressed_zstd;
@@ -143,7 +144,7 @@ private:
 	void _add_stage(const char *p_code, StageType p_stage_type);
 
 	String _version_get_sha1(Version *p_version) const;
-	String _get_cache_file_path(Version *p_version, int p_group);
+	String _get_cache_file_name(Version *p_version, int p_group);
 	bool _load_from_cache(Version *p_version, int p_group);
 	void _save_to_cache(Version *p_version, int p_group);
 	void _initialize_cache();
@@ -196,11 +197,19 @@ public:
 	bool is_group_enabled(int p_group) const;
 
 	static void set_shader_cache_dir(const String &p_dir);
+	static String get_shader_cache_dir();
+	// Read-only cache shipped with the project, used when the user cache misses.
+	static void set_shader_cache_packed_dir(const String &p_dir);
 	static void set_shader_cache_save_compressed(bool p_enable);
 	static void set_shader_cache_save_compressed_zstd(bool p_enable);
 	static void set_shader_cache_save_debug(bool p_enable);
 
 	RS::ShaderNativeSourceCode version_get_native_source_code(RID p_version);
+#ifdef TOOLS_ENABLED
+	// Cache files of the enabled groups of the version, relative to the cache directory.
+	// They only exist once the version was compiled or loaded from the cache.
+	Vector<String> version_get_cache_files(RID p_version);
+#endif
 
 	void initialize(const Vector<String> &p_variant_defines, const String &p_general_defines = "");
 	void initialize(const Vector<VariantDefine> &p_variant_defines, const String &p_general_defines = "");
@@ -2008,6 +2008,17 @@ RS::ShaderNativeSourceCode MaterialStorage::shader_get_native_source_code(RID p_
 	return RS::ShaderNativeSourceCode();
 }
 
+#ifdef TOOLS_ENABLED
+Vector<String> MaterialStorage::shader_get_cache_files(RID p_shader) const {
+	Shader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL_V(shader, Vector<String>());
+	if (shader->data) {
+		return shader->data->get_cache_files();
+	}
+	return Vector<String>();
+}
+#endif
+
 /* MATERIAL API */
 
 void MaterialStorage::_material_uniform_set_erased(void *p_material) {
@@ -2227,6 +2238,27 @@ void MaterialStorage::material_get_instance_shader_parameters(RID p_material, Li
 	}
 }
 
+void MaterialStorage::material_get_textures(RID p_material, LocalVector<RID> *r_textures) {
+	Material *material = material_owner.get_or_null(p_material);
+	ERR_FAIL_NULL(material);
+	for (const KeyValue<StringName, Variant> &E : material->params) {
+		if (E.value.get_type() == Variant::RID) {
+			r_textures->push_back(E.value);
+		} else if (E.value.get_type() == Variant::ARRAY) {
+			const Array &array = E.value;
+			for (int i = 0; i < array.size(); i++) {
+				if (array[i].get_type() == Variant::RID) {
+					r_textures->push_back(array[i]);
+				}
+			}
+		}
+	}
+
+	if (material->next_pass.is_valid()) {
+		material_get_textures(material->next_pass, r_textures);
+	}
+}
+
 void MaterialStorage::material_update_dependency(RID p_material, DependencyTracker *p_instance) {
 	Material *material = material_owner.get_or_null(p_material);
 	ERR_FAIL_NULL(material);
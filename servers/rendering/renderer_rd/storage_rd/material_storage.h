@@ -71,6 +71,9 @@ public:
 		virtual bool is_animated() const = 0;
 		virtual bool casts_shadows() const = 0;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const { return RS::ShaderNativeSourceCode(); }
+#ifdef TOOLS_ENABLED
+		virtual Vector<String> get_cache_files() const { return Vector<String>(); }
+#endif
 
 		virtual ~ShaderData() {}
 	};
@@ -406,6 +409,10 @@ public:
 	void shader_set_data_request_function(ShaderType p_shader_type, ShaderDataRequestFunction p_function);
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override;
+#ifdef TOOLS_ENABLED
+	// ShaderRD cache files of the shader, relative to the shader cache directory.
+	Vector<String> shader_get_cache_files(RID p_shader) const;
+#endif
 
 	/* MATERIAL API */
 
@@ -431,6 +438,7 @@ public:
 	virtual bool material_casts_shadows(RID p_material) override;
 
 	virtual void material_get_instance_shader_parameters(RID p_material, List<InstanceShaderParam> *r_parameters) override;
+	virtual void material_get_textures(RID p_material, LocalVector<RID> *r_textures) override;
 
 	virtual void material_update_dependency(RID p_material, DependencyTracker *p_instance) override;
 
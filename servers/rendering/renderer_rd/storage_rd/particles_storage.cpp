@@ -1721,6 +1721,12 @@ RS::ShaderNativeSourceCode ParticlesStorage::ParticlesShaderData::get_native_sou
 	return ParticlesStorage::get_singleton()->particles_shader.shader.version_get_native_source_code(version);
 }
 
+#ifdef TOOLS_ENABLED
+Vector<String> ParticlesStorage::ParticlesShaderData::get_cache_files() const {
+	return ParticlesStorage::get_singleton()->particles_shader.shader.version_get_cache_files(version);
+}
+#endif
+
 ParticlesStorage::ParticlesShaderData::~ParticlesShaderData() {
 	//pipeline variants will clear themselves if shader is gone
 	if (version.is_valid()) {
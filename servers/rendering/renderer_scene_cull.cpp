@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
 
@@ -874,6 +875,7 @@ void RendererSceneCull::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 	instance->layer_mask = p_mask;
 	if (instance->scenario && instance->array_index >= 0) {
 		instance->scenario->instance_data[instance->array_index].layer_mask = p_mask;
+		instance->scenario->instance_cull_buffer.set_layer_mask(instance->array_index, p_mask);
 	}
 
 	if ((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK && instance->base_data) {
@@ -1173,6 +1175,47 @@ Vector<ObjectID> RendererSceneCull::instances_cull_convex(const Vector<Plane> &p
 	return cull_convex.instances;
 }
 
+void RendererSceneCull::instances_set_cull_statistics_enabled(bool p_enabled) {
+	instance_cull_statistics_enabled = p_enabled;
+	if (!p_enabled) {
+		instance_cull_statistics.clear();
+	}
+}
+
+Dictionary RendererSceneCull::instances_get_cull_statistics(RID p_viewport) const {
+	Dictionary ret;
+	const InstanceCullStatistics *stats = instance_cull_statistics.getptr(p_viewport);
+	if (!stats) {
+		return ret;
+	}
+
+	TypedArray<RID> instances;
+	instances.resize(stats->instances.size());
+	PackedInt32Array states;
+	states.resize(stats->states.size());
+	int32_t *states_ptrw = states.ptrw();
+	for (uint32_t i = 0; i < stats->instances.size(); i++) {
+		instances[i] = stats->instances[i];
+		states_ptrw[i] = stats->states[i];
+	}
+
+	Dictionary timings;
+	timings["visibility_range"] = stats->visibility_range_usec;
+	timings["directional_shadows"] = stats->directional_shadows_usec;
+	timings["instances"] = stats->instances_usec;
+	timings["positional_shadows"] = stats->positional_shadows_usec;
+
+	ret["frame"] = stats->frame;
+	ret["instances"] = instances;
+	ret["states"] = states;
+	ret["timings_usec"] = timings;
+	return ret;
+}
+
+void RendererSceneCull::instances_clear_cull_statistics(RID p_viewport) {
+	instance_cull_statistics.erase(p_viewport);
+}
+
 void RendererSceneCull::instance_geometry_set_flag(RID p_instance, RS::InstanceFlags p_flags, bool p_enabled) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_NULL(instance);
@@ -1795,6 +1838,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 
 		p_instance->scenario->instance_data.push_back(idata);
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
+		p_instance->scenario->instance_cull_buffer.push_back(p_instance->transformed_aabb, p_instance->layer_mask);
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1803,12 +1847,17 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_cull_buffer.set_bounds(p_instance->array_index, p_instance->transformed_aabb);
 	}
 
 	if (p_instance->visibility_index != -1) {
 		p_instance->scenario->instance_visibility[p_instance->visibility_index].position = p_instance->transformed_aabb.get_center();
 	}
 
+	if (instance_cluster_cell_size > 0.0 && p_instance->base_type == RS::INSTANCE_MESH) {
+		_instance_update_cluster(p_instance);
+	}
+
 	//move instance and repair
 	pair_pass++;
 
@@ -1883,6 +1932,10 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 
 	p_instance->indexer_id = DynamicBVH::ID();
 
+	if (p_instance->cluster_index >= 0) {
+		_instance_remove_from_cluster(p_instance);
+	}
+
 	//replace this by last
 	int32_t swap_with_index = p_instance->scenario->instance_data.size() - 1;
 	if (swap_with_index != p_instance->array_index) {
@@ -1906,6 +1959,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 	// pop last
 	p_instance->scenario->instance_data.pop_back();
 	p_instance->scenario->instance_aabbs.pop_back();
+	p_instance->scenario->instance_cull_buffer.remove_at_unordered(p_instance->array_index);
 
 	//uninitialize
 	p_instance->array_index = -1;
@@ -1933,6 +1987,117 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 	_update_instance_visibility_dependencies(p_instance);
 }
 
+void RendererSceneCull::_instance_update_cluster(Instance *p_instance) {
+	Scenario *scenario = p_instance->scenario;
+
+	// Materials are only sampled here, a material change regroups the instance
+	// on its next move. Grouping only affects how coarse the culling is.
+	InstanceClusterKey key;
+	key.base = p_instance->base;
+	key.material_override = p_instance->material_override;
+	key.material_overlay = p_instance->material_overlay;
+	key.cell = Vector3i((p_instance->transformed_aabb.get_center() / instance_cluster_cell_size).floor());
+
+	if (p_instance->cluster_index >= 0) {
+		InstanceCluster &cluster = scenario->instance_clusters[p_instance->cluster_index];
+		if (cluster.key == key) {
+			// Still in the same cell, growing the bounds keeps them conservative.
+			cluster.aabb.merge_with(p_instance->transformed_aabb);
+			return;
+		}
+		_instance_remove_from_cluster(p_instance);
+	}
+
+	uint32_t cluster_index;
+	HashMap<InstanceClusterKey, uint32_t, InstanceClusterKey>::Iterator E = scenario->instance_cluster_map.find(key);
+	if (E) {
+		cluster_index = E->value;
+	} else {
+		if (scenario->instance_clusters_free.size()) {
+			cluster_index = scenario->instance_clusters_free[scenario->instance_clusters_free.size() - 1];
+			scenario->instance_clusters_free.resize(scenario->instance_clusters_free.size() - 1);
+		} else {
+			cluster_index = scenario->instance_clusters.size();
+			scenario->instance_clusters.resize(cluster_index + 1);
+		}
+		InstanceCluster &cluster = scenario->instance_clusters[cluster_index];
+		cluster.key = key;
+		cluster.aabb_dirty = false;
+		scenario->instance_cluster_map.insert(key, cluster_index);
+	}
+
+	InstanceCluster &cluster = scenario->instance_clusters[cluster_index];
+	if (cluster.instances.is_empty()) {
+		cluster.aabb = p_instance->transformed_aabb;
+	} else {
+		cluster.aabb.merge_with(p_instance->transformed_aabb);
+	}
+
+	p_instance->cluster_index = cluster_index;
+	p_instance->cluster_slot = cluster.instances.size();
+	cluster.instances.push_back(p_instance);
+	scenario->instance_data[p_instance->array_index].cluster_index = cluster_index;
+}
+
+void RendererSceneCull::_instance_remove_from_cluster(Instance *p_instance) {
+	Scenario *scenario = p_instance->scenario;
+	uint32_t cluster_index = p_instance->cluster_index;
+	InstanceCluster &cluster = scenario->instance_clusters[cluster_index];
+
+	Instance *last = cluster.instances[cluster.instances.size() - 1];
+	cluster.instances[p_instance->cluster_slot] = last;
+	last->cluster_slot = p_instance->cluster_slot;
+	cluster.instances.resize(cluster.instances.size() - 1);
+
+	if (cluster.instances.is_empty()) {
+		scenario->instance_cluster_map.erase(cluster.key);
+		scenario->instance_clusters_free.push_back(cluster_index);
+		cluster.aabb_dirty = false;
+	} else if (!cluster.aabb_dirty) {
+		// Shrinking needs the remaining members, defer it to the next cull.
+		cluster.aabb_dirty = true;
+		scenario->instance_clusters_dirty.push_back(cluster_index);
+	}
+
+	if (p_instance->array_index >= 0) {
+		scenario->instance_data[p_instance->array_index].cluster_index = -1;
+	}
+	p_instance->cluster_index = -1;
+}
+
+void RendererSceneCull::_update_instance_cluster_cull(Scenario *p_scenario, const Frustum &p_frustum) {
+	for (uint32_t cluster_index : p_scenario->instance_clusters_dirty) {
+		InstanceCluster &cluster = p_scenario->instance_clusters[cluster_index];
+		if (!cluster.aabb_dirty) {
+			continue;
+		}
+		cluster.aabb_dirty = false;
+		cluster.aabb = cluster.instances[0]->transformed_aabb;
+		for (uint32_t i = 1; i < cluster.instances.size(); i++) {
+			cluster.aabb.merge_with(cluster.instances[i]->transformed_aabb);
+		}
+	}
+	p_scenario->instance_clusters_dirty.clear();
+
+	instance_cluster_cull_state.resize(p_scenario->instance_clusters.size());
+	for (uint32_t i = 0; i < p_scenario->instance_clusters.size(); i++) {
+		const InstanceCluster &cluster = p_scenario->instance_clusters[i];
+		if (cluster.instances.is_empty()) {
+			instance_cluster_cull_state[i] = INSTANCE_CLUSTER_CULLED;
+			continue;
+		}
+
+		InstanceBounds bounds(cluster.aabb);
+		if (!bounds.in_frustum(p_frustum)) {
+			instance_cluster_cull_state[i] = INSTANCE_CLUSTER_CULLED;
+		} else if (bounds.inside_frustum(p_frustum)) {
+			instance_cluster_cull_state[i] = INSTANCE_CLUSTER_INSIDE;
+		} else {
+			instance_cluster_cull_state[i] = INSTANCE_CLUSTER_INTERSECTS;
+		}
+	}
+}
+
 void RendererSceneCull::_update_instance_aabb(Instance *p_instance) {
 	AABB new_aabb;
 
@@ -2764,6 +2929,22 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	// Layer and camera frustum tests for the whole range run first, over the packed bounds.
+	// Instances in clusters that are fully inside or outside the frustum are already decided,
+	// so only the rest go through the plane tests.
+	uint8_t *frustum_visible = cull_data.instance_frustum_visible;
+	const InstanceCullBuffer &cull_buffer = cull_data.scenario->instance_cull_buffer;
+	if (cull_data.instance_cluster_cull_state) {
+		for (uint64_t i = p_from; i < p_to; i++) {
+			int32_t cluster_index = cull_data.scenario->instance_data[i].cluster_index;
+			uint8_t cluster_cull_state = cluster_index >= 0 ? cull_data.instance_cluster_cull_state[cluster_index] : INSTANCE_CLUSTER_INTERSECTS;
+			frustum_visible[i] = cluster_cull_state == INSTANCE_CLUSTER_INTERSECTS ? InstanceCullBuffer::CULL_PENDING : uint8_t(cluster_cull_state == INSTANCE_CLUSTER_INSIDE);
+		}
+		cull_buffer.cull_pending(cull_data.cull->frustum.planes_ptr, cull_data.cull->frustum.plane_count, cull_data.visible_layers, p_from, p_to, frustum_visible + p_from);
+	} else {
+		cull_buffer.cull(cull_data.cull->frustum.planes_ptr, cull_data.cull->frustum.plane_count, cull_data.visible_layers, p_from, p_to, frustum_visible + p_from);
+	}
+
 	for (uint64_t i = p_from; i < p_to; i++) {
 		bool mesh_visible = false;
 
@@ -2774,13 +2955,31 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
 #define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define IN_CAMERA_FRUSTUM (frustum_visible[i])
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near, cull_data.scenario->instance_data[i].occlusion_timeout))
 
+		RS::InstanceCullState cull_state = RS::INSTANCE_CULL_STATE_VISIBLE;
+		if (HIDDEN_BY_VISIBILITY_CHECKS) {
+			cull_state = RS::INSTANCE_CULL_STATE_VISIBILITY_RANGE_CULLED;
+		} else if (!LAYER_CHECK) {
+			cull_state = RS::INSTANCE_CULL_STATE_LAYER_CULLED;
+		} else if (!IN_CAMERA_FRUSTUM) {
+			cull_state = RS::INSTANCE_CULL_STATE_FRUSTUM_CULLED;
+		} else if (!VIS_CHECK) {
+			cull_state = RS::INSTANCE_CULL_STATE_VISIBILITY_RANGE_CULLED;
+		} else if (OCCLUSION_CULLED) {
+			cull_state = RS::INSTANCE_CULL_STATE_OCCLUSION_CULLED;
+		}
+
+		if (cull_data.instance_cull_states) {
+			cull_data.instance_cull_states[i] = cull_state;
+		}
+
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if (cull_state == RS::INSTANCE_CULL_STATE_VISIBLE || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -2966,6 +3165,9 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 					if (keep) {
 						cull_result.geometry_instances.push_back(idata.instance_geometry);
+						if (cull_data.report_texture_usage) {
+							cull_result.texture_usage_instances.push_back(idata.instance);
+						}
 					}
 				}
 			}
@@ -2990,6 +3192,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #undef HIDDEN_BY_VISIBILITY_CHECKS
 #undef LAYER_CHECK
 #undef IN_FRUSTUM
+#undef IN_CAMERA_FRUSTUM
 #undef VIS_RANGE_CHECK
 #undef VIS_PARENT_CHECK
 #undef VIS_CHECK
@@ -3023,6 +3226,40 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	}
 }
 
+void RendererSceneCull::_report_texture_usage(const PagedArray<Instance *> &p_instances) {
+	// Materials are shared by many instances, only look up their textures once.
+	HashSet<RID> materials;
+	for (uint64_t i = 0; i < p_instances.size(); i++) {
+		const Instance *instance = p_instances[i];
+		if (instance->material_override.is_valid()) {
+			materials.insert(instance->material_override);
+		} else {
+			int surface_count = instance->base_type == RS::INSTANCE_MESH ? RSG::mesh_storage->mesh_get_surface_count(instance->base) : instance->materials.size();
+			for (int j = 0; j < surface_count; j++) {
+				RID material = j < instance->materials.size() ? instance->materials[j] : RID();
+				if (material.is_null() && instance->base_type == RS::INSTANCE_MESH) {
+					material = RSG::mesh_storage->mesh_surface_get_material(instance->base, j);
+				}
+				if (material.is_valid()) {
+					materials.insert(material);
+				}
+			}
+		}
+		if (instance->material_overlay.is_valid()) {
+			materials.insert(instance->material_overlay);
+		}
+	}
+
+	// How large the textures are on screen is unknown here, request them at full size.
+	LocalVector<RID> textures;
+	for (const RID &material : materials) {
+		RSG::material_storage->material_get_textures(material, &textures);
+	}
+	for (const RID &texture : textures) {
+		RSG::texture_storage->texture_report_usage(texture, 1.0);
+	}
+}
+
 void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, RID p_compositor, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, bool p_using_shadows, RenderingMethod::RenderInfo *r_render_info) {
 	Instance *render_reflection_probe = instance_owner.get_or_null(p_reflection_probe); //if null, not rendering to it
 
@@ -3043,6 +3280,15 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		scene_render->sdfgi_update(p_render_buffers, p_environment, camera_position); //update conditions for SDFGI (whether its used or not)
 	}
 
+	// Only camera renders are recorded, reflection probes have no viewport.
+	InstanceCullStatistics *cull_statistics = nullptr;
+	uint64_t cull_phase_from = 0;
+	if (instance_cull_statistics_enabled && p_viewport.is_valid() && p_reflection_probe.is_null()) {
+		cull_statistics = &instance_cull_statistics[p_viewport];
+		cull_statistics->frame = RSG::rasterizer->get_frame_number();
+		cull_phase_from = OS::get_singleton()->get_ticks_usec();
+	}
+
 	RENDER_TIMESTAMP("Update Visibility Dependencies");
 
 	if (scenario->instance_visibility.get_bin_count() > 0) {
@@ -3072,6 +3318,12 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		}
 	}
 
+	if (cull_statistics) {
+		uint64_t time = OS::get_singleton()->get_ticks_usec();
+		cull_statistics->visibility_range_usec = time - cull_phase_from;
+		cull_phase_from = time;
+	}
+
 	RENDER_TIMESTAMP("Cull 3D Scene");
 
 	//rasterizer->set_camera(p_camera_data->main_transform, p_camera_data.main_projection, p_camera_data.is_orthogonal);
@@ -3142,6 +3394,14 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		}
 	}
 
+	if (cull_statistics) {
+		uint64_t time = OS::get_singleton()->get_ticks_usec();
+		cull_statistics->directional_shadows_usec = time - cull_phase_from;
+		cull_phase_from = time;
+	}
+
+	RENDER_TIMESTAMP("Cull 3D Instances");
+
 	scene_cull_result.clear();
 
 	{
@@ -3160,6 +3420,17 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
+		if (instance_cluster_cell_size > 0.0) {
+			_update_instance_cluster_cull(scenario, cull.frustum);
+			cull_data.instance_cluster_cull_state = instance_cluster_cull_state.ptr();
+		}
+		instance_frustum_visible.resize(cull_to);
+		cull_data.instance_frustum_visible = instance_frustum_visible.ptr();
+		if (cull_statistics) {
+			cull_statistics->states.resize(cull_to);
+			cull_data.instance_cull_states = cull_statistics->states.ptr();
+		}
+		cull_data.report_texture_usage = RSG::texture_storage->has_texture_usage_callbacks();
 //#define DEBUG_CULL_TIME
 #ifdef DEBUG_CULL_TIME
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
@@ -3191,14 +3462,31 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		print_line("time taken: " + rtos(time_avg / time_count));
 #endif
 
+		if (scene_cull_result.texture_usage_instances.size()) {
+			_report_texture_usage(scene_cull_result.texture_usage_instances);
+		}
+
 		if (scene_cull_result.mesh_instances.size()) {
 			for (uint64_t i = 0; i < scene_cull_result.mesh_instances.size(); i++) {
 				RSG::mesh_storage->mesh_instance_check_for_update(scene_cull_result.mesh_instances[i]);
 			}
 			RSG::mesh_storage->update_mesh_instances();
 		}
+
+		if (cull_statistics) {
+			cull_statistics->instances_usec = OS::get_singleton()->get_ticks_usec() - cull_phase_from;
+
+			cull_statistics->instances.resize(cull_to);
+			for (uint64_t i = 0; i < cull_to; i++) {
+				cull_statistics->instances[i] = scenario->instance_data[i].instance->self;
+			}
+
+			cull_phase_from = OS::get_singleton()->get_ticks_usec();
+		}
 	}
 
+	RENDER_TIMESTAMP("Update Positional Shadows");
+
 	//render shadows
 
 	max_shadows_used = 0;
@@ -3350,6 +3638,10 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		}
 	}
 
+	if (cull_statistics) {
+		cull_statistics->positional_shadows_usec = OS::get_singleton()->get_ticks_usec() - cull_phase_from;
+	}
+
 	//render SDFGI
 
 	{
@@ -4163,6 +4455,7 @@ bool RendererSceneCull::free(RID p_rid) {
 			instance_set_scenario(scenario->instances.first()->self()->self, RID());
 		}
 		scenario->instance_aabbs.reset();
+		scenario->instance_cull_buffer.reset();
 		scenario->instance_data.reset();
 		scenario->instance_visibility.reset();
 
@@ -4263,9 +4556,10 @@ RendererSceneCull::RendererSceneCull() {
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
+	instance_cluster_cell_size = GLOBAL_GET("rendering/limits/spatial_indexer/instance_cluster_cell_size");
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	default_occlusion_culling = memnew(RasterOcclusionCull);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4291,8 +4585,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (default_occlusion_culling) {
+		memdelete(default_occlusion_culling);
 	}
 
 	if (light_culler) {
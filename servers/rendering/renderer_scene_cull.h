@@ -39,6 +39,7 @@
 #include "core/templates/pass_func.h"
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
+#include "servers/rendering/instance_cull_buffer.h"
 #include "servers/rendering/renderer_scene_occlusion_cull.h"
 #include "servers/rendering/renderer_scene_render.h"
 #include "servers/rendering/rendering_method.h"
@@ -123,7 +124,8 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	// CPU rasterizer, superseded by the raycast module when it is available.
+	RendererSceneOcclusionCull *default_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -222,6 +224,23 @@ public:
 
 			return true;
 		}
+		_ALWAYS_INLINE_ bool inside_frustum(const Frustum &p_frustum) const {
+			// True only when the bounds are fully on the inner side of every plane.
+
+			for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+				const uint32_t *signs = p_frustum.plane_signs_ptr[i].signs;
+				Vector3 max(
+						bounds[signs[0] < 3 ? signs[0] + 3 : signs[0] - 3],
+						bounds[signs[1] < 3 ? signs[1] + 3 : signs[1] - 3],
+						bounds[signs[2] < 3 ? signs[2] + 3 : signs[2] - 3]);
+
+				if (p_frustum.planes_ptr[i].distance_to(max) >= 0.0) {
+					return false;
+				}
+			}
+
+			return true;
+		}
 		_ALWAYS_INLINE_ bool in_aabb(const AABB &p_aabb) const {
 			Vector3 end = p_aabb.position + p_aabb.size;
 
@@ -286,6 +305,7 @@ public:
 		Instance *instance = nullptr;
 		int32_t parent_array_index = -1;
 		int32_t visibility_index = -1;
+		int32_t cluster_index = -1;
 
 		// Each time occlusion culling determines an instance is visible,
 		// set this to occlusion_frame plus some delay.
@@ -317,6 +337,43 @@ public:
 		}
 	};
 
+	struct InstanceClusterKey {
+		RID base;
+		RID material_override;
+		RID material_overlay;
+		Vector3i cell;
+
+		_FORCE_INLINE_ bool operator==(const InstanceClusterKey &p_key) const {
+			return base == p_key.base && material_override == p_key.material_override && material_overlay == p_key.material_overlay && cell == p_key.cell;
+		}
+
+		static _FORCE_INLINE_ uint32_t hash(const InstanceClusterKey &p_key) {
+			uint32_t h = hash_murmur3_one_64(p_key.base.get_id());
+			h = hash_murmur3_one_64(p_key.material_override.get_id(), h);
+			h = hash_murmur3_one_64(p_key.material_overlay.get_id(), h);
+			h = hash_murmur3_one_32(p_key.cell.x, h);
+			h = hash_murmur3_one_32(p_key.cell.y, h);
+			h = hash_murmur3_one_32(p_key.cell.z, h);
+			return hash_fmix32(h);
+		}
+	};
+
+	struct InstanceCluster {
+		// Mesh instances sharing the same mesh and materials inside one grid cell.
+		// The camera cull tests the cluster bounds once and only falls back to
+		// testing each instance when the cluster straddles the frustum.
+		InstanceClusterKey key;
+		AABB aabb;
+		LocalVector<Instance *> instances;
+		bool aabb_dirty = false;
+	};
+
+	enum InstanceClusterCullState : uint8_t {
+		INSTANCE_CLUSTER_CULLED,
+		INSTANCE_CLUSTER_INTERSECTS,
+		INSTANCE_CLUSTER_INSIDE,
+	};
+
 	PagedArrayPool<InstanceBounds> instance_aabb_page_pool;
 	PagedArrayPool<InstanceData> instance_data_page_pool;
 	PagedArrayPool<InstanceVisibilityData> instance_visibility_data_page_pool;
@@ -348,8 +405,14 @@ public:
 
 		PagedArray<InstanceBounds> instance_aabbs;
 		PagedArray<InstanceData> instance_data;
+		InstanceCullBuffer instance_cull_buffer;
 		VisibilityArray instance_visibility;
 
+		LocalVector<InstanceCluster> instance_clusters;
+		LocalVector<uint32_t> instance_clusters_free;
+		LocalVector<uint32_t> instance_clusters_dirty;
+		HashMap<InstanceClusterKey, uint32_t, InstanceClusterKey> instance_cluster_map;
+
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
 			indexers[INDEXER_VOLUMES].set_index(INDEXER_VOLUMES);
@@ -454,6 +517,8 @@ public:
 		DynamicBVH::ID indexer_id;
 		int32_t array_index = -1;
 		int32_t visibility_index = -1;
+		int32_t cluster_index = -1;
+		uint32_t cluster_slot = 0;
 		float visibility_range_begin = 0.0f;
 		float visibility_range_end = 0.0f;
 		float visibility_range_begin_margin = 0.0f;
@@ -891,6 +956,7 @@ public:
 		PagedArray<RID> voxel_gi_instances;
 		PagedArray<RID> mesh_instances;
 		PagedArray<RID> fog_volumes;
+		PagedArray<Instance *> texture_usage_instances; // Only filled when textures have usage callbacks.
 
 		struct DirectionalShadow {
 			PagedArray<RenderGeometryInstance *> cascade_geometry_instances[RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
@@ -909,6 +975,7 @@ public:
 			voxel_gi_instances.clear();
 			mesh_instances.clear();
 			fog_volumes.clear();
+			texture_usage_instances.clear();
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].clear();
@@ -934,6 +1001,7 @@ public:
 			voxel_gi_instances.reset();
 			mesh_instances.reset();
 			fog_volumes.reset();
+			texture_usage_instances.reset();
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].reset();
@@ -959,6 +1027,7 @@ public:
 			voxel_gi_instances.merge_unordered(p_cull_result.voxel_gi_instances);
 			mesh_instances.merge_unordered(p_cull_result.mesh_instances);
 			fog_volumes.merge_unordered(p_cull_result.fog_volumes);
+			texture_usage_instances.merge_unordered(p_cull_result.texture_usage_instances);
 
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
@@ -985,6 +1054,7 @@ public:
 			voxel_gi_instances.set_page_pool(p_rid_pool);
 			mesh_instances.set_page_pool(p_rid_pool);
 			fog_volumes.set_page_pool(p_rid_pool);
+			texture_usage_instances.set_page_pool(p_instance_pool);
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].set_page_pool(p_geometry_instance_pool);
@@ -1012,6 +1082,14 @@ public:
 
 	uint32_t thread_cull_threshold = 200;
 
+	float instance_cluster_cell_size = 0.0;
+	LocalVector<uint8_t> instance_cluster_cull_state;
+	LocalVector<uint8_t> instance_frustum_visible;
+
+	void _instance_update_cluster(Instance *p_instance);
+	void _instance_remove_from_cluster(Instance *p_instance);
+	void _update_instance_cluster_cull(Scenario *p_scenario, const Frustum &p_frustum);
+
 	RID_Owner<Instance, true> instance_owner;
 
 	uint32_t geometry_instance_pair_mask = 0; // used in traditional forward, unnecessary on clustered
@@ -1051,6 +1129,24 @@ public:
 	virtual Vector<ObjectID> instances_cull_ray(const Vector3 &p_from, const Vector3 &p_to, RID p_scenario = RID()) const;
 	virtual Vector<ObjectID> instances_cull_convex(const Vector<Plane> &p_convex, RID p_scenario = RID()) const;
 
+	struct InstanceCullStatistics {
+		uint64_t frame = 0;
+		uint64_t visibility_range_usec = 0;
+		uint64_t directional_shadows_usec = 0;
+		uint64_t instances_usec = 0;
+		uint64_t positional_shadows_usec = 0;
+		// Parallel arrays, one entry per instance in the scenario.
+		LocalVector<RID> instances;
+		LocalVector<uint8_t> states;
+	};
+
+	bool instance_cull_statistics_enabled = false;
+	HashMap<RID, InstanceCullStatistics> instance_cull_statistics;
+
+	virtual void instances_set_cull_statistics_enabled(bool p_enabled);
+	virtual Dictionary instances_get_cull_statistics(RID p_viewport) const;
+	virtual void instances_clear_cull_statistics(RID p_viewport);
+
 	virtual void instance_geometry_set_flag(RID p_instance, RS::InstanceFlags p_flags, bool p_enabled);
 	virtual void instance_geometry_set_cast_shadows_setting(RID p_instance, RS::ShadowCastingSetting p_shadow_casting_setting);
 	virtual void instance_geometry_set_material_override(RID p_instance, RID p_material);
@@ -1142,11 +1238,16 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		const uint8_t *instance_cluster_cull_state = nullptr;
+		uint8_t *instance_cull_states = nullptr;
+		uint8_t *instance_frustum_visible = nullptr;
+		bool report_texture_usage = false;
 	};
 
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
+	void _report_texture_usage(const PagedArray<Instance *> &p_instances);
 
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
 	void _render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, RID p_compositor, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, bool p_using_shadows = true, RenderInfo *r_render_info = nullptr);
@@ -30,6 +30,8 @@
 
 #include "renderer_scene_occlusion_cull.h"
 
+#include "core/object/worker_thread_pool.h"
+
 RendererSceneOcclusionCull *RendererSceneOcclusionCull::singleton = nullptr;
 
 const Vector3 RendererSceneOcclusionCull::HZBuffer::corners[8] = {
@@ -45,6 +47,180 @@ const Vector3 RendererSceneOcclusionCull::HZBuffer::corners[8] = {
 
 bool RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = false;
 
+Projection RendererSceneOcclusionCull::_jitter_projection(const Projection &p_cam_projection, const Size2i &p_viewport_size) {
+	if (!HZBuffer::occlusion_jitter_enabled) {
+		return p_cam_projection;
+	}
+
+	// Prevent divide by zero when using NULL viewport.
+	if ((p_viewport_size.x <= 0) || (p_viewport_size.y <= 0)) {
+		return p_cam_projection;
+	}
+
+	Projection p = p_cam_projection;
+
+	int32_t frame = Engine::get_singleton()->get_frames_drawn();
+	frame %= 9;
+
+	Vector2 jitter;
+
+	switch (frame) {
+		default:
+			break;
+		case 1: {
+			jitter = Vector2(-1, -1);
+		} break;
+		case 2: {
+			jitter = Vector2(1, -1);
+		} break;
+		case 3: {
+			jitter = Vector2(-1, 1);
+		} break;
+		case 4: {
+			jitter = Vector2(1, 1);
+		} break;
+		case 5: {
+			jitter = Vector2(-0.5f, -0.5f);
+		} break;
+		case 6: {
+			jitter = Vector2(0.5f, -0.5f);
+		} break;
+		case 7: {
+			jitter = Vector2(-0.5f, 0.5f);
+		} break;
+		case 8: {
+			jitter = Vector2(0.5f, 0.5f);
+		} break;
+	}
+
+	// The multiplier here determines the divergence from center,
+	// and is to some extent a balancing act.
+	// Higher divergence gives fewer false hidden, but more false shown.
+	// False hidden is obvious to viewer, false shown is not.
+	// False shown can lower percentage that are occluded, and therefore performance.
+	jitter *= Vector2(1 / (float)p_viewport_size.x, 1 / (float)p_viewport_size.y) * 0.05f;
+
+	p.add_jitter_offset(jitter);
+
+	return p;
+}
+
+void RendererSceneOcclusionCull::OccluderScenario::mark_instance_dirty(RID p_instance) {
+	if (!dirty_instances.has(p_instance)) {
+		dirty_instances.insert(p_instance);
+		dirty_instances_array.push_back(p_instance);
+		dirty = true;
+	}
+}
+
+bool RendererSceneOcclusionCull::OccluderScenario::update_instances(const StringName &p_task_name) {
+	if (!dirty && removed_instances.is_empty() && dirty_instances_array.is_empty()) {
+		return false;
+	}
+
+	for (const RID &instance : removed_instances) {
+		instances.erase(instance);
+	}
+
+	if (dirty_instances_array.size() / WorkerThreadPool::get_singleton()->get_thread_count() > 128) {
+		// Lots of instances, use per-instance threading
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &OccluderScenario::_update_dirty_instance, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, p_task_name);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		// Few instances, backends can thread the vertex transforms instead
+		for (uint32_t i = 0; i < dirty_instances_array.size(); i++) {
+			_update_dirty_instance(i, dirty_instances_array.ptr());
+		}
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+
+	return true;
+}
+
+void RendererSceneOcclusionCull::_occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		OccluderScenario *scenario = _get_occluder_scenario(E.scenario);
+		ERR_CONTINUE(!scenario);
+		ERR_CONTINUE(!scenario->instances.has(E.instance));
+
+		scenario->mark_instance_dirty(E.instance);
+	}
+}
+
+void RendererSceneOcclusionCull::_scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	OccluderScenario *scenario = _get_occluder_scenario(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	if (!scenario->instances.has(p_instance)) {
+		scenario->instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario->instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario->removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	if (instance.enabled != p_enabled) {
+		instance.enabled = p_enabled;
+		scenario->dirty = true; // The scenario needs a rebuild, but the instance doesn't need update
+	}
+
+	if (changed) {
+		scenario->mark_instance_dirty(p_instance);
+	}
+}
+
+void RendererSceneOcclusionCull::_scenario_remove_instance(RID p_scenario, RID p_instance) {
+	OccluderScenario *scenario = _get_occluder_scenario(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (instance && !instance->removed) {
+		Occluder *occluder = occluder_owner.get_or_null(instance->occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		scenario->removed_instances.push_back(p_instance);
+		instance->removed = true;
+	}
+}
+
 bool RendererSceneOcclusionCull::HZBuffer::is_empty() const {
 	return sizes.is_empty();
 }
@@ -32,13 +32,78 @@
 #define RENDERER_SCENE_OCCLUSION_CULL_H
 
 #include "core/math/projection.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
 #include "servers/rendering_server.h"
 
 class RendererSceneOcclusionCull {
 protected:
 	static RendererSceneOcclusionCull *singleton;
 
+	// Offsets the projection by a sub-pixel amount that changes every frame,
+	// to be used along with HZBuffer::occlusion_jitter_enabled.
+	static Projection _jitter_projection(const Projection &p_cam_projection, const Size2i &p_viewport_size);
+
+	// Occluder meshes and their instances in each scenario, shared by the culling backends.
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<uint32_t> indices;
+		LocalVector<Vector3> xformed_vertices;
+		Transform3D xform;
+		bool enabled = true;
+		bool removed = false;
+	};
+
+	struct OccluderScenario {
+		HashMap<RID, OccluderInstance> instances;
+		HashSet<RID> dirty_instances; // To avoid duplicates
+		LocalVector<RID> dirty_instances_array; // To iterate and split into threads
+		LocalVector<RID> removed_instances;
+		bool dirty = false;
+
+		void mark_instance_dirty(RID p_instance);
+
+		// Erases the removed instances and calls _update_dirty_instance() on the dirty ones.
+		// Returns false if nothing changed, otherwise the backend rebuilds its scene and clears `dirty`.
+		bool update_instances(const StringName &p_task_name);
+		virtual void _update_dirty_instance(uint32_t p_idx, RID *p_instances) = 0;
+
+		virtual ~OccluderScenario() {}
+	};
+
+	RID_PtrOwner<Occluder> occluder_owner;
+
+	virtual OccluderScenario *_get_occluder_scenario(RID p_scenario) { return nullptr; }
+
+	void _occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices);
+	void _scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled);
+	void _scenario_remove_instance(RID p_scenario, RID p_instance);
+
 public:
 	class HZBuffer {
 	protected:
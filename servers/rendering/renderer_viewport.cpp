@@ -587,6 +587,19 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 			scenario_draw_canvas_bg = false;
 		}
 
+		if (RSG::canvas->is_threaded_cull_enabled() && canvas_map.size()) {
+			// Cull every canvas layer up front so the work can be spread over threads,
+			// render_canvas() below then only draws the prepared lists in layer order.
+			LocalVector<RendererCanvasCull::Canvas *> canvases;
+			LocalVector<Transform2D> canvas_transforms;
+			for (const KeyValue<Viewport::CanvasKey, Viewport::CanvasData *> &E : canvas_map) {
+				RendererCanvasCull::Canvas *canvas = static_cast<RendererCanvasCull::Canvas *>(E.value->canvas);
+				canvases.push_back(canvas);
+				canvas_transforms.push_back(_canvas_get_transform(p_viewport, canvas, E.value, clip_rect.size));
+			}
+			RSG::canvas->cull_canvases(canvases.ptr(), canvas_transforms.ptr(), canvases.size(), clip_rect, p_viewport->snap_2d_transforms_to_pixel, p_viewport->canvas_cull_mask);
+		}
+
 		for (const KeyValue<Viewport::CanvasKey, Viewport::CanvasData *> &E : canvas_map) {
 			RendererCanvasCull::Canvas *canvas = static_cast<RendererCanvasCull::Canvas *>(E.value->canvas);
 
@@ -1494,6 +1507,8 @@ bool RendererViewport::free(RID p_rid) {
 			RendererSceneOcclusionCull::get_singleton()->remove_buffer(p_rid);
 		}
 
+		RSG::scene->instances_clear_cull_statistics(p_rid);
+
 		if (_viewport_requires_motion_vectors(viewport)) {
 			num_viewports_with_motion_vectors--;
 		}
@@ -900,6 +900,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 
 			if (p_assigning && p_actions.write_flag_pointers.has(vnode->name)) {
 				*p_actions.write_flag_pointers[vnode->name] = true;
+				used_write_flag_pointers.insert(vnode->name);
 			}
 
 			if (p_default_actions.usage_defines.has(vnode->name) && !used_name_defines.has(vnode->name)) {
@@ -1017,6 +1018,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 
 			if (p_assigning && p_actions.write_flag_pointers.has(anode->name)) {
 				*p_actions.write_flag_pointers[anode->name] = true;
+				used_write_flag_pointers.insert(anode->name);
 			}
 
 			if (p_default_actions.usage_defines.has(anode->name) && !used_name_defines.has(anode->name)) {
@@ -1232,6 +1234,7 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 
 							if (found && p_actions.write_flag_pointers.has(name)) {
 								*p_actions.write_flag_pointers[name] = true;
+								used_write_flag_pointers.insert(name);
 							}
 						}
 
@@ -1462,7 +1465,62 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
+uint64_t ShaderCompiler::_get_code_cache_key(RS::ShaderMode p_mode, const String &p_code) {
+	return hash_murmur3_one_64(p_mode, p_code.hash64());
+}
+
+bool ShaderCompiler::_load_from_code_cache(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	HashMap<uint64_t, CachedCode>::Iterator E = code_cache.find(_get_code_cache_key(p_mode, p_code));
+	if (!E || E->value.mode != p_mode || E->value.source != p_code) {
+		return false;
+	}
+	const CachedCode &cached = E->value;
+
+	if (Engine::get_singleton()->is_editor_hint()) {
+		// Global uniforms are only validated in the editor, and may have changed type since.
+		for (const KeyValue<StringName, SL::ShaderNode::Uniform> &U : cached.uniforms) {
+			if (U.value.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL && _get_global_shader_uniform_type(U.key) != U.value.type) {
+				code_cache.remove(E);
+				return false;
+			}
+		}
+	}
+
+	// Report the same render modes, flags and uniforms as _dump_node_code() would.
+	for (const StringName &render_mode : cached.render_modes) {
+		if (p_actions->render_mode_flags.has(render_mode)) {
+			*p_actions->render_mode_flags[render_mode] = true;
+		}
+
+		if (p_actions->render_mode_values.has(render_mode)) {
+			Pair<int *, int> &p = p_actions->render_mode_values[render_mode];
+			*p.first = p.second;
+		}
+	}
+	for (const StringName &usage_flag : cached.usage_flags) {
+		if (p_actions->usage_flag_pointers.has(usage_flag)) {
+			*p_actions->usage_flag_pointers[usage_flag] = true;
+		}
+	}
+	for (const StringName &write_flag : cached.write_flags) {
+		if (p_actions->write_flag_pointers.has(write_flag)) {
+			*p_actions->write_flag_pointers[write_flag] = true;
+		}
+	}
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &U : cached.uniforms) {
+		p_actions->uniforms->insert(U.key, U.value);
+	}
+
+	r_gen_code = cached.gen_code;
+	code_cache_hits++;
+	return true;
+}
+
 Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	if (_load_from_code_cache(p_mode, p_code, p_actions, r_gen_code)) {
+		return OK;
+	}
+
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1561,17 +1619,51 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	used_name_defines.clear();
 	used_rmode_defines.clear();
 	used_flag_pointers.clear();
+	used_write_flag_pointers.clear();
 	fragment_varyings.clear();
 
+	CachedCode cached;
+	cached.source = p_code;
+	cached.mode = p_mode;
+
+	// Collect the uniforms separately so only the ones from this shader are cached.
+	HashMap<StringName, SL::ShaderNode::Uniform> *uniforms = p_actions->uniforms;
+	p_actions->uniforms = &cached.uniforms;
+
 	shader = parser.get_shader();
 	function = nullptr;
 	_dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
 
+	p_actions->uniforms = uniforms;
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &U : cached.uniforms) {
+		uniforms->insert(U.key, U.value);
+	}
+
+	cached.render_modes = shader->render_modes;
+	for (const StringName &E : used_flag_pointers) {
+		cached.usage_flags.push_back(E);
+	}
+	for (const StringName &E : used_write_flag_pointers) {
+		cached.write_flags.push_back(E);
+	}
+	cached.gen_code = r_gen_code;
+
+	if (code_cache.size() >= CODE_CACHE_MAX_ENTRIES) {
+		code_cache.remove(code_cache.begin());
+	}
+	code_cache.insert(_get_code_cache_key(p_mode, p_code), cached);
+
 	return OK;
 }
 
+void ShaderCompiler::clear_code_cache() {
+	code_cache.clear();
+	code_cache_hits = 0;
+}
+
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
+	clear_code_cache();
 
 	time_name = "TIME";
 
@@ -119,18 +119,44 @@ private:
 
 	HashSet<StringName> used_name_defines;
 	HashSet<StringName> used_flag_pointers;
+	HashSet<StringName> used_write_flag_pointers;
 	HashSet<StringName> used_rmode_defines;
 	HashSet<StringName> internal_functions;
 	HashSet<StringName> fragment_varyings;
 
 	DefaultIdentifierActions actions;
 
+	// Output of a successful compilation, along with what it reported through the
+	// IdentifierActions, so it can be handed to the next shader with the same source.
+	struct CachedCode {
+		String source;
+		RS::ShaderMode mode = RS::SHADER_MAX;
+		GeneratedCode gen_code;
+		Vector<StringName> render_modes;
+		Vector<StringName> usage_flags;
+		Vector<StringName> write_flags;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	};
+
+	// Keyed by the hash of the (already preprocessed) source and shader mode. Shared by
+	// all the shaders compiled with this compiler, so duplicated shaders and visual shaders
+	// regenerating the same code are parsed once. Oldest entries are dropped first.
+	static constexpr uint32_t CODE_CACHE_MAX_ENTRIES = 256;
+	HashMap<uint64_t, CachedCode> code_cache;
+	uint64_t code_cache_hits = 0;
+
+	static uint64_t _get_code_cache_key(RS::ShaderMode p_mode, const String &p_code);
+	bool _load_from_code_cache(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
 	void initialize(DefaultIdentifierActions p_actions);
+	void clear_code_cache();
+	// Number of compilations served from the code cache since it was last cleared.
+	uint64_t get_code_cache_hits() const { return code_cache_hits; }
 	ShaderCompiler();
 };
 
@@ -396,6 +396,9 @@ const ShaderLanguage::KeyWord ShaderLanguage::keyword_list[] = {
 	{ TK_ERROR, nullptr, CF_UNSPECIFIED, {}, {} }
 };
 
+// Index into keyword_list by keyword text, filled while there are ShaderLanguage instances.
+HashMap<String, int> keyword_index_map;
+
 ShaderLanguage::Token ShaderLanguage::_get_token() {
 #define GETCHAR(m_idx) (((char_idx + m_idx) < code.length()) ? code[char_idx + m_idx] : char32_t(0))
 
@@ -847,25 +850,23 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 
 				if (is_ascii_identifier_char(GETCHAR(0))) {
 					// parse identifier
-					String str;
+					const int from = char_idx;
 
 					while (is_ascii_identifier_char(GETCHAR(0))) {
-						str += char32_t(GETCHAR(0));
 						char_idx++;
 					}
 
-					//see if keyword
-					//should be converted to a static map
-					int idx = 0;
+					String str = code.substr(from, char_idx - from);
 
-					while (keyword_list[idx].text) {
-						if (str == keyword_list[idx].text) {
-							return _make_token(keyword_list[idx].token);
-						}
-						idx++;
+					//see if keyword
+					HashMap<String, int>::ConstIterator keyword = keyword_index_map.find(str);
+					if (keyword) {
+						return _make_token(keyword_list[keyword->value].token);
 					}
 
-					str = str.replace("dus_", "_");
+					if (str.contains("dus_")) {
+						str = str.replace("dus_", "_");
+					}
 
 					return _make_token(TK_IDENTIFIER, str);
 				}
@@ -10856,6 +10857,14 @@ ShaderLanguage::ShaderLanguage() {
 			}
 			idx++;
 		}
+
+		idx = 0;
+		while (keyword_list[idx].text) {
+			if (!keyword_index_map.has(keyword_list[idx].text)) {
+				keyword_index_map.insert(keyword_list[idx].text, idx);
+			}
+			idx++;
+		}
 	}
 	instance_counter++;
 
@@ -10875,5 +10884,6 @@ ShaderLanguage::~ShaderLanguage() {
 	instance_counter--;
 	if (instance_counter == 0) {
 		global_func_set.clear();
+		keyword_index_map.clear();
 	}
 }
@@ -95,6 +95,7 @@ public:
 	};
 
 	virtual void material_get_instance_shader_parameters(RID p_material, List<InstanceShaderParam> *r_parameters) = 0;
+	virtual void material_get_textures(RID p_material, LocalVector<RID> *r_textures) = 0;
 
 	virtual void material_update_dependency(RID p_material, DependencyTracker *p_instance) = 0;
 };
@@ -37,6 +37,12 @@ class RendererTextureStorage {
 private:
 	Color default_clear_color;
 
+	struct UsageCallback {
+		RS::TextureUsageCallback callback = nullptr;
+		void *userdata = nullptr;
+	};
+	HashMap<RID, UsageCallback> usage_callbacks;
+
 public:
 	void set_default_clear_color(const Color &p_color) {
 		default_clear_color = p_color;
@@ -96,6 +102,25 @@ public:
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) = 0;
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata) = 0;
 
+	// Usage callbacks are independent of the renderer, the cull reports them.
+	void texture_set_usage_callback(RID p_texture, RS::TextureUsageCallback p_callback, void *p_userdata) {
+		if (p_callback) {
+			UsageCallback &usage = usage_callbacks[p_texture];
+			usage.callback = p_callback;
+			usage.userdata = p_userdata;
+		} else {
+			usage_callbacks.erase(p_texture);
+		}
+	}
+	_FORCE_INLINE_ bool has_texture_usage_callbacks() const { return !usage_callbacks.is_empty(); }
+	_FORCE_INLINE_ bool texture_has_usage_callback(RID p_texture) const { return usage_callbacks.has(p_texture); }
+	_FORCE_INLINE_ void texture_report_usage(RID p_texture, float p_scale) const {
+		const UsageCallback *usage = usage_callbacks.getptr(p_texture);
+		if (usage) {
+			usage->callback(usage->userdata, p_scale);
+		}
+	}
+
 	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info) = 0;
 
 	virtual void texture_set_force_redraw_if_visible(RID p_texture, bool p_enable) = 0;
@@ -3145,6 +3145,8 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instances_cull_aabb", "aabb", "scenario"), &RenderingServer::_instances_cull_aabb_bind, DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("instances_cull_ray", "from", "to", "scenario"), &RenderingServer::_instances_cull_ray_bind, DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("instances_cull_convex", "convex", "scenario"), &RenderingServer::_instances_cull_convex_bind, DEFVAL(RID()));
+	ClassDB::bind_method(D_METHOD("instances_set_cull_statistics_enabled", "enabled"), &RenderingServer::instances_set_cull_statistics_enabled);
+	ClassDB::bind_method(D_METHOD("instances_get_cull_statistics", "viewport"), &RenderingServer::instances_get_cull_statistics);
 
 	BIND_ENUM_CONSTANT(INSTANCE_NONE);
 	BIND_ENUM_CONSTANT(INSTANCE_MESH);
@@ -3169,6 +3171,13 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_IGNORE_OCCLUSION_CULLING);
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_MAX);
 
+	BIND_ENUM_CONSTANT(INSTANCE_CULL_STATE_VISIBLE);
+	BIND_ENUM_CONSTANT(INSTANCE_CULL_STATE_LAYER_CULLED);
+	BIND_ENUM_CONSTANT(INSTANCE_CULL_STATE_FRUSTUM_CULLED);
+	BIND_ENUM_CONSTANT(INSTANCE_CULL_STATE_VISIBILITY_RANGE_CULLED);
+	BIND_ENUM_CONSTANT(INSTANCE_CULL_STATE_OCCLUSION_CULLED);
+	BIND_ENUM_CONSTANT(INSTANCE_CULL_STATE_MAX);
+
 	BIND_ENUM_CONSTANT(SHADOW_CASTING_SETTING_OFF);
 	BIND_ENUM_CONSTANT(SHADOW_CASTING_SETTING_ON);
 	BIND_ENUM_CONSTANT(SHADOW_CASTING_SETTING_DOUBLE_SIDED);
@@ -3545,6 +3554,7 @@ void RenderingServer::init() {
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/use_zstd_compression", true);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/strip_debug", false);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/strip_debug.release", true);
+	GLOBAL_DEF("rendering/shader_compiler/shader_cache/include_in_export", false);
 
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/reflections/sky_reflections/roughness_layers", PROPERTY_HINT_RANGE, "1,32,1"), 8); // Assumes a 256x256 cubemap
 	GLOBAL_DEF_RST("rendering/reflections/sky_reflections/texture_array_reflections", true);
@@ -3627,6 +3637,7 @@ void RenderingServer::init() {
 
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/update_iterations_per_frame", PROPERTY_HINT_RANGE, "0,1024,1"), 10);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/threaded_cull_minimum_instances", PROPERTY_HINT_RANGE, "32,65536,1"), 1000);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::FLOAT, "rendering/limits/spatial_indexer/instance_cluster_cell_size", PROPERTY_HINT_RANGE, "0,1024,0.1,or_greater,suffix:m"), 32.0);
 
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "rendering/limits/cluster_builder/max_clustered_elements", PROPERTY_HINT_RANGE, "32,8192,1"), 512);
 
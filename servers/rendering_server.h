@@ -170,6 +170,11 @@ public:
 	typedef void (*TextureDetectRoughnessCallback)(void *, const String &, TextureDetectRoughnessChannel);
 	virtual void texture_set_detect_roughness_callback(RID p_texture, TextureDetectRoughnessCallback p_callback, void *p_userdata) = 0;
 
+	// Called by the canvas and scene cull every frame the texture is drawn, possibly from several threads.
+	// The scale is the on-screen size of a texel, 1.0 when it can't be known (e.g. in 3D).
+	typedef void (*TextureUsageCallback)(void *, float);
+	virtual void texture_set_usage_callback(RID p_texture, TextureUsageCallback p_callback, void *p_userdata) = 0;
+
 	struct TextureInfo {
 		RID texture;
 		uint32_t width;
@@ -1357,6 +1362,18 @@ public:
 	PackedInt64Array _instances_cull_ray_bind(const Vector3 &p_from, const Vector3 &p_to, RID p_scenario = RID()) const;
 	PackedInt64Array _instances_cull_convex_bind(const TypedArray<Plane> &p_convex, RID p_scenario = RID()) const;
 
+	enum InstanceCullState {
+		INSTANCE_CULL_STATE_VISIBLE,
+		INSTANCE_CULL_STATE_LAYER_CULLED,
+		INSTANCE_CULL_STATE_FRUSTUM_CULLED,
+		INSTANCE_CULL_STATE_VISIBILITY_RANGE_CULLED,
+		INSTANCE_CULL_STATE_OCCLUSION_CULLED,
+		INSTANCE_CULL_STATE_MAX
+	};
+
+	virtual void instances_set_cull_statistics_enabled(bool p_enabled) = 0;
+	virtual Dictionary instances_get_cull_statistics(RID p_viewport) const = 0;
+
 	enum InstanceFlags {
 		INSTANCE_FLAG_USE_BAKED_LIGHT,
 		INSTANCE_FLAG_USE_DYNAMIC_GI,
@@ -1840,6 +1857,7 @@ VARIANT_ENUM_CAST(RenderingServer::DOFBokehShape);
 VARIANT_ENUM_CAST(RenderingServer::ShadowQuality);
 VARIANT_ENUM_CAST(RenderingServer::InstanceType);
 VARIANT_ENUM_CAST(RenderingServer::InstanceFlags);
+VARIANT_ENUM_CAST(RenderingServer::InstanceCullState);
 VARIANT_ENUM_CAST(RenderingServer::ShadowCastingSetting);
 VARIANT_ENUM_CAST(RenderingServer::VisibilityRangeFadeMode);
 VARIANT_ENUM_CAST(RenderingServer::NinePatchAxisMode);
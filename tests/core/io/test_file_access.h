@@ -31,7 +31,11 @@
 #ifndef TEST_FILE_ACCESS_H
 #define TEST_FILE_ACCESS_H
 
+#include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_pack.h"
+#include "core/version.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -107,6 +111,192 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Compressed file with multiple blocks") {
+	const String path = TestUtils::get_temp_path("compressed_blocks.bin");
+	// Large enough to span many blocks and more than one read-ahead window.
+	const int size = 1024 * 1024 + 123;
+
+	Vector<uint8_t> data;
+	data.resize(size);
+	for (int i = 0; i < size; i++) {
+		data.write[i] = (i * 7 + i / 4096) & 0xFF;
+	}
+
+	{
+		Ref<FileAccess> f = FileAccess::open_compressed(path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data.ptr(), data.size());
+	}
+
+	Ref<FileAccess> f = FileAccess::open_compressed(path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)size);
+
+	Vector<uint8_t> read;
+	read.resize(size);
+	CHECK(f->get_buffer(read.ptrw(), size) == (uint64_t)size);
+	CHECK(read == data);
+	CHECK_FALSE(f->eof_reached());
+
+	// Reading past the end.
+	uint8_t extra = 0;
+	CHECK(f->get_buffer(&extra, 1) == 0);
+	CHECK(f->eof_reached());
+
+	// Random access, both inside and outside of the current read-ahead window.
+	const int offsets[] = { 5000, 700000, 4096, size - 10, 1 };
+	for (int ofs : offsets) {
+		f->seek(ofs);
+		CHECK(f->get_position() == (uint64_t)ofs);
+		CHECK(f->get_8() == data[ofs]);
+	}
+
+	f->seek(size - 3);
+	CHECK(f->get_buffer(read.ptrw(), 10) == 3);
+	CHECK(f->eof_reached());
+}
+
+TEST_CASE("[FileAccess] Compressed file with zstd dictionary") {
+	Vector<Vector<uint8_t>> samples;
+	for (int i = 0; i < 50; i++) {
+		String text = vformat("[gd_resource type=\"Resource\" format=3]\n\n[resource]\nname = \"item_%d\"\nvalue = %d\n", i, i * 3);
+		samples.push_back(text.to_utf8_buffer());
+	}
+
+	Vector<uint8_t> dictionary_data = ZstdDictionary::build(samples, 1024);
+	CHECK(dictionary_data.size() > 0);
+	CHECK(dictionary_data.size() <= 1024);
+	ZstdDictionary dictionary(dictionary_data, true);
+
+	const String path = TestUtils::get_temp_path("compressed_dictionary.bin");
+	const Vector<uint8_t> &data = samples[7];
+	{
+		Ref<FileAccess> base = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(base.is_valid());
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure("GCPD");
+		fac->set_dictionary(&dictionary);
+		REQUIRE(fac->open_for_write(base) == OK);
+		fac->store_buffer(data.ptr(), data.size());
+		fac->close();
+	}
+
+	Ref<FileAccessCompressed> fac;
+	fac.instantiate();
+	fac->configure("GCPD");
+	fac->set_dictionary(&dictionary);
+	REQUIRE(fac->open_internal(path, FileAccess::READ) == OK);
+	CHECK(fac->get_length() == (uint64_t)data.size());
+
+	Vector<uint8_t> read;
+	read.resize(data.size());
+	CHECK(fac->get_buffer(read.ptrw(), read.size()) == (uint64_t)data.size());
+	CHECK(read == data);
+}
+
+TEST_CASE("[FileAccess] Pack with zstd dictionary compressed files") {
+	Vector<Vector<uint8_t>> samples;
+	for (int i = 0; i < 50; i++) {
+		String text = vformat("[gd_resource type=\"Resource\" format=3]\n\n[resource]\nname = \"item_%d\"\nvalue = %d\n", i, i * 3);
+		samples.push_back(text.to_utf8_buffer());
+	}
+	Vector<uint8_t> dictionary_data = ZstdDictionary::build(samples, 1024);
+	REQUIRE(dictionary_data.size() > 0);
+	ZstdDictionary dictionary(dictionary_data, true);
+
+	const String paths[] = { "res://pck_dictionary_test/compressed.tres", "res://pck_dictionary_test/stored.tres" };
+	const Vector<uint8_t> contents[] = { samples[3], samples[11] };
+
+	// Same layout as EditorExportPlatform::save_pack(): the dictionary and file data follow the directory.
+	const String data_path = TestUtils::get_temp_path("pck_dictionary_data.bin");
+	uint64_t data_ofs[2];
+	{
+		Ref<FileAccess> data = FileAccess::open(data_path, FileAccess::WRITE);
+		REQUIRE(data.is_valid());
+		data->store_buffer(dictionary_data.ptr(), dictionary_data.size());
+
+		data_ofs[0] = data->get_position();
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure(PACK_COMPRESSED_FILE_MAGIC);
+		fac->set_dictionary(&dictionary);
+		REQUIRE(fac->open_for_write(data) == OK);
+		fac->store_buffer(contents[0].ptr(), contents[0].size());
+		fac->close();
+
+		data_ofs[1] = data->get_position();
+		data->store_buffer(contents[1].ptr(), contents[1].size());
+	}
+	const Vector<uint8_t> file_data = FileAccess::get_file_as_bytes(data_path);
+	REQUIRE(file_data.size() > 0);
+
+	const String pck_path = TestUtils::get_temp_path("dictionary.pck");
+	uint64_t file_base = 0;
+	{
+		Ref<FileAccess> f = FileAccess::open(pck_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_32(PACK_HEADER_MAGIC);
+		f->store_32(PACK_FORMAT_VERSION);
+		f->store_32(VERSION_MAJOR);
+		f->store_32(VERSION_MINOR);
+		f->store_32(VERSION_PATCH);
+		f->store_32(PACK_ZSTD_DICTIONARY);
+		uint64_t file_base_ofs = f->get_position();
+		f->store_64(0); // Files base.
+		f->store_64(0); // Dictionary offset.
+		f->store_32(dictionary_data.size());
+		for (int i = 0; i < 13; i++) {
+			f->store_32(0);
+		}
+
+		f->store_32(2);
+		for (int i = 0; i < 2; i++) {
+			CharString path_utf8 = paths[i].utf8();
+			int pad = (4 - path_utf8.length() % 4) % 4;
+			f->store_32(path_utf8.length() + pad);
+			f->store_buffer((const uint8_t *)path_utf8.get_data(), path_utf8.length());
+			for (int j = 0; j < pad; j++) {
+				f->store_8(0);
+			}
+			f->store_64(data_ofs[i]);
+			f->store_64(contents[i].size());
+			unsigned char md5[16];
+			CryptoCore::md5(contents[i].ptr(), contents[i].size(), md5);
+			f->store_buffer(md5, 16);
+			f->store_32(i == 0 ? PACK_FILE_COMPRESSED : 0);
+		}
+
+		file_base = f->get_position();
+		f->store_buffer(file_data.ptr(), file_data.size());
+		f->seek(file_base_ofs);
+		f->store_64(file_base);
+	}
+
+	// Open the entries through a local FileAccessPack instead of PackedData::add_pack(),
+	// so neither the paths nor the dictionary outlive this test.
+	for (int i = 0; i < 2; i++) {
+		PackedData::PackedFile pf;
+		pf.pack = pck_path;
+		pf.offset = file_base + data_ofs[i];
+		pf.size = contents[i].size();
+		CryptoCore::md5(contents[i].ptr(), contents[i].size(), pf.md5);
+		pf.encrypted = false;
+		pf.dictionary = i == 0 ? &dictionary : nullptr;
+
+		Ref<FileAccess> f = memnew(FileAccessPack(pck_path, pf));
+		REQUIRE(f->is_open());
+		CHECK(f->get_length() == (uint64_t)contents[i].size());
+		Vector<uint8_t> read;
+		read.resize(contents[i].size());
+		CHECK(f->get_buffer(read.ptrw(), read.size()) == (uint64_t)contents[i].size());
+		CHECK(read == contents[i]);
+	}
+	if (PackedData::get_singleton()) {
+		CHECK_FALSE(PackedData::get_singleton()->has_path(paths[0]));
+	}
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -0,0 +1,191 @@
+/**************************************************************************/
+/*  test_net_socket.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NET_SOCKET_H
+#define TEST_NET_SOCKET_H
+
+#include "core/io/net_socket.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNetSocket {
+
+// Socket receiving queued datagrams, recording reads that would block.
+class FakeNetSocket : public NetSocket {
+public:
+	LocalVector<Vector<uint8_t>> pending;
+	int blocking_reads = 0;
+	mutable int busy_polls = 0; // Polls reporting nothing before the pending datagrams show up.
+
+	void queue(uint8_t p_value) {
+		Vector<uint8_t> datagram;
+		datagram.push_back(p_value);
+		pending.push_back(datagram);
+	}
+
+	virtual Error open(Type p_type, IP::Type &ip_type) override { return OK; }
+	virtual void close() override {}
+	virtual Error bind(IPAddress p_addr, uint16_t p_port) override { return OK; }
+	virtual Error listen(int p_max_pending) override { return OK; }
+	virtual Error connect_to_host(IPAddress p_addr, uint16_t p_port) override { return OK; }
+	virtual Error poll(PollType p_type, int timeout) const override {
+		if (p_type == POLL_TYPE_OUT) {
+			return ERR_BUSY;
+		}
+		if (busy_polls > 0) {
+			busy_polls--;
+			return ERR_BUSY;
+		}
+		return pending.is_empty() ? ERR_BUSY : OK;
+	}
+	virtual Error recv(uint8_t *p_buffer, int p_len, int &r_read) override { return ERR_UNAVAILABLE; }
+	virtual Error recvfrom(uint8_t *p_buffer, int p_len, int &r_read, IPAddress &r_ip, uint16_t &r_port, bool p_peek = false) override {
+		if (pending.is_empty()) {
+			blocking_reads++;
+			return ERR_BUSY;
+		}
+		r_read = MIN(p_len, pending[0].size());
+		memcpy(p_buffer, pending[0].ptr(), r_read);
+		r_ip = IPAddress("127.0.0.1");
+		r_port = 4242;
+		pending.remove_at(0);
+		return OK;
+	}
+	virtual Error send(const uint8_t *p_buffer, int p_len, int &r_sent) override { return ERR_UNAVAILABLE; }
+	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IPAddress p_ip, uint16_t p_port) override { return ERR_UNAVAILABLE; }
+	virtual Ref<NetSocket> accept(IPAddress &r_ip, uint16_t &r_port) override { return Ref<NetSocket>(); }
+
+	virtual bool is_open() const override { return true; }
+	virtual int get_available_bytes() const override { return pending.is_empty() ? 0 : pending[0].size(); }
+	virtual Error get_socket_address(IPAddress *r_ip, uint16_t *r_port) const override { return OK; }
+
+	virtual Error set_broadcasting_enabled(bool p_enabled) override { return OK; }
+	virtual void set_blocking_enabled(bool p_enabled) override {}
+	virtual void set_ipv6_only_enabled(bool p_enabled) override {}
+	virtual void set_tcp_no_delay_enabled(bool p_enabled) override {}
+	virtual void set_reuse_address_enabled(bool p_enabled) override {}
+	virtual Error join_multicast_group(const IPAddress &p_multi_address, const String &p_if_name) override { return OK; }
+	virtual Error leave_multicast_group(const IPAddress &p_multi_address, const String &p_if_name) override { return OK; }
+};
+
+TEST_CASE("[NetSocket] Batched receive falls back to one read per datagram") {
+	Ref<FakeNetSocket> socket;
+	socket.instantiate();
+	uint8_t buffers[4][16];
+	NetSocket::Datagram datagrams[4];
+	for (int i = 0; i < 4; i++) {
+		datagrams[i].buffer = buffers[i];
+		datagrams[i].size = 16;
+	}
+	int received = 0;
+
+	SUBCASE("Stops once nothing else is pending") {
+		socket->queue(1);
+		socket->queue(2);
+		CHECK(socket->recvfrom_batch(datagrams, 4, received) == OK);
+		CHECK(received == 2);
+		CHECK(socket->blocking_reads == 0);
+		CHECK(datagrams[0].transferred == 1);
+		CHECK(buffers[0][0] == 1);
+		CHECK(buffers[1][0] == 2);
+		CHECK(datagrams[1].ip == IPAddress("127.0.0.1"));
+		CHECK(datagrams[1].port == 4242);
+	}
+
+	SUBCASE("Stops when the batch is full") {
+		for (int i = 0; i < 6; i++) {
+			socket->queue(i);
+		}
+		CHECK(socket->recvfrom_batch(datagrams, 4, received) == OK);
+		CHECK(received == 4);
+		CHECK(socket->pending.size() == 2);
+	}
+
+	SUBCASE("Reports the read error when nothing was received") {
+		CHECK(socket->recvfrom_batch(datagrams, 4, received) == ERR_BUSY);
+		CHECK(received == 0);
+		CHECK(socket->blocking_reads == 1);
+	}
+}
+
+TEST_CASE("[NetSocketPoller] Polling sockets one by one") {
+	Ref<NetSocketPoller> poller;
+	poller.instantiate();
+	Ref<FakeNetSocket> idle;
+	idle.instantiate();
+	Ref<FakeNetSocket> active;
+	active.instantiate();
+	REQUIRE(poller->add(idle, 1) == OK);
+	REQUIRE(poller->add(active, 2) == OK);
+	CHECK(poller->get_socket_count() == 2);
+	LocalVector<NetSocketPoller::Event> events;
+
+	SUBCASE("Only readable sockets are reported") {
+		active->queue(1);
+		CHECK(poller->wait(events, 0) == OK);
+		REQUIRE(events.size() == 1);
+		CHECK(events[0].id == 2);
+		CHECK(events[0].readable);
+		CHECK_FALSE(events[0].writable);
+		CHECK_FALSE(events[0].error);
+	}
+
+	SUBCASE("Waiting times out when nothing is ready") {
+		const uint64_t start = OS::get_singleton()->get_ticks_msec();
+		CHECK(poller->wait(events, 20) == OK);
+		CHECK(events.is_empty());
+		CHECK(OS::get_singleton()->get_ticks_msec() - start >= 20);
+	}
+
+	SUBCASE("A negative timeout waits for a socket to be ready") {
+		active->queue(1);
+		active->busy_polls = 5;
+		CHECK(poller->wait(events, -1) == OK);
+		REQUIRE(events.size() == 1);
+		CHECK(events[0].id == 2);
+		CHECK(active->busy_polls == 0);
+	}
+
+	SUBCASE("Removed sockets are not reported") {
+		active->queue(1);
+		poller->remove(2);
+		CHECK_FALSE(poller->has(2));
+		CHECK(poller->wait(events, 0) == OK);
+		CHECK(events.is_empty());
+		ERR_PRINT_OFF;
+		CHECK(poller->modify(2, NetSocket::POLL_TYPE_IN_OUT) == ERR_DOES_NOT_EXIST);
+		ERR_PRINT_ON;
+	}
+}
+
+} // namespace TestNetSocket
+
+#endif // TEST_NET_SOCKET_H
@@ -40,6 +40,15 @@
 
 #include "tests/test_macros.h"
 
+class _TestCountedResource : public Resource {
+	GDCLASS(_TestCountedResource, Resource);
+
+public:
+	inline static int instance_count = 0;
+
+	_TestCountedResource() { instance_count++; }
+};
+
 namespace TestResource {
 
 TEST_CASE("[Resource] Duplication") {
@@ -166,6 +175,57 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Loading a single sub-resource") {
+	GDREGISTER_CLASS(_TestCountedResource);
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Main");
+	Ref<Resource> child_a = memnew(_TestCountedResource);
+	child_a->set_name("A");
+	child_a->set_scene_unique_id("child_a");
+	Ref<Resource> child_b = memnew(_TestCountedResource);
+	child_b->set_name("B");
+	child_b->set_scene_unique_id("child_b");
+	Ref<Resource> child_c = memnew(_TestCountedResource);
+	child_c->set_name("C");
+	child_c->set_scene_unique_id("child_c");
+	child_b->set_meta("next", child_c);
+	resource->set_meta("a", child_a);
+	resource->set_meta("b", child_b);
+
+	const String save_path_binary = TestUtils::get_temp_path("resource.res");
+	ResourceSaver::save(resource, save_path_binary);
+
+	_TestCountedResource::instance_count = 0;
+	const Ref<Resource> &loaded_child_b = ResourceLoader::load(save_path_binary + "::child_b", "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded_child_b.is_valid());
+	CHECK_MESSAGE(
+			loaded_child_b->get_name() == "B",
+			"The loaded sub-resource name should be equal to the expected value.");
+	const Ref<Resource> &loaded_child_c = loaded_child_b->get_meta("next");
+	REQUIRE(loaded_child_c.is_valid());
+	CHECK_MESSAGE(
+			loaded_child_c->get_name() == "C",
+			"Resources referenced by the sub-resource should be loaded on demand.");
+	CHECK_MESSAGE(
+			_TestCountedResource::instance_count == 2,
+			"Sub-resources that the requested one doesn't reference should never be decoded.");
+
+	_TestCountedResource::instance_count = 0;
+	const Ref<Resource> &loaded_resource = ResourceLoader::load(save_path_binary, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK_MESSAGE(
+			_TestCountedResource::instance_count == 3,
+			"A full load should decode every sub-resource.");
+
+	ERR_PRINT_OFF;
+	const Ref<Resource> &missing_child = ResourceLoader::load(save_path_binary + "::missing", "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(
+			missing_child.is_null(),
+			"Loading a sub-resource that doesn't exist should fail.");
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
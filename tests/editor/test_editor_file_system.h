@@ -0,0 +1,101 @@
+/**************************************************************************/
+/*  test_editor_file_system.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_EDITOR_FILE_SYSTEM_H
+#define TEST_EDITOR_FILE_SYSTEM_H
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "editor/editor_file_system.h"
+#include "editor/import/resource_importer_wav.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestEditorFileSystem {
+
+static String write_import_cache_source(const String &p_name, const String &p_contents) {
+	String path = TestUtils::get_temp_path(p_name);
+	DirAccess::make_dir_recursive_absolute(path.get_base_dir());
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	f->store_string(p_contents);
+	return path;
+}
+
+TEST_CASE("[EditorFileSystem] Import cache key") {
+	Ref<ResourceImporterWAV> importer;
+	importer.instantiate();
+
+	List<ResourceImporter::ImportOption> options;
+	options.push_back(ResourceImporter::ImportOption(PropertyInfo(Variant::BOOL, "force/mono"), false));
+	HashMap<StringName, Variant> params;
+	params["force/mono"] = false;
+
+	const String source_path = write_import_cache_source("import_cache/source.wav", "RIFF source contents");
+	const String key = EditorFileSystem::get_import_cache_key(source_path, importer, options, params);
+	REQUIRE_FALSE(key.is_empty());
+
+	SUBCASE("Keys are stable") {
+		CHECK(EditorFileSystem::get_import_cache_key(source_path, importer, options, params) == key);
+	}
+
+	SUBCASE("Keys don't depend on the source path") {
+		const String moved_path = write_import_cache_source("import_cache/moved/renamed.wav", "RIFF source contents");
+		CHECK(EditorFileSystem::get_import_cache_key(moved_path, importer, options, params) == key);
+	}
+
+	SUBCASE("Source contents invalidate the key") {
+		const String other_path = write_import_cache_source("import_cache/other.wav", "RIFF other contents");
+		CHECK(EditorFileSystem::get_import_cache_key(other_path, importer, options, params) != key);
+	}
+
+	SUBCASE("Import options invalidate the key") {
+		params["force/mono"] = true;
+		CHECK(EditorFileSystem::get_import_cache_key(source_path, importer, options, params) != key);
+	}
+
+	SUBCASE("Lossless compression project settings invalidate the key") {
+		const String setting = "rendering/textures/lossless_compression/force_png";
+		const Variant old_value = ProjectSettings::get_singleton()->get_setting(setting);
+		ProjectSettings::get_singleton()->set_setting(setting, !bool(old_value));
+		CHECK(EditorFileSystem::get_import_cache_key(source_path, importer, options, params) != key);
+		ProjectSettings::get_singleton()->set_setting(setting, old_value);
+		CHECK(EditorFileSystem::get_import_cache_key(source_path, importer, options, params) == key);
+	}
+
+	SUBCASE("Missing source files have no key") {
+		CHECK(EditorFileSystem::get_import_cache_key(TestUtils::get_temp_path("import_cache/missing.wav"), importer, options, params).is_empty());
+	}
+}
+
+} // namespace TestEditorFileSystem
+
+#endif // TEST_EDITOR_FILE_SYSTEM_H
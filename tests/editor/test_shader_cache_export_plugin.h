@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*  test_shader_cache_export_plugin.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_CACHE_EXPORT_PLUGIN_H
+#define TEST_SHADER_CACHE_EXPORT_PLUGIN_H
+
+#include "editor/plugins/shader_cache_export_plugin.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/resources/3d/primitive_meshes.h"
+#include "scene/resources/material.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderCacheExportPlugin {
+
+TEST_CASE("[SceneTree][ShaderCacheExportPlugin] Shaders of the exported materials") {
+	Ref<StandardMaterial3D> surface_material;
+	surface_material.instantiate();
+	Ref<StandardMaterial3D> next_pass;
+	next_pass.instantiate();
+	next_pass->set_transparency(BaseMaterial3D::TRANSPARENCY_ALPHA);
+	surface_material->set_next_pass(next_pass);
+
+	Ref<Shader> shader;
+	shader.instantiate();
+	shader->set_code("shader_type spatial;");
+	Ref<ShaderMaterial> override_material;
+	override_material.instantiate();
+	override_material->set_shader(shader);
+
+	// Same parameters as the surface material, so it shares its shader.
+	Ref<StandardMaterial3D> shared_material;
+	shared_material.instantiate();
+
+	Ref<StandardMaterial3D> unused_material;
+	unused_material.instantiate();
+	unused_material->set_shading_mode(BaseMaterial3D::SHADING_MODE_UNSHADED);
+
+	Ref<BoxMesh> mesh;
+	mesh.instantiate();
+	mesh->set_material(surface_material);
+
+	const RID surface_shader = surface_material->get_shader_rid();
+	const RID next_pass_shader = next_pass->get_shader_rid();
+	REQUIRE(surface_shader.is_valid());
+	REQUIRE(next_pass_shader.is_valid());
+	REQUIRE(surface_shader != next_pass_shader);
+	REQUIRE(shared_material->get_shader_rid() == surface_shader);
+	REQUIRE(unused_material->get_shader_rid() != surface_shader);
+
+	SUBCASE("Materials") {
+		HashSet<RID> shaders;
+		ShaderCacheExportPlugin::get_resource_shaders(surface_material, shaders);
+		CHECK(shaders.size() == 2);
+		CHECK(shaders.has(surface_shader));
+		CHECK_MESSAGE(shaders.has(next_pass_shader), "Next passes should be followed.");
+
+		shaders.clear();
+		ShaderCacheExportPlugin::get_resource_shaders(override_material, shaders);
+		CHECK(shaders.size() == 1);
+		CHECK(shaders.has(shader->get_rid()));
+	}
+
+	SUBCASE("Meshes") {
+		HashSet<RID> shaders;
+		ShaderCacheExportPlugin::get_resource_shaders(mesh, shaders);
+		CHECK(shaders.size() == 2);
+		CHECK(shaders.has(surface_shader));
+		CHECK(shaders.has(next_pass_shader));
+	}
+
+	SUBCASE("Packed scenes") {
+		MeshInstance3D *mesh_instance = memnew(MeshInstance3D);
+		mesh_instance->set_mesh(mesh);
+		mesh_instance->set_material_override(override_material);
+		mesh_instance->set_surface_override_material(0, shared_material);
+		Ref<PackedScene> scene;
+		scene.instantiate();
+		REQUIRE(scene->pack(mesh_instance) == OK);
+		memdelete(mesh_instance);
+
+		HashSet<RID> shaders;
+		ShaderCacheExportPlugin::get_resource_shaders(scene, shaders);
+		CHECK_MESSAGE(shaders.size() == 3, "Shared shaders should only be listed once.");
+		CHECK(shaders.has(surface_shader));
+		CHECK(shaders.has(next_pass_shader));
+		CHECK(shaders.has(shader->get_rid()));
+		CHECK_FALSE_MESSAGE(shaders.has(unused_material->get_shader_rid()), "Materials the scene doesn't use should not be listed.");
+	}
+}
+
+} // namespace TestShaderCacheExportPlugin
+
+#endif // TEST_SHADER_CACHE_EXPORT_PLUGIN_H
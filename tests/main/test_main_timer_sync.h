@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*  test_main_timer_sync.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MAIN_TIMER_SYNC_H
+#define TEST_MAIN_TIMER_SYNC_H
+
+#include "main/main_timer_sync.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMainTimerSync {
+
+TEST_CASE("[ServerTickSync] Ticks are scheduled at a fixed rate") {
+	ServerTickSync sync;
+	const uint64_t tick = 10000;
+	uint64_t now = 1000000;
+
+	// Ticks that finish early wait for the next one.
+	CHECK(sync.schedule_next_tick(now, tick, 8) == now + tick);
+	now += tick + 300; // Slept a bit too long.
+	CHECK(sync.schedule_next_tick(now, tick, 8) == 1000000 + 2 * tick);
+	CHECK(sync.get_overruns() == 0);
+
+	SUBCASE("Late ticks run right away and catch up") {
+		now = 1000000 + 5 * tick - 100;
+		CHECK(sync.schedule_next_tick(now, tick, 8) == now);
+		CHECK(sync.schedule_next_tick(now, tick, 8) == now);
+		CHECK(sync.get_overruns() == 2);
+		// Back on schedule.
+		CHECK(sync.schedule_next_tick(now, tick, 8) == 1000000 + 5 * tick);
+		CHECK(sync.get_overruns() == 2);
+	}
+
+	SUBCASE("The schedule restarts when too far behind") {
+		now = 1000000 + 20 * tick;
+		CHECK(sync.schedule_next_tick(now, tick, 8) == now);
+		CHECK(sync.get_overruns() == 1);
+		CHECK(sync.schedule_next_tick(now, tick, 8) == now + tick);
+	}
+}
+
+TEST_CASE("[ServerTickSync] Waiting for the next tick") {
+	ServerTickSync sync;
+	const uint64_t now = 1000000;
+
+	// Without a spin window, the whole wait is slept.
+	CHECK(sync.get_sleep_usec(now, now + 5000) == 5000);
+	CHECK(sync.get_sleep_usec(now, now) == 0);
+
+	// The spin window is taken from the end of the wait.
+	sync.set_spin_usec(1000);
+	CHECK(sync.get_sleep_usec(now, now + 5000) == 4000);
+	CHECK(sync.get_sleep_usec(now, now + 1000) == 0);
+	CHECK(sync.get_sleep_usec(now, now + 500) == 0);
+}
+
+TEST_CASE("[ServerTickSync] Tick time statistics") {
+	ServerTickSync sync;
+	for (int i = 0; i < 98; i++) {
+		sync.add_tick_time(120); // Third bucket.
+	}
+	sync.add_tick_time(1010);
+	sync.add_tick_time(200000); // Past the last bucket.
+
+	CHECK(sync.get_tick_count() == 100);
+	CHECK(sync.get_tick_time_percentile(0.5) == doctest::Approx(150e-6));
+	CHECK(sync.get_tick_time_percentile(0.99) == doctest::Approx(1050e-6));
+	CHECK(sync.get_tick_time_percentile(1.0) == doctest::Approx(0.2));
+	CHECK(sync.get_max_tick_time() == doctest::Approx(0.2));
+
+	sync.clear_stats();
+	CHECK(sync.get_tick_count() == 0);
+	CHECK(sync.get_overruns() == 0);
+	CHECK(sync.get_max_tick_time() == 0);
+}
+
+} // namespace TestMainTimerSync
+
+#endif // TEST_MAIN_TIMER_SYNC_H
@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  test_compressed_texture.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPRESSED_TEXTURE_H
+#define TEST_COMPRESSED_TEXTURE_H
+
+#include "core/io/file_access.h"
+#include "core/io/image.h"
+#include "scene/resources/compressed_texture.h"
+#include "scene/resources/texture_streaming.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestCompressedTexture {
+
+static void save_streamed_ctex(const Ref<Image> &p_image, const String &p_path, int p_mipmap_limit = -1) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_8('G');
+	f->store_8('S');
+	f->store_8('T');
+	f->store_8('2');
+	f->store_32(CompressedTexture2D::FORMAT_VERSION);
+	f->store_32(p_image->get_width());
+	f->store_32(p_image->get_height());
+	f->store_32(CompressedTexture2D::FORMAT_BIT_STREAM | CompressedTexture2D::FORMAT_BIT_HAS_MIPMAPS);
+	f->store_32(p_mipmap_limit);
+	f->store_32(0);
+	f->store_32(0);
+	f->store_32(0);
+
+	f->store_32(CompressedTexture2D::DATA_FORMAT_IMAGE);
+	f->store_16(p_image->get_width());
+	f->store_16(p_image->get_height());
+	f->store_32(p_image->get_mipmap_count());
+	f->store_32(p_image->get_format());
+	Vector<uint8_t> data = p_image->get_data();
+	f->store_buffer(data.ptr(), data.size());
+}
+
+// [SceneTree] in a test case name enables initializing a mock render server,
+// which CompressedTexture2D is dependent on.
+TEST_CASE("[SceneTree][CompressedTexture2D] Texture streaming") {
+	TextureStreaming *streaming = TextureStreaming::get_singleton();
+	REQUIRE(streaming);
+	REQUIRE(streaming->get_min_resident_size() == 128);
+
+	Ref<Image> image = Image::create_empty(512, 256, true, Image::FORMAT_RGBA8);
+	image->fill(Color(1, 0, 0));
+	const String path = TestUtils::get_temp_path("streamed.ctex");
+	save_streamed_ctex(image, path);
+
+	const uint64_t initial_size = streaming->get_resident_size();
+
+	Ref<CompressedTexture2D> texture;
+	texture.instantiate();
+	REQUIRE(texture->load(path) == OK);
+	CHECK(texture->is_streamed());
+	CHECK(texture->get_width() == 512);
+	CHECK(texture->get_height() == 256);
+	CHECK_MESSAGE(
+			texture->get_image()->get_width() == 128,
+			"Only mipmaps up to the minimum resident size should be loaded.");
+	CHECK(streaming->get_resident_size() - initial_size == uint64_t(image->get_data().size() - Image::get_image_mipmap_offset(512, 256, Image::FORMAT_RGBA8, 2)));
+
+	SUBCASE("Requested mipmaps are streamed in") {
+		texture->request_streaming_size(200);
+		streaming->update();
+		CHECK(texture->get_image()->get_width() == 256);
+
+		texture->request_streaming_size(300);
+		streaming->update();
+		CHECK(texture->get_image()->get_width() == 512);
+		CHECK(texture->get_image()->has_mipmaps());
+		CHECK(streaming->get_resident_size() - initial_size == uint64_t(image->get_data().size()));
+	}
+
+	SUBCASE("Mipmaps are evicted when over the memory budget") {
+		texture->request_streaming_size(512);
+		streaming->update();
+		REQUIRE(texture->get_image()->get_width() == 512);
+
+		const uint64_t memory_budget = streaming->get_memory_budget();
+		streaming->set_memory_budget(0);
+		streaming->update();
+		CHECK_MESSAGE(
+				texture->get_image()->get_width() == 512,
+				"Recently used textures should not be evicted.");
+
+		for (int i = 0; i < TextureStreaming::EVICTION_DELAY_FRAMES; i++) {
+			streaming->update();
+		}
+		CHECK(texture->get_image()->get_width() == 128);
+		CHECK(streaming->get_resident_size() - initial_size == uint64_t(image->get_data().size() - Image::get_image_mipmap_offset(512, 256, Image::FORMAT_RGBA8, 2)));
+
+		streaming->set_memory_budget(memory_budget);
+	}
+
+	SUBCASE("Textures drawn every frame stay resident") {
+		// What the canvas and scene cull do for every frame the texture is drawn in.
+		REQUIRE(RSG::texture_storage->texture_has_usage_callback(texture->get_rid()));
+		RSG::texture_storage->texture_report_usage(texture->get_rid(), 1.0);
+		streaming->update();
+		REQUIRE(texture->get_image()->get_width() == 512);
+
+		const uint64_t memory_budget = streaming->get_memory_budget();
+		streaming->set_memory_budget(0);
+		for (int i = 0; i < TextureStreaming::EVICTION_DELAY_FRAMES * 2; i++) {
+			RSG::texture_storage->texture_report_usage(texture->get_rid(), 1.0);
+			streaming->update();
+		}
+		CHECK_MESSAGE(
+				texture->get_image()->get_width() == 512,
+				"Textures that are still drawn should not be evicted.");
+
+		for (int i = 0; i < TextureStreaming::EVICTION_DELAY_FRAMES; i++) {
+			streaming->update();
+		}
+		CHECK_MESSAGE(
+				texture->get_image()->get_width() == 128,
+				"Textures that are no longer drawn should be evicted.");
+
+		streaming->set_memory_budget(memory_budget);
+	}
+
+	const RID rid = texture->get_rid();
+	texture.unref();
+	CHECK_FALSE(RSG::texture_storage->texture_has_usage_callback(rid));
+	CHECK(streaming->get_resident_size() == initial_size);
+}
+
+TEST_CASE("[SceneTree][CompressedTexture2D] Texture streaming respects the mipmap limit") {
+	Ref<Image> image = Image::create_empty(512, 256, true, Image::FORMAT_RGBA8);
+	image->fill(Color(0, 1, 0));
+	const String path = TestUtils::get_temp_path("streamed_limit.ctex");
+	save_streamed_ctex(image, path, 1);
+
+	Ref<CompressedTexture2D> texture;
+	texture.instantiate();
+	REQUIRE(texture->load(path) == OK);
+	CHECK(texture->is_streamed());
+	CHECK_MESSAGE(
+			texture->get_image()->get_width() == 256,
+			"The resident mipmap should not be past the mipmap limit.");
+}
+
+} // namespace TestCompressedTexture
+
+#endif // TEST_COMPRESSED_TEXTURE_H
@@ -0,0 +1,214 @@
+/**************************************************************************/
+/*  test_canvas_instance_cache.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CANVAS_INSTANCE_CACHE_H
+#define TEST_CANVAS_INSTANCE_CACHE_H
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/renderer_canvas_render.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCanvasInstanceCache {
+
+struct TestRecord {
+	float value[4];
+};
+
+static LocalVector<uint8_t> make_key(uint32_t p_value) {
+	LocalVector<uint8_t> key;
+	key.resize(sizeof(uint32_t));
+	memcpy(key.ptr(), &p_value, sizeof(uint32_t));
+	return key;
+}
+
+TEST_CASE("[CanvasInstanceCache] Item version tracks command changes") {
+	RendererCanvasRender::Item item;
+	uint64_t version = item.version;
+
+	RendererCanvasRender::Item::CommandRect *rect = item.alloc_command<RendererCanvasRender::Item::CommandRect>();
+	rect->rect = Rect2(0, 0, 16, 16);
+	CHECK_MESSAGE(item.version != version, "Adding a command should change the item version.");
+	version = item.version;
+
+	item.alloc_command<RendererCanvasRender::Item::CommandRect>();
+	CHECK_MESSAGE(item.version != version, "Adding a command to a block should change the item version.");
+	version = item.version;
+
+	item.get_rect();
+	CHECK_MESSAGE(item.version == version, "Querying the item should not change its version.");
+
+	item.clear();
+	CHECK_MESSAGE(item.version != version, "Clearing the commands should change the item version.");
+}
+
+TEST_CASE("[CanvasInstanceCache] Records are only valid for their version and key") {
+	RendererCanvasRender::Item item;
+	item.alloc_command<RendererCanvasRender::Item::CommandRect>();
+	item.instance_cache = memnew(RendererCanvasRender::Item::InstanceCache);
+
+	const TestRecord records[3] = { { { 1, 2, 3, 4 } }, { { 5, 6, 7, 8 } }, { { 9, 10, 11, 12 } } };
+	item.instance_cache->store(item.version, make_key(42), records, 3);
+
+	CHECK(item.instance_cache->matches(item.version, make_key(42)));
+	CHECK_FALSE_MESSAGE(item.instance_cache->matches(item.version, make_key(43)), "A different renderer state should not match.");
+
+	REQUIRE(item.instance_cache->get_record_count<TestRecord>() == 3);
+	const TestRecord *cached = item.instance_cache->get_records<TestRecord>();
+	CHECK(cached[0].value[0] == 1);
+	CHECK(cached[1].value[1] == 6);
+	CHECK(cached[2].value[3] == 12);
+
+	item.alloc_command<RendererCanvasRender::Item::CommandRect>();
+	CHECK_FALSE_MESSAGE(item.instance_cache->matches(item.version, make_key(42)), "Changing the commands should invalidate the records.");
+
+	LocalVector<uint8_t> longer_key = make_key(42);
+	longer_key.push_back(0);
+	item.instance_cache->store(item.version, make_key(42), records, 1);
+	CHECK_FALSE_MESSAGE(item.instance_cache->matches(item.version, longer_key), "A key with extra data should not match.");
+	CHECK(item.instance_cache->get_record_count<TestRecord>() == 1);
+}
+
+typedef RendererCanvasRender::Item::InstanceCache InstanceCache;
+
+// Texture state as a renderer would report it.
+struct TestTextures {
+	static const uint32_t FLAG_NORMAL_MAP = 1;
+
+	HashMap<RID, Size2i> sizes;
+	HashSet<RID> normal_maps;
+
+	static void get_state(void *p_userdata, RID p_texture, InstanceCache::TextureState &r_state) {
+		const TestTextures *textures = static_cast<const TestTextures *>(p_userdata);
+		Size2i size = textures->sizes.has(p_texture) ? textures->sizes[p_texture] : Size2i(1, 1);
+		r_state.texpixel_size[0] = 1.0 / size.x;
+		r_state.texpixel_size[1] = 1.0 / size.y;
+		r_state.flags = textures->normal_maps.has(p_texture) ? FLAG_NORMAL_MAP : 0;
+		r_state.specular_shininess = 0;
+	}
+};
+
+static bool build_key(const RendererCanvasRender::Item *p_item, uint32_t p_state, TestTextures &p_textures, LocalVector<uint8_t> &r_key, const Point2 &p_offset = Point2()) {
+	return InstanceCache::build_key(p_item, p_offset, &p_state, sizeof(uint32_t), TestTextures::get_state, &p_textures, r_key);
+}
+
+TEST_CASE("[CanvasInstanceCache] Keys cover the renderer state and the texture state") {
+	const RID texture_a = RID::from_uint64(1);
+	const RID texture_b = RID::from_uint64(2);
+	TestTextures textures;
+	textures.sizes[texture_a] = Size2i(64, 32);
+	textures.sizes[texture_b] = Size2i(16, 16);
+
+	RendererCanvasRender::Item item;
+	item.alloc_command<RendererCanvasRender::Item::CommandRect>()->texture = texture_a;
+	item.alloc_command<RendererCanvasRender::Item::CommandRect>()->texture = texture_a;
+	item.alloc_command<RendererCanvasRender::Item::CommandTransform>();
+	item.alloc_command<RendererCanvasRender::Item::CommandNinePatch>()->texture = texture_b;
+	item.instance_cache = memnew(InstanceCache);
+
+	LocalVector<uint8_t> key;
+	REQUIRE(build_key(&item, 42, textures, key));
+	CHECK_MESSAGE(key.size() == sizeof(uint32_t) + 2 * sizeof(InstanceCache::TextureState), "The key should hold the state and one entry per texture change.");
+
+	const TestRecord records[3] = { { { 1, 2, 3, 4 } }, { { 5, 6, 7, 8 } }, { { 9, 10, 11, 12 } } };
+	item.instance_cache->store(item.version, key, records, 3);
+	CHECK(item.instance_cache->get_texture_state(sizeof(uint32_t), 0).texture == texture_a);
+	CHECK(item.instance_cache->get_texture_state(sizeof(uint32_t), 1).texture == texture_b);
+
+	REQUIRE(build_key(&item, 42, textures, key));
+	CHECK_MESSAGE(item.instance_cache->matches(item.version, key), "The same state should build the same key.");
+
+	REQUIRE(build_key(&item, 43, textures, key));
+	CHECK_FALSE_MESSAGE(item.instance_cache->matches(item.version, key), "A different renderer state should not match.");
+
+	textures.sizes[texture_a] = Size2i(128, 32);
+	REQUIRE(build_key(&item, 42, textures, key));
+	CHECK_FALSE_MESSAGE(item.instance_cache->matches(item.version, key), "Resizing a texture should invalidate the records.");
+	item.instance_cache->store(item.version, key, records, 3);
+
+	textures.normal_maps.insert(texture_b);
+	REQUIRE(build_key(&item, 42, textures, key));
+	CHECK_FALSE_MESSAGE(item.instance_cache->matches(item.version, key), "Adding a normal map should invalidate the records.");
+	item.instance_cache->store(item.version, key, records, 3);
+	CHECK(item.instance_cache->get_texture_state(sizeof(uint32_t), 0).flags == 0);
+	CHECK_MESSAGE(item.instance_cache->get_texture_state(sizeof(uint32_t), 1).flags == TestTextures::FLAG_NORMAL_MAP, "The texture flags should be available when replaying.");
+}
+
+TEST_CASE("[CanvasInstanceCache] Repeated items and unsupported commands are not cached") {
+	TestTextures textures;
+	RendererCanvasRender::Item item;
+	item.alloc_command<RendererCanvasRender::Item::CommandRect>();
+
+	LocalVector<uint8_t> key;
+	CHECK(build_key(&item, 42, textures, key));
+	CHECK_FALSE_MESSAGE(build_key(&item, 42, textures, key, Point2(16, 0)), "An item drawn with a repeat offset should not be cached.");
+
+	item.alloc_command<RendererCanvasRender::Item::CommandPrimitive>();
+	CHECK_FALSE_MESSAGE(build_key(&item, 42, textures, key), "An item with commands other than rects and nine-patches should not be cached.");
+}
+
+TEST_CASE("[SceneTree][CanvasInstanceCache] Changes through the server invalidate cached records") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID item_rid = rs->canvas_item_create();
+	rs->canvas_item_add_rect(item_rid, Rect2(0, 0, 16, 16), Color(1, 1, 1));
+	rs->canvas_item_add_rect(item_rid, Rect2(16, 0, 8, 8), Color(1, 0, 0));
+	const RendererCanvasRender::Item *item = RSG::canvas->canvas_item_owner.get_or_null(item_rid);
+	REQUIRE(item != nullptr);
+
+	TestTextures textures;
+	LocalVector<uint8_t> key;
+	REQUIRE(build_key(item, 42, textures, key));
+	const TestRecord records[2] = { { { 1, 2, 3, 4 } }, { { 5, 6, 7, 8 } } };
+	item->instance_cache = memnew(InstanceCache);
+	item->instance_cache->store(item->version, key, records, 2);
+
+	// Item state outside of the commands is covered by the renderer state in the key, not by the version.
+	rs->canvas_item_set_transform(item_rid, Transform2D(0, Vector2(5, 5)));
+	rs->canvas_item_set_modulate(item_rid, Color(1, 1, 1, 0.5));
+	CHECK_MESSAGE(item->instance_cache->matches(item->version, key), "Changing the item transform or modulate should not change its version.");
+
+	rs->canvas_item_add_rect(item_rid, Rect2(0, 16, 4, 4), Color(0, 1, 0));
+	REQUIRE(build_key(item, 42, textures, key));
+	CHECK_FALSE_MESSAGE(item->instance_cache->matches(item->version, key), "Adding a command through the server should invalidate the records.");
+	item->instance_cache->store(item->version, key, records, 2);
+
+	rs->canvas_item_clear(item_rid);
+	REQUIRE(build_key(item, 42, textures, key));
+	CHECK_FALSE_MESSAGE(item->instance_cache->matches(item->version, key), "Clearing the item through the server should invalidate the records.");
+
+	rs->free(item_rid);
+}
+
+} // namespace TestCanvasInstanceCache
+
+#endif // TEST_CANVAS_INSTANCE_CACHE_H
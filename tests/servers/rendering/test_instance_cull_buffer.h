@@ -0,0 +1,227 @@
+/**************************************************************************/
+/*  test_instance_cull_buffer.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_INSTANCE_CULL_BUFFER_H
+#define TEST_INSTANCE_CULL_BUFFER_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/rendering/instance_cull_buffer.h"
+#include "servers/rendering/renderer_scene_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestInstanceCullBuffer {
+
+// Axis aligned box [-10, 10] as outward facing planes.
+static void make_box_planes(Plane r_planes[6]) {
+	r_planes[0] = Plane(Vector3(1, 0, 0), 10);
+	r_planes[1] = Plane(Vector3(-1, 0, 0), 10);
+	r_planes[2] = Plane(Vector3(0, 1, 0), 10);
+	r_planes[3] = Plane(Vector3(0, -1, 0), 10);
+	r_planes[4] = Plane(Vector3(0, 0, 1), 10);
+	r_planes[5] = Plane(Vector3(0, 0, -1), 10);
+}
+
+TEST_CASE("[InstanceCullBuffer] Frustum and layer tests") {
+	InstanceCullBuffer buffer;
+	buffer.push_back(AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)), 1); // Inside.
+	buffer.push_back(AABB(Vector3(20, 0, 0), Vector3(1, 1, 1)), 1); // Outside.
+	buffer.push_back(AABB(Vector3(9, 9, 9), Vector3(4, 4, 4)), 1); // Straddling a corner.
+	buffer.push_back(AABB(Vector3(0, 0, 0), Vector3(1, 1, 1)), 2); // Inside, other layer.
+	buffer.push_back(AABB(Vector3(10, 0, 0), Vector3(1, 1, 1)), 1); // Touching a plane from outside.
+	CHECK(buffer.size() == 5);
+
+	Plane planes[6];
+	make_box_planes(planes);
+
+	uint8_t visible[5];
+	buffer.cull(planes, 6, 1, 0, 5, visible);
+	CHECK(visible[0] == 1);
+	CHECK(visible[1] == 0);
+	CHECK(visible[2] == 1);
+	CHECK_MESSAGE(visible[3] == 0, "Instances on other layers should be rejected.");
+	CHECK_MESSAGE(visible[4] == 0, "Instances touching a plane from the outside should be rejected, like InstanceBounds::in_frustum.");
+
+	buffer.cull(planes, 6, 3, 0, 5, visible);
+	CHECK(visible[3] == 1);
+
+	buffer.cull(planes, 6, 1, 1, 3, visible);
+	CHECK_MESSAGE(visible[0] == 0, "Results should be written relative to the start of the range.");
+	CHECK(visible[1] == 1);
+}
+
+TEST_CASE("[InstanceCullBuffer] Only pending instances are tested") {
+	InstanceCullBuffer buffer;
+	for (uint32_t i = 0; i < 6; i++) {
+		buffer.push_back(AABB(Vector3(0, 0, 0), Vector3(1, 1, 1)), 1); // Inside.
+	}
+
+	Plane planes[6];
+	make_box_planes(planes);
+
+	// The first four are decided up front and must be skipped, even though they are all inside.
+	uint8_t visible[6] = { 0, 0, 0, 0, InstanceCullBuffer::CULL_PENDING, 0 };
+	buffer.cull_pending(planes, 6, 1, 0, 6, visible);
+	CHECK(visible[0] == 0);
+	CHECK(visible[3] == 0);
+	CHECK_MESSAGE(visible[4] == 1, "Pending instances should be tested.");
+	CHECK_MESSAGE(visible[5] == 0, "Decided instances in the tail should be left as they are.");
+
+	uint8_t mixed[6] = { InstanceCullBuffer::CULL_PENDING, 0, 1, InstanceCullBuffer::CULL_PENDING, 0, 1 };
+	buffer.cull_pending(planes, 6, 1, 0, 6, mixed);
+	CHECK(mixed[0] == 1);
+	CHECK_MESSAGE(mixed[1] == 0, "Decided instances next to pending ones should be left as they are.");
+	CHECK(mixed[2] == 1);
+	CHECK(mixed[3] == 1);
+}
+
+TEST_CASE("[InstanceCullBuffer] Incremental updates") {
+	InstanceCullBuffer buffer;
+	buffer.push_back(AABB(Vector3(0, 0, 0), Vector3(1, 1, 1)), 1);
+	buffer.push_back(AABB(Vector3(50, 0, 0), Vector3(1, 1, 1)), 1);
+	buffer.push_back(AABB(Vector3(2, 2, 2), Vector3(1, 1, 1)), 4);
+
+	Plane planes[6];
+	make_box_planes(planes);
+	uint8_t visible[3];
+
+	buffer.set_bounds(1, AABB(Vector3(-5, 0, 0), Vector3(1, 1, 1)));
+	buffer.set_layer_mask(2, 1);
+	buffer.cull(planes, 6, 1, 0, 3, visible);
+	CHECK(visible[0] == 1);
+	CHECK_MESSAGE(visible[1] == 1, "Moved bounds should be used.");
+	CHECK_MESSAGE(visible[2] == 1, "Changed layer masks should be used.");
+
+	buffer.set_bounds(2, AABB(Vector3(100, 0, 0), Vector3(1, 1, 1)));
+	buffer.remove_at_unordered(0);
+	CHECK(buffer.size() == 2);
+	buffer.cull(planes, 6, 1, 0, 2, visible);
+	CHECK_MESSAGE(visible[0] == 0, "The last instance should take the place of the removed one.");
+	CHECK(visible[1] == 1);
+
+	buffer.reset();
+	CHECK(buffer.size() == 0);
+}
+
+TEST_CASE("[InstanceCullBuffer] Matches InstanceBounds::in_frustum") {
+	RandomPCG rng(1234);
+	InstanceCullBuffer buffer;
+	LocalVector<AABB> aabbs;
+	LocalVector<uint32_t> layers;
+
+	// Integer coordinates and normals keep the arithmetic exact, so both paths must agree bit for bit.
+	const uint32_t count = 1003; // Not a multiple of the vector width, to exercise the tail.
+	for (uint32_t i = 0; i < count; i++) {
+		AABB aabb(Vector3(rng.random(-40, 40), rng.random(-40, 40), rng.random(-40, 40)), Vector3(rng.random(0, 8), rng.random(0, 8), rng.random(0, 8)));
+		uint32_t layer = 1 << rng.random(0, 3);
+		aabbs.push_back(aabb);
+		layers.push_back(layer);
+		buffer.push_back(aabb, layer);
+	}
+
+	Vector<Plane> planes;
+	planes.push_back(Plane(Vector3(1, 1, 0), 20));
+	planes.push_back(Plane(Vector3(-1, 1, 0), 20));
+	planes.push_back(Plane(Vector3(0, -1, 0), 15));
+	planes.push_back(Plane(Vector3(0, 0, 1), 25));
+	planes.push_back(Plane(Vector3(2, 0, -1), 30));
+	const RendererSceneCull::Frustum frustum(planes);
+
+	LocalVector<uint8_t> visible;
+	visible.resize(count);
+	const uint32_t ranges[3][2] = { { 0, count }, { 3, 514 }, { 514, count } };
+	for (uint32_t r = 0; r < 3; r++) {
+		uint32_t from = ranges[r][0];
+		uint32_t to = ranges[r][1];
+		buffer.cull(planes.ptr(), planes.size(), 0b0101, from, to, visible.ptr());
+
+		uint32_t mismatches = 0;
+		for (uint32_t i = from; i < to; i++) {
+			bool expected = (layers[i] & 0b0101) && RendererSceneCull::InstanceBounds(aabbs[i]).in_frustum(frustum);
+			if (bool(visible[i - from]) != expected) {
+				mismatches++;
+			}
+		}
+		CHECK_MESSAGE(mismatches == 0, vformat("Range %d to %d should match InstanceBounds::in_frustum.", from, to));
+	}
+}
+
+TEST_CASE_PENDING("[InstanceCullBuffer][Benchmark] One million instances") {
+	RandomPCG rng(42);
+	InstanceCullBuffer buffer;
+	LocalVector<RendererSceneCull::InstanceBounds> bounds;
+	const uint32_t count = 1000000;
+	for (uint32_t i = 0; i < count; i++) {
+		Vector3 position(rng.random(-1000.0f, 1000.0f), rng.random(-100.0f, 100.0f), rng.random(-1000.0f, 1000.0f));
+		AABB aabb(position, Vector3(2, 2, 2));
+		buffer.push_back(aabb, 1);
+		bounds.push_back(RendererSceneCull::InstanceBounds(aabb));
+	}
+
+	Projection projection;
+	projection.set_perspective(75, 16.0 / 9.0, 0.05, 500);
+	Vector<Plane> planes = projection.get_projection_planes(Transform3D());
+	const RendererSceneCull::Frustum frustum(planes);
+
+	LocalVector<uint8_t> visible;
+	visible.resize(count);
+	LocalVector<uint8_t> expected;
+	expected.resize(count);
+
+	const uint32_t iterations = 20;
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < iterations; i++) {
+		buffer.cull(planes.ptr(), planes.size(), 1, 0, count, visible.ptr());
+	}
+	uint64_t buffer_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < iterations; i++) {
+		for (uint32_t j = 0; j < count; j++) {
+			expected[j] = bounds[j].in_frustum(frustum);
+		}
+	}
+	uint64_t bounds_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	uint32_t visible_count = 0;
+	uint32_t expected_count = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		visible_count += visible[i];
+		expected_count += expected[i];
+	}
+	MESSAGE(vformat("Culled %d instances in %.3f ms on average with InstanceCullBuffer, %.3f ms with InstanceBounds::in_frustum.", count, double(buffer_usec) / iterations / 1000.0, double(bounds_usec) / iterations / 1000.0));
+	MESSAGE(vformat("%d visible with InstanceCullBuffer, %d with InstanceBounds::in_frustum.", visible_count, expected_count));
+	CHECK(visible_count > 0);
+}
+
+} // namespace TestInstanceCullBuffer
+
+#endif // TEST_INSTANCE_CULL_BUFFER_H
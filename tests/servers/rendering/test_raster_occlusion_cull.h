@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+static bool is_box_occluded(const RasterOcclusionCull::RasterHZBuffer &p_buffer, const AABB &p_box, const Transform3D &p_cam_transform, const Projection &p_cam_projection) {
+	const real_t bounds[6] = { p_box.position.x, p_box.position.y, p_box.position.z, p_box.get_end().x, p_box.get_end().y, p_box.get_end().z };
+	uint64_t timeout = 0;
+	return p_buffer.is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near(), timeout);
+}
+
+static void rasterize_quad(RasterOcclusionCull::RasterHZBuffer &r_buffer, const Vector3 p_corners[4], const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_orthogonal) {
+	const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+	RasterOcclusionCull::RasterHZBuffer::Mesh mesh;
+	mesh.vertices = p_corners;
+	mesh.indices = indices;
+	mesh.index_count = 6;
+	r_buffer.rasterize(&mesh, 1, p_cam_transform, p_cam_projection, p_orthogonal);
+	r_buffer.update_mips();
+}
+
+TEST_CASE("[RasterOcclusionCull] Perspective wall") {
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(61, 47)); // Not a multiple of the vector width, to exercise row tails.
+
+	const Transform3D cam_transform;
+	const Projection cam_projection = Projection::create_perspective(90, 61.0 / 47.0, 0.1, 100);
+	const Vector3 wall[4] = { Vector3(-20, -20, -5), Vector3(20, -20, -5), Vector3(20, 20, -5), Vector3(-20, 20, -5) };
+	rasterize_quad(buffer, wall, cam_transform, cam_projection, false);
+
+	CHECK_MESSAGE(is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -8), Vector3(1, 1, 1)), cam_transform, cam_projection), "Box behind the wall should be occluded.");
+	CHECK_MESSAGE(is_box_occluded(buffer, AABB(Vector3(2, 1, -30), Vector3(1, 1, 1)), cam_transform, cam_projection), "Box far behind the wall should be occluded.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -3), Vector3(1, 1, 1)), cam_transform, cam_projection), "Box in front of the wall should be visible.");
+
+	// Winding must not matter, occluders are double sided.
+	const Vector3 reversed_wall[4] = { wall[3], wall[2], wall[1], wall[0] };
+	rasterize_quad(buffer, reversed_wall, cam_transform, cam_projection, false);
+	CHECK(is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -8), Vector3(1, 1, 1)), cam_transform, cam_projection));
+
+	// Nothing to rasterize clears the previous frame.
+	buffer.rasterize(nullptr, 0, cam_transform, cam_projection, false);
+	buffer.update_mips();
+	CHECK_FALSE(is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -8), Vector3(1, 1, 1)), cam_transform, cam_projection));
+}
+
+TEST_CASE("[RasterOcclusionCull] Occluder crossing the near plane") {
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+
+	const Transform3D cam_transform;
+	const Projection cam_projection = Projection::create_perspective(90, 1, 0.1, 100);
+	// Slanted wall that starts behind the camera and rises in front of it.
+	const Vector3 wall[4] = { Vector3(-10, -12, 5), Vector3(10, -12, 5), Vector3(10, 8, -5), Vector3(-10, 8, -5) };
+	rasterize_quad(buffer, wall, cam_transform, cam_projection, false);
+
+	CHECK_MESSAGE(is_box_occluded(buffer, AABB(Vector3(-0.5, 5.5, -8), Vector3(1, 1, 1)), cam_transform, cam_projection), "Box behind the slanted wall should be occluded.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(buffer, AABB(Vector3(-0.25, 0.25, -1.25), Vector3(0.5, 0.5, 0.5)), cam_transform, cam_projection), "Box in front of the slanted wall should be visible.");
+}
+
+TEST_CASE("[RasterOcclusionCull] Orthogonal projection") {
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+
+	const Transform3D cam_transform;
+	Projection cam_projection;
+	cam_projection.set_orthogonal(20, 1, 0.1, 100);
+	const Vector3 wall[4] = { Vector3(-2, -2, -5), Vector3(2, -2, -5), Vector3(2, 2, -5), Vector3(-2, 2, -5) };
+	rasterize_quad(buffer, wall, cam_transform, cam_projection, true);
+
+	CHECK_MESSAGE(is_box_occluded(buffer, AABB(Vector3(-0.5, -0.5, -9), Vector3(1, 1, 1)), cam_transform, cam_projection), "Box behind the wall should be occluded.");
+	CHECK_FALSE_MESSAGE(is_box_occluded(buffer, AABB(Vector3(5, -0.5, -9), Vector3(1, 1, 1)), cam_transform, cam_projection), "Box beside the wall should be visible.");
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
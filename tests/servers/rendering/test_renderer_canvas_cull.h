@@ -0,0 +1,314 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+// A canvas with one parent item and enough children for it to build a spatial index.
+struct TestTree {
+	static const int CHILD_COUNT = 200;
+	static const int COLUMNS = 20;
+
+	RID canvas;
+	RID parent;
+	LocalVector<RID> items; // Children of the parent, followed by a grandchild.
+};
+
+static TestTree create_tree(RendererCanvasCull *p_cull) {
+	TestTree tree;
+	tree.canvas = p_cull->canvas_allocate();
+	p_cull->canvas_initialize(tree.canvas);
+
+	tree.parent = p_cull->canvas_item_allocate();
+	p_cull->canvas_item_initialize(tree.parent);
+	p_cull->canvas_item_set_parent(tree.parent, tree.canvas);
+
+	for (int i = 0; i < TestTree::CHILD_COUNT; i++) {
+		RID child = p_cull->canvas_item_allocate();
+		p_cull->canvas_item_initialize(child);
+		p_cull->canvas_item_set_parent(child, tree.parent);
+		p_cull->canvas_item_set_draw_index(child, i);
+		p_cull->canvas_item_set_z_index(child, i % 3 - 1);
+		p_cull->canvas_item_set_transform(child, Transform2D(0, Vector2(i % TestTree::COLUMNS, i / TestTree::COLUMNS) * 40));
+		p_cull->canvas_item_add_rect(child, Rect2(0, 0, 16, 16), Color(1, 1, 1), false);
+		tree.items.push_back(child);
+	}
+
+	// Hidden children and children with their own children are handled outside of the index.
+	p_cull->canvas_item_set_visible(tree.items[13], false);
+
+	RID grandchild = p_cull->canvas_item_allocate();
+	p_cull->canvas_item_initialize(grandchild);
+	p_cull->canvas_item_set_parent(grandchild, tree.items[7]);
+	p_cull->canvas_item_set_transform(grandchild, Transform2D(0, Vector2(20, 20)));
+	p_cull->canvas_item_add_rect(grandchild, Rect2(0, 0, 16, 16), Color(1, 1, 1), false);
+	tree.items.push_back(grandchild);
+
+	return tree;
+}
+
+static void free_tree(RendererCanvasCull *p_cull, const TestTree &p_tree) {
+	for (int i = p_tree.items.size() - 1; i >= 0; i--) {
+		p_cull->free(p_tree.items[i]);
+	}
+	p_cull->free(p_tree.parent);
+	p_cull->free(p_tree.canvas);
+}
+
+// Returns the indices in `p_tree.items` of the culled items, in draw order.
+static LocalVector<int> cull_tree(RendererCanvasCull *p_cull, const TestTree &p_tree, const Rect2 &p_clip_rect) {
+	HashMap<const RendererCanvasRender::Item *, int> item_indices;
+	for (uint32_t i = 0; i < p_tree.items.size(); i++) {
+		item_indices[p_cull->canvas_item_owner.get_or_null(p_tree.items[i])] = i;
+	}
+
+	RendererCanvasCull::Canvas *canvas = p_cull->canvas_owner.get_or_null(p_tree.canvas);
+	Transform2D canvas_transform;
+	p_cull->cull_canvases(&canvas, &canvas_transform, 1, p_clip_rect, false, 0xFFFFFFFF);
+
+	LocalVector<int> result;
+	for (const RendererCanvasRender::Item *item = canvas->cull_list; item; item = item->next) {
+		const int *index = item_indices.getptr(item);
+		result.push_back(index ? *index : -1);
+	}
+	canvas->cull_list = nullptr;
+	canvas->cull_prepared = false;
+
+	return result;
+}
+
+static LocalVector<int> check_matches_brute_force(RendererCanvasCull *p_cull, const TestTree &p_brute_force, const TestTree &p_indexed, const Rect2 &p_clip_rect) {
+	p_cull->use_spatial_index = false;
+	LocalVector<int> expected = cull_tree(p_cull, p_brute_force, p_clip_rect);
+	p_cull->use_spatial_index = true;
+	LocalVector<int> result = cull_tree(p_cull, p_indexed, p_clip_rect);
+
+	bool matches = result.size() == expected.size();
+	for (uint32_t i = 0; matches && i < result.size(); i++) {
+		matches = result[i] == expected[i];
+	}
+	CHECK_MESSAGE(matches, "The spatial index should cull the same items, in the same order, as visiting every child.");
+
+	return expected;
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Spatial index culls the same children as brute force") {
+	RendererCanvasCull *canvas_cull = RSG::canvas;
+	const bool was_using_spatial_index = canvas_cull->use_spatial_index;
+
+	TestTree brute_force = create_tree(canvas_cull);
+	TestTree indexed = create_tree(canvas_cull);
+
+	const Rect2 full_clip(0, 0, 2000, 2000);
+	const Rect2 partial_clip(0, 0, 300, 200);
+
+	SUBCASE("Unculled children") {
+		LocalVector<int> culled = check_matches_brute_force(canvas_cull, brute_force, indexed, full_clip);
+		CHECK_MESSAGE(culled.size() == brute_force.items.size() - 1, "Every visible item should be drawn.");
+		CHECK_MESSAGE(canvas_cull->canvas_item_owner.get_or_null(indexed.parent)->spatial_index != nullptr, "The parent should have built a spatial index.");
+	}
+
+	SUBCASE("Culled children") {
+		LocalVector<int> culled = check_matches_brute_force(canvas_cull, brute_force, indexed, partial_clip);
+		CHECK(culled.size() > 0);
+		CHECK_MESSAGE(culled.size() < brute_force.items.size() - 1, "Children outside of the clip rect should be culled.");
+	}
+
+	SUBCASE("Transformed parent") {
+		check_matches_brute_force(canvas_cull, brute_force, indexed, partial_clip);
+
+		const Transform2D parent_xform = Transform2D(0.3, Size2(1.5, 0.75), 0, Vector2(100, -50));
+		canvas_cull->canvas_item_set_transform(brute_force.parent, parent_xform);
+		canvas_cull->canvas_item_set_transform(indexed.parent, parent_xform);
+		check_matches_brute_force(canvas_cull, brute_force, indexed, partial_clip);
+	}
+
+	SUBCASE("Changed children") {
+		check_matches_brute_force(canvas_cull, brute_force, indexed, partial_clip);
+
+		// Move children in and out of view, and grow one by adding a command.
+		for (int i = 0; i < 10; i++) {
+			canvas_cull->canvas_item_set_transform(brute_force.items[i], Transform2D(0, Vector2(1000, 1000)));
+			canvas_cull->canvas_item_set_transform(indexed.items[i], Transform2D(0, Vector2(1000, 1000)));
+			canvas_cull->canvas_item_set_transform(brute_force.items[190 + i], Transform2D(0, Vector2(i * 20, 10)));
+			canvas_cull->canvas_item_set_transform(indexed.items[190 + i], Transform2D(0, Vector2(i * 20, 10)));
+		}
+		canvas_cull->canvas_item_add_rect(brute_force.items[150], Rect2(-800, -400, 16, 16), Color(1, 1, 1), false);
+		canvas_cull->canvas_item_add_rect(indexed.items[150], Rect2(-800, -400, 16, 16), Color(1, 1, 1), false);
+		canvas_cull->canvas_item_set_visible(brute_force.items[13], true);
+		canvas_cull->canvas_item_set_visible(indexed.items[13], true);
+		check_matches_brute_force(canvas_cull, brute_force, indexed, partial_clip);
+
+		// Reparent a child, so it leaves the index.
+		canvas_cull->canvas_item_set_parent(brute_force.items[20], brute_force.canvas);
+		canvas_cull->canvas_item_set_parent(indexed.items[20], indexed.canvas);
+		check_matches_brute_force(canvas_cull, brute_force, indexed, partial_clip);
+	}
+
+	canvas_cull->use_spatial_index = was_using_spatial_index;
+	free_tree(canvas_cull, brute_force);
+	free_tree(canvas_cull, indexed);
+}
+
+// Culls the canvases together and returns the items drawn by each of them, separated by nullptr.
+static LocalVector<const RendererCanvasRender::Item *> cull_canvases(RendererCanvasCull *p_cull, const LocalVector<RID> &p_canvases, const Rect2 &p_clip_rect) {
+	LocalVector<RendererCanvasCull::Canvas *> canvases;
+	LocalVector<Transform2D> canvas_transforms;
+	for (const RID &canvas : p_canvases) {
+		canvases.push_back(p_cull->canvas_owner.get_or_null(canvas));
+		canvas_transforms.push_back(Transform2D());
+	}
+	p_cull->cull_canvases(canvases.ptr(), canvas_transforms.ptr(), canvases.size(), p_clip_rect, false, 0xFFFFFFFF);
+
+	LocalVector<const RendererCanvasRender::Item *> result;
+	for (RendererCanvasCull::Canvas *canvas : canvases) {
+		for (const RendererCanvasRender::Item *item = canvas->cull_list; item; item = item->next) {
+			result.push_back(item);
+		}
+		result.push_back(nullptr);
+		canvas->cull_list = nullptr;
+		canvas->cull_prepared = false;
+	}
+
+	return result;
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Threaded culling draws in the same order as serial culling") {
+	RendererCanvasCull *canvas_cull = RSG::canvas;
+	const bool was_threaded = canvas_cull->is_threaded_cull_enabled();
+
+	// Several canvases with many top level items, so they are split into chunks,
+	// with Z indices that interleave the items of different chunks.
+	LocalVector<RID> canvases;
+	LocalVector<RID> items;
+	for (int i = 0; i < 3; i++) {
+		RID canvas = canvas_cull->canvas_allocate();
+		canvas_cull->canvas_initialize(canvas);
+		canvases.push_back(canvas);
+
+		for (int j = 0; j < 40; j++) {
+			RID item = canvas_cull->canvas_item_allocate();
+			canvas_cull->canvas_item_initialize(item);
+			canvas_cull->canvas_item_set_parent(item, canvas);
+			canvas_cull->canvas_item_set_draw_index(item, j);
+			canvas_cull->canvas_item_set_z_index(item, (j * 7) % 5 - 2);
+			canvas_cull->canvas_item_set_transform(item, Transform2D(0, Vector2(j % 8, j / 8) * 100));
+			canvas_cull->canvas_item_add_rect(item, Rect2(0, 0, 32, 32), Color(1, 1, 1), false);
+			canvas_cull->canvas_item_set_sort_children_by_y(item, j % 4 == 0);
+			items.push_back(item);
+
+			for (int k = 0; k < 3; k++) {
+				RID child = canvas_cull->canvas_item_allocate();
+				canvas_cull->canvas_item_initialize(child);
+				canvas_cull->canvas_item_set_parent(child, item);
+				canvas_cull->canvas_item_set_draw_index(child, k);
+				canvas_cull->canvas_item_set_z_index(child, k - 1);
+				canvas_cull->canvas_item_set_z_as_relative_to_parent(child, k != 2);
+				canvas_cull->canvas_item_set_transform(child, Transform2D(0, Vector2(k * 10, (2 - k) * 10)));
+				canvas_cull->canvas_item_add_rect(child, Rect2(0, 0, 8, 8), Color(1, 1, 1), false);
+				items.push_back(child);
+			}
+		}
+	}
+
+	const Rect2 clip_rect(0, 0, 600, 400);
+
+	canvas_cull->set_threaded_cull_enabled(false);
+	LocalVector<const RendererCanvasRender::Item *> expected = cull_canvases(canvas_cull, canvases, clip_rect);
+	canvas_cull->set_threaded_cull_enabled(true);
+	LocalVector<const RendererCanvasRender::Item *> result = cull_canvases(canvas_cull, canvases, clip_rect);
+
+	CHECK_MESSAGE(expected.size() > canvases.size(), "Some items should be drawn.");
+	CHECK_MESSAGE(expected.size() < items.size() + canvases.size(), "Items outside of the clip rect should be culled.");
+
+	bool matches = result.size() == expected.size();
+	for (uint32_t i = 0; matches && i < result.size(); i++) {
+		matches = result[i] == expected[i];
+	}
+	CHECK_MESSAGE(matches, "Merging the per-thread Z lists should give the same draw order as culling on a single thread.");
+
+	canvas_cull->set_threaded_cull_enabled(was_threaded);
+	for (int i = items.size() - 1; i >= 0; i--) {
+		canvas_cull->free(items[i]);
+	}
+	for (const RID &canvas : canvases) {
+		canvas_cull->free(canvas);
+	}
+}
+
+static void _record_texture_usage(void *p_userdata, float p_scale) {
+	float *max_scale = (float *)p_userdata;
+	*max_scale = MAX(*max_scale, p_scale);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Culling reports the usage of drawn textures") {
+	RendererCanvasCull *canvas_cull = RSG::canvas;
+
+	RID texture = RS::get_singleton()->texture_2d_create(Image::create_empty(64, 64, false, Image::FORMAT_RGBA8));
+	float max_scale = 0.0;
+	RSG::texture_storage->texture_set_usage_callback(texture, _record_texture_usage, &max_scale);
+
+	RID canvas = canvas_cull->canvas_allocate();
+	canvas_cull->canvas_initialize(canvas);
+	RID item = canvas_cull->canvas_item_allocate();
+	canvas_cull->canvas_item_initialize(item);
+	canvas_cull->canvas_item_set_parent(item, canvas);
+	canvas_cull->canvas_item_set_transform(item, Transform2D(0, Size2(2, 2), 0, Vector2(10, 10)));
+	// A 16x16 region drawn 32 pixels wide and scaled by the transform, so each texel covers 4 pixels.
+	canvas_cull->canvas_item_add_texture_rect_region(item, Rect2(0, 0, 32, 32), texture, Rect2(0, 0, 16, 16));
+
+	LocalVector<RID> canvases;
+	canvases.push_back(canvas);
+
+	cull_canvases(canvas_cull, canvases, Rect2(0, 0, 200, 200));
+	CHECK(max_scale == doctest::Approx(4.0));
+
+	max_scale = 0.0;
+	canvas_cull->canvas_item_set_visible(item, false);
+	cull_canvases(canvas_cull, canvases, Rect2(0, 0, 200, 200));
+	CHECK_MESSAGE(max_scale == 0.0, "Textures of hidden items should not be reported.");
+
+	RSG::texture_storage->texture_set_usage_callback(texture, nullptr, nullptr);
+	CHECK_FALSE(RSG::texture_storage->has_texture_usage_callbacks());
+
+	canvas_cull->free(item);
+	canvas_cull->free(canvas);
+	RS::get_singleton()->free(texture);
+}
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
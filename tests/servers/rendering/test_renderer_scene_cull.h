@@ -0,0 +1,246 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+// Frustum made of the six faces of a box, with normals pointing outwards.
+static RendererSceneCull::Frustum make_box_frustum(const AABB &p_box) {
+	Vector<Plane> planes;
+	const Vector3 end = p_box.get_end();
+	planes.push_back(Plane(Vector3(1, 0, 0), end.x));
+	planes.push_back(Plane(Vector3(-1, 0, 0), -p_box.position.x));
+	planes.push_back(Plane(Vector3(0, 1, 0), end.y));
+	planes.push_back(Plane(Vector3(0, -1, 0), -p_box.position.y));
+	planes.push_back(Plane(Vector3(0, 0, 1), end.z));
+	planes.push_back(Plane(Vector3(0, 0, -1), -p_box.position.z));
+	return RendererSceneCull::Frustum(planes);
+}
+
+// Unit sized mesh instance centered at the given position.
+static RID create_mesh_instance(RID p_mesh, RID p_scenario, const Vector3 &p_position) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID instance = rs->instance_create2(p_mesh, p_scenario);
+	rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+	rs->instance_set_transform(instance, Transform3D(Basis(), p_position));
+	return instance;
+}
+
+TEST_CASE("[RendererSceneCull] InstanceBounds frustum classification") {
+	const RendererSceneCull::Frustum frustum = make_box_frustum(AABB(Vector3(-10, -10, -10), Vector3(20, 20, 20)));
+
+	const RendererSceneCull::InstanceBounds inside(AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+	CHECK(inside.in_frustum(frustum));
+	CHECK(inside.inside_frustum(frustum));
+
+	const RendererSceneCull::InstanceBounds straddling(AABB(Vector3(8, -1, -1), Vector3(4, 2, 2)));
+	CHECK(straddling.in_frustum(frustum));
+	CHECK_FALSE_MESSAGE(straddling.inside_frustum(frustum), "Bounds crossing a plane are not fully inside.");
+
+	const RendererSceneCull::InstanceBounds touching(AABB(Vector3(8, -1, -1), Vector3(2, 2, 2)));
+	CHECK_FALSE_MESSAGE(touching.inside_frustum(frustum), "Bounds touching a plane are not fully inside.");
+
+	const RendererSceneCull::InstanceBounds outside(AABB(Vector3(11, -1, -1), Vector3(2, 2, 2)));
+	CHECK_FALSE(outside.in_frustum(frustum));
+	CHECK_FALSE(outside.inside_frustum(frustum));
+
+	const RendererSceneCull::InstanceBounds enclosing(AABB(Vector3(-20, -20, -20), Vector3(40, 40, 40)));
+	CHECK(enclosing.in_frustum(frustum));
+	CHECK_FALSE(enclosing.inside_frustum(frustum));
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Instance cluster bookkeeping") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	const float cell_size = scene_cull->instance_cluster_cell_size;
+	scene_cull->instance_cluster_cell_size = 10.0;
+
+	RID scenario_rid = rs->scenario_create();
+	RID mesh = rs->mesh_create();
+	RID a = create_mesh_instance(mesh, scenario_rid, Vector3(1, 1, 1));
+	RID b = create_mesh_instance(mesh, scenario_rid, Vector3(3, 3, 3));
+	RID c = create_mesh_instance(mesh, scenario_rid, Vector3(15, 1, 1));
+	scene_cull->update_dirty_instances();
+
+	RendererSceneCull::Scenario *scenario = scene_cull->scenario_owner.get_or_null(scenario_rid);
+	RendererSceneCull::Instance *instance_b = scene_cull->instance_owner.get_or_null(b);
+	RendererSceneCull::Instance *instance_c = scene_cull->instance_owner.get_or_null(c);
+	const int32_t cluster_ab = scene_cull->instance_owner.get_or_null(a)->cluster_index;
+	const int32_t cluster_c = instance_c->cluster_index;
+
+	REQUIRE(cluster_ab >= 0);
+	REQUIRE(cluster_c >= 0);
+	CHECK_MESSAGE(instance_b->cluster_index == cluster_ab, "Instances of the same mesh in the same cell should share a cluster.");
+	CHECK_MESSAGE(cluster_c != cluster_ab, "Instances in different cells should not share a cluster.");
+	CHECK(scenario->instance_clusters[cluster_ab].instances.size() == 2);
+	CHECK(scenario->instance_clusters[cluster_ab].aabb.is_equal_approx(AABB(Vector3(0.5, 0.5, 0.5), Vector3(3, 3, 3))));
+	CHECK(scenario->instance_data[instance_b->array_index].cluster_index == cluster_ab);
+
+	SUBCASE("Removing a member swaps the last one in and shrinks the bounds lazily") {
+		rs->free(a);
+		a = RID();
+
+		const RendererSceneCull::InstanceCluster &cluster = scenario->instance_clusters[cluster_ab];
+		REQUIRE(cluster.instances.size() == 1);
+		CHECK(cluster.instances[0] == instance_b);
+		CHECK(instance_b->cluster_slot == 0);
+		CHECK(cluster.aabb_dirty);
+		CHECK_MESSAGE(cluster.aabb.has_point(Vector3(0.75, 0.75, 0.75)), "The bounds should only shrink on the next cull.");
+
+		scene_cull->_update_instance_cluster_cull(scenario, make_box_frustum(AABB(Vector3(-10, -10, -10), Vector3(20, 20, 20))));
+		CHECK_FALSE(cluster.aabb_dirty);
+		CHECK(scenario->instance_clusters_dirty.is_empty());
+		CHECK(cluster.aabb.is_equal_approx(instance_b->transformed_aabb));
+	}
+
+	SUBCASE("Empty clusters are reused") {
+		const uint32_t cluster_count = scenario->instance_clusters.size();
+		rs->free(c);
+		c = RID();
+		CHECK(scenario->instance_clusters[cluster_c].instances.is_empty());
+		CHECK(scenario->instance_clusters_free.size() == 1);
+		CHECK(scenario->instance_cluster_map.size() == 1);
+
+		c = create_mesh_instance(mesh, scenario_rid, Vector3(25, 1, 1));
+		scene_cull->update_dirty_instances();
+		CHECK_MESSAGE(scene_cull->instance_owner.get_or_null(c)->cluster_index == cluster_c, "A new cluster should take the slot of the freed one.");
+		CHECK(scenario->instance_clusters.size() == cluster_count);
+		CHECK(scenario->instance_clusters_free.is_empty());
+	}
+
+	SUBCASE("Moving members") {
+		rs->instance_set_transform(b, Transform3D(Basis(), Vector3(8, 8, 8)));
+		scene_cull->update_dirty_instances();
+		CHECK_MESSAGE(instance_b->cluster_index == cluster_ab, "Moving inside the cell should keep the cluster.");
+		CHECK_MESSAGE(scenario->instance_clusters[cluster_ab].aabb.has_point(Vector3(8.25, 8.25, 8.25)), "The bounds should grow with the member.");
+
+		rs->instance_set_transform(b, Transform3D(Basis(), Vector3(12, 1, 1)));
+		scene_cull->update_dirty_instances();
+		CHECK_MESSAGE(instance_b->cluster_index == cluster_c, "Moving to another cell should join the cluster there.");
+		CHECK(scenario->instance_clusters[cluster_c].instances.size() == 2);
+		CHECK(scenario->instance_clusters[cluster_ab].instances.size() == 1);
+		CHECK(scenario->instance_clusters[cluster_ab].aabb_dirty);
+	}
+
+	SUBCASE("Cull states") {
+		// A different mesh gets its own cluster, placed across the frustum boundary.
+		RID other_mesh = rs->mesh_create();
+		RID d = create_mesh_instance(other_mesh, scenario_rid, Vector3(9, 1, 1));
+		scene_cull->update_dirty_instances();
+		const int32_t cluster_d = scene_cull->instance_owner.get_or_null(d)->cluster_index;
+
+		scene_cull->_update_instance_cluster_cull(scenario, make_box_frustum(AABB(Vector3(-5, -5, -5), Vector3(14, 14, 14))));
+		REQUIRE(scene_cull->instance_cluster_cull_state.size() == scenario->instance_clusters.size());
+		CHECK(scene_cull->instance_cluster_cull_state[cluster_ab] == RendererSceneCull::INSTANCE_CLUSTER_INSIDE);
+		CHECK(scene_cull->instance_cluster_cull_state[cluster_c] == RendererSceneCull::INSTANCE_CLUSTER_CULLED);
+		CHECK(scene_cull->instance_cluster_cull_state[cluster_d] == RendererSceneCull::INSTANCE_CLUSTER_INTERSECTS);
+
+		rs->free(d);
+		scene_cull->_update_instance_cluster_cull(scenario, make_box_frustum(AABB(Vector3(-5, -5, -5), Vector3(14, 14, 14))));
+		CHECK_MESSAGE(scene_cull->instance_cluster_cull_state[cluster_d] == RendererSceneCull::INSTANCE_CLUSTER_CULLED, "Empty clusters should be culled.");
+		rs->free(other_mesh);
+	}
+
+	if (a.is_valid()) {
+		rs->free(a);
+	}
+	rs->free(b);
+	if (c.is_valid()) {
+		rs->free(c);
+	}
+	rs->free(mesh);
+	rs->free(scenario_rid);
+	scene_cull->instance_cluster_cell_size = cell_size;
+}
+
+#ifndef _3D_DISABLED
+TEST_CASE("[SceneTree][RendererSceneCull] Instance cull states") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+
+	RID scenario = rs->scenario_create();
+	RID viewport = rs->viewport_create();
+	RID mesh = rs->mesh_create();
+	RID camera = rs->camera_create();
+	rs->camera_set_perspective(camera, 60, 0.1, 100);
+	rs->camera_set_cull_mask(camera, 1);
+
+	// The camera looks down -Z from the origin.
+	RID visible = create_mesh_instance(mesh, scenario, Vector3(0, 0, -10));
+	RID layer_culled = create_mesh_instance(mesh, scenario, Vector3(0, 0, -10));
+	rs->instance_set_layer_mask(layer_culled, 2);
+	RID frustum_culled = create_mesh_instance(mesh, scenario, Vector3(0, 0, 10));
+	RID range_culled = create_mesh_instance(mesh, scenario, Vector3(0, 0, -50));
+	rs->instance_geometry_set_visibility_range(range_culled, 0, 20, 0, 0, RS::VISIBILITY_RANGE_FADE_DISABLED);
+	scene_cull->update_dirty_instances();
+
+	rs->instances_set_cull_statistics_enabled(true);
+	Ref<XRInterface> xr_interface;
+	scene_cull->render_camera(Ref<RenderSceneBuffers>(), camera, scenario, viewport, Size2(64, 64), 0, 0, RID(), xr_interface);
+
+	Dictionary stats = rs->instances_get_cull_statistics(viewport);
+	TypedArray<RID> instances = stats["instances"];
+	PackedInt32Array states = stats["states"];
+	REQUIRE(instances.size() == 4);
+	REQUIRE(states.size() == 4);
+
+	HashMap<RID, int32_t> state_map;
+	for (int i = 0; i < instances.size(); i++) {
+		state_map[instances[i]] = states[i];
+	}
+	CHECK(state_map[visible] == RS::INSTANCE_CULL_STATE_VISIBLE);
+	CHECK(state_map[layer_culled] == RS::INSTANCE_CULL_STATE_LAYER_CULLED);
+	CHECK(state_map[frustum_culled] == RS::INSTANCE_CULL_STATE_FRUSTUM_CULLED);
+	CHECK(state_map[range_culled] == RS::INSTANCE_CULL_STATE_VISIBILITY_RANGE_CULLED);
+
+	rs->free(viewport);
+	CHECK_MESSAGE(rs->instances_get_cull_statistics(viewport).is_empty(), "Statistics should be dropped with their viewport.");
+
+	rs->instances_set_cull_statistics_enabled(false);
+	rs->free(visible);
+	rs->free(layer_culled);
+	rs->free(frustum_culled);
+	rs->free(range_culled);
+	rs->free(camera);
+	rs->free(mesh);
+	rs->free(scenario);
+}
+#endif // _3D_DISABLED
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
@@ -0,0 +1,252 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_H
+#define TEST_SHADER_COMPILER_H
+
+#include "core/os/os.h"
+#include "scene/resources/3d/fog_material.h"
+#include "scene/resources/3d/sky_material.h"
+#include "scene/resources/canvas_item_material.h"
+#include "scene/resources/material.h"
+#include "scene/resources/particle_process_material.h"
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderCompiler {
+
+static const char *spatial_code = R"(
+shader_type spatial;
+render_mode unshaded, blend_add;
+
+uniform vec4 albedo : source_color;
+
+void vertex() {
+	VERTEX += vec3(sin(TIME));
+}
+
+void fragment() {
+	ALBEDO = albedo.rgb;
+	ALPHA = albedo.a;
+}
+)";
+
+struct SpatialResults {
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	ShaderCompiler::GeneratedCode gen_code;
+	int blend_mode = 0;
+	bool unshaded = false;
+	bool uses_alpha = false;
+	bool uses_time = false;
+	bool uses_discard = false;
+	bool writes_vertex = false;
+};
+
+static Error compile_spatial(ShaderCompiler &p_compiler, const String &p_code, SpatialResults &r_results) {
+	ShaderCompiler::IdentifierActions actions;
+	actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
+	actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+	actions.entry_point_stages["light"] = ShaderCompiler::STAGE_FRAGMENT;
+
+	actions.render_mode_values["blend_mix"] = Pair<int *, int>(&r_results.blend_mode, 0);
+	actions.render_mode_values["blend_add"] = Pair<int *, int>(&r_results.blend_mode, 1);
+	actions.render_mode_flags["unshaded"] = &r_results.unshaded;
+	actions.usage_flag_pointers["ALPHA"] = &r_results.uses_alpha;
+	actions.usage_flag_pointers["TIME"] = &r_results.uses_time;
+	actions.usage_flag_pointers["DISCARD"] = &r_results.uses_discard;
+	actions.write_flag_pointers["VERTEX"] = &r_results.writes_vertex;
+	actions.uniforms = &r_results.uniforms;
+
+	return p_compiler.compile(RS::SHADER_SPATIAL, p_code, &actions, "", r_results.gen_code);
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Identical sources report the same results") {
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	SpatialResults first;
+	REQUIRE(compile_spatial(compiler, spatial_code, first) == OK);
+	CHECK(compiler.get_code_cache_hits() == 0);
+	CHECK(first.blend_mode == 1);
+	CHECK(first.unshaded);
+	CHECK(first.uses_alpha);
+	CHECK(first.uses_time);
+	CHECK_FALSE(first.uses_discard);
+	CHECK(first.writes_vertex);
+	CHECK(first.uniforms.has("albedo"));
+
+	// The second compilation is served from the code cache and must look the same to the caller.
+	SpatialResults second;
+	REQUIRE(compile_spatial(compiler, spatial_code, second) == OK);
+	CHECK_MESSAGE(compiler.get_code_cache_hits() == 1, "The second compilation should be served from the code cache.");
+	CHECK(second.blend_mode == first.blend_mode);
+	CHECK(second.unshaded == first.unshaded);
+	CHECK(second.uses_alpha == first.uses_alpha);
+	CHECK(second.uses_time == first.uses_time);
+	CHECK(second.uses_discard == first.uses_discard);
+	CHECK(second.writes_vertex == first.writes_vertex);
+	CHECK(second.uniforms.size() == first.uniforms.size());
+	CHECK(second.uniforms.has("albedo"));
+	CHECK(second.gen_code.uniforms == first.gen_code.uniforms);
+	CHECK(second.gen_code.uniform_total_size == first.gen_code.uniform_total_size);
+	CHECK(second.gen_code.defines == first.gen_code.defines);
+	CHECK(second.gen_code.code.size() == first.gen_code.code.size());
+	for (const KeyValue<String, String> &E : first.gen_code.code) {
+		CHECK(second.gen_code.code.has(E.key));
+		CHECK(second.gen_code.code[E.key] == E.value);
+	}
+
+	// Same result with a fresh cache.
+	compiler.clear_code_cache();
+	SpatialResults third;
+	REQUIRE(compile_spatial(compiler, spatial_code, third) == OK);
+	CHECK(compiler.get_code_cache_hits() == 0);
+	CHECK(third.gen_code.code["fragment"] == first.gen_code.code["fragment"]);
+	CHECK(third.uses_alpha);
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Different sources are compiled separately") {
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	SpatialResults first;
+	REQUIRE(compile_spatial(compiler, spatial_code, first) == OK);
+
+	const String other_code = R"(
+shader_type spatial;
+
+uniform float cutoff;
+
+void fragment() {
+	if (cutoff > 0.5) {
+		discard;
+	}
+}
+)";
+	SpatialResults second;
+	REQUIRE(compile_spatial(compiler, other_code, second) == OK);
+	CHECK(compiler.get_code_cache_hits() == 0);
+	CHECK(second.blend_mode == 0);
+	CHECK_FALSE(second.unshaded);
+	CHECK_FALSE(second.uses_alpha);
+	CHECK(second.uses_discard);
+	CHECK(second.uniforms.has("cutoff"));
+	CHECK_FALSE(second.uniforms.has("albedo"));
+	CHECK(second.gen_code.code["fragment"] != first.gen_code.code["fragment"]);
+
+	// Errors are reported every time, never cached.
+	SpatialResults invalid;
+	ERR_PRINT_OFF;
+	CHECK(compile_spatial(compiler, "shader_type spatial;\nvoid fragment() { ALBEDO = undefined; }\n", invalid) != OK);
+	CHECK(compile_spatial(compiler, "shader_type spatial;\nvoid fragment() { ALBEDO = undefined; }\n", invalid) != OK);
+	ERR_PRINT_ON;
+	CHECK(compiler.get_code_cache_hits() == 0);
+}
+
+static RS::ShaderMode get_shader_mode(const String &p_code) {
+	const String type = ShaderLanguage::get_shader_type(p_code);
+	if (type == "canvas_item") {
+		return RS::SHADER_CANVAS_ITEM;
+	} else if (type == "particles") {
+		return RS::SHADER_PARTICLES;
+	} else if (type == "sky") {
+		return RS::SHADER_SKY;
+	} else if (type == "fog") {
+		return RS::SHADER_FOG;
+	}
+	return RS::SHADER_SPATIAL;
+}
+
+TEST_CASE_PENDING("[SceneTree][ShaderCompiler][Benchmark] Built-in material shaders") {
+	// Generate the sources of the engine's built-in materials for a few common feature sets.
+	Vector<Ref<Material>> materials;
+	for (int i = 0; i < 8; i++) {
+		Ref<StandardMaterial3D> material;
+		material.instantiate();
+		material->set_feature(BaseMaterial3D::FEATURE_NORMAL_MAPPING, i & 1);
+		material->set_transparency((i & 2) ? BaseMaterial3D::TRANSPARENCY_ALPHA : BaseMaterial3D::TRANSPARENCY_DISABLED);
+		material->set_shading_mode((i & 4) ? BaseMaterial3D::SHADING_MODE_UNSHADED : BaseMaterial3D::SHADING_MODE_PER_PIXEL);
+		materials.push_back(material);
+	}
+	Ref<ORMMaterial3D> orm_material;
+	orm_material.instantiate();
+	orm_material->set_feature(BaseMaterial3D::FEATURE_EMISSION, true);
+	materials.push_back(orm_material);
+	materials.push_back(Ref<CanvasItemMaterial>(memnew(CanvasItemMaterial)));
+	materials.push_back(Ref<ParticleProcessMaterial>(memnew(ParticleProcessMaterial)));
+	materials.push_back(Ref<ProceduralSkyMaterial>(memnew(ProceduralSkyMaterial)));
+	materials.push_back(Ref<PanoramaSkyMaterial>(memnew(PanoramaSkyMaterial)));
+	materials.push_back(Ref<PhysicalSkyMaterial>(memnew(PhysicalSkyMaterial)));
+	materials.push_back(Ref<FogMaterial>(memnew(FogMaterial)));
+
+	BaseMaterial3D::flush_changes();
+	CanvasItemMaterial::flush_changes();
+	ParticleProcessMaterial::flush_changes();
+
+	Vector<String> sources;
+	for (const Ref<Material> &material : materials) {
+		const String code = RS::get_singleton()->shader_get_code(material->get_shader_rid());
+		if (!code.is_empty()) {
+			sources.push_back(code);
+		}
+	}
+	REQUIRE(sources.size() > 0);
+
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	const int iterations = 20;
+	uint64_t uncached_usec = 0;
+	uint64_t cached_usec = 0;
+	for (int i = 0; i < iterations; i++) {
+		compiler.clear_code_cache();
+		uint64_t uncached_hits = 0;
+		for (int pass = 0; pass < 2; pass++) {
+			uncached_hits = compiler.get_code_cache_hits();
+			const uint64_t from = OS::get_singleton()->get_ticks_usec();
+			for (const String &code : sources) {
+				HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+				ShaderCompiler::IdentifierActions actions;
+				actions.uniforms = &uniforms;
+				ShaderCompiler::GeneratedCode gen_code;
+				CHECK(compiler.compile(get_shader_mode(code), code, &actions, "", gen_code) == OK);
+			}
+			(pass == 0 ? uncached_usec : cached_usec) += OS::get_singleton()->get_ticks_usec() - from;
+		}
+		CHECK_MESSAGE(compiler.get_code_cache_hits() - uncached_hits == uint64_t(sources.size()), "The second pass should be served from the code cache.");
+	}
+
+	MESSAGE(vformat("Compiled %d built-in shaders in %.3f ms on average, %.3f ms when cached.", sources.size(), double(uncached_usec) / iterations / 1000.0, double(cached_usec) / iterations / 1000.0));
+}
+
+} // namespace TestShaderCompiler
+
+#endif // TEST_SHADER_COMPILER_H
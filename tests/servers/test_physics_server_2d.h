@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "core/config/project_settings.h"
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+static RID create_rigid_body(PhysicsServer2D *p_server, RID p_space, RID p_shape, const Transform2D &p_transform) {
+	RID body = p_server->body_create();
+	p_server->body_add_shape(body, p_shape);
+	p_server->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+	p_server->body_set_space(body, p_space);
+	p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, p_transform);
+	return body;
+}
+
+static Vector2 get_body_position(PhysicsServer2D *p_server, RID p_body) {
+	return Transform2D(p_server->body_get_state(p_body, PhysicsServer2D::BODY_STATE_TRANSFORM)).get_origin();
+}
+
+// Steps two spaces, moving a body from one to the other halfway, and returns where both bodies end up.
+static LocalVector<Vector2> step_two_spaces(PhysicsServer2D *p_server, bool p_parallel) {
+	ProjectSettings::get_singleton()->set_setting("physics/2d/step_spaces_in_parallel", p_parallel);
+	p_server->finish();
+	p_server->init();
+
+	RID shape = p_server->circle_shape_create();
+	p_server->shape_set_data(shape, 0.5);
+	RID spaces[2];
+	RID bodies[2];
+	for (int i = 0; i < 2; i++) {
+		spaces[i] = p_server->space_create();
+		p_server->space_set_active(spaces[i], true);
+		bodies[i] = create_rigid_body(p_server, spaces[i], shape, i == 0 ? Transform2D(0, Vector2(0, 0)) : Transform2D(0, Vector2(100, 0)));
+	}
+
+	for (int i = 0; i < 10; i++) {
+		p_server->step(1.0 / 60.0);
+	}
+	// Bodies moved to another space are stepped there like any other.
+	p_server->body_set_space(bodies[1], spaces[0]);
+	for (int i = 0; i < 10; i++) {
+		p_server->step(1.0 / 60.0);
+	}
+
+	LocalVector<Vector2> positions;
+	for (int i = 0; i < 2; i++) {
+		positions.push_back(get_body_position(p_server, bodies[i]));
+		p_server->free(bodies[i]);
+	}
+	for (int i = 0; i < 2; i++) {
+		p_server->free(spaces[i]);
+	}
+	p_server->free(shape);
+	return positions;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Spaces stepped in parallel match serial stepping") {
+	PhysicsServer2D *server = PhysicsServer2D::get_singleton();
+	const Variant parallel = GLOBAL_GET("physics/2d/step_spaces_in_parallel");
+
+	const LocalVector<Vector2> serial_positions = step_two_spaces(server, false);
+	const LocalVector<Vector2> parallel_positions = step_two_spaces(server, true);
+	REQUIRE(serial_positions.size() == 2);
+	REQUIRE(parallel_positions.size() == 2);
+	for (int i = 0; i < 2; i++) {
+		CHECK(parallel_positions[i].is_equal_approx(serial_positions[i]));
+	}
+	// Both bodies fell the same distance under the default gravity.
+	CHECK_FALSE(parallel_positions[0].is_equal_approx(Vector2()));
+	CHECK(parallel_positions[1].is_equal_approx(parallel_positions[0] + Transform2D(0, Vector2(100, 0)).get_origin()));
+
+	ProjectSettings::get_singleton()->set_setting("physics/2d/step_spaces_in_parallel", parallel);
+	server->finish();
+	server->init();
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
@@ -49,6 +49,7 @@
 #include "tests/core/io/test_ip.h"
 #include "tests/core/io/test_json.h"
 #include "tests/core/io/test_marshalls.h"
+#include "tests/core/io/test_net_socket.h"
 #include "tests/core/io/test_pck_packer.h"
 #include "tests/core/io/test_resource.h"
 #include "tests/core/io/test_xml_parser.h"
@@ -101,10 +102,12 @@
 #include "tests/core/variant/test_dictionary.h"
 #include "tests/core/variant/test_variant.h"
 #include "tests/core/variant/test_variant_utility.h"
+#include "tests/main/test_main_timer_sync.h"
 #include "tests/scene/test_animation.h"
 #include "tests/scene/test_audio_stream_wav.h"
 #include "tests/scene/test_bit_map.h"
 #include "tests/scene/test_camera_2d.h"
+#include "tests/scene/test_compressed_texture.h"
 #include "tests/scene/test_control.h"
 #include "tests/scene/test_curve.h"
 #include "tests/scene/test_curve_2d.h"
@@ -124,10 +127,22 @@
 #include "tests/scene/test_viewport.h"
 #include "tests/scene/test_visual_shader.h"
 #include "tests/scene/test_window.h"
+#include "tests/servers/rendering/test_canvas_instance_cache.h"
+#include "tests/servers/rendering/test_instance_cull_buffer.h"
+#include "tests/servers/rendering/test_raster_occlusion_cull.h"
+#include "tests/servers/rendering/test_renderer_canvas_cull.h"
+#include "tests/servers/rendering/test_renderer_scene_cull.h"
+#include "tests/servers/rendering/test_shader_compiler.h"
 #include "tests/servers/rendering/test_shader_preprocessor.h"
+#include "tests/servers/test_physics_server_2d.h"
 #include "tests/servers/test_text_server.h"
 #include "tests/test_validate_testing.h"
 
+#ifdef TOOLS_ENABLED
+#include "tests/editor/test_editor_file_system.h"
+#include "tests/editor/test_shader_cache_export_plugin.h"
+#endif // TOOLS_ENABLED
+
 #ifndef ADVANCED_GUI_DISABLED
 #include "tests/scene/test_code_edit.h"
 #include "tests/scene/test_color_picker.h"
@@ -152,6 +167,7 @@
 #include "tests/scene/test_path_3d.h"
 #include "tests/scene/test_path_follow_3d.h"
 #include "tests/scene/test_primitives.h"
+#include "tests/servers/test_physics_server_3d.h"
 #endif // _3D_DISABLED
 
 #include "modules/modules_tests.gen.h"
@@ -70,11 +70,23 @@ private:
 	IPAddress local_address;
 	bool bound = false;
 
+	// ENet reads one datagram per call, so pull a batch from the socket at once and hand
+	// them out one by one to save system calls on busy hosts.
+	static const int RECV_BATCH_SIZE = 16;
+	uint8_t recv_buffers[RECV_BATCH_SIZE][ENET_PROTOCOL_MAXIMUM_MTU];
+	NetSocket::Datagram recv_batch[RECV_BATCH_SIZE];
+	int recv_count = 0;
+	int recv_next = 0;
+
 public:
 	ENetUDP() {
 		sock = Ref<NetSocket>(NetSocket::create());
 		IP::Type ip_type = IP::TYPE_ANY;
 		sock->open(NetSocket::TYPE_UDP, ip_type);
+		for (int i = 0; i < RECV_BATCH_SIZE; i++) {
+			recv_batch[i].buffer = recv_buffers[i];
+			recv_batch[i].size = ENET_PROTOCOL_MAXIMUM_MTU;
+		}
 	}
 
 	~ENetUDP() {
@@ -104,11 +116,27 @@ public:
 	}
 
 	Error recvfrom(uint8_t *p_buffer, int p_len, int &r_read, IPAddress &r_ip, uint16_t &r_port) {
-		Error err = sock->poll(NetSocket::POLL_TYPE_IN, 0);
-		if (err != OK) {
-			return err;
+		if (recv_next == recv_count) {
+			recv_next = 0;
+			recv_count = 0;
+			Error err = sock->poll(NetSocket::POLL_TYPE_IN, 0);
+			if (err != OK) {
+				return err;
+			}
+			err = sock->recvfrom_batch(recv_batch, RECV_BATCH_SIZE, recv_count);
+			if (err != OK) {
+				return err;
+			}
+		}
+		const NetSocket::Datagram &dg = recv_batch[recv_next++];
+		if (dg.transferred > p_len) {
+			return ERR_OUT_OF_MEMORY;
 		}
-		return sock->recvfrom(p_buffer, p_len, r_read, r_ip, r_port);
+		memcpy(p_buffer, dg.buffer, dg.transferred);
+		r_read = dg.transferred;
+		r_ip = dg.ip;
+		r_port = dg.port;
+		return OK;
 	}
 
 	int set_option(ENetSocketOption p_option, int p_value) {
@@ -156,6 +184,8 @@ public:
 	void close() {
 		sock->close();
 		local_address.clear();
+		recv_count = 0;
+		recv_next = 0;
 	}
 };
 